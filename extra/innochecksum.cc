@@ -127,6 +127,16 @@ static bool			is_log_enabled = false;
 struct flock			lk;
 #endif /* _WIN32 */
 
+/* Pages that are read ahead and checksummed together, when the pages
+are only checked. */
+#define BATCH_PAGES		16
+static byte*			batch_buf;
+/* Bytes in batch_buf, and the next page of it to check. */
+static ulint			batch_bytes;
+static ulint			batch_next;
+/* Whether each full page in batch_buf has a valid CRC-32C checksum. */
+static bool			batch_crc32_valid[BATCH_PAGES];
+
 /* Strict check algorithm name. */
 static ulong			strict_check;
 /* Rewrite checksum algorithm name. */
@@ -452,6 +462,47 @@ ulint read_file(
 	return bytes;
 }
 
+/** Read the next page of an uncompressed tablespace from batch_buf,
+first reading BATCH_PAGES pages into it and checking their CRC-32C
+checksums with buf_page_is_crc32_valid_multi() if it is used up.
+@param[out]	page			the page, in batch_buf
+@param[out]	crc32_valid		whether the page is known to be valid
+@param[in]	physical_page_size	page size
+@param[in,out]	fil_in			tablespace file
+@return number of bytes of the page that were read */
+static
+ulint
+read_page_batched(
+	byte**	page,
+	bool*	crc32_valid,
+	ulint	physical_page_size,
+	FILE*	fil_in)
+{
+	if (batch_next * physical_page_size >= batch_bytes) {
+		batch_bytes = ulint(fread(batch_buf, 1,
+					  BATCH_PAGES * physical_page_size,
+					  fil_in));
+		batch_next = 0;
+		buf_page_is_crc32_valid_multi(
+			batch_buf, batch_bytes / physical_page_size,
+			batch_crc32_valid);
+	}
+
+	const ulint	offset = batch_next * physical_page_size;
+	const ulint	bytes = MY_MIN(batch_bytes - offset,
+				       physical_page_size);
+
+	*page = batch_buf + offset;
+	/* A partially read page is not valid. */
+	*crc32_valid = bytes == physical_page_size
+		&& batch_crc32_valid[batch_next];
+	if (bytes) {
+		batch_next++;
+	}
+
+	return(bytes);
+}
+
 /** Check if page is corrupted or not.
 @param[in]	buf		page frame
 @param[in]	page_size	page size
@@ -1447,6 +1498,8 @@ bool check_encryption(
 Verify page checksum.
 @param[in] buf			page to verify
 @param[in] page_size		page size
+@param[in] crc32_valid		true if the page is known to carry a valid
+				CRC-32C checksum
 @param[in] is_encrypted		true if tablespace is encrypted
 @param[in] is_compressed	true if tablespace is page compressed
 @param[in,out] mismatch_count	Number of pages failed in checksum verify
@@ -1456,6 +1509,7 @@ static
 int verify_checksum(
 	byte* buf,
 	const page_size_t& page_size,
+	bool crc32_valid,
 	bool is_encrypted,
 	bool is_compressed,
 	unsigned long long* mismatch_count)
@@ -1463,7 +1517,7 @@ int verify_checksum(
 	int exit_status = 0;
 	bool is_corrupted = false;
 
-	is_corrupted = is_page_corrupted(
+	is_corrupted = !crc32_valid && is_page_corrupted(
 		buf, page_size, is_encrypted, is_compressed);
 
 	if (is_corrupted) {
@@ -1535,6 +1589,7 @@ int main(
 	/* Buffer to store pages read. */
 	byte*		buf_ptr = NULL;
 	byte*		xdes_ptr = NULL;
+	byte*		batch_ptr = NULL;
 	byte*		buf = NULL;
 	byte*		xdes = NULL;
 	/* bytes read count */
@@ -1621,8 +1676,10 @@ int main(
 
 	buf_ptr = (byte*) malloc(UNIV_PAGE_SIZE_MAX * 2);
 	xdes_ptr = (byte*)malloc(UNIV_PAGE_SIZE_MAX * 2);
+	batch_ptr = (byte*) malloc(UNIV_PAGE_SIZE_MAX * (BATCH_PAGES + 1));
 	buf = (byte *) ut_align(buf_ptr, UNIV_PAGE_SIZE_MAX);
 	xdes = (byte *) ut_align(xdes_ptr, UNIV_PAGE_SIZE_MAX);
+	batch_buf = (byte *) ut_align(batch_ptr, UNIV_PAGE_SIZE_MAX);
 
 	/* The file name is not optional. */
 	for (int i = 0; i < argc; ++i) {
@@ -1731,7 +1788,7 @@ int main(
 			unsigned long long tmp_allow_mismatches = allow_mismatches;
 			allow_mismatches = 0;
 
-			exit_status = verify_checksum(buf, page_size, is_encrypted, is_compressed, &mismatch_count);
+			exit_status = verify_checksum(buf, page_size, false, is_encrypted, is_compressed, &mismatch_count);
 
 			if (exit_status) {
 				fprintf(stderr, "Error: Page 0 checksum mismatch, can't continue. \n");
@@ -1863,12 +1920,29 @@ int main(
 		/* main checksumming loop */
 		cur_page_num = start_page ? start_page : cur_page_num + 1;
 
-		lastt = 0;
-		while (!feof(fil_in)) {
+		/* When the pages are only checked, read them in batches
+		and checksum each batch at once. The pages are written
+		or logged one at a time. */
+		const bool batched = !do_write && !is_log_enabled
+			&& !partial_page_read && !page_size.is_compressed();
+		batch_bytes = batch_next = 0;
 
-			bytes = read_file(buf, partial_page_read,
-					  static_cast<ulong>(
-						  page_size.physical()), fil_in);
+		lastt = 0;
+		while (!feof(fil_in)
+		       || batch_next * page_size.physical() < batch_bytes) {
+			byte*	page = buf;
+			bool	crc32_valid = false;
+
+			if (batched) {
+				bytes = read_page_batched(
+					&page, &crc32_valid,
+					page_size.physical(), fil_in);
+			} else {
+				bytes = read_file(
+					buf, partial_page_read,
+					static_cast<ulong>(
+						page_size.physical()), fil_in);
+			}
 			partial_page_read = false;
 
 			if (!bytes && feof(fil_in)) {
@@ -1894,12 +1968,12 @@ int main(
 
 			if (is_system_tablespace) {
 				/* enable when page is double write buffer.*/
-				skip_page = is_page_doublewritebuffer(buf);
+				skip_page = is_page_doublewritebuffer(page);
 			} else {
 				skip_page = false;
 			}
 
-			ulint cur_page_type = mach_read_from_2(buf+FIL_PAGE_TYPE);
+			ulint cur_page_type = mach_read_from_2(page+FIL_PAGE_TYPE);
 
 			/* FIXME: Page compressed or Page compressed and encrypted
 			pages do not contain checksum. */
@@ -1912,12 +1986,13 @@ int main(
 			checksum verification.*/
 			if (!no_check
 			    && !skip_page
-			    && (exit_status = verify_checksum(buf, page_size,
-					    is_encrypted, is_compressed, &mismatch_count))) {
+			    && (exit_status = verify_checksum(page, page_size,
+					    crc32_valid, is_encrypted,
+					    is_compressed, &mismatch_count))) {
 				goto my_exit;
 			}
 
-			if ((exit_status = rewrite_checksum(filename, fil_in, buf,
+			if ((exit_status = rewrite_checksum(filename, fil_in, page,
 						page_size, &pos, is_encrypted, is_compressed))) {
 				goto my_exit;
 			}
@@ -1932,7 +2007,7 @@ int main(
 			}
 
 			if (page_type_summary || page_type_dump) {
-				parse_page(buf, xdes, fil_page_type, page_size, is_encrypted);
+				parse_page(page, xdes, fil_page_type, page_size, is_encrypted);
 			}
 
 			/* do counter increase and progress printing */
@@ -1979,6 +2054,7 @@ int main(
 
 	free(buf_ptr);
 	free(xdes_ptr);
+	free(batch_ptr);
 
 	my_end(exit_status);
 	DBUG_RETURN(exit_status);
@@ -1992,6 +2068,10 @@ int main(
 		free(xdes_ptr);
 	}
 
+	if (batch_ptr) {
+		free(batch_ptr);
+	}
+
 	if (!read_from_stdin && fil_in) {
 		fclose(fil_in);
 	}
@@ -257,6 +257,7 @@ xb_fil_cur_read(
 	xb_fil_cur_result_t	ret;
 	ib_int64_t		offset;
 	ib_int64_t		to_read;
+	bool			crc32_valid[XB_FIL_CUR_PAGES];
 	const ulint		page_size = cursor->page_size.physical();
 	xb_ad(!cursor->is_system() || page_size == UNIV_PAGE_SIZE);
 
@@ -320,6 +321,15 @@ xb_fil_cur_read(
 		return(XB_FIL_CUR_ERROR);
 	}
 
+	/* Most pages carry a CRC-32C checksum; compute those for the
+	whole batch at once. */
+	if (cursor->page_size.is_compressed()) {
+		memset(crc32_valid, 0, npages * sizeof *crc32_valid);
+	} else {
+		buf_page_is_crc32_valid_multi(cursor->buf, npages,
+					      crc32_valid);
+	}
+
 	/* check pages for corruption and re-read if necessary. i.e. in case of
 	partially written pages */
 	for (page = cursor->buf, i = 0; i < npages;
@@ -330,7 +340,8 @@ xb_fil_cur_read(
 		    page_no >= FSP_EXTENT_SIZE &&
 		    page_no < FSP_EXTENT_SIZE * 3) {
 			/* We ignore the doublewrite buffer pages */
-		} else if (!fil_space_verify_crypt_checksum(
+		} else if (!crc32_valid[i]
+			   && !fil_space_verify_crypt_checksum(
 				   page, cursor->page_size, space->id, page_no)
 			   && buf_page_is_corrupted(true, page,
 						    cursor->page_size,
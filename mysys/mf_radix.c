@@ -58,3 +58,111 @@ void radixsort_for_str_ptr(uchar **base, uint number_of_elements, size_t size_of
   next:;
   }
 }
+
+
+/*
+  MSD radixsort for pointers to fixed length strings.
+
+  Meant for big arrays (see radixsort_msd_is_applicable()), where the LSD
+  sort above would make a pass over the whole array for every byte of
+  the key, and where quicksort is dominated by mispredicted branches in
+  the byte comparisons.
+
+  The array is distributed into 256 buckets on the first byte, and each
+  bucket is sorted recursively on the next byte. Bytes that are equal
+  for the whole bucket are skipped without recursing. To keep the
+  counting and distribution passes cache friendly, the current byte of
+  every key is fetched once into 'digits', so the key data is only
+  touched once per pass. Small buckets are finished with insertion sort.
+  Recursion is limited to MSD_MAX_DEPTH levels to bound the stack usage,
+  deeper buckets are finished with my_qsort2().
+
+  'buffer' must have space for number_of_elements pointers and 'digits'
+  for number_of_elements bytes.
+*/
+
+#define MSD_MAX_DEPTH              16
+#define MSD_INSERTION_SORT_LIMIT   32
+
+my_bool radixsort_msd_is_applicable(uint n_items, size_t size_of_element)
+{
+  return size_of_element > 0 && n_items >= 100000;
+}
+
+
+static void msd_insertion_sort(uchar **base, uint number_of_elements,
+                               size_t offset, size_t length)
+{
+  uchar **end= base + number_of_elements, **ptr, **pos, *key;
+
+  for (ptr= base + 1 ; ptr < end ; ptr++)
+  {
+    key= *ptr;
+    for (pos= ptr ; pos > base && memcmp(pos[-1] + offset, key + offset,
+                                         length) > 0 ; pos--)
+      *pos= pos[-1];
+    *pos= key;
+  }
+}
+
+
+static void msd_sort(uchar **base, uint number_of_elements, size_t offset,
+                     size_t size_of_element, uchar **buffer, uchar *digits,
+                     uint depth)
+{
+  uint32 count[256], start, bucket_start;
+  uint i, byte;
+
+  for (; offset < size_of_element ; offset++)
+  {
+    if (number_of_elements <= MSD_INSERTION_SORT_LIMIT)
+    {
+      msd_insertion_sort(base, number_of_elements, offset,
+                         size_of_element - offset);
+      return;
+    }
+    if (depth >= MSD_MAX_DEPTH)
+    {
+      my_qsort2(base, number_of_elements, sizeof(uchar*),
+                get_ptr_compare(size_of_element), &size_of_element);
+      return;
+    }
+
+    bzero((uchar*) count, sizeof(count));
+    for (i= 0 ; i < number_of_elements ; i++)
+      count[digits[i]= base[i][offset]]++;
+    if (count[digits[0]] == number_of_elements)
+      continue;                                 /* Same byte in all keys */
+
+    /* Turn the counts into bucket start positions and distribute */
+    for (byte= 0, start= 0 ; byte < 256 ; byte++)
+    {
+      uint32 tmp= count[byte];
+      count[byte]= start;
+      start+= tmp;
+    }
+    for (i= 0 ; i < number_of_elements ; i++)
+      buffer[count[digits[i]]++]= base[i];
+    memcpy(base, buffer, number_of_elements * sizeof(uchar*));
+
+    /* count[byte] is now the end of the bucket for 'byte' */
+    for (byte= 0, bucket_start= 0 ; byte < 256 ; byte++)
+    {
+      if (count[byte] - bucket_start > 1)
+        msd_sort(base + bucket_start, count[byte] - bucket_start,
+                 offset + 1, size_of_element, buffer, digits, depth + 1);
+      bucket_start= count[byte];
+    }
+    return;
+  }
+}
+
+
+void radixsort_msd_for_str_ptr(uchar **base, uint number_of_elements,
+                               size_t size_of_element, uchar **buffer,
+                               uchar *digits)
+{
+  if (number_of_elements > 1)
+    msd_sort(base, number_of_elements, 0, size_of_element, buffer, digits,
+             0);
+}
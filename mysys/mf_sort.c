@@ -23,8 +23,15 @@ void my_string_ptr_sort(uchar *base, uint items, size_t size)
 #if INT_MAX > 65536L
   uchar **ptr=0;
 
-  if (radixsort_is_appliccable(items, size) &&
-      (ptr= (uchar**) my_malloc(items*sizeof(char*),MYF(0))))
+  if (radixsort_msd_is_applicable(items, size) &&
+      (ptr= (uchar**) my_malloc(items*(sizeof(char*)+1),MYF(0))))
+  {
+    radixsort_msd_for_str_ptr((uchar**) base,items,size,ptr,
+                              (uchar*) (ptr+items));
+    my_free(ptr);
+  }
+  else if (radixsort_is_appliccable(items, size) &&
+           (ptr= (uchar**) my_malloc(items*sizeof(char*),MYF(0))))
   {
     radixsort_for_str_ptr((uchar**) base,items,size,ptr);
     my_free(ptr);
@@ -112,19 +112,14 @@ static ST_FIELD_INFO qc_info_fields[]=
 
 static const char unknown[]= "#UNKNOWN#";
 
-static int qc_info_fill_table(THD *thd, TABLE_LIST *tables,
-                                              COND *cond)
+static int qc_info_fill_partition(THD *thd, TABLE *table,
+                                  Accessible_Query_Cache *part)
 {
   int status= 1;
   CHARSET_INFO *scs= system_charset_info;
-  TABLE *table= tables->table;
-  HASH *queries = qc->get_queries();
-
-  /* one must have PROCESS privilege to see others' queries */
-  if (check_global_access(thd, PROCESS_ACL, true))
-    return 0;
+  HASH *queries = part->get_queries();
 
-  if (qc->try_lock(thd))
+  if (part->try_lock(thd))
     return 0; // QC is or is being disabled
 
   /* loop through all queries in the query cache */
@@ -268,17 +263,85 @@ static int qc_info_fill_table(THD *thd, TABLE_LIST *tables,
   status = 0;
 
 cleanup:
-  qc->unlock();
+  part->unlock();
   return status;
 }
 
-static int qc_info_plugin_init(void *p)
+static int qc_info_fill_table(THD *thd, TABLE_LIST *tables,
+                                              COND *cond)
 {
-  ST_SCHEMA_TABLE *schema= (ST_SCHEMA_TABLE *)p;
+  /* one must have PROCESS privilege to see others' queries */
+  if (check_global_access(thd, PROCESS_ACL, true))
+    return 0;
 
-  schema->fields_info= qc_info_fields;
-  schema->fill_table= qc_info_fill_table;
+  for (uint i= 0; i < qc->partition_count(); i++)
+    if (qc_info_fill_partition(thd, tables->table,
+                               (Accessible_Query_Cache *)
+                               qc->get_partition(i)))
+      return 1;
+  return 0;
+}
+
+
+#define COLUMN_PARTITION_ID 0
+#define COLUMN_PARTITION_SIZE 1
+#define COLUMN_PARTITION_FREE_MEMORY 2
+#define COLUMN_PARTITION_QUERIES 3
+#define COLUMN_PARTITION_HITS 4
+#define COLUMN_PARTITION_INSERTS 5
+#define COLUMN_PARTITION_NOT_CACHED 6
+#define COLUMN_PARTITION_LOWMEM_PRUNES 7
+#define COLUMN_PARTITION_LOCK_WAITS 8
+
+static ST_FIELD_INFO qc_partitions_fields[]=
+{
+  {"PARTITION_ID", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"SIZE", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"FREE_MEMORY", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"QUERIES", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"HITS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"INSERTS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"NOT_CACHED", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"LOWMEM_PRUNES", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"LOCK_WAITS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {0, 0, MYSQL_TYPE_STRING, 0, 0, 0, 0}
+};
+
+/*
+  One row per partition of the query cache. The counters are read without
+  locking the partitions, as the Qcache_% status variables are.
+*/
+static int qc_partitions_fill_table(THD *thd, TABLE_LIST *tables,
+                                    COND *cond)
+{
+  TABLE *table= tables->table;
+
+  if (check_global_access(thd, PROCESS_ACL, true))
+    return 0;
 
+  for (uint i= 0; i < qc->partition_count(); i++)
+  {
+    Query_cache *part= qc->get_partition(i);
+
+    table->field[COLUMN_PARTITION_ID]->store(i, 1);
+    table->field[COLUMN_PARTITION_SIZE]->store(part->query_cache_size, 1);
+    table->field[COLUMN_PARTITION_FREE_MEMORY]->store(part->free_memory, 1);
+    table->field[COLUMN_PARTITION_QUERIES]->store(part->queries_in_cache, 1);
+    table->field[COLUMN_PARTITION_HITS]->store(part->hits, 1);
+    table->field[COLUMN_PARTITION_INSERTS]->store(part->inserts, 1);
+    table->field[COLUMN_PARTITION_NOT_CACHED]->store(part->refused, 1);
+    table->field[COLUMN_PARTITION_LOWMEM_PRUNES]->
+      store(part->lowmem_prunes, 1);
+    table->field[COLUMN_PARTITION_LOCK_WAITS]->store(part->lock_waits, 1);
+
+    if (schema_table_store_record(thd, table))
+      return 1;
+  }
+  return 0;
+}
+
+static int qc_info_find_query_cache()
+{
 #ifdef _WIN32
   qc = (Accessible_Query_Cache *)
     GetProcAddress(GetModuleHandle(NULL), "?query_cache@@3VQuery_cache@@A");
@@ -289,6 +352,26 @@ static int qc_info_plugin_init(void *p)
   return qc == 0;
 }
 
+static int qc_info_plugin_init(void *p)
+{
+  ST_SCHEMA_TABLE *schema= (ST_SCHEMA_TABLE *)p;
+
+  schema->fields_info= qc_info_fields;
+  schema->fill_table= qc_info_fill_table;
+
+  return qc_info_find_query_cache();
+}
+
+static int qc_partitions_plugin_init(void *p)
+{
+  ST_SCHEMA_TABLE *schema= (ST_SCHEMA_TABLE *)p;
+
+  schema->fields_info= qc_partitions_fields;
+  schema->fill_table= qc_partitions_fill_table;
+
+  return qc_info_find_query_cache();
+}
+
 
 static struct st_mysql_information_schema qc_info_plugin=
 { MYSQL_INFORMATION_SCHEMA_INTERFACE_VERSION };
@@ -312,6 +395,21 @@ maria_declare_plugin(query_cache_info)
   NULL,                       /* system variables     */
   "1.1",                      /* version as a string  */
   MariaDB_PLUGIN_MATURITY_STABLE
+},
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &qc_info_plugin,
+  "QUERY_CACHE_PARTITIONS",
+  "MariaDB Corporation",
+  "Lists the partitions of the query cache with their statistics.",
+  PLUGIN_LICENSE_BSD,
+  qc_partitions_plugin_init,  /* Plugin Init */
+  0,                          /* Plugin Deinit        */
+  0x0100,                     /* version, hex         */
+  NULL,                       /* status variables     */
+  NULL,                       /* system variables     */
+  "1.0",                      /* version as a string  */
+  MariaDB_PLUGIN_MATURITY_STABLE
 }
 maria_declare_plugin_end;
 
@@ -0,0 +1,130 @@
+/* Copyright (C) 2018 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02111-1301 USA */
+
+/*
+  INFORMATION_SCHEMA.THREAD_POOL_USERS: the per-user statement and queue
+  time accounting of the thread pool, one row per user that has logged
+  in while thread_handling=pool-of-threads.
+*/
+
+#ifndef MYSQL_SERVER
+#define MYSQL_SERVER
+#endif
+
+#include <my_global.h>
+#include <sql_parse.h>          // check_global_access
+#include <sql_acl.h>            // PROCESS_ACL
+#include <sql_class.h>          // THD
+#include <table.h>              // ST_SCHEMA_TABLE
+#include <threadpool.h>
+#include <mysql/plugin.h>
+
+bool schema_table_store_record(THD *thd, TABLE *table);
+
+#define COLUMN_USER 0
+#define COLUMN_CONNECTIONS 1
+#define COLUMN_RUNNING 2
+#define COLUMN_WAITING 3
+#define COLUMN_STATEMENTS 4
+#define COLUMN_QUEUE_TIME 5
+#define COLUMN_ADMISSION_WAITS 6
+#define COLUMN_ADMISSION_TIME 7
+
+static ST_FIELD_INFO tp_users_fields[]=
+{
+  {"USER", USERNAME_CHAR_LENGTH, MYSQL_TYPE_STRING, 0, 0, 0, 0},
+  {"CONNECTIONS", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"RUNNING", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"WAITING", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"STATEMENTS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"QUEUE_TIME", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"ADMISSION_WAITS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"ADMISSION_TIME", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {0, 0, MYSQL_TYPE_STRING, 0, 0, 0, 0}
+};
+
+struct tp_users_fill_arg
+{
+  THD *thd;
+  TABLE *table;
+};
+
+/*
+  Store one user. The counters are read without synchronization, they
+  are updated concurrently by the statements of the user.
+*/
+static int tp_users_fill_user(TP_user *user, void *arg)
+{
+  tp_users_fill_arg *fill= (tp_users_fill_arg *) arg;
+  TABLE *table= fill->table;
+
+  table->field[COLUMN_USER]->store(user->name, user->name_length,
+                                   system_charset_info);
+  table->field[COLUMN_CONNECTIONS]->store(user->connections, 1);
+  table->field[COLUMN_RUNNING]->store(MY_MAX(user->running, 0), 1);
+  table->field[COLUMN_WAITING]->store(MY_MAX(user->waiting, 0), 1);
+  table->field[COLUMN_STATEMENTS]->store(user->statements, 1);
+  table->field[COLUMN_QUEUE_TIME]->store(user->queue_time, 1);
+  table->field[COLUMN_ADMISSION_WAITS]->store(user->admission_waits, 1);
+  table->field[COLUMN_ADMISSION_TIME]->store(user->admission_time, 1);
+
+  return schema_table_store_record(fill->thd, table);
+}
+
+static int tp_users_fill_table(THD *thd, TABLE_LIST *tables, COND *cond)
+{
+  tp_users_fill_arg fill= { thd, tables->table };
+
+  if (check_global_access(thd, PROCESS_ACL, true))
+    return 0;
+
+  return tp_for_each_user(tp_users_fill_user, &fill);
+}
+
+static int tp_users_plugin_init(void *p)
+{
+  ST_SCHEMA_TABLE *schema= (ST_SCHEMA_TABLE *)p;
+
+  schema->fields_info= tp_users_fields;
+  schema->fill_table= tp_users_fill_table;
+
+  return 0;
+}
+
+
+static struct st_mysql_information_schema tp_info_plugin=
+{ MYSQL_INFORMATION_SCHEMA_INTERFACE_VERSION };
+
+/*
+  Plugin library descriptor
+*/
+
+maria_declare_plugin(thread_pool_info)
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &tp_info_plugin,
+  "THREAD_POOL_USERS",
+  "MariaDB Corporation",
+  "Statement admission and queue time of the thread pool, per user.",
+  PLUGIN_LICENSE_GPL,
+  tp_users_plugin_init,       /* Plugin Init          */
+  0,                          /* Plugin Deinit        */
+  0x0100,                     /* version, hex         */
+  NULL,                       /* status variables     */
+  NULL,                       /* system variables     */
+  "1.0",                      /* version as a string  */
+  MariaDB_PLUGIN_MATURITY_STABLE
+}
+maria_declare_plugin_end;
@@ -66,6 +66,10 @@ static SORT_ADDON_FIELD *get_addon_fields(ulong max_length_for_sort_data,
                                           LEX_STRING *addon_buf);
 static void unpack_addon_fields(struct st_sort_addon_field *addon_field,
                                 uchar *buff, uchar *buff_end);
+static int do_merge_buffers(THD *thd, bool in_worker, Sort_param *param,
+                            IO_CACHE *from_file, IO_CACHE *to_file,
+                            uchar *sort_buffer, BUFFPEK *lastbuff,
+                            BUFFPEK *Fb, BUFFPEK *Tb, int flag);
 static bool check_if_pq_applicable(Sort_param *param, SORT_INFO *info,
                                    TABLE *table,
                                    ha_rows records, size_t memory_available);
@@ -193,6 +197,10 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
                           table,
                           thd->variables.max_length_for_sort_data,
                           max_rows, filesort->sort_positions);
+  param.sort_threads= (uint) thd->variables.filesort_threads;
+  if (param.sort_threads > 1)
+    param.workers= new_filesort_workers(param.sort_threads - 1);
+  param.tracker= tracker;
 
   sort->addon_buf=    param.addon_buf;
   sort->addon_field=  param.addon_field;
@@ -347,6 +355,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
 
   err:
   my_free(param.tmp_buffer);
+  delete_filesort_workers(param.workers);
   if (!subselect || !subselect->is_uncacheable())
   {
     sort->free_sort_buffer();
@@ -1455,12 +1464,216 @@ static bool check_if_pq_applicable(Sort_param *param,
 }
 
 
-/** Merge buffers to make < MERGEBUFF2 buffers. */
+/**
+  One thread of a parallel merge pass, see merge_pass_parallel(). It
+  merges the groups [first_group, end_group) with its own share of the
+  sort buffer, writing through its own cache of the output file, which
+  starts where the output of first_group goes.
+*/
+
+struct Merge_pass_unit
+{
+  Sort_param param;             /* With the share of max_keys_per_buffer */
+  uchar *sort_buffer;
+  IO_CACHE to_file;
+  uint first_group, end_group;
+  int error;
+};
+
+
+/** A pass of merge_many_buff() that is run by several threads */
+
+struct Merge_pass
+{
+  THD *thd;
+  IO_CACHE *from_file;
+  BUFFPEK *buffpek;             /* The runs to merge */
+  uint *group_start;            /* Group g is runs [group_start[g], [g+1]) */
+  BUFFPEK *merged;              /* The run merged from each group */
+  Merge_pass_unit *units;
+};
+
+
+/**
+  Write function of the caches of a parallel merge pass. The caches
+  share the file descriptor, so they write at explicit positions instead
+  of seeking.
+*/
+
+static int merge_pass_write(IO_CACHE *info, const uchar *buffer, size_t count)
+{
+  if (buffer != info->write_buffer)
+  {
+    count&= ~((size_t) IO_SIZE - 1);
+    if (!count)
+      return 0;
+  }
+  if (mysql_file_pwrite(info->file, buffer, count, info->pos_in_file,
+                        info->myflags | MY_NABP))
+    return info->error= -1;
+  info->pos_in_file+= count;
+  return 0;
+}
+
+
+static void merge_pass_unit(void *arg, uint index)
+{
+  Merge_pass *pass= (Merge_pass*) arg;
+  Merge_pass_unit *unit= pass->units + index;
+
+  for (uint g= unit->first_group; g < unit->end_group; g++)
+  {
+    if ((unit->error=
+         do_merge_buffers(pass->thd, index != 0, &unit->param,
+                          pass->from_file, &unit->to_file,
+                          unit->sort_buffer, pass->merged + g,
+                          pass->buffpek + pass->group_start[g],
+                          pass->buffpek + pass->group_start[g + 1] - 1, 0)))
+      return;
+  }
+  unit->error= my_b_flush_io_cache(&unit->to_file, 0);
+}
+
+
+/**
+  Run one pass of merge_many_buff() with up to param->sort_threads
+  threads. The runs are merged in the same groups as by a serial pass,
+  and the groups are divided among the threads. Each thread gets its
+  share of the sort buffer. As the output of each group is as long as
+  its runs, up to the LIMIT, each thread writes directly to where the
+  output of its groups goes in to_file.
+
+  @param[out] lastbuff  The BUFFPEK after the merged runs
+
+  @retval -1  The pass cannot be run in parallel; nothing was done
+  @retval 0   OK; the merged runs are at the start of buffpek
+  @retval 1   Error
+*/
+
+static int merge_pass_parallel(Sort_param *param, uchar *sort_buffer,
+                               BUFFPEK *buffpek, uint maxbuffer,
+                               IO_CACHE *from_file, IO_CACHE *to_file,
+                               BUFFPEK **lastbuff)
+{
+  THD *thd= current_thd;
+  uint i, n_groups, n_units, *group_start;
+  Merge_pass pass;
+  Merge_pass_unit *units;
+  BUFFPEK *merged;
+  my_off_t pos= 0;
+  int error= 0;
+  DBUG_ENTER("merge_pass_parallel");
+
+  /* Unique removes duplicates, so its output length is not known */
+  if (!param->workers || param->unique_buff ||
+      ((from_file->myflags | to_file->myflags) & MY_ENCRYPT))
+    DBUG_RETURN(-1);
+
+  n_groups= (maxbuffer - MERGEBUFF*3/2) / MERGEBUFF + 2;
+  n_units= MY_MIN(MY_MIN(param->sort_threads, n_groups),
+                  param->max_keys_per_buffer /
+                  FILESORT_MIN_MERGE_KEYS_PER_THREAD);
+  if (n_units < 2 ||
+      !my_multi_malloc(MYF(MY_THREAD_SPECIFIC),
+                       &group_start, (n_groups + 1) * sizeof(uint),
+                       &merged, n_groups * sizeof(BUFFPEK),
+                       &units, n_units * sizeof(Merge_pass_unit),
+                       NullS))
+    DBUG_RETURN(-1);
+
+  for (i= 0; i < n_groups; i++)
+    group_start[i]= i * MERGEBUFF;
+  group_start[n_groups]= maxbuffer + 1;
+
+  if (to_file->file < 0 && real_open_cached_file(to_file))
+  {
+    my_free(group_start);
+    DBUG_RETURN(1);
+  }
+
+  for (i= 0; i < n_units; i++)
+  {
+    Merge_pass_unit *unit= units + i;
+    unit->param= *param;
+    unit->param.max_keys_per_buffer= param->max_keys_per_buffer / n_units;
+    unit->sort_buffer= sort_buffer + (size_t) i * param->rec_length *
+                                     unit->param.max_keys_per_buffer;
+    unit->first_group= n_groups * i / n_units;
+    unit->end_group= n_groups * (i + 1) / n_units;
+    unit->error= 0;
+    if (init_io_cache(&unit->to_file, to_file->file, DISK_BUFFER_SIZE,
+                      WRITE_CACHE, pos, 0, MYF(0)))
+    {
+      while (i--)
+        end_io_cache(&units[i].to_file);
+      my_free(group_start);
+      DBUG_RETURN(-1);
+    }
+    unit->to_file.write_function= merge_pass_write;
+
+    for (uint g= unit->first_group; g < unit->end_group; g++)
+    {
+      ha_rows rows= 0;
+      for (uint r= group_start[g]; r < group_start[g + 1]; r++)
+        rows+= buffpek[r].count;
+      set_if_smaller(rows, param->max_rows);
+      pos+= rows * param->rec_length;
+    }
+  }
+
+  pass.thd= thd;
+  pass.from_file= from_file;
+  pass.buffpek= buffpek;
+  pass.group_start= group_start;
+  pass.merged= merged;
+  pass.units= units;
+  if (!run_filesort_workers(param->workers, n_units, merge_pass_unit, &pass))
+    error= -1;
+
+  for (i= 0; i < n_units; i++)
+  {
+    if (units[i].error)
+      error= 1;
+    end_io_cache(&units[i].to_file);
+  }
+
+  if (error > 0)
+  {
+    if (!thd->killed && !thd->is_error())
+      my_error(ER_TEMP_FILE_WRITE_FAILURE, MYF(0));
+  }
+  else if (!error)
+  {
+    for (i= 0; i < n_groups; i++)
+    {
+      DBUG_ASSERT(i + 1 == n_groups ||
+                  merged[i + 1].file_pos ==
+                  merged[i].file_pos + merged[i].count * param->rec_length);
+      buffpek[i].count= merged[i].count;
+      buffpek[i].file_pos= merged[i].file_pos;
+      thd->inc_status_sort_merge_passes();
+      thd->query_plan_fsort_passes++;
+    }
+    *lastbuff= buffpek + n_groups;
+    /* Make my_b_tell(to_file) the end of what the threads wrote */
+    if (reinit_io_cache(to_file, WRITE_CACHE, pos, 0, 0))
+      error= 1;
+  }
+  my_free(group_start);
+  DBUG_RETURN(error);
+}
+
+
+/**
+  Merge buffers to make < MERGEBUFF2 buffers. If the filesort has sort
+  threads, each pass is run by several threads, see merge_pass_parallel().
+*/
 
 int merge_many_buff(Sort_param *param, uchar *sort_buffer,
                     BUFFPEK *buffpek, uint *maxbuffer, IO_CACHE *t_file)
 {
   register uint i;
+  int error;
   IO_CACHE t_file2,*from_file,*to_file,*temp;
   BUFFPEK *lastbuff;
   DBUG_ENTER("merge_many_buff");
@@ -1480,15 +1693,22 @@ int merge_many_buff(Sort_param *param, uchar *sort_buffer,
     if (reinit_io_cache(to_file,WRITE_CACHE,0L,0,0))
       goto cleanup;
     lastbuff=buffpek;
-    for (i=0 ; i <= *maxbuffer-MERGEBUFF*3/2 ; i+=MERGEBUFF)
+    error= merge_pass_parallel(param, sort_buffer, buffpek, *maxbuffer,
+                               from_file, to_file, &lastbuff);
+    if (error > 0)
+      goto cleanup;
+    if (error < 0)
     {
+      for (i=0 ; i <= *maxbuffer-MERGEBUFF*3/2 ; i+=MERGEBUFF)
+      {
+        if (merge_buffers(param,from_file,to_file,sort_buffer,lastbuff++,
+                          buffpek+i,buffpek+i+MERGEBUFF-1,0))
+        goto cleanup;
+      }
       if (merge_buffers(param,from_file,to_file,sort_buffer,lastbuff++,
-			buffpek+i,buffpek+i+MERGEBUFF-1,0))
-      goto cleanup;
+                        buffpek+i,buffpek+ *maxbuffer,0))
+        break;					/* purecov: inspected */
     }
-    if (merge_buffers(param,from_file,to_file,sort_buffer,lastbuff++,
-		      buffpek+i,buffpek+ *maxbuffer,0))
-      break;					/* purecov: inspected */
     if (flush_io_cache(to_file))
       break;					/* purecov: inspected */
     temp=from_file; from_file=to_file; to_file=temp;
@@ -1589,6 +1809,31 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
                   IO_CACHE *to_file, uchar *sort_buffer,
                   BUFFPEK *lastbuff, BUFFPEK *Fb, BUFFPEK *Tb,
                   int flag)
+{
+  THD* const thd=current_thd;
+
+  thd->inc_status_sort_merge_passes();
+  thd->query_plan_fsort_passes++;
+
+  return do_merge_buffers(thd, false, param, from_file, to_file, sort_buffer,
+                          lastbuff, Fb, Tb, flag);
+} /* merge_buffers */
+
+
+/**
+  Merge buffers to one buffer, see merge_buffers().
+
+  @param thd          The thread that runs the filesort
+  @param in_worker    Whether this is called by a thread of param->workers,
+                      which has no THD of its own; then only thd->killed is
+                      checked, and from_file and to_file must not be
+                      encrypted
+*/
+
+static int do_merge_buffers(THD *thd, bool in_worker, Sort_param *param,
+                            IO_CACHE *from_file, IO_CACHE *to_file,
+                            uchar *sort_buffer, BUFFPEK *lastbuff,
+                            BUFFPEK *Fb, BUFFPEK *Tb, int flag)
 {
   int error;
   uint rec_length,res_length,offset;
@@ -1605,11 +1850,7 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
   uchar *src;
   uchar *unique_buff= param->unique_buff;
   const bool killable= !param->not_killable;
-  THD* const thd=current_thd;
-  DBUG_ENTER("merge_buffers");
-
-  thd->inc_status_sort_merge_passes();
-  thd->query_plan_fsort_passes++;
+  DBUG_ENTER("do_merge_buffers");
 
   error=0;
   rec_length= param->rec_length;
@@ -1686,7 +1927,8 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
 
   while (queue.elements > 1)
   {
-    if (killable && thd->check_killed())
+    if (killable &&
+        (in_worker ? thd->killed != NOT_KILLED : thd->check_killed()))
     {
       error= 1; goto err;                        /* purecov: inspected */
     }
@@ -1847,7 +2089,7 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
 err:
   delete_queue(&queue);
   DBUG_RETURN(error);
-} /* merge_buffers */
+} /* do_merge_buffers */
 
 
 	/* Do a merge to output-file (save only positions) */
@@ -18,6 +18,7 @@
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
+#include "mysqld.h"                             /* key_thread_filesort */
 
 
 namespace {
@@ -157,21 +158,375 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
+namespace {
+/**
+  Sort an array of pointers to fixed length keys in the calling thread.
+
+  The keys produced by make_sortkey() compare with memcmp(), so big
+  arrays are sorted with MSD radix sort and medium sized arrays of
+  short keys with LSD radix sort. Everything else uses quicksort.
+
+  @param scratch  Space for 'count' pointers the radix sorts may use,
+                  or NULL to have it allocated here if needed
+  @param digits   Space for 'count' bytes, used with 'scratch'
+*/
+void sort_keys_serial(uchar **keys, uint count, size_t size,
+                      uchar **scratch, uchar *digits)
+{
+  bool msd= radixsort_msd_is_applicable(count, size);
+  if (msd || radixsort_is_appliccable(count, size))
+  {
+    uchar **buffer= scratch;
+    if (!buffer &&
+        (buffer= (uchar**) my_malloc(count * (sizeof(uchar*) + 1),
+                                     MYF(MY_THREAD_SPECIFIC))))
+      digits= (uchar*) (buffer + count);
+    if (buffer)
+    {
+      if (msd)
+        radixsort_msd_for_str_ptr(keys, count, size, buffer, digits);
+      else
+        radixsort_for_str_ptr(keys, count, size, buffer);
+      if (buffer != scratch)
+        my_free(buffer);
+      return;
+    }
+  }
+
+  my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
+}
+
+
+/**
+  Merge two adjacent sorted runs of key pointers into 'to'.
+  Keys that compare equal are taken from the left run first.
+*/
+void merge_key_runs(uchar **left, uint left_count,
+                    uchar **right, uint right_count,
+                    uchar **to, size_t size)
+{
+  uchar **left_end= left + left_count;
+  uchar **right_end= right + right_count;
+
+  while (left != left_end && right != right_end)
+  {
+    if (memcmp(*right, *left, size) < 0)
+      *to++= *right++;
+    else
+      *to++= *left++;
+  }
+  while (left != left_end)
+    *to++= *left++;
+  while (right != right_end)
+    *to++= *right++;
+}
+
+
+/**
+  One unit of work for a parallel sort: either sort a run in place,
+  or merge two adjacent runs from 'keys' into 'to', or, for
+  run_filesort_workers(), call func(arg, index).
+
+  Worker threads have no THD, so they must not allocate thread specific
+  memory: all buffers are allocated up front by the sorting thread.
+*/
+struct Sort_worker
+{
+  uchar **keys;
+  uint count;                  /* Keys in the run (left run when merging) */
+  uint right_count;            /* Keys in the right run */
+  uchar **to;                  /* Merge destination, or sort scratch space */
+  uchar *digits;               /* Sort scratch space */
+  bool merge;
+  size_t sort_length;
+  void (*func)(void *arg, uint index);
+  void *arg;
+  uint index;
+  ulonglong time;              /* Time spent in this unit, microseconds */
+
+  void run()
+  {
+    ulonglong start= microsecond_interval_timer();
+    if (func)
+      func(arg, index);
+    else if (merge)
+      merge_key_runs(keys, count, keys + count, right_count, to,
+                     sort_length);
+    else
+      sort_keys_serial(keys, count, sort_length, to, digits);
+    time= microsecond_interval_timer() - start;
+  }
+};
+
+
+}
+
+
+pthread_handler_t filesort_worker_thread(void *arg);
+
+
+/**
+  Threads that run the units of the parallel sorts of one filesort().
+  They are started by the first sort that needs them and are reused for
+  the sorts of all the buffers of the filesort, until the object is
+  deleted.
+
+  Unit i of a sort is always run by thread i - 1, and unit 0 by the
+  calling thread, so the number of threads that run a sort is known
+  in advance. A unit whose thread could not be started is run by the
+  calling thread.
+*/
+class Filesort_workers
+{
+public:
+  explicit Filesort_workers(uint max_threads_arg)
+    :max_threads(max_threads_arg), n_threads(0), n_pending(0), stop(false)
+  {
+    mysql_mutex_init(key_LOCK_filesort_workers, &mutex, MY_MUTEX_INIT_FAST);
+    mysql_cond_init(key_COND_filesort_work, &cond_work, NULL);
+    mysql_cond_init(key_COND_filesort_done, &cond_done, NULL);
+  }
+
+  ~Filesort_workers()
+  {
+    mysql_mutex_lock(&mutex);
+    stop= true;
+    mysql_cond_broadcast(&cond_work);
+    mysql_mutex_unlock(&mutex);
+    for (uint i= 0; i < n_threads; i++)
+      pthread_join(threads[i].thread, NULL);
+    mysql_cond_destroy(&cond_done);
+    mysql_cond_destroy(&cond_work);
+    mysql_mutex_destroy(&mutex);
+  }
+
+  /**
+    Run the units and wait for all of them.
+
+    @param      units    The units
+    @param      n        Number of units
+    @param[out] used     Number of threads that ran the units
+
+    @return Sum of the time spent in all units, microseconds
+  */
+  ulonglong run(Sort_worker *units, uint n, uint *used)
+  {
+    ulonglong total= 0;
+    uint with_thread;
+
+    for (; n_threads < MY_MIN(n - 1, max_threads); n_threads++)
+    {
+      Worker_thread *slot= threads + n_threads;
+      slot->pool= this;
+      slot->unit= NULL;
+      if (mysql_thread_create(key_thread_filesort, &slot->thread, NULL,
+                              filesort_worker_thread, slot))
+        break;
+    }
+    with_thread= MY_MIN(n - 1, n_threads);
+
+    mysql_mutex_lock(&mutex);
+    for (uint i= 0; i < with_thread; i++)
+      threads[i].unit= units + i + 1;
+    n_pending= with_thread;
+    mysql_cond_broadcast(&cond_work);
+    mysql_mutex_unlock(&mutex);
+
+    units[0].run();
+    for (uint i= with_thread + 1; i < n; i++)
+      units[i].run();
+
+    mysql_mutex_lock(&mutex);
+    while (n_pending)
+      mysql_cond_wait(&cond_done, &mutex);
+    mysql_mutex_unlock(&mutex);
+
+    for (uint i= 0; i < n; i++)
+      total+= units[i].time;
+    *used= with_thread + 1;
+    return total;
+  }
+
+private:
+  struct Worker_thread
+  {
+    Filesort_workers *pool;
+    pthread_t thread;
+    Sort_worker *unit;          /* The unit to run next, or NULL */
+  };
+
+  friend void *filesort_worker_thread(void *arg);
+
+  void work(Worker_thread *self)
+  {
+    mysql_mutex_lock(&mutex);
+    while (!stop || self->unit)
+    {
+      if (Sort_worker *unit= self->unit)
+      {
+        mysql_mutex_unlock(&mutex);
+        unit->run();
+        mysql_mutex_lock(&mutex);
+        self->unit= NULL;
+        if (!--n_pending)
+          mysql_cond_signal(&cond_done);
+      }
+      else
+        mysql_cond_wait(&cond_work, &mutex);
+    }
+    mysql_mutex_unlock(&mutex);
+  }
+
+  mysql_mutex_t mutex;
+  mysql_cond_t cond_work;       /* A unit was assigned, or stop was set */
+  mysql_cond_t cond_done;       /* n_pending dropped to 0 */
+  uint max_threads;
+  uint n_threads;               /* Threads started */
+  uint n_pending;               /* Assigned units which are not done */
+  bool stop;
+  Worker_thread threads[FILESORT_MAX_THREADS - 1];
+};
+
+
+pthread_handler_t filesort_worker_thread(void *arg)
+{
+  my_thread_init();
+  Filesort_workers::Worker_thread *self=
+    static_cast<Filesort_workers::Worker_thread*>(arg);
+  self->pool->work(self);
+  my_thread_end();
+  return 0;
+}
+
+
+Filesort_workers *new_filesort_workers(uint max_threads)
+{
+  DBUG_ASSERT(max_threads < FILESORT_MAX_THREADS);
+  return new Filesort_workers(max_threads);
+}
+
+
+void delete_filesort_workers(Filesort_workers *workers)
+{
+  delete workers;
+}
+
+
+uint run_filesort_workers(Filesort_workers *workers, uint n,
+                          void (*func)(void *arg, uint index), void *arg)
+{
+  Sort_worker *units;
+  uint used;
+
+  if (!(units= (Sort_worker*) my_malloc(n * sizeof(Sort_worker),
+                                        MYF(MY_THREAD_SPECIFIC | MY_ZEROFILL))))
+    return 0;
+  for (uint i= 0; i < n; i++)
+  {
+    units[i].func= func;
+    units[i].arg= arg;
+    units[i].index= i;
+  }
+  workers->run(units, n, &used);
+  my_free(units);
+  return used;
+}
+
+
+/**
+  Sort the key pointers with up to n_threads threads.
+
+  The pointer array is cut into n_threads runs which are sorted
+  concurrently. The runs are then merged pairwise, each round merging
+  all pairs concurrently, ping-ponging between the key array and a
+  temporary array of the same size, until a single run is left. The
+  threads are those of param->workers, which are kept for the whole
+  filesort.
+
+  @return false if the keys were sorted
+  @return true  if we ran out of memory; the keys are left unchanged
+*/
+
+bool Filesort_buffer::parallel_sort(const Sort_param *param, uint count,
+                                    uint n_threads)
+{
+  size_t size= param->sort_length;
+  uchar **keys= get_sort_keys();
+  uchar **buffer, *digits;
+  Sort_worker *workers;
+  uint *run_start, threads_used, merge_threads;
+  ulonglong sort_time, merge_time= 0;
+  DBUG_ENTER("Filesort_buffer::parallel_sort");
+
+  if (!param->workers ||
+      !my_multi_malloc(MYF(MY_THREAD_SPECIFIC),
+                       &buffer, count * sizeof(uchar*),
+                       &digits, (size_t) count,
+                       &workers, n_threads * sizeof(Sort_worker),
+                       &run_start, (n_threads + 1) * sizeof(uint),
+                       NullS))
+    DBUG_RETURN(true);
+
+  bzero(workers, n_threads * sizeof(Sort_worker));
+  for (uint i= 0; i <= n_threads; i++)
+    run_start[i]= (uint) ((ulonglong) count * i / n_threads);
+
+  for (uint i= 0; i < n_threads; i++)
+  {
+    workers[i].keys= keys + run_start[i];
+    workers[i].count= run_start[i + 1] - run_start[i];
+    workers[i].to= buffer + run_start[i];
+    workers[i].digits= digits + run_start[i];
+    workers[i].sort_length= size;
+  }
+  sort_time= param->workers->run(workers, n_threads, &threads_used);
+
+  uchar **from= keys, **to= buffer;
+  for (uint runs= n_threads; runs > 1; runs= (runs + 1) / 2)
+  {
+    uint pairs= runs / 2;
+    for (uint i= 0; i < pairs; i++)
+    {
+      uint left= run_start[2 * i], mid= run_start[2 * i + 1];
+      uint right= run_start[2 * i + 2];
+      workers[i].keys= from + left;
+      workers[i].count= mid - left;
+      workers[i].right_count= right - mid;
+      workers[i].to= to + left;
+      workers[i].merge= true;
+    }
+    merge_time+= param->workers->run(workers, pairs, &merge_threads);
+    if (runs & 1)
+    {
+      /* The odd run out is carried over to the next round as is */
+      uint left= run_start[runs - 1];
+      memcpy(to + left, from + left,
+             (run_start[runs] - left) * sizeof(uchar*));
+    }
+    for (uint i= 0; i <= (runs + 1) / 2; i++)
+      run_start[i]= run_start[MY_MIN(2 * i, runs)];
+    swap_variables(uchar**, from, to);
+  }
+  if (from != keys)
+    memcpy(keys, from, count * sizeof(uchar*));
+
+  if (param->tracker)
+    param->tracker->report_parallel_sort(threads_used, sort_time, merge_time);
+  my_free(buffer);
+  DBUG_RETURN(false);
+}
+
+
 void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
   if (count <= 1 || size == 0)
     return;
-  uchar **keys= get_sort_keys();
-  uchar **buffer= NULL;
-  if (radixsort_is_appliccable(count, param->sort_length) &&
-      (buffer= (uchar**) my_malloc(count*sizeof(char*),
-                                   MYF(MY_THREAD_SPECIFIC))))
-  {
-    radixsort_for_str_ptr(keys, count, param->sort_length, buffer);
-    my_free(buffer);
+
+  uint n_threads= MY_MIN(param->sort_threads,
+                         count / FILESORT_MIN_KEYS_PER_THREAD);
+  if (n_threads > 1 && !parallel_sort(param, count, n_threads))
     return;
-  }
-  
-  my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
+
+  sort_keys_serial(get_sort_keys(), count, size, NULL, NULL);
 }
@@ -20,6 +20,38 @@
 #include "sql_array.h"
 
 class Sort_param;
+
+/*
+  Minimum number of keys each thread must get before filesort splits
+  the sort of a buffer across several threads.
+*/
+#define FILESORT_MIN_KEYS_PER_THREAD 16384
+
+/*
+  Minimum number of keys of the sort buffer each thread must get before
+  filesort runs the merges of a merge pass with several threads, so that
+  each run is still read from the file in chunks of about 100 keys.
+*/
+#define FILESORT_MIN_MERGE_KEYS_PER_THREAD 1024
+
+/* The maximum of filesort_threads */
+#define FILESORT_MAX_THREADS 256
+
+class Filesort_workers;
+
+/* Threads for the parallel sorts of one filesort(), see parallel_sort() */
+Filesort_workers *new_filesort_workers(uint max_threads);
+void delete_filesort_workers(Filesort_workers *workers);
+
+/*
+  Call func(arg, i) for each i < n, concurrently with the threads of
+  workers; func(arg, 0) is called by the calling thread. Returns the number
+  of threads that were used, or 0 if we ran out of memory and func was not
+  called.
+*/
+uint run_filesort_workers(Filesort_workers *workers, uint n,
+                          void (*func)(void *arg, uint index), void *arg);
+
 /*
   Calculate cost of merge sort
 
@@ -80,6 +112,9 @@ class Filesort_buffer
   /** Sort me... */
   void sort_buffer(const Sort_param *param, uint count);
 
+  /** Sort me using several threads, see filesort_threads */
+  bool parallel_sort(const Sort_param *param, uint count, uint n_threads);
+
   /// Initializes a record pointer.
   uchar *get_record_buffer(uint idx)
   {
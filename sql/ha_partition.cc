@@ -5074,6 +5074,62 @@ int ha_partition::rnd_next(uchar *buf)
 }
 
 
+/*
+  Read all rows of the used partitions with several threads
+
+  SYNOPSIS
+    parallel_scan()
+    n_threads          Maximum number of threads
+    consumer           Receives the rows
+
+  RETURN VALUE
+    >0                 Error code
+    0                  Success
+
+  DESCRIPTION
+    The partitions are read one after the other, each of them by the
+    parallel_scan() of the underlying handler with up to n_threads
+    threads. A partition which can't be read in parallel at the moment
+    is read with rnd_next() by the calling thread, as thread 0, while
+    no other thread is running, so the scan as a whole never returns
+    HA_ERR_WRONG_COMMAND after some rows were passed to the consumer.
+*/
+
+int ha_partition::parallel_scan(uint n_threads,
+                                Parallel_scan_consumer *consumer)
+{
+  uint part_id;
+  int error= 0;
+  DBUG_ENTER("ha_partition::parallel_scan");
+  DBUG_ASSERT(m_scan_value == 1);
+
+  for (part_id= bitmap_get_first_set(&m_part_info->read_partitions);
+       part_id < m_tot_parts;
+       part_id= bitmap_get_next_set(&m_part_info->read_partitions, part_id))
+  {
+    handler *file= m_file[part_id];
+    if ((error= file->parallel_scan(n_threads, consumer)) !=
+        HA_ERR_WRONG_COMMAND)
+    {
+      if (error)
+        break;
+      continue;
+    }
+
+    while ((error= file->ha_rnd_next(table->record[0])) !=
+           HA_ERR_END_OF_FILE)
+    {
+      if (!error)
+        consumer->add_row(0, table->record[0]);
+      else if (error != HA_ERR_RECORD_DELETED)
+        DBUG_RETURN(error);
+    }
+    error= 0;
+  }
+  DBUG_RETURN(error);
+}
+
+
 /*
   Save position of current row
 
@@ -686,6 +686,8 @@ class ha_partition :public handler
   virtual int rnd_init(bool scan);
   virtual int rnd_end();
   virtual int rnd_next(uchar * buf);
+  virtual int parallel_scan(uint n_threads,
+                            Parallel_scan_consumer *consumer);
   virtual int rnd_pos(uchar * buf, uchar * pos);
   virtual int rnd_pos_by_record(uchar *record);
   virtual void position(const uchar * record);
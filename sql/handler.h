@@ -299,6 +299,12 @@ enum enum_alter_inplace_result {
 /* calling cmp_ref() on the engine is expensive */
 #define HA_CMP_REF_IS_EXPENSIVE (1ULL << 54)
 
+/*
+  The engine can read the whole table with several threads,
+  see handler::parallel_scan()
+*/
+#define HA_CAN_PARALLEL_SCAN (1ULL << 55)
+
 /* bits in index_flags(index_number) for what you can do with index */
 #define HA_READ_NEXT            1       /* TODO really use this flag */
 #define HA_READ_PREV            2       /* supports ::index_prev */
@@ -2806,6 +2812,22 @@ class Handler_share
   must be set to 0.
 */
 
+/**
+  Receives the rows of handler::parallel_scan().
+*/
+
+class Parallel_scan_consumer
+{
+public:
+  virtual ~Parallel_scan_consumer() {}
+  /*
+    Called for every row by the thread that read it, concurrently with
+    the other threads. The record is in the format of table->record[0],
+    with the columns of table->read_set, and is only valid during the call.
+  */
+  virtual void add_row(uint thread_no, const uchar *record)= 0;
+};
+
 class handler :public Sql_alloc
 {
 public:
@@ -3535,6 +3557,21 @@ class handler :public Sql_alloc
     return rnd_pos(record, ref);
   }
   virtual int read_first_row(uchar *buf, uint primary_key);
+  /**
+    Read all rows of the table with up to n_threads threads and pass
+    them to consumer->add_row(), in no particular order.
+
+    Only for engines with HA_CAN_PARALLEL_SCAN. Called between
+    ha_rnd_init() and ha_rnd_end() instead of rnd_next(), in a
+    statement that doesn't lock the rows it reads.
+
+    @retval 0                    All rows were read
+    @retval HA_ERR_WRONG_COMMAND The table can't be read in parallel
+                                 now; no rows were passed to consumer
+    @retval other                Error code
+  */
+  virtual int parallel_scan(uint n_threads, Parallel_scan_consumer *consumer)
+  { return HA_ERR_WRONG_COMMAND; }
 public:
 
   /* Same as above, but with statistics */
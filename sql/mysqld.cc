@@ -950,6 +950,7 @@ PSI_mutex_key key_LOCK_prepare_ordered, key_LOCK_commit_ordered,
   key_LOCK_slave_background;
 PSI_mutex_key key_TABLE_SHARE_LOCK_share;
 PSI_mutex_key key_LOCK_ack_receiver;
+PSI_mutex_key key_LOCK_filesort_workers;
 
 PSI_mutex_key key_TABLE_SHARE_LOCK_rotation;
 PSI_cond_key key_TABLE_SHARE_COND_rotation;
@@ -1033,6 +1034,7 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_LOCK_rpl_thread_pool, "LOCK_rpl_thread_pool", 0},
   { &key_LOCK_parallel_entry, "LOCK_parallel_entry", 0},
   { &key_LOCK_ack_receiver, "Ack_receiver::mutex", 0},
+  { &key_LOCK_filesort_workers, "Filesort_workers::mutex", 0},
   { &key_LOCK_binlog, "LOCK_binlog", 0}
 };
 
@@ -1090,6 +1092,7 @@ PSI_cond_key key_COND_rpl_thread_queue, key_COND_rpl_thread,
   key_COND_prepare_ordered, key_COND_slave_background;
 PSI_cond_key key_COND_wait_gtid, key_COND_gtid_ignore_duplicates;
 PSI_cond_key key_COND_ack_receiver;
+PSI_cond_key key_COND_filesort_work, key_COND_filesort_done;
 
 static PSI_cond_info all_server_conds[]=
 {
@@ -1144,6 +1147,8 @@ static PSI_cond_info all_server_conds[]=
   { &key_COND_wait_gtid, "COND_wait_gtid", 0},
   { &key_COND_gtid_ignore_duplicates, "COND_gtid_ignore_duplicates", 0},
   { &key_COND_ack_receiver, "Ack_receiver::cond", 0},
+  { &key_COND_filesort_work, "Filesort_workers::cond_work", 0},
+  { &key_COND_filesort_done, "Filesort_workers::cond_done", 0},
   { &key_COND_binlog_send, "COND_binlog_send", 0},
   { &key_TABLE_SHARE_COND_rotation, "TABLE_SHARE::COND_rotation", 0}
 };
@@ -1153,6 +1158,7 @@ PSI_thread_key key_thread_bootstrap, key_thread_delayed_insert,
   key_thread_one_connection, key_thread_signal_hand,
   key_thread_slave_background, key_rpl_parallel_thread;
 PSI_thread_key key_thread_ack_receiver;
+PSI_thread_key key_thread_filesort;
 
 static PSI_thread_info all_server_threads[]=
 {
@@ -1180,6 +1186,7 @@ static PSI_thread_info all_server_threads[]=
   { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL},
   { &key_thread_slave_background, "slave_background", PSI_FLAG_GLOBAL},
   { &key_thread_ack_receiver, "Ack_receiver", PSI_FLAG_GLOBAL},
+  { &key_thread_filesort, "filesort_worker", 0},
   { &key_rpl_parallel_thread, "rpl_parallel_thread", 0}
 };
 
@@ -1512,6 +1519,7 @@ int deny_severity = LOG_WARNING;
 #endif
 #ifdef HAVE_QUERY_CACHE
 ulong query_cache_min_res_unit= QUERY_CACHE_MIN_RESULT_DATA_SIZE;
+uint query_cache_partitions= 1;
 Query_cache query_cache;
 #endif
 #ifdef HAVE_SMEM
@@ -8404,6 +8412,51 @@ static int show_default_keycache(THD *thd, SHOW_VAR *var, char *buff,
 }
 
 
+#ifdef HAVE_QUERY_CACHE
+static int show_query_cache(THD *thd, SHOW_VAR *var, char *buff,
+                            enum enum_var_type scope)
+{
+  struct st_data {
+    Query_cache_statistics stats;
+    SHOW_VAR var[9];
+  } *data;
+  SHOW_VAR *v;
+
+  data=(st_data *)buff;
+  v= data->var;
+
+  var->type= SHOW_ARRAY;
+  var->value= v;
+
+  /* The totals of all query cache partitions */
+  query_cache.get_statistics(&data->stats);
+
+#define set_one_qcache_var(X,Y)         \
+  v->name= X;                           \
+  v->type= SHOW_LONGLONG;               \
+  v->value= &data->stats.Y;             \
+  v++;
+
+  set_one_qcache_var("free_blocks",      free_memory_blocks);
+  set_one_qcache_var("free_memory",      free_memory);
+  set_one_qcache_var("hits",             hits);
+  set_one_qcache_var("inserts",          inserts);
+  set_one_qcache_var("lowmem_prunes",    lowmem_prunes);
+  set_one_qcache_var("not_cached",       refused);
+  set_one_qcache_var("queries_in_cache", queries_in_cache);
+  set_one_qcache_var("total_blocks",     total_blocks);
+
+  v->name= 0;
+
+  DBUG_ASSERT((char*)(v+1) <= buff + SHOW_VAR_FUNC_BUFF_SIZE);
+
+#undef set_one_qcache_var
+
+  return 0;
+}
+#endif /* HAVE_QUERY_CACHE */
+
+
 static int show_memory_used(THD *thd, SHOW_VAR *var, char *buff,
                             struct system_status_var *status_var,
                             enum enum_var_type scope)
@@ -8465,6 +8518,17 @@ int show_threadpool_idle_threads(THD *thd, SHOW_VAR *var, char *buff,
   *(int *)buff= tp_get_idle_thread_count(); 
   return 0;
 }
+
+static SHOW_VAR threadpool_queue_wait_status[]=
+{
+  {"under_100us", (char*) &tp_stats.queue_wait[0], SHOW_LONGLONG},
+  {"under_1ms",   (char*) &tp_stats.queue_wait[1], SHOW_LONGLONG},
+  {"under_10ms",  (char*) &tp_stats.queue_wait[2], SHOW_LONGLONG},
+  {"under_100ms", (char*) &tp_stats.queue_wait[3], SHOW_LONGLONG},
+  {"under_1s",    (char*) &tp_stats.queue_wait[4], SHOW_LONGLONG},
+  {"over_1s",     (char*) &tp_stats.queue_wait[5], SHOW_LONGLONG},
+  {NullS, NullS, SHOW_LONG}
+};
 #endif
 
 /*
@@ -8593,14 +8657,7 @@ SHOW_VAR status_vars[]= {
   {"Rpl_semi_sync_slave_send_ack", (char*) &rpl_semi_sync_slave_send_ack, SHOW_LONGLONG},
 #endif /* HAVE_REPLICATION */
 #ifdef HAVE_QUERY_CACHE
-  {"Qcache_free_blocks",       (char*) &query_cache.free_memory_blocks, SHOW_LONG_NOFLUSH},
-  {"Qcache_free_memory",       (char*) &query_cache.free_memory, SHOW_LONG_NOFLUSH},
-  {"Qcache_hits",              (char*) &query_cache.hits,       SHOW_LONG},
-  {"Qcache_inserts",           (char*) &query_cache.inserts,    SHOW_LONG},
-  {"Qcache_lowmem_prunes",     (char*) &query_cache.lowmem_prunes, SHOW_LONG},
-  {"Qcache_not_cached",        (char*) &query_cache.refused,    SHOW_LONG},
-  {"Qcache_queries_in_cache",  (char*) &query_cache.queries_in_cache, SHOW_LONG_NOFLUSH},
-  {"Qcache_total_blocks",      (char*) &query_cache.total_blocks, SHOW_LONG_NOFLUSH},
+  {"Qcache",                   (char*) &show_query_cache,       SHOW_FUNC},
 #endif /*HAVE_QUERY_CACHE*/
   {"Queries",                  (char*) &show_queries,            SHOW_SIMPLE_FUNC},
   {"Questions",                (char*) offsetof(STATUS_VAR, questions), SHOW_LONG_STATUS},
@@ -8679,6 +8736,8 @@ SHOW_VAR status_vars[]= {
 #endif
 #ifdef HAVE_POOL_OF_THREADS
   {"Threadpool_idle_threads",  (char *) &show_threadpool_idle_threads, SHOW_SIMPLE_FUNC},
+  {"Threadpool_queue_wait",    (char *) threadpool_queue_wait_status, SHOW_ARRAY},
+  {"Threadpool_steals",        (char *) &tp_stats.steals, SHOW_LONGLONG},
   {"Threadpool_threads",       (char *) &tp_stats.num_worker_threads, SHOW_INT},
 #endif
   {"Threads_cached",           (char*) &cached_thread_count,    SHOW_LONG_NOFLUSH},
@@ -10173,6 +10232,9 @@ void refresh_status(THD *thd)
 
   /* Reset the counters of all key caches (default and named). */
   process_key_caches(reset_key_cache_counters, 0);
+#ifdef HAVE_QUERY_CACHE
+  query_cache.reset_statistics();
+#endif /* HAVE_QUERY_CACHE */
   flush_status_time= time((time_t*) 0);
   mysql_mutex_unlock(&LOCK_status);
 
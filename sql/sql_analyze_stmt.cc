@@ -78,5 +78,14 @@ void Filesort_tracker::print_json_members(Json_writer *writer)
     else
       writer->add_size(sort_buffer_size);
   }
+
+  if (r_parallel_sorts)
+  {
+    writer->add_member("r_sort_threads").add_ll(r_sort_threads);
+    writer->add_member("r_thread_sort_time_ms").
+            add_double(r_thread_sort_time / 1000.0 / r_parallel_sorts);
+    writer->add_member("r_thread_merge_time_ms").
+            add_double(r_thread_merge_time / 1000.0 / r_parallel_sorts);
+  }
 }
 
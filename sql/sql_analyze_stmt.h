@@ -131,12 +131,13 @@ class Table_access_tracker
 public:
   Table_access_tracker() :
     r_scans(0), r_rows(0), /*r_rows_after_table_cond(0),*/
-    r_rows_after_where(0)
+    r_rows_after_where(0), r_scan_threads(0)
   {}
 
   ha_rows r_scans; /* How many scans were ran on this join_tab */
   ha_rows r_rows; /* How many rows we've got after that */
   ha_rows r_rows_after_where; /* Rows after applying attached part of WHERE */
+  uint r_scan_threads; /* Most threads that read rows in a parallel scan */
 
   bool has_scans() { return (r_scans != 0); }
   ha_rows get_loops() { return r_scans; }
@@ -181,7 +182,9 @@ class Filesort_tracker : public Sql_alloc
     time_tracker(do_timing), r_limit(0), r_used_pq(0),
     r_examined_rows(0), r_sorted_rows(0), r_output_rows(0),
     sort_passes(0),
-    sort_buffer_size(0)
+    sort_buffer_size(0),
+    r_parallel_sorts(0), r_sort_threads(0),
+    r_thread_sort_time(0), r_thread_merge_time(0)
   {}
   
   /* Functions that filesort uses to report various things about its execution */
@@ -224,6 +227,15 @@ class Filesort_tracker : public Sql_alloc
       sort_buffer_size= bufsize;
   }
   
+  inline void report_parallel_sort(uint threads, ulonglong sort_usec,
+                                   ulonglong merge_usec)
+  {
+    r_parallel_sorts++;
+    set_if_bigger(r_sort_threads, threads);
+    r_thread_sort_time+= sort_usec;
+    r_thread_merge_time+= merge_usec;
+  }
+
   /* Functions to get the statistics */
   void print_json_members(Json_writer *writer);
   
@@ -282,5 +294,16 @@ class Filesort_tracker : public Sql_alloc
     other          - value
   */
   ulonglong sort_buffer_size;
+
+  /* How many sort buffers were sorted by more than one thread */
+  ulonglong r_parallel_sorts;
+  /* Max number of threads used for one sort buffer */
+  uint r_sort_threads;
+  /*
+    Time spent by all threads sorting runs and merging them,
+    summed over threads, in microseconds
+  */
+  ulonglong r_thread_sort_time;
+  ulonglong r_thread_merge_time;
 };
 
@@ -0,0 +1,463 @@
+/*
+   Copyright (c) 2018 MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "mariadb.h"
+#include "sql_select.h"
+#include "sql_batch_where.h"
+
+/* Max number of conjuncts that are evaluated in batches */
+#define MAX_BATCH_PREDICATES 16
+
+
+/**
+  Check if a table scan can read rows ahead and evaluate its condition
+  in batches.
+
+  The rows of a batch are processed after the handler has moved on, so
+  nothing but record[0] may be needed to process a row: no row locks,
+  no rowids, no blobs (they point into handler memory), no virtual
+  columns and no fulltext functions. The scan also has to be the
+  outermost loop of a SELECT, without outer or semi-join processing
+  attached to it, and at least two rows have to fit in a batch.
+
+  EXPLAIN shows "Using batched where" from this, so it has to make the
+  same decision as create(thd, tab).
+*/
+
+bool Batch_where::is_applicable(JOIN_TAB *tab)
+{
+  JOIN *join= tab->join;
+  THD *thd= join->thd;
+  TABLE *table= tab->table;
+  thr_lock_type lock_type= table->reginfo.lock_type;
+
+  if (thd->variables.where_batch_size < 2 ||
+      thd->lex->sql_command != SQLCOM_SELECT ||
+      thd->variables.tx_isolation == ISO_SERIALIZABLE)
+    return false;
+
+  if (tab != join->join_tab + join->const_tables ||
+      tab->type != JT_ALL || tab->use_quick ||
+      (tab->select && tab->select->quick) ||
+      !tab->select_cond || tab->bush_children ||
+      tab->last_inner || tab->first_inner ||
+      tab->loosescan_match_tab || tab->keep_current_rowid ||
+      tab->flush_weedout_table || tab->check_weed_out_table ||
+      tab->do_firstmatch)
+    return false;
+
+  if ((lock_type != TL_READ && lock_type != TL_READ_HIGH_PRIORITY &&
+       lock_type != TL_READ_NO_INSERT) ||
+      table->s->blob_fields || table->vfield ||
+      join->select_lex->ftfunc_list->elements)
+    return false;
+
+  bool complete;
+  return collect_predicates(tab->select_cond, table, NULL,
+                            MAX_BATCH_PREDICATES, &complete) > 0 &&
+         rows_per_batch(tab) >= 2;
+}
+
+
+/* Number of rows in a batch of a table scan */
+
+uint Batch_where::rows_per_batch(JOIN_TAB *tab)
+{
+  THD *thd= tab->join->thd;
+
+  /* Don't let the copies of the rows use more than a join buffer */
+  return (uint) MY_MIN(thd->variables.where_batch_size,
+                       thd->variables.join_buff_size /
+                       tab->table->s->reclength);
+}
+
+
+/**
+  Check if the values of a column can be extracted into a batch: they
+  have to fit in a longlong.
+*/
+
+bool Batch_where::is_supported_field(Field *field)
+{
+  switch (field->type()) {
+  case MYSQL_TYPE_TINY:
+  case MYSQL_TYPE_SHORT:
+  case MYSQL_TYPE_INT24:
+  case MYSQL_TYPE_LONG:
+    return true;
+  case MYSQL_TYPE_LONGLONG:
+    return !(field->flags & UNSIGNED_FLAG);
+  default:
+    return false;
+  }
+}
+
+
+/**
+  Check if a conjunct is a comparison of an integer column of 'table'
+  with a constant, and describe it in 'pred' if it is not NULL.
+*/
+
+bool Batch_where::get_predicate(Item *item, TABLE *table, Predicate *pred)
+{
+  static const cmp_op swapped[]=
+  { CMP_EQ, CMP_NE, CMP_GT, CMP_GE, CMP_LT, CMP_LE };
+  cmp_op op;
+
+  if (item->type() != Item::FUNC_ITEM)
+    return false;
+  Item_func *func= (Item_func *) item;
+  switch (func->functype()) {
+  case Item_func::EQ_FUNC: op= CMP_EQ; break;
+  case Item_func::NE_FUNC: op= CMP_NE; break;
+  case Item_func::LT_FUNC: op= CMP_LT; break;
+  case Item_func::LE_FUNC: op= CMP_LE; break;
+  case Item_func::GT_FUNC: op= CMP_GT; break;
+  case Item_func::GE_FUNC: op= CMP_GE; break;
+  default:
+    return false;
+  }
+  if (func->argument_count() != 2)
+    return false;
+
+  Item *col= func->arguments()[0]->real_item();
+  Item *val= func->arguments()[1];
+  if (col->type() != Item::FIELD_ITEM)
+  {
+    col= func->arguments()[1]->real_item();
+    val= func->arguments()[0];
+    op= swapped[op];
+  }
+  if (col->type() != Item::FIELD_ITEM ||
+      !val->const_item() || val->is_expensive() ||
+      col->cmp_type() != INT_RESULT || val->cmp_type() != INT_RESULT)
+    return false;
+
+  Field *field= ((Item_field *) col)->field;
+  if (field->table != table || !is_supported_field(field))
+    return false;
+
+  if (pred)
+  {
+    pred->field= field;
+    pred->op= op;
+    pred->const_item= val;
+  }
+  return true;
+}
+
+
+/**
+  Collect the conjuncts of 'cond' that can be evaluated in batches.
+
+  @param preds     Where to store them, or NULL to only count them
+  @param complete  Set to true if they are the whole condition
+  @param rest      If not NULL, the other conjuncts are added to it
+
+  @return Number of conjuncts found, at most max_preds
+*/
+
+uint Batch_where::collect_predicates(Item *cond, TABLE *table,
+                                     Predicate *preds, uint max_preds,
+                                     bool *complete, List<Item> *rest)
+{
+  uint count= 0;
+
+  *complete= true;
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond *) cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    List_iterator<Item> li(*((Item_cond *) cond)->argument_list());
+    Item *item;
+    while ((item= li++))
+    {
+      if (count < max_preds &&
+          get_predicate(item, table, preds ? preds + count : NULL))
+        count++;
+      else
+      {
+        *complete= false;
+        if (rest && rest->push_back(item, table->in_use->mem_root))
+          return 0;
+      }
+    }
+  }
+  else if (get_predicate(cond, table, preds))
+    count= 1;
+  else
+    *complete= false;
+  return count;
+}
+
+
+/**
+  Check if all of 'cond' can be evaluated in batches.
+*/
+
+bool Batch_where::covers(Item *cond, TABLE *table)
+{
+  bool complete;
+  if (!cond)
+    return true;
+  collect_predicates(cond, table, NULL, MAX_BATCH_PREDICATES, &complete);
+  return complete;
+}
+
+
+Batch_where *Batch_where::create(THD *thd, JOIN_TAB *tab)
+{
+  DBUG_ASSERT(is_applicable(tab));
+  return create(thd, tab->table, tab->select_cond, rows_per_batch(tab),
+                NULL, 0, true);
+}
+
+
+Batch_where *Batch_where::create(THD *thd, TABLE *table, Item *cond,
+                                 uint batch_size, Field **extra_fields,
+                                 uint n_extra_fields, bool copy_rows)
+{
+  Predicate preds[MAX_BATCH_PREDICATES];
+  List<Item> rest;
+  Field **fields;
+  uint n_preds= 0, n_cols= 0;
+  bool complete= true;
+  Batch_where *batch;
+  DBUG_ENTER("Batch_where::create");
+
+  if (cond)
+    n_preds= collect_predicates(cond, table, preds, MAX_BATCH_PREDICATES,
+                                &complete, &rest);
+  if (!(fields= (Field **) thd->alloc((n_preds + n_extra_fields) *
+                                      sizeof(Field *))))
+    DBUG_RETURN(NULL);
+
+  /* Each column is extracted once, however many conjuncts use it */
+  for (uint i= 0; i < n_preds + n_extra_fields; i++)
+  {
+    Field *field= i < n_preds ? preds[i].field : extra_fields[i - n_preds];
+    uint col;
+    DBUG_ASSERT(is_supported_field(field));
+    for (col= 0; col < n_cols && fields[col] != field; col++)
+    {}
+    if (col == n_cols)
+      fields[n_cols++]= field;
+    if (i < n_preds)
+      preds[i].column= col;
+  }
+
+  if (!(batch= new (thd->mem_root) Batch_where) ||
+      !(batch->selected= (uchar *) thd->alloc(batch_size)) ||
+      !(batch->selection= (uint *) thd->alloc(batch_size * sizeof(uint))) ||
+      !(batch->columns= (Column *) thd->alloc(n_cols * sizeof(Column))) ||
+      !(batch->predicates= (Predicate *) thd->memdup(preds, n_preds *
+                                                     sizeof(Predicate))))
+    DBUG_RETURN(NULL);
+
+  batch->records= NULL;
+  if (copy_rows &&
+      !(batch->records= (uchar *) thd->alloc(batch_size *
+                                             table->s->reclength)))
+    DBUG_RETURN(NULL);
+
+  for (uint col= 0; col < n_cols; col++)
+  {
+    Column *c= batch->columns + col;
+    c->field= fields[col];
+    c->type= fields[col]->type();
+    c->is_unsigned= fields[col]->flags & UNSIGNED_FLAG;
+    c->offset= (uint) (fields[col]->ptr - table->record[0]);
+    c->null_bit= fields[col]->null_ptr ? fields[col]->null_bit : 0;
+    c->null_offset= fields[col]->null_ptr ?
+                    (uint) (fields[col]->null_ptr - table->record[0]) : 0;
+    if (!(c->values= (longlong *) thd->alloc(batch_size * sizeof(longlong))) ||
+        !(c->nulls= (uchar *) thd->calloc(batch_size)))
+      DBUG_RETURN(NULL);
+  }
+
+  batch->table= table;
+  batch->batch_size= batch_size;
+  batch->n_rows= 0;
+  batch->n_columns= n_cols;
+  batch->n_predicates= n_preds;
+  batch->remaining_cond= NULL;
+  if (!complete && !(batch->remaining_cond= make_remaining_cond(thd, cond,
+                                                                &rest)))
+    DBUG_RETURN(NULL);
+  DBUG_RETURN(batch);
+}
+
+
+/**
+  Build the condition made of the conjuncts of 'cond' that are not
+  evaluated in batches, so that the batched ones are not evaluated
+  again for each row that passed them.
+
+  @param rest  The conjuncts that are not batched, see collect_predicates()
+
+  @return The condition, NULL on OOM
+*/
+
+Item *Batch_where::make_remaining_cond(THD *thd, Item *cond,
+                                       List<Item> *rest)
+{
+  if (rest->elements == 0)
+  {
+    /* Nothing could be batched, all of 'cond' remains */
+    return cond;
+  }
+  if (rest->elements == 1)
+    return rest->head();
+
+  Item_cond_and *new_cond= new (thd->mem_root) Item_cond_and(thd, *rest);
+  if (!new_cond)
+    return NULL;
+  /*
+    Call fix_fields to propagate the properties of the conjuncts, which
+    are all fixed, to the new AND.
+  */
+  if (new_cond->fix_fields(thd, 0))
+    return NULL;
+  new_cond->used_tables_cache= cond->used_tables();
+  new_cond->top_level_item();
+  return new_cond;
+}
+
+
+uint Batch_where::column(Field *field) const
+{
+  uint col;
+  for (col= 0; columns[col].field != field; col++)
+    DBUG_ASSERT(col + 1 < n_columns);
+  return col;
+}
+
+
+bool Batch_where::start()
+{
+  always_false= false;
+  n_rows= 0;
+  for (uint i= 0; i < n_predicates; i++)
+  {
+    Predicate *pred= predicates + i;
+    pred->value= pred->const_item->val_int();
+    pred->eval_op= pred->op;
+    if (pred->const_item->null_value)
+      always_false= true;
+    else if (pred->const_item->unsigned_flag && pred->value < 0)
+    {
+      /*
+        An unsigned constant above LONGLONG_MAX: all values of a column
+        we batch are smaller.
+      */
+      if (pred->op == CMP_GT || pred->op == CMP_GE || pred->op == CMP_EQ)
+        always_false= true;
+      pred->value= LONGLONG_MAX;
+      pred->eval_op= CMP_LE;                    /* <, <= and != are true */
+    }
+  }
+  return table->in_use->is_error();
+}
+
+
+inline longlong Batch_where::read_column(const Column *col,
+                                         const uchar *record) const
+{
+  const uchar *ptr= record + col->offset;
+  bool is_unsigned= col->is_unsigned;
+  switch (col->type) {
+  case MYSQL_TYPE_TINY:
+    return is_unsigned ? (longlong) *ptr : (longlong) (signed char) *ptr;
+  case MYSQL_TYPE_SHORT:
+    return is_unsigned ? (longlong) uint2korr(ptr) : (longlong) sint2korr(ptr);
+  case MYSQL_TYPE_INT24:
+    return is_unsigned ? (longlong) uint3korr(ptr) : (longlong) sint3korr(ptr);
+  case MYSQL_TYPE_LONG:
+    return is_unsigned ? (longlong) uint4korr(ptr) : (longlong) sint4korr(ptr);
+  default:
+    return sint8korr(ptr);
+  }
+}
+
+
+bool Batch_where::add_row(const uchar *record)
+{
+  if (records)
+  {
+    uchar *copy= records + n_rows * table->s->reclength;
+    memcpy(copy, record, table->s->reclength);
+  }
+  for (uint i= 0; i < n_columns; i++)
+  {
+    Column *col= columns + i;
+    col->nulls[n_rows]= col->null_bit && (record[col->null_offset] &
+                                          col->null_bit);
+    col->values[n_rows]= read_column(col, record);
+  }
+  return ++n_rows == batch_size;
+}
+
+
+/*
+  The loops below have no branches and no calls, so that the compiler
+  can vectorize them.
+*/
+#define BATCH_COMPARE(OP)                                               \
+  for (uint i= 0; i < n; i++)                                           \
+    sel[i]&= (uchar) ((values[i] OP value) & !nulls[i]);
+
+uint Batch_where::filter()
+{
+  uint n= n_rows;
+  uchar *sel= selected;
+
+  n_selected= 0;
+  if (always_false)
+    return 0;
+
+  memset(sel, 1, n);
+  for (uint p= 0; p < n_predicates; p++)
+  {
+    const Predicate *pred= predicates + p;
+    const longlong *values= columns[pred->column].values;
+    const uchar *nulls= columns[pred->column].nulls;
+    const longlong value= pred->value;
+    switch (pred->eval_op) {
+    case CMP_EQ: BATCH_COMPARE(==); break;
+    case CMP_NE: BATCH_COMPARE(!=); break;
+    case CMP_LT: BATCH_COMPARE(<);  break;
+    case CMP_LE: BATCH_COMPARE(<=); break;
+    case CMP_GT: BATCH_COMPARE(>);  break;
+    case CMP_GE: BATCH_COMPARE(>=); break;
+    }
+  }
+
+  for (uint i= 0; i < n; i++)
+  {
+    selection[n_selected]= i;
+    n_selected+= sel[i];
+  }
+  return n_selected;
+}
+
+
+void Batch_where::restore_selected_row(uint n)
+{
+  DBUG_ASSERT(n < n_selected);
+  DBUG_ASSERT(records);
+  memcpy(table->record[0],
+         records + selection[n] * table->s->reclength,
+         table->s->reclength);
+}
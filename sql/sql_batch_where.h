@@ -0,0 +1,147 @@
+#ifndef SQL_BATCH_WHERE_INCLUDED
+#define SQL_BATCH_WHERE_INCLUDED
+/*
+   Copyright (c) 2018 MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  Batched evaluation of the WHERE condition of a full table scan.
+
+  A table scan normally evaluates the condition attached to its JOIN_TAB
+  once per row, walking the Item tree with a virtual call per node.
+  When @@where_batch_size is set, the scan instead reads up to that many
+  rows ahead into a buffer, extracting the integer columns used by the
+  simple conjuncts of the condition into columnar arrays. These conjuncts
+  (comparisons of an integer column with a constant) are then evaluated
+  for the whole batch with tight loops over the arrays, producing a
+  selection vector. Only the rows that pass are copied back to
+  record[0] and go through the normal per-row path, which evaluates the
+  rest of the condition, if any.
+
+  Reading ahead is only safe when nothing but the record buffer is used
+  to process a row, see Batch_where::is_applicable().
+
+  A Batch_where can also be filled with rows that don't come from
+  record[0], and without keeping copies of them, when only its columns
+  are needed; Parallel_aggregate does that for each of its threads.
+*/
+
+class Batch_where: public Sql_alloc
+{
+public:
+  static bool is_applicable(JOIN_TAB *tab);
+  static Batch_where *create(THD *thd, JOIN_TAB *tab);
+
+  /*
+    @param cond          Condition to evaluate, NULL to select all rows
+    @param extra_fields  Columns to extract in addition to the ones used
+                         by the batched conjuncts, see column_values()
+    @param copy_rows     Keep copies of the rows for restore_selected_row()
+  */
+  static Batch_where *create(THD *thd, TABLE *table, Item *cond,
+                             uint batch_size, Field **extra_fields,
+                             uint n_extra_fields, bool copy_rows);
+
+  /* Whether a column can be extracted into a batch */
+  static bool is_supported_field(Field *field);
+
+  /* Whether all of 'cond' can be evaluated in batches */
+  static bool covers(Item *cond, TABLE *table);
+
+  /* Prepare for a new scan: evaluate the constants, empty the batch */
+  bool start();
+
+  /* Add the row in record[0] to the batch, return true if it is full */
+  bool add_row() { return add_row(table->record[0]); }
+
+  /* Add a row in the format of record[0], return true if it is full */
+  bool add_row(const uchar *record);
+
+  /*
+    Evaluate the batched conjuncts for all rows in the batch.
+    @return number of rows that passed, see restore_selected_row()
+  */
+  uint filter();
+
+  /* Copy the n-th row that passed filter() to record[0] */
+  void restore_selected_row(uint n);
+
+  uint rows() const { return n_rows; }
+  void clear() { n_rows= 0; }
+
+  /* The rows that passed filter(), as positions in the batch */
+  const uint *selected_rows() const { return selection; }
+
+  /* Number of the column of 'field', which has to be in the batch */
+  uint column(Field *field) const;
+  /* Values of a column for the rows of the batch, and which are NULL */
+  const longlong *column_values(uint col) const { return columns[col].values; }
+  const uchar *column_nulls(uint col) const { return columns[col].nulls; }
+
+  /*
+    The condition which still has to be evaluated per row for the rows
+    that passed filter(): NULL if the batched conjuncts are the whole
+    condition, otherwise the AND of the conjuncts that are not batched
+  */
+  Item *remaining_cond;
+
+private:
+  enum cmp_op { CMP_EQ, CMP_NE, CMP_LT, CMP_LE, CMP_GT, CMP_GE };
+
+  struct Column
+  {
+    enum_field_types type;
+    bool is_unsigned;
+    Field *field;
+    uint offset;                 /* Of the value in the record */
+    uint null_offset;
+    uchar null_bit;              /* 0 if the column is not nullable */
+    longlong *values;
+    uchar *nulls;
+  };
+
+  struct Predicate
+  {
+    Field *field;
+    uint column;
+    cmp_op op;
+    Item *const_item;
+    longlong value;              /* const_item, evaluated by start() */
+    cmp_op eval_op;              /* op adjusted to value by start() */
+  };
+
+  static uint collect_predicates(Item *cond, TABLE *table,
+                                 Predicate *preds, uint max_preds,
+                                 bool *complete, List<Item> *rest= NULL);
+  static Item *make_remaining_cond(THD *thd, Item *cond, List<Item> *rest);
+  static bool get_predicate(Item *item, TABLE *table, Predicate *pred);
+  static uint rows_per_batch(JOIN_TAB *tab);
+  longlong read_column(const Column *col, const uchar *record) const;
+
+  TABLE *table;
+  uint batch_size;
+  uint n_rows;
+  uint n_selected;
+  uchar *records;                /* NULL if the rows are not copied */
+  uchar *selected;               /* Per row: 1 if it passed so far */
+  uint *selection;               /* Indexes of the rows that passed */
+  Column *columns;
+  uint n_columns;
+  Predicate *predicates;
+  uint n_predicates;
+  bool always_false;             /* A constant was NULL */
+};
+
+#endif /* SQL_BATCH_WHERE_INCLUDED */
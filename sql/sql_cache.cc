@@ -285,7 +285,9 @@ The query cache interfaces with the rest of the server code through 7
  3. query_cache_insert
        - Called from net_real_write to append a result set to a cached query
          if (and only if) this query has a registered result set writer
-         (thd->net.query_cache_query).
+         (thd->net.query_cache_query). Small packets are collected in
+         the result buffer of the writer (Query_cache_tls) and are stored
+         in the cache together.
  4. Query_cache::invalidate
     Query_cache::invalidate_locked_for_write
        - Called from various places to invalidate query cache based on data-
@@ -641,11 +643,13 @@ bool Query_cache::try_lock(THD *thd, Cache_try_lock_mode mode)
       */
       if (mode == WAIT)
       {
+        lock_waits++;
         mysql_cond_wait(&COND_cache_status_changed, &structure_guard_mutex);
       }
       else if (mode == TIMEOUT)
       {
         struct timespec waittime;
+        lock_waits++;
         set_timespec_nsec(waittime,50000000UL);  /* Wait for 50 msec */
         int res= mysql_cond_timedwait(&COND_cache_status_changed,
                                       &structure_guard_mutex, &waittime);
@@ -693,7 +697,10 @@ void Query_cache::lock_and_suspend(void)
   mysql_mutex_lock(&structure_guard_mutex);
   m_requests_in_progress++;
   while (m_cache_lock_status != Query_cache::UNLOCKED)
+  {
+    lock_waits++;
     mysql_cond_wait(&COND_cache_status_changed, &structure_guard_mutex);
+  }
   m_cache_lock_status= Query_cache::LOCKED_NO_WAIT;
 #ifndef DBUG_OFF
   /* Here thd may not be set during shutdown */
@@ -724,7 +731,10 @@ void Query_cache::lock(THD *thd)
   m_requests_in_progress++;
   fix_local_query_cache_mode(thd);
   while (m_cache_lock_status != Query_cache::UNLOCKED)
+  {
+    lock_waits++;
     mysql_cond_wait(&COND_cache_status_changed, &structure_guard_mutex);
+  }
   m_cache_lock_status= Query_cache::LOCKED;
 #ifndef DBUG_OFF
   m_cache_lock_thread_id= thd->thread_id;
@@ -1060,6 +1070,12 @@ void query_cache_insert(void *thd_arg, const char *packet, size_t length,
 
 /**
   Insert the packet into the query cache.
+
+  Packets smaller than QUERY_CACHE_MIN_RESULT_DATA_SIZE are collected
+  in the result buffer of the writer and are stored together, so that
+  the structure lock is not taken for each of them. Larger packets are
+  stored directly, after the packets collected before them, so the bulk
+  of a large result is copied only once.
 */
 
 void
@@ -1073,6 +1089,68 @@ Query_cache::insert(THD *thd, Query_cache_tls *query_cache_tls,
   if (is_disabled() || query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
 
+  if (query_cache_tls->partition != this)
+  {
+    query_cache_tls->partition->insert(thd, query_cache_tls, packet, length,
+                                       pkt_nr);
+    DBUG_VOID_RETURN;
+  }
+
+  if (length >= QUERY_CACHE_MIN_RESULT_DATA_SIZE ||
+      query_cache_tls->result_length + length > QUERY_CACHE_RESULT_BUFFER)
+  {
+    store_result_buffer(thd, query_cache_tls);
+    if (query_cache_tls->first_query_block == NULL)
+      DBUG_VOID_RETURN;
+  }
+
+  if (length < QUERY_CACHE_MIN_RESULT_DATA_SIZE &&
+      (query_cache_tls->result_buffer ||
+       (query_cache_tls->result_buffer=
+        (uchar*) my_malloc(QUERY_CACHE_RESULT_BUFFER, MYF(0)))))
+  {
+    DBUG_PRINT("qcache", ("buffer packet %zu bytes long", length));
+    memcpy(query_cache_tls->result_buffer + query_cache_tls->result_length,
+           packet, length);
+    query_cache_tls->result_length+= length;
+    query_cache_tls->last_pkt_nr= pkt_nr;
+  }
+  else
+    store_result_data(thd, query_cache_tls, packet, length, pkt_nr);
+
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+  Store the packets collected in the result buffer of the writer.
+*/
+
+void
+Query_cache::store_result_buffer(THD *thd, Query_cache_tls *query_cache_tls)
+{
+  if (query_cache_tls->result_length)
+  {
+    store_result_data(thd, query_cache_tls,
+                      (char*) query_cache_tls->result_buffer,
+                      query_cache_tls->result_length,
+                      query_cache_tls->last_pkt_nr);
+    query_cache_tls->result_length= 0;
+  }
+}
+
+
+/**
+  Append the result data of the writer to its query.
+*/
+
+void
+Query_cache::store_result_data(THD *thd, Query_cache_tls *query_cache_tls,
+                               const char *packet, size_t length,
+                               unsigned pkt_nr)
+{
+  DBUG_ENTER("Query_cache::store_result_data");
+
   QC_DEBUG_SYNC("wait_in_query_cache_insert");
 
   /*
@@ -1111,8 +1189,8 @@ Query_cache::insert(THD *thd, Query_cache_tls *query_cache_tls,
     header->result(result);
     DBUG_PRINT("qcache", ("free query %p", query_block));
     // The following call will remove the lock on query_block
-    query_cache.free_query(query_block);
-    query_cache.refused++;
+    free_query(query_block);
+    refused++;
     // append_result_data no success => we need unlock
     unlock();
     DBUG_VOID_RETURN;
@@ -1136,6 +1214,14 @@ Query_cache::abort(THD *thd, Query_cache_tls *query_cache_tls)
   if (is_disabled() || query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
 
+  if (query_cache_tls->partition != this)
+  {
+    query_cache_tls->partition->abort(thd, query_cache_tls);
+    DBUG_VOID_RETURN;
+  }
+
+  query_cache_tls->result_length= 0;
+
   if (try_lock(thd, Query_cache::WAIT))
     DBUG_VOID_RETURN;
 
@@ -1170,7 +1256,17 @@ void Query_cache::end_of_result(THD *thd)
 
   /* See the comment on double-check locking usage above. */
   if (query_cache_tls->first_query_block == NULL)
+  {
+    /* The query may have been invalidated while its result was collected */
+    query_cache_tls->result_length= 0;
+    DBUG_VOID_RETURN;
+  }
+
+  if (query_cache_tls->partition != this)
+  {
+    query_cache_tls->partition->end_of_result(thd);
     DBUG_VOID_RETURN;
+  }
 
   /* Ensure that only complete results are cached. */
   DBUG_ASSERT(thd->get_stmt_da()->is_eof());
@@ -1182,8 +1278,10 @@ void Query_cache::end_of_result(THD *thd)
   }
 
 #ifdef EMBEDDED_LIBRARY
-  insert(thd, query_cache_tls, (char*)thd,
-                     emb_count_querycache_size(thd), 0);
+  store_result_data(thd, query_cache_tls, (char*)thd,
+                    emb_count_querycache_size(thd), 0);
+#else
+  store_result_buffer(thd, query_cache_tls);
 #endif
 
   if (try_lock(thd, Query_cache::WAIT))
@@ -1221,9 +1319,9 @@ void Query_cache::end_of_result(THD *thd)
     }
     last_result_block= header->result()->prev;
     allign_size= ALIGN_SIZE(last_result_block->used);
-    len= MY_MAX(query_cache.min_allocation_unit, allign_size);
-    if (last_result_block->length >= query_cache.min_allocation_unit + len)
-      query_cache.split_block(last_result_block,len);
+    len= MY_MAX(min_allocation_unit, allign_size);
+    if (last_result_block->length >= min_allocation_unit + len)
+      split_block(last_result_block,len);
 
     header->found_rows(limit_found_rows);
     header->set_results_ready(); // signal for plugin
@@ -1271,13 +1369,13 @@ Query_cache::Query_cache(size_t query_cache_limit_arg,
   :query_cache_size(0),
    query_cache_limit(query_cache_limit_arg),
    queries_in_cache(0), hits(0), inserts(0), refused(0),
-   total_blocks(0), lowmem_prunes(0),
+   total_blocks(0), lowmem_prunes(0), lock_waits(0),
    m_cache_status(OK),
    min_allocation_unit(ALIGN_SIZE(min_allocation_unit_arg)),
    min_result_data_size(ALIGN_SIZE(min_result_data_size_arg)),
    def_query_hash_size(ALIGN_SIZE(def_query_hash_size_arg)),
    def_table_hash_size(ALIGN_SIZE(def_table_hash_size_arg)),
-   initialized(0)
+   initialized(0), partitions(0), n_partitions(0)
 {
   size_t min_needed= (ALIGN_SIZE(sizeof(Query_cache_block)) +
 		     ALIGN_SIZE(sizeof(Query_cache_block_table)) +
@@ -1296,6 +1394,22 @@ size_t Query_cache::resize(size_t query_cache_size_arg)
 			query_cache_size_arg));
   DBUG_ASSERT(initialized);
 
+  if (n_partitions)
+  {
+    /* The first partition also gets the remainder of the division */
+    size_t partition_size= query_cache_size_arg / n_partitions;
+    new_query_cache_size= partitions[0].resize(partition_size +
+                                               query_cache_size_arg %
+                                               n_partitions);
+    for (uint i= 1; i < n_partitions; i++)
+      new_query_cache_size+= partitions[i].resize(partition_size);
+    query_cache_size= new_query_cache_size;
+    m_cache_status= (new_query_cache_size &&
+                     global_system_variables.query_cache_type != 0) ?
+                    OK : DISABLED;
+    DBUG_RETURN(new_query_cache_size);
+  }
+
   lock_and_suspend();
 
   /*
@@ -1351,6 +1465,8 @@ size_t Query_cache::set_min_res_unit(size_t size)
   DBUG_ASSERT(size % 8 == 0);
   if (size < min_allocation_unit)
     size= ALIGN_SIZE(min_allocation_unit);
+  for (uint i= 0; i < n_partitions; i++)
+    partitions[i].set_min_res_unit(size);
   return (min_result_data_size= size);
 }
 
@@ -1467,33 +1583,6 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
                           (int)flags.in_trans,
                           (int)flags.autocommit));
 
-    /*
-      A table- or a full flush operation can potentially take a long time to
-      finish. We choose not to wait for them and skip caching statements
-      instead.
-
-      In case the wait time can't be determined there is an upper limit which
-      causes try_lock() to abort with a time out.
-
-      The 'TIMEOUT' parameter indicate that the lock is allowed to timeout
-
-    */
-    if (try_lock(thd, Query_cache::TIMEOUT))
-      DBUG_VOID_RETURN;
-    if (query_cache_size == 0)
-    {
-      unlock();
-      DBUG_VOID_RETURN;
-    }
-    DUMP(this);
-
-    if (ask_handler_allowance(thd, tables_used))
-    {
-      refused++;
-      unlock();
-      DBUG_VOID_RETURN;
-    }
-
     query=        thd->base_query.ptr();
     query_length= thd->base_query.length();
 
@@ -1518,73 +1607,129 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
     memcpy((void*) (query + (tot_length - QUERY_CACHE_FLAGS_SIZE)),
 	   &flags, QUERY_CACHE_FLAGS_SIZE);
 
-    /* Check if another thread is processing the same query? */
-    Query_cache_block *competitor = (Query_cache_block *)
-      my_hash_search(&queries, (uchar*) query, tot_length);
-    DBUG_PRINT("qcache", ("competitor %p", competitor));
-    if (competitor == 0)
-    {
-      /* Query is not in cache and no one is working with it; Store it */
-      Query_cache_block *query_block;
-      query_block= write_block_data(tot_length, (uchar*) query,
-				    ALIGN_SIZE(sizeof(Query_cache_query)),
-				    Query_cache_block::QUERY, local_tables);
-      if (query_block != 0)
-      {
-	DBUG_PRINT("qcache", ("query block %p allocated, %zu",
-			    query_block, query_block->used));
+    partition_for_key(query, tot_length)->
+      store_query_block(thd, tables_used, query, tot_length,
+                        local_tables, tables_type);
+  }
+  else
+    statistic_increment(refused, &structure_guard_mutex);
 
-	Query_cache_query *header = query_block->query();
-	header->init_n_lock();
-	if (my_hash_insert(&queries, (uchar*) query_block))
-	{
-	  refused++;
-	  DBUG_PRINT("qcache", ("insertion in query hash"));
-	  header->unlock_n_destroy();
-	  free_memory_block(query_block);
-          unlock();
-	  goto end;
-	}
-	if (!register_all_tables(thd, query_block, tables_used, local_tables))
-	{
-	  refused++;
-	  DBUG_PRINT("warning", ("tables list including failed"));
-	  my_hash_delete(&queries, (uchar *) query_block);
-	  header->unlock_n_destroy();
-	  free_memory_block(query_block);
-          unlock();
-	  goto end;
-	}
-	double_linked_list_simple_include(query_block, &queries_blocks);
-	inserts++;
-	queries_in_cache++;
-	thd->query_cache_tls.first_query_block= query_block;
-	header->writer(&thd->query_cache_tls);
-	header->tables_type(tables_type);
+  DBUG_VOID_RETURN;
+}
 
-        unlock();
 
-	// init_n_lock make query block locked
-	BLOCK_UNLOCK_WR(query_block);
+/**
+  Register the query in this cache (or partition of the cache) and make
+  the current thread the writer of its result.
+
+  @param thd           thread handle
+  @param tables_used   tables used by the query
+  @param query         query cache key: query + database + flags
+  @param tot_length    length of the key
+  @param local_tables  number of tables used by the query
+  @param tables_type   types of the used tables
+*/
+
+void Query_cache::store_query_block(THD *thd, TABLE_LIST *tables_used,
+                                    const char *query, size_t tot_length,
+                                    TABLE_COUNTER_TYPE local_tables,
+                                    uint8 tables_type)
+{
+  DBUG_ENTER("Query_cache::store_query_block");
+
+  /*
+    A table- or a full flush operation can potentially take a long time to
+    finish. We choose not to wait for them and skip caching statements
+    instead.
+
+    In case the wait time can't be determined there is an upper limit which
+    causes try_lock() to abort with a time out.
+
+    The 'TIMEOUT' parameter indicate that the lock is allowed to timeout
+
+  */
+  if (try_lock(thd, Query_cache::TIMEOUT))
+    DBUG_VOID_RETURN;
+  if (query_cache_size == 0)
+  {
+    unlock();
+    DBUG_VOID_RETURN;
+  }
+  DUMP(this);
+
+  if (ask_handler_allowance(thd, tables_used))
+  {
+    refused++;
+    unlock();
+    DBUG_VOID_RETURN;
+  }
+
+  /* Check if another thread is processing the same query? */
+  Query_cache_block *competitor = (Query_cache_block *)
+    my_hash_search(&queries, (uchar*) query, tot_length);
+  DBUG_PRINT("qcache", ("competitor %p", competitor));
+  if (competitor == 0)
+  {
+    /* Query is not in cache and no one is working with it; Store it */
+    Query_cache_block *query_block;
+    query_block= write_block_data(tot_length, (uchar*) query,
+                                  ALIGN_SIZE(sizeof(Query_cache_query)),
+                                  Query_cache_block::QUERY, local_tables);
+    if (query_block != 0)
+    {
+      DBUG_PRINT("qcache", ("query block %p allocated, %zu",
+                            query_block, query_block->used));
+
+      Query_cache_query *header = query_block->query();
+      header->init_n_lock();
+      if (my_hash_insert(&queries, (uchar*) query_block))
+      {
+        refused++;
+        DBUG_PRINT("qcache", ("insertion in query hash"));
+        header->unlock_n_destroy();
+        free_memory_block(query_block);
+        unlock();
+        goto end;
       }
-      else
+      if (!register_all_tables(thd, query_block, tables_used, local_tables))
       {
-	// We have not enough memory to store query => do nothing
-	refused++;
+        refused++;
+        DBUG_PRINT("warning", ("tables list including failed"));
+        my_hash_delete(&queries, (uchar *) query_block);
+        header->unlock_n_destroy();
+        free_memory_block(query_block);
         unlock();
-	DBUG_PRINT("warning", ("Can't allocate query"));
+        goto end;
       }
+      double_linked_list_simple_include(query_block, &queries_blocks);
+      inserts++;
+      queries_in_cache++;
+      thd->query_cache_tls.first_query_block= query_block;
+      thd->query_cache_tls.partition= this;
+      thd->query_cache_tls.result_length= 0;
+      header->writer(&thd->query_cache_tls);
+      header->tables_type(tables_type);
+
+      unlock();
+
+      // init_n_lock make query block locked
+      BLOCK_UNLOCK_WR(query_block);
     }
     else
     {
-      // Another thread is processing the same query => do nothing
+      // We have not enough memory to store query => do nothing
       refused++;
       unlock();
-      DBUG_PRINT("qcache", ("Another thread process same query"));
+      DBUG_PRINT("warning", ("Can't allocate query"));
     }
   }
   else
-    statistic_increment(refused, &structure_guard_mutex);
+  {
+    // Another thread is processing the same query => do nothing
+    refused++;
+    unlock();
+    DBUG_PRINT("qcache", ("Another thread process same query"));
+  }
 
 end:
   DBUG_VOID_RETURN;
@@ -1699,13 +1844,6 @@ size_t build_normalized_name(char *buff, size_t bufflen,
 int
 Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
 {
-  ulonglong engine_data;
-  Query_cache_query *query;
-#ifndef EMBEDDED_LIBRARY
-  Query_cache_block *first_result_block;
-#endif
-  Query_cache_block *result_block;
-  Query_cache_block_table *block_table, *block_table_end;
   size_t tot_length;
   Query_cache_query_flags flags;
   const char *sql, *sql_end, *found_brace= 0;
@@ -1864,23 +2002,6 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
       goto err;
     }
   }
-  /*
-    Try to obtain an exclusive lock on the query cache. If the cache is
-    disabled or if a full cache flush is in progress, the attempt to
-    get the lock is aborted.
-
-    The TIMEOUT parameter indicate that the lock is allowed to timeout.
-  */
-  if (try_lock(thd, Query_cache::TIMEOUT))
-    goto err;
-
-  if (query_cache_size == 0)
-  {
-    thd->query_cache_is_applicable= 0;            // Query can't be cached
-    goto err_unlock;
-  }
-
-  Query_cache_block *query_block;
   if (thd->variables.query_cache_strip_comments)
   {
     if (found_brace)
@@ -1967,6 +2088,56 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
   memcpy((uchar *)(sql + (tot_length - QUERY_CACHE_FLAGS_SIZE)),
 	 (uchar*) &flags, QUERY_CACHE_FLAGS_SIZE);
 
+  DBUG_RETURN(partition_for_key(sql, tot_length)->
+              send_result_from_block(thd, sql, tot_length));
+
+err:
+  thd->query_cache_is_applicable= 0;            // Query can't be cached
+  DBUG_RETURN(0);				// Query was not cached
+}
+
+
+/**
+  Look up the query in this cache (or partition of the cache) and send
+  the cached result to the client.
+
+  @param thd         thread handle
+  @param sql         query cache key: query + database + flags
+  @param tot_length  length of the key
+
+  @return status code, see send_result_to_client()
+*/
+
+int
+Query_cache::send_result_from_block(THD *thd, const char *sql,
+                                    size_t tot_length)
+{
+  ulonglong engine_data;
+  Query_cache_query *query;
+#ifndef EMBEDDED_LIBRARY
+  Query_cache_block *first_result_block;
+#endif
+  Query_cache_block *result_block;
+  Query_cache_block_table *block_table, *block_table_end;
+  Query_cache_block *query_block;
+  DBUG_ENTER("Query_cache::send_result_from_block");
+
+  /*
+    Try to obtain an exclusive lock on the query cache. If the cache is
+    disabled or if a full cache flush is in progress, the attempt to
+    get the lock is aborted.
+
+    The TIMEOUT parameter indicate that the lock is allowed to timeout.
+  */
+  if (try_lock(thd, Query_cache::TIMEOUT))
+    goto err;
+
+  if (query_cache_size == 0)
+  {
+    thd->query_cache_is_applicable= 0;            // Query can't be cached
+    goto err_unlock;
+  }
+
 #ifdef WITH_WSREP
   bool once_more;
   once_more= true;
@@ -2346,6 +2517,13 @@ void Query_cache::invalidate(THD *thd, const char *db)
 
   DBUG_SLOW_ASSERT(ok_for_lower_case_names(db));
 
+  if (n_partitions)
+  {
+    for (uint i= 0; i < n_partitions; i++)
+      partitions[i].invalidate(thd, db);
+    DBUG_VOID_RETURN;
+  }
+
   bool restart= FALSE;
   /*
     Lock the query cache and queue all invalidation attempts to avoid
@@ -2435,6 +2613,13 @@ void Query_cache::flush()
   if (is_disabled())
     DBUG_VOID_RETURN;
 
+  if (n_partitions)
+  {
+    for (uint i= 0; i < n_partitions; i++)
+      partitions[i].flush();
+    DBUG_VOID_RETURN;
+  }
+
   QC_DEBUG_SYNC("wait_in_query_cache_flush1");
 
   lock_and_suspend();
@@ -2445,7 +2630,7 @@ void Query_cache::flush()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   unlock();
   DBUG_VOID_RETURN;
 }
@@ -2468,6 +2653,13 @@ void Query_cache::pack(THD *thd, size_t join_limit, uint iteration_limit)
   if (is_disabled())
     DBUG_VOID_RETURN;
 
+  if (n_partitions)
+  {
+    for (uint i= 0; i < n_partitions; i++)
+      partitions[i].pack(thd, join_limit, iteration_limit);
+    DBUG_VOID_RETURN;
+  }
+
   /*
     If the entire qc is being invalidated we can bail out early
     instead of waiting for the lock.
@@ -2501,6 +2693,18 @@ void Query_cache::destroy()
   }
   else
   {
+    if (n_partitions)
+    {
+      for (uint i= 0; i < n_partitions; i++)
+      {
+        partitions[i].destroy();
+        partitions[i].~Query_cache();
+      }
+      my_free(partitions);
+      partitions= 0;
+      n_partitions= 0;
+    }
+
     /* Underlying code expects the lock. */
     lock_and_suspend();
     free_cache();
@@ -2517,6 +2721,18 @@ void Query_cache::destroy()
 
 void Query_cache::disable_query_cache(THD *thd)
 {
+  if (n_partitions)
+  {
+    /*
+      Stop routing requests to the partitions; each of them frees its
+      memory once its last request in progress is over.
+    */
+    m_cache_status= DISABLED;
+    for (uint i= 0; i < n_partitions; i++)
+      partitions[i].disable_query_cache(thd);
+    return;
+  }
+
   m_cache_status= DISABLE_REQUEST;
   /*
     If there is no requests in progress try to free buffer.
@@ -2576,10 +2792,102 @@ void Query_cache::init()
     free_cache();
     m_cache_status= DISABLED;
   }
+
+  if (query_cache_partitions > 1 && this == &query_cache)
+  {
+    /* Zero filled, as the global query cache object */
+    if (!(partitions= (Query_cache*)
+          my_malloc(query_cache_partitions * sizeof(Query_cache),
+                    MYF(MY_WME | MY_ZEROFILL))))
+    {
+      sql_print_warning("Could not allocate %u query cache partitions; "
+                        "the query cache will not be partitioned",
+                        query_cache_partitions);
+      DBUG_VOID_RETURN;
+    }
+    n_partitions= query_cache_partitions;
+    for (uint i= 0; i < n_partitions; i++)
+    {
+      new (&partitions[i]) Query_cache(query_cache_limit,
+                                       min_allocation_unit,
+                                       min_result_data_size,
+                                       def_query_hash_size,
+                                       def_table_hash_size);
+      partitions[i].init();
+    }
+  }
   DBUG_VOID_RETURN;
 }
 
 
+/**
+  Find the partition of the cache which stores the query with the given
+  key. The partition does not depend on the hash function of the query
+  hash, so that the queries of a partition still spread over its buckets.
+*/
+
+Query_cache *Query_cache::partition_for_key(const char *key,
+                                            size_t key_length)
+{
+  if (!n_partitions)
+    return this;
+  return &partitions[my_checksum(0, (const uchar*) key, key_length) %
+                     n_partitions];
+}
+
+
+bool Query_cache::partition_disable_in_progress()
+{
+  for (uint i= 0; i < n_partitions; i++)
+    if (partitions[i].is_disable_in_progress())
+      return true;
+  return false;
+}
+
+
+/**
+  Sum the statistics of the cache and all its partitions.
+
+  The values are read without locking, as the status variables always were.
+*/
+
+void Query_cache::get_statistics(Query_cache_statistics *stats)
+{
+  stats->free_memory_blocks= free_memory_blocks;
+  stats->free_memory= free_memory;
+  stats->hits= hits;
+  stats->inserts= inserts;
+  stats->lowmem_prunes= lowmem_prunes;
+  stats->refused= refused;
+  stats->queries_in_cache= queries_in_cache;
+  stats->total_blocks= total_blocks;
+  for (uint i= 0; i < n_partitions; i++)
+  {
+    Query_cache *part= &partitions[i];
+    stats->free_memory_blocks+= part->free_memory_blocks;
+    stats->free_memory+= part->free_memory;
+    stats->hits+= part->hits;
+    stats->inserts+= part->inserts;
+    stats->lowmem_prunes+= part->lowmem_prunes;
+    stats->refused+= part->refused;
+    stats->queries_in_cache+= part->queries_in_cache;
+    stats->total_blocks+= part->total_blocks;
+  }
+}
+
+
+/**
+  Reset the counters that FLUSH STATUS resets.
+*/
+
+void Query_cache::reset_statistics()
+{
+  hits= inserts= lowmem_prunes= refused= lock_waits= 0;
+  for (uint i= 0; i < n_partitions; i++)
+    partitions[i].reset_statistics();
+}
+
+
 size_t Query_cache::init_cache()
 {
   size_t mem_bin_count, num, step;
@@ -3271,6 +3579,19 @@ void Query_cache::invalidate_table(THD *thd, TABLE *table)
 
 void Query_cache::invalidate_table(THD *thd, uchar * key, size_t key_length)
 {
+  if (n_partitions)
+  {
+    /*
+      The queries using the table may be in any partition. The partitions
+      are locked one at a time, so lookups in the other partitions can
+      proceed while one of them is being invalidated.
+    */
+    for (uint i= 0; i < n_partitions; i++)
+      if (!partitions[i].is_disabled())
+        partitions[i].invalidate_table(thd, key, key_length);
+    return;
+  }
+
   DEBUG_SYNC(thd, "wait_in_query_cache_invalidate1");
 
   /*
@@ -4204,7 +4525,7 @@ void Query_cache::pack_cache()
 {
   DBUG_ENTER("Query_cache::pack_cache");
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
 
   uchar *border = 0;
   Query_cache_block *before = 0;
@@ -4236,7 +4557,7 @@ void Query_cache::pack_cache()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   DBUG_VOID_RETURN;
 }
 
@@ -4823,6 +5144,13 @@ my_bool Query_cache::check_integrity(bool locked)
   uint i;
   DBUG_ENTER("check_integrity");
 
+  if (n_partitions)
+  {
+    for (i= 0; i < n_partitions; i++)
+      result|= partitions[i].check_integrity(locked);
+    DBUG_RETURN(result);
+  }
+
   if (!locked)
     lock_and_suspend();
 
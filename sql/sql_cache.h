@@ -43,6 +43,9 @@ typedef struct st_changed_table_list CHANGED_TABLE_LIST;
 /* minimal result data size when data allocated */
 #define QUERY_CACHE_MIN_RESULT_DATA_SIZE	(1024*4)
 
+/* size of the buffer which collects the small packets of a writer */
+#define QUERY_CACHE_RESULT_BUFFER		(1024*16)
+
 /* 
    start estimation of first result block size only when number of queries
    bigger then: 
@@ -297,6 +300,16 @@ struct Query_cache_memory_bin_step
   }
 };
 
+/**
+  Query cache statistics summed over all partitions of the cache,
+  see Query_cache::get_statistics().
+*/
+struct Query_cache_statistics
+{
+  ulonglong free_memory_blocks, free_memory, hits, inserts, lowmem_prunes,
+    refused, queries_in_cache, total_blocks;
+};
+
 class Query_cache
 {
 public:
@@ -305,6 +318,8 @@ class Query_cache
   /* statistics */
   size_t free_memory, queries_in_cache, hits, inserts, refused,
     free_memory_blocks, total_blocks, lowmem_prunes;
+  /* number of times a thread had to wait for the cache lock */
+  size_t lock_waits;
 
 
 private:
@@ -353,6 +368,19 @@ class Query_cache
 
   bool initialized;
 
+  /*
+    With query_cache_partitions > 1 this object only routes the requests
+    to n_partitions independent caches, each with its own lock, memory,
+    bins and query and table hashes. A query is stored in the partition
+    selected by its key; a table is invalidated in every partition, one
+    partition lock at a time.
+  */
+  Query_cache *partitions;
+  uint n_partitions;
+
+  Query_cache *partition_for_key(const char *key, size_t key_length);
+  bool partition_disable_in_progress();
+
   /* Exclude/include from cyclic double linked list */
   static void double_linked_list_exclude(Query_cache_block *point,
 					 Query_cache_block **list_pointer);
@@ -445,6 +473,17 @@ class Query_cache
                                               uint8 *tables_type);
 
   static my_bool ask_handler_allowance(THD *thd, TABLE_LIST *tables_used);
+
+  /* store_query() and send_result_to_client() in the chosen partition */
+  void store_query_block(THD *thd, TABLE_LIST *tables_used,
+                         const char *query, size_t tot_length,
+                         TABLE_COUNTER_TYPE local_tables,
+                         uint8 tables_type);
+  int send_result_from_block(THD *thd, const char *sql, size_t tot_length);
+  void store_result_data(THD *thd, Query_cache_tls *query_cache_tls,
+                         const char *packet, size_t length,
+                         unsigned pkt_nr);
+  void store_result_buffer(THD *thd, Query_cache_tls *query_cache_tls);
  public:
 
   Query_cache(size_t query_cache_limit = ULONG_MAX,
@@ -455,14 +494,22 @@ class Query_cache
 
   inline bool is_disabled(void) { return m_cache_status != OK; }
   inline bool is_disable_in_progress(void)
-  { return m_cache_status == DISABLE_REQUEST; }
+  {
+    return m_cache_status == DISABLE_REQUEST ||
+           (n_partitions && partition_disable_in_progress());
+  }
 
   /* initialize cache (mutex) */
   void init();
   /* resize query cache (return real query size, 0 if disabled) */
   size_t resize(size_t query_cache_size);
   /* set limit on result size */
-  inline void result_size_limit(size_t limit){query_cache_limit=limit;}
+  inline void result_size_limit(size_t limit)
+  {
+    query_cache_limit= limit;
+    for (uint i= 0; i < n_partitions; i++)
+      partitions[i].result_size_limit(limit);
+  }
   /* set minimal result data allocation unit size */
   size_t set_min_res_unit(size_t size);
 
@@ -541,6 +588,14 @@ class Query_cache
   void unlock(void);
 
   void disable_query_cache(THD *thd);
+
+  /* Partitions of the cache; the cache itself if it is not partitioned */
+  uint partition_count() { return n_partitions ? n_partitions : 1; }
+  Query_cache *get_partition(uint i)
+  { return n_partitions ? &partitions[i] : this; }
+
+  void get_statistics(Query_cache_statistics *stats);
+  void reset_statistics();
 };
 
 #ifdef HAVE_QUERY_CACHE
@@ -394,6 +394,7 @@ class MY_LOCALE;
 */
 
 struct Query_cache_block;
+class Query_cache;
 
 struct Query_cache_tls
 {
@@ -402,12 +403,30 @@ struct Query_cache_tls
     functions and methods to maintain proper locking.
   */
   Query_cache_block *first_query_block;
+  /* The query cache partition which holds first_query_block */
+  Query_cache *partition;
+  /*
+    Small result packets which are not stored in the cache yet. The
+    buffer of QUERY_CACHE_RESULT_BUFFER bytes is kept for the next
+    queries of the connection.
+  */
+  uchar *result_buffer;
+  size_t result_length;
+  unsigned last_pkt_nr;
   void set_first_query_block(Query_cache_block *first_query_block_arg)
   {
     first_query_block= first_query_block_arg;
   }
+  void free_result_buffer()
+  {
+    my_free(result_buffer);
+    result_buffer= NULL;
+    result_length= 0;
+  }
 
-  Query_cache_tls() :first_query_block(NULL) {}
+  Query_cache_tls()
+    :first_query_block(NULL), partition(NULL), result_buffer(NULL),
+     result_length(0), last_pkt_nr(0) {}
 };
 
 /* SIGNAL / RESIGNAL / GET DIAGNOSTICS */
@@ -592,6 +611,9 @@ typedef struct system_variables
   ulong read_rnd_buff_size;
   ulong mrr_buff_size;
   ulong div_precincrement;
+  ulong filesort_threads;
+  ulong where_batch_size;
+  ulong parallel_scan_threads;
   /* Total size of all buffers used by the subselect_rowid_merge_engine. */
   ulong rowid_merge_buff_size;
   ulong max_sp_recursion_depth;
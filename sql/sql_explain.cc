@@ -1488,6 +1488,12 @@ void Explain_table_access::tag_to_json(Json_writer *writer, enum explain_extra_t
     case ET_LOOSESCAN:
       writer->add_member("loose_scan").add_bool(true);
       break;
+    case ET_USING_BATCHED_WHERE:
+      writer->add_member("batched_where").add_bool(true);
+      break;
+    case ET_USING_PARALLEL_SCAN:
+      writer->add_member("parallel_scan").add_bool(true);
+      break;
     case ET_USING_MRR:
       writer->add_member("mrr_type").add_str(mrr_type.c_ptr());
       break;
@@ -1711,6 +1717,9 @@ void Explain_table_access::print_explain_json(Explain_query *query,
   {
     tag_to_json(writer, extra_tags.at(i));
   }
+
+  if (is_analyze && tracker.r_scan_threads)
+    writer->add_member("r_scan_threads").add_ll(tracker.r_scan_threads);
   
   if (full_scan_on_null_key)
     writer->end_object(); //"full-scan-on-null_key"
@@ -1822,6 +1831,8 @@ const char * extra_tag_text[]=
   "Const row not found",
   "Unique row not found",
   "Impossible ON condition",
+  "Using batched where",
+  "Using parallel scan",
 };
 
 
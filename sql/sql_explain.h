@@ -539,6 +539,8 @@ enum explain_extra_tag
   ET_CONST_ROW_NOT_FOUND,
   ET_UNIQUE_ROW_NOT_FOUND,
   ET_IMPOSSIBLE_ON_CONDITION,
+  ET_USING_BATCHED_WHERE,
+  ET_USING_PARALLEL_SCAN,
 
   ET_total
 };
@@ -0,0 +1,443 @@
+/*
+   Copyright (c) 2018 MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "mariadb.h"
+#include "sql_select.h"
+#include "sql_batch_where.h"
+#include "sql_parallel_aggr.h"
+
+/* Don't start a thread for less rows than this */
+#define PARALLEL_SCAN_MIN_ROWS_PER_THREAD 10000
+
+/* Number of rows a scan thread collects before it evaluates them */
+#define PARALLEL_SCAN_BATCH_SIZE 1024
+
+
+/**
+  Check if an aggregate function can be computed from the partial
+  results of the scan threads.
+*/
+
+bool Parallel_aggregate::is_supported(Item_sum *item, TABLE *table)
+{
+  switch (item->sum_func()) {
+  case Item_sum::COUNT_FUNC:
+  case Item_sum::SUM_FUNC:
+  case Item_sum::MIN_FUNC:
+  case Item_sum::MAX_FUNC:
+    break;
+  default:
+    return false;
+  }
+  if (item->get_arg_count() != 1)
+    return false;
+
+  Item *arg= item->get_arg(0)->real_item();
+  if (arg->const_item())
+  {
+    /* COUNT(*) */
+    return item->sum_func() == Item_sum::COUNT_FUNC &&
+           arg->basic_const_item() && !arg->is_null();
+  }
+  if (arg->type() != Item::FIELD_ITEM)
+    return false;
+  Field *field= ((Item_field *) arg)->field;
+  return field->table == table && Batch_where::is_supported_field(field) &&
+         (item->sum_func() != Item_sum::SUM_FUNC ||
+          item->result_type() == DECIMAL_RESULT);
+}
+
+
+/**
+  Check if an item of the select list or HAVING is computed from the
+  aggregate functions and constants only, without looking at the row.
+*/
+
+static bool is_computed_from_aggregates(Item *item)
+{
+  if (item->type() == Item::SUM_FUNC_ITEM || item->const_item())
+    return true;
+  if (item->type() == Item::REF_ITEM)
+    return is_computed_from_aggregates(*((Item_ref *) item)->ref);
+  if (item->type() == Item::FUNC_ITEM)
+  {
+    Item_func *func= (Item_func *) item;
+    for (uint i= 0; i < func->argument_count(); i++)
+    {
+      if (!is_computed_from_aggregates(func->arguments()[i]))
+        return false;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+/**
+  Check if the table of 'tab' can be read by a parallel scan that
+  computes the aggregate functions of the query, see sql_parallel_aggr.h.
+
+  The table has to be the only one of an implicitly grouped SELECT, read
+  with a non-locking full table scan, and everything the query needs
+  from a row has to be in its integer columns.
+
+  @return Number of threads to use, 0 if a parallel scan can't be used
+*/
+
+uint Parallel_aggregate::threads(JOIN_TAB *tab)
+{
+  JOIN *join= tab->join;
+  THD *thd= join->thd;
+  TABLE *table= tab->table;
+  thr_lock_type lock_type= table->reginfo.lock_type;
+  ha_rows rows;
+  uint n_threads= (uint) thd->variables.parallel_scan_threads;
+
+  if (n_threads < 2 ||
+      thd->lex->sql_command != SQLCOM_SELECT ||
+      thd->variables.tx_isolation == ISO_SERIALIZABLE ||
+      !(table->file->ha_table_flags() & HA_CAN_PARALLEL_SCAN))
+    return 0;
+
+  if (join->table_count != join->const_tables + 1 ||
+      tab != join->join_tab + join->const_tables ||
+      tab->type != JT_ALL || tab->use_quick ||
+      (tab->select && tab->select->quick) || tab->filesort ||
+      tab->bush_children || tab->last_inner || tab->first_inner)
+    return 0;
+
+  if ((lock_type != TL_READ && lock_type != TL_READ_HIGH_PRIORITY &&
+       lock_type != TL_READ_NO_INSERT) ||
+      table->s->blob_fields || table->vfield ||
+      join->select_lex->ftfunc_list->elements)
+    return 0;
+
+  /* Only the single row of an implicitly grouped query is produced */
+  if (!join->implicit_grouping || join->group_list || join->need_tmp ||
+      (join->having && !is_computed_from_aggregates(join->having)) ||
+      join->procedure ||
+      join->select_lex->have_window_funcs() ||
+      !join->sum_funcs || !*join->sum_funcs)
+    return 0;
+
+  for (Item_sum **func= join->sum_funcs; *func; func++)
+  {
+    if (!is_supported(*func, table))
+      return 0;
+  }
+
+  /* The other items are computed from the aggregates */
+  List_iterator_fast<Item> it(join->all_fields);
+  Item *item;
+  while ((item= it++))
+  {
+    if (!is_computed_from_aggregates(item))
+      return 0;
+  }
+
+  if (tab->select_cond && !Batch_where::covers(tab->select_cond, table))
+    return 0;
+
+  rows= table->file->stats.records;
+  if (rows / PARALLEL_SCAN_MIN_ROWS_PER_THREAD < n_threads)
+    n_threads= (uint) (rows / PARALLEL_SCAN_MIN_ROWS_PER_THREAD);
+  return n_threads >= 2 ? n_threads : 0;
+}
+
+
+Parallel_aggregate *Parallel_aggregate::create(THD *thd, JOIN_TAB *tab)
+{
+  JOIN *join= tab->join;
+  TABLE *table= tab->table;
+  Parallel_aggregate *aggr;
+  Field **fields;
+  uint n_threads, n_aggregates= 0, n_fields= 0, batch_size;
+  DBUG_ENTER("Parallel_aggregate::create");
+
+  if (!(n_threads= threads(tab)))
+    DBUG_RETURN(NULL);
+
+  for (Item_sum **func= join->sum_funcs; *func; func++)
+    n_aggregates++;
+
+  batch_size= (uint) MY_MIN(PARALLEL_SCAN_BATCH_SIZE,
+                            thd->variables.join_buff_size /
+                            table->s->reclength);
+  set_if_bigger(batch_size, 1);
+
+  if (!(aggr= new (thd->mem_root) Parallel_aggregate) ||
+      !(aggr->aggregates= (Aggregate *) thd->alloc(n_aggregates *
+                                                   sizeof(Aggregate))) ||
+      !(aggr->workers= (Worker *) thd->alloc(n_threads * sizeof(Worker))) ||
+      !(fields= (Field **) thd->alloc(n_aggregates * sizeof(Field *))) ||
+      !(aggr->null_value= new (thd->mem_root) Item_null(thd)))
+    DBUG_RETURN(NULL);
+
+  for (uint i= 0; i < n_aggregates; i++)
+  {
+    Aggregate *agg= aggr->aggregates + i;
+    Item *arg;
+    agg->item= join->sum_funcs[i];
+    agg->value= NULL;
+    arg= agg->item->get_arg(0)->real_item();
+    if (arg->const_item())
+      agg->column= -1;
+    else
+      fields[n_fields++]= ((Item_field *) arg)->field;
+    if ((agg->item->sum_func() == Item_sum::MIN_FUNC ||
+         agg->item->sum_func() == Item_sum::MAX_FUNC) &&
+        !(agg->value= new (thd->mem_root) Item_int(thd, (longlong) 0)))
+      DBUG_RETURN(NULL);
+  }
+
+  for (uint i= 0; i < n_threads; i++)
+  {
+    Worker *worker= aggr->workers + i;
+    if (!(worker->batch= Batch_where::create(thd, table, tab->select_cond,
+                                             batch_size, fields, n_fields,
+                                             false)) ||
+        !(worker->partials= (Partial *) thd->alloc(n_aggregates *
+                                                   sizeof(Partial))))
+      DBUG_RETURN(NULL);
+  }
+
+  /* All batches have the same columns */
+  for (uint i= 0; i < n_aggregates; i++)
+  {
+    Aggregate *agg= aggr->aggregates + i;
+    Item *arg= agg->item->get_arg(0)->real_item();
+    if (!arg->const_item())
+      agg->column= (int) aggr->workers[0].batch->
+                         column(((Item_field *) arg)->field);
+  }
+
+  aggr->tab= tab;
+  aggr->n_threads= n_threads;
+  aggr->n_aggregates= n_aggregates;
+  DBUG_RETURN(aggr);
+}
+
+
+int Parallel_aggregate::scan()
+{
+  handler *file= tab->table->file;
+  ha_rows rows_read= 0, rows_selected= 0;
+  uint threads_used= 0;
+  int error;
+  DBUG_ENTER("Parallel_aggregate::scan");
+
+  for (uint i= 0; i < n_threads; i++)
+  {
+    Worker *worker= workers + i;
+    if (worker->batch->start())
+      DBUG_RETURN(HA_ERR_INTERNAL_ERROR);
+    bzero(worker->partials, n_aggregates * sizeof(Partial));
+    worker->rows_read= worker->rows_selected= 0;
+  }
+
+  if ((error= file->ha_rnd_init_with_error(1)))
+    DBUG_RETURN(error);
+  error= file->parallel_scan(n_threads, this);
+  file->ha_rnd_end();
+  if (error)
+    DBUG_RETURN(error);
+
+  for (uint i= 0; i < n_threads; i++)
+  {
+    Worker *worker= workers + i;
+    if (worker->batch->rows())
+      aggregate_batch(worker);
+    rows_read+= worker->rows_read;
+    rows_selected+= worker->rows_selected;
+    threads_used+= worker->rows_read != 0;
+  }
+
+  tab->tracker->r_rows+= rows_read;
+  tab->tracker->r_rows_after_where+= rows_selected;
+  set_if_bigger(tab->tracker->r_scan_threads, threads_used);
+  tab->join->join_examined_rows+= rows_read;
+  DBUG_RETURN(0);
+}
+
+
+/**
+  Called by the scan threads for each row of the table.
+*/
+
+void Parallel_aggregate::add_row(uint thread_no, const uchar *record)
+{
+  Worker *worker= workers + thread_no;
+  DBUG_ASSERT(thread_no < n_threads);
+  if (worker->batch->add_row(record))
+    aggregate_batch(worker);
+}
+
+
+/**
+  Add the rows of the batch of a thread which pass the WHERE condition
+  to the partial results of the thread, and empty the batch.
+*/
+
+void Parallel_aggregate::aggregate_batch(Worker *worker)
+{
+  Batch_where *batch= worker->batch;
+  uint n= batch->filter();
+  const uint *sel= batch->selected_rows();
+
+  worker->rows_read+= batch->rows();
+  worker->rows_selected+= n;
+
+  for (uint a= 0; a < n_aggregates; a++)
+  {
+    Partial *p= worker->partials + a;
+    if (aggregates[a].column < 0)
+    {
+      p->count+= n;
+      continue;
+    }
+
+    const longlong *values= batch->column_values(aggregates[a].column);
+    const uchar *nulls= batch->column_nulls(aggregates[a].column);
+    switch (aggregates[a].item->sum_func()) {
+    case Item_sum::COUNT_FUNC:
+      for (uint i= 0; i < n; i++)
+        p->count+= !nulls[sel[i]];
+      break;
+    case Item_sum::SUM_FUNC:
+      for (uint i= 0; i < n; i++)
+      {
+        if (nulls[sel[i]])
+          continue;
+        longlong value= values[sel[i]];
+        ulonglong low= p->sum_low + (ulonglong) value;
+        p->sum_high+= (value < 0 ? -1 : 0) + (low < p->sum_low);
+        p->sum_low= low;
+        p->count++;
+      }
+      break;
+    case Item_sum::MIN_FUNC:
+      for (uint i= 0; i < n; i++)
+      {
+        if (nulls[sel[i]])
+          continue;
+        if (!p->count++ || values[sel[i]] < p->min)
+          p->min= values[sel[i]];
+      }
+      break;
+    case Item_sum::MAX_FUNC:
+      for (uint i= 0; i < n; i++)
+      {
+        if (nulls[sel[i]])
+          continue;
+        if (!p->count++ || values[sel[i]] > p->max)
+          p->max= values[sel[i]];
+      }
+      break;
+    default:
+      DBUG_ASSERT(0);
+    }
+  }
+  batch->clear();
+}
+
+
+/**
+  Convert a sum kept as 128 bits to a decimal.
+*/
+
+static void sum_to_decimal(ulonglong low, longlong high, my_decimal *to)
+{
+  my_decimal high_dec, low_dec, scale, tmp, one;
+
+  if ((high == 0 && low <= (ulonglong) LONGLONG_MAX) ||
+      (high == -1 && low > (ulonglong) LONGLONG_MAX))
+  {
+    int2my_decimal(E_DEC_FATAL_ERROR, (longlong) low, FALSE, to);
+    return;
+  }
+  /* high * 2^64 + low */
+  int2my_decimal(E_DEC_FATAL_ERROR, high, FALSE, &high_dec);
+  int2my_decimal(E_DEC_FATAL_ERROR, (longlong) low, TRUE, &low_dec);
+  int2my_decimal(E_DEC_FATAL_ERROR, (longlong) ULONGLONG_MAX, TRUE, &tmp);
+  int2my_decimal(E_DEC_FATAL_ERROR, 1, FALSE, &one);
+  my_decimal_add(E_DEC_FATAL_ERROR, &scale, &tmp, &one);
+  my_decimal_mul(E_DEC_FATAL_ERROR, &tmp, &high_dec, &scale);
+  my_decimal_add(E_DEC_FATAL_ERROR, to, &tmp, &low_dec);
+}
+
+
+bool Parallel_aggregate::merge()
+{
+  ha_rows rows_selected= 0;
+  DBUG_ENTER("Parallel_aggregate::merge");
+
+  for (uint i= 0; i < n_threads; i++)
+    rows_selected+= workers[i].rows_selected;
+  if (!rows_selected)
+    DBUG_RETURN(false);
+
+  for (uint a= 0; a < n_aggregates; a++)
+  {
+    Aggregate *agg= aggregates + a;
+    Partial total;
+
+    bzero(&total, sizeof(total));
+    for (uint i= 0; i < n_threads; i++)
+    {
+      const Partial *p= workers[i].partials + a;
+      if (!p->count)
+        continue;
+      ulonglong low= total.sum_low + p->sum_low;
+      total.sum_high+= p->sum_high + (low < total.sum_low);
+      total.sum_low= low;
+      if (!total.count || p->min < total.min)
+        total.min= p->min;
+      if (!total.count || p->max > total.max)
+        total.max= p->max;
+      total.count+= p->count;
+    }
+
+    switch (agg->item->sum_func()) {
+    case Item_sum::COUNT_FUNC:
+      ((Item_sum_count *) agg->item)->direct_add(total.count);
+      break;
+    case Item_sum::SUM_FUNC:
+      if (total.count)
+      {
+        my_decimal sum;
+        sum_to_decimal(total.sum_low, total.sum_high, &sum);
+        ((Item_sum_sum *) agg->item)->direct_add(&sum);
+      }
+      else
+        ((Item_sum_sum *) agg->item)->direct_add((my_decimal *) NULL);
+      break;
+    case Item_sum::MIN_FUNC:
+    case Item_sum::MAX_FUNC:
+      if (total.count)
+      {
+        agg->value->value= agg->item->sum_func() == Item_sum::MIN_FUNC ?
+                           total.min : total.max;
+        ((Item_sum_hybrid *) agg->item)->direct_add(agg->value);
+      }
+      else
+        ((Item_sum_hybrid *) agg->item)->direct_add(null_value);
+      break;
+    default:
+      DBUG_ASSERT(0);
+    }
+  }
+  DBUG_RETURN(true);
+}
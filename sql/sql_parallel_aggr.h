@@ -0,0 +1,102 @@
+#ifndef SQL_PARALLEL_AGGR_INCLUDED
+#define SQL_PARALLEL_AGGR_INCLUDED
+/*
+   Copyright (c) 2018 MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  Aggregate functions of a single table query computed by a parallel scan.
+
+  For a query like
+
+    SELECT COUNT(*), SUM(a), MIN(b) FROM t1 WHERE c > 10
+
+  the storage engine reads the table with several threads, see
+  handler::parallel_scan(). Every thread collects its rows in its own
+  Batch_where, evaluates the WHERE condition for them in batches and
+  aggregates the rows that pass into partial results of its own. When
+  the scan is done, the partial results are merged and handed to the
+  Item_sum objects with their direct_add() methods, so that the rest of
+  the execution (end_send_group(), HAVING, sending the row) is as usual.
+
+  This is only done when nothing but integer columns has to be looked
+  at: the WHERE condition has to be a conjunction of comparisons that
+  Batch_where can evaluate, and the aggregate functions have to be
+  COUNT, SUM, MIN or MAX of an integer column, see
+  Parallel_aggregate::threads().
+*/
+
+class Batch_where;
+
+class Parallel_aggregate: public Parallel_scan_consumer, public Sql_alloc
+{
+public:
+  /* Number of threads to scan the table of 'tab' with, 0 if it can't be */
+  static uint threads(JOIN_TAB *tab);
+  static bool is_applicable(JOIN_TAB *tab) { return threads(tab) != 0; }
+  static Parallel_aggregate *create(THD *thd, JOIN_TAB *tab);
+
+  /*
+    Read the table and compute the partial results.
+    @return 0, HA_ERR_WRONG_COMMAND if the engine could not scan the
+            table in parallel (nothing was read then), or error code
+  */
+  int scan();
+
+  /*
+    Pass the results of scan() to the aggregate functions.
+    @return false if no rows passed the WHERE condition
+  */
+  bool merge();
+
+  void add_row(uint thread_no, const uchar *record);
+
+private:
+  struct Aggregate
+  {
+    Item_sum *item;
+    int column;                  /* In the batches, -1 for COUNT(const) */
+    Item_int *value;             /* Result for MIN and MAX */
+  };
+
+  /* Result of an aggregate over the rows read by one thread */
+  struct Partial
+  {
+    longlong count;              /* Of the non-NULL values */
+    ulonglong sum_low;           /* Sum of the values as 128 bits */
+    longlong sum_high;
+    longlong min, max;
+  };
+
+  struct Worker
+  {
+    Batch_where *batch;
+    Partial *partials;
+    ha_rows rows_read;
+    ha_rows rows_selected;
+  };
+
+  static bool is_supported(Item_sum *item, TABLE *table);
+  void aggregate_batch(Worker *worker);
+
+  JOIN_TAB *tab;
+  uint n_threads;
+  Worker *workers;
+  Aggregate *aggregates;
+  uint n_aggregates;
+  Item *null_value;
+};
+
+#endif /* SQL_PARALLEL_AGGR_INCLUDED */
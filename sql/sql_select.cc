@@ -54,6 +54,8 @@
 #include "sql_statistics.h"
 #include "sql_cte.h"
 #include "sql_window.h"
+#include "sql_batch_where.h"
+#include "sql_parallel_aggr.h"
 #include "tztime.h"
 
 #include "debug_sync.h"          // DEBUG_SYNC
@@ -170,6 +172,7 @@ bool const_expression_in_where(COND *conds,Item *item, Item **comp_item);
 static int do_select(JOIN *join, Procedure *procedure);
 
 static enum_nested_loop_state evaluate_join_record(JOIN *, JOIN_TAB *, int);
+static enum_nested_loop_state sub_select_batched(JOIN *, JOIN_TAB *);
 static enum_nested_loop_state
 evaluate_null_complemented_join_record(JOIN *join, JOIN_TAB *join_tab);
 static enum_nested_loop_state
@@ -12343,6 +12346,9 @@ void JOIN_TAB::cleanup()
     table->file->ha_end_keyread();
     table->file->ha_index_or_rnd_end();
     preread_init_done= FALSE;
+    batch_where= NULL;
+    parallel_aggr= NULL;
+    batched_scan_checked= FALSE;
     if (table->pos_in_table_list && 
         table->pos_in_table_list->jtbm_subselect)
     {
@@ -19296,6 +19302,40 @@ sub_select(JOIN *join,JOIN_TAB *join_tab,bool end_of_records)
   if (join_tab->loosescan_match_tab)
     join_tab->loosescan_match_tab->found_match= FALSE;
 
+  if (!join_tab->batched_scan_checked)
+  {
+    join_tab->batched_scan_checked= TRUE;
+    if (join_tab->next_select == end_send_group &&
+        Parallel_aggregate::is_applicable(join_tab))
+      join_tab->parallel_aggr= Parallel_aggregate::create(join->thd,
+                                                          join_tab);
+    else if (Batch_where::is_applicable(join_tab))
+      join_tab->batch_where= Batch_where::create(join->thd, join_tab);
+  }
+  if (join_tab->parallel_aggr && rc != NESTED_LOOP_NO_MORE_ROWS)
+  {
+    if (!(error= join_tab->parallel_aggr->scan()))
+    {
+      if (join_tab->parallel_aggr->merge())
+        rc= (*join_tab->next_select)(join, join_tab + 1, 0);
+      DBUG_RETURN(rc == NESTED_LOOP_NO_MORE_ROWS ? NESTED_LOOP_OK : rc);
+    }
+    if (error != HA_ERR_WRONG_COMMAND)
+    {
+      if (join->thd->killed)
+      {
+        join->thd->send_kill_message();
+        DBUG_RETURN(NESTED_LOOP_KILLED);
+      }
+      report_error(join_tab->table, error);
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+    }
+    /* The engine can't scan the table in parallel now, read it row by row */
+    join_tab->parallel_aggr= NULL;
+  }
+  if (join_tab->batch_where && rc != NESTED_LOOP_NO_MORE_ROWS)
+    DBUG_RETURN(sub_select_batched(join, join_tab));
+
   if (rc != NESTED_LOOP_NO_MORE_ROWS)
   {
     error= (*join_tab->read_first_record)(join_tab);
@@ -19352,6 +19392,79 @@ sub_select(JOIN *join,JOIN_TAB *join_tab,bool end_of_records)
   DBUG_RETURN(rc);
 }
 
+/**
+  Table scan loop of sub_select() when the rows are read in batches.
+
+  Rows are read ahead into join_tab->batch_where until it is full or the
+  scan ends. The simple conjuncts of the condition are evaluated for
+  the whole batch at once, and only the rows that pass them are put
+  back into record[0] and handed to evaluate_join_record(), with the
+  condition replaced by what is left of it to evaluate.
+
+  See Batch_where::is_applicable() for when this can be used.
+*/
+
+static enum_nested_loop_state
+sub_select_batched(JOIN *join, JOIN_TAB *join_tab)
+{
+  Batch_where *batch= join_tab->batch_where;
+  READ_RECORD *info= &join_tab->read_record;
+  THD *thd= join->thd;
+  COND *save_select_cond= join_tab->select_cond;
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  int error;
+  DBUG_ENTER("sub_select_batched");
+
+  if (batch->start())
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+  join_tab->select_cond= batch->remaining_cond;
+
+  error= (*join_tab->read_first_record)(join_tab);
+  for (;;)
+  {
+    while (!error && !batch->add_row())
+      error= info->read_record();
+    if (error > 0 || thd->is_error())
+    {
+      rc= NESTED_LOOP_ERROR;
+      break;
+    }
+    if (thd->check_killed())
+    {
+      thd->send_kill_message();
+      rc= NESTED_LOOP_KILLED;
+      break;
+    }
+
+    uint rows= batch->rows();
+    uint selected= batch->filter();
+    join_tab->tracker->r_rows+= rows - selected;
+    join->join_examined_rows+= rows - selected;
+    for (uint i= selected; i < rows; i++)
+      thd->get_stmt_da()->inc_current_row_for_warning();
+
+    join_tab->table->status= 0;
+    for (uint i= 0;
+         i < selected && rc == NESTED_LOOP_OK && join->return_tab >= join_tab;
+         i++)
+    {
+      batch->restore_selected_row(i);
+      rc= evaluate_join_record(join, join_tab, 0);
+    }
+    batch->clear();
+
+    if (error || rc != NESTED_LOOP_OK || join->return_tab < join_tab)
+      break;
+    error= info->read_record();
+  }
+  join_tab->select_cond= save_select_cond;
+
+  if (rc == NESTED_LOOP_NO_MORE_ROWS)
+    rc= NESTED_LOOP_OK;
+  DBUG_RETURN(rc);
+}
+
+
 /**
   @brief Process one row of the nested loop join.
 
@@ -25254,9 +25367,14 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
           eta->where_cond= tab_select->cond;
           eta->cache_cond= cache_select? cache_select->cond : NULL;
           eta->push_extra(ET_USING_WHERE);
+          if (Batch_where::is_applicable(this) &&
+              !Parallel_aggregate::is_applicable(this))
+            eta->push_extra(ET_USING_BATCHED_WHERE);
         }
       }
     }
+    if (Parallel_aggregate::is_applicable(this))
+      eta->push_extra(ET_USING_PARALLEL_SCAN);
     if (table_list /* SJM bushes don't have table_list */ &&
         table_list->schema_table &&
         table_list->schema_table->i_s_requested_object & OPTIMIZE_I_S_TABLE)
@@ -35,6 +35,8 @@
 #include "filesort.h"
 
 typedef struct st_join_table JOIN_TAB;
+class Batch_where;
+class Parallel_aggregate;
 /* Values in optimize */
 #define KEY_OPTIMIZE_EXISTS		1U
 #define KEY_OPTIMIZE_REF_OR_NULL	2U
@@ -507,6 +509,12 @@ typedef struct st_join_table {
 
   bool preread_init_done;
 
+  /* Set if the scan reads rows ahead to filter them in batches */
+  Batch_where *batch_where;
+  /* Set if the aggregate functions are computed by a parallel scan */
+  Parallel_aggregate *parallel_aggr;
+  bool batched_scan_checked;
+
   void cleanup();
   inline bool is_using_loose_index_scan()
   {
@@ -24,6 +24,8 @@ typedef struct st_buffpek BUFFPEK;
 
 struct SORT_FIELD;
 class Field;
+class Filesort_tracker;
+class Filesort_workers;
 struct TABLE;
 
 /* Defines used by filesort and uniques */
@@ -83,6 +85,9 @@ class Sort_param {
   uchar *unique_buff;
   bool not_killable;
   char* tmp_buffer;
+  uint sort_threads;          // Max threads to sort one buffer with.
+  Filesort_workers *workers;  // Threads for sort_threads > 1, or NULL.
+  Filesort_tracker *tracker;  // For ANALYZE, NULL if not used by filesort.
   // The fields below are used only by Unique class.
   qsort2_cmp compare;
   BUFFPEK_COMPARE_CONTEXT cmp_context;
@@ -1160,6 +1160,24 @@ static Sys_var_ulong Sys_interactive_timeout(
        CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(1, LONG_TIMEOUT), DEFAULT(NET_WAIT_TIMEOUT), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_where_batch_size(
+       "where_batch_size",
+       "Number of rows a full table scan reads ahead to evaluate simple "
+       "comparisons of integer columns in the WHERE clause for all of them "
+       "at once. The rows of a batch also take at most join_buffer_size "
+       "bytes. 0 means rows are always evaluated one by one",
+       SESSION_VAR(where_batch_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 65536), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_parallel_scan_threads(
+       "parallel_scan_threads",
+       "Number of threads that read the table of a single table SELECT "
+       "without GROUP BY to compute its aggregate functions, when the "
+       "storage engine supports it. 1 means the table is read by the "
+       "connection thread only",
+       SESSION_VAR(parallel_scan_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulonglong Sys_join_buffer_size(
        "join_buffer_size",
        "The size of the buffer that is used for joins",
@@ -2855,6 +2873,13 @@ static Sys_var_ulong Sys_query_cache_limit(
        NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(NULL),
        ON_UPDATE(fix_query_cache_limit));
 
+static Sys_var_uint Sys_query_cache_partitions(
+       "query_cache_partitions",
+       "Number of independently locked partitions of the query cache. "
+       "query_cache_size is divided between the partitions",
+       READ_ONLY GLOBAL_VAR(query_cache_partitions), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 64), DEFAULT(1), BLOCK_SIZE(1));
+
 static bool fix_qcache_min_res_unit(sys_var *self, THD *thd, enum_var_type type)
 {
   query_cache_min_res_unit=
@@ -3240,6 +3265,14 @@ static Sys_var_ulong Sys_slow_launch_time(
        GLOBAL_VAR(slow_launch_time), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, LONG_TIMEOUT), DEFAULT(2), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_filesort_threads(
+       "filesort_threads",
+       "Maximum number of threads a single sort may use to sort the keys "
+       "in its sort buffer. 1 means the sort buffer is always sorted by "
+       "the connection thread",
+       SESSION_VAR(filesort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulonglong Sys_sort_buffer(
        "sort_buffer_size",
        "Each thread that needs to do a sort allocates a buffer of this size",
@@ -3532,6 +3565,13 @@ static bool fix_threadpool_stall_limit(sys_var*, THD*, enum_var_type)
   return false;
 }
 
+
+static bool fix_threadpool_max_user_statements(sys_var*, THD*, enum_var_type)
+{
+  tp_user_wake_waiters();
+  return false;
+}
+
 #ifdef _WIN32
 static Sys_var_uint Sys_threadpool_min_threads(
   "thread_pool_min_threads",
@@ -3609,6 +3649,28 @@ static Sys_var_uint Sys_threadpool_threadpool_prio_kickup_timer(
   GLOBAL_VAR(threadpool_prio_kickup_timer), CMD_LINE(REQUIRED_ARG),
   VALID_RANGE(0, UINT_MAX), DEFAULT(1000), BLOCK_SIZE(1)
 );
+
+static Sys_var_mybool Sys_threadpool_work_stealing(
+ "thread_pool_work_stealing",
+ "Let an idle worker thread execute requests queued in another thread "
+ "group, instead of waiting for work in its own group",
+  GLOBAL_VAR(threadpool_work_stealing), CMD_LINE(OPT_ARG), DEFAULT(FALSE)
+);
+
+static Sys_var_uint Sys_threadpool_max_user_statements(
+ "thread_pool_max_user_statements",
+ "Maximum number of statements of one user executing at the same time "
+ "in the thread pool. Further statements of the user wait in the queue "
+ "until one of them completes or waits for a row, table or metadata "
+ "lock; a statement that waits for IO keeps its slot, and one that "
+ "returns from a lock wait runs even if that exceeds the limit. "
+ "Statements of connections that are in a transaction, hold locks or "
+ "were killed do not wait. 0 means no limit",
+  GLOBAL_VAR(threadpool_max_user_statements), CMD_LINE(REQUIRED_ARG),
+  VALID_RANGE(0, 100000), DEFAULT(0), BLOCK_SIZE(1),
+  NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+  ON_UPDATE(fix_threadpool_max_user_statements)
+);
 #endif /* HAVE_POOL_OF_THREADS */
 
 /**
@@ -1126,6 +1126,12 @@ struct TABLE
 public:
 
   uint32 instance; /** Table cache instance this TABLE is belonging to */
+  /**
+    Table cache: the object was released to Share_free_tables::mru and is
+    still in the LRU list of its instance, even if it was taken from
+    there again.
+  */
+  bool in_mru;
   THD	*in_use;                        /* Which thread uses this */
 
   uchar *record[3];			/* Pointer to records */
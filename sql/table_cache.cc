@@ -121,7 +121,11 @@ struct Table_cache_instance
   /**
     Protects free_tables (TABLE::global_free_next and TABLE::global_free_prev),
     records, Share_free_tables::List (TABLE::prev and TABLE::next),
-    TABLE::in_use.
+    TABLE::in_use, TABLE::in_mru and the stores to Share_free_tables::mru.
+
+    Share_free_tables::mru is taken by tc_acquire_table() without the mutex,
+    so free_tables may hold a TABLE with TABLE::in_mru set that is in use.
+    It is skipped by eviction and removed when released.
   */
   mysql_mutex_t LOCK_table_cache;
   I_P_List <TABLE, I_P_List_adapter<TABLE, &TABLE::global_free_next,
@@ -280,6 +284,12 @@ static void tc_remove_all_unused_tables(TDC_element *element,
   for (ulong i= 0; i < tc_instances; i++)
   {
     mysql_mutex_lock(&tc[i].LOCK_table_cache);
+    if ((table= (TABLE*) my_atomic_fasptr((void**) &element->free_tables[i].mru,
+                                          0)))
+    {
+      table->in_mru= false;
+      element->free_tables[i].list.push_front(table);
+    }
     while ((table= element->free_tables[i].list.pop_front()))
     {
       tc[i].records--;
@@ -371,9 +381,22 @@ void tc_add_table(THD *thd, TABLE *table)
   mysql_mutex_lock(&tc[i].LOCK_table_cache);
   if (tc[i].records == tc_size)
   {
-    if ((LRU_table= tc[i].free_tables.pop_front()))
+    while ((LRU_table= tc[i].free_tables.pop_front()))
+    {
+      Share_free_tables *free_tables= &LRU_table->s->tdc->free_tables[i];
+      if (!LRU_table->in_mru)
+      {
+        free_tables->list.remove(LRU_table);
+        break;
+      }
+      /* Skip the object if tc_acquire_table() took it */
+      LRU_table->in_mru= false;
+      void *expected= LRU_table;
+      if (my_atomic_casptr((void**) &free_tables->mru, &expected, 0))
+        break;
+    }
+    if (LRU_table)
     {
-      LRU_table->s->tdc->free_tables[i].list.remove(LRU_table);
       /* Needed if MDL deadlock detector chimes in before tc_remove_table() */
       LRU_table->in_use= thd;
       mysql_mutex_unlock(&tc[i].LOCK_table_cache);
@@ -414,19 +437,29 @@ static TABLE *tc_acquire_table(THD *thd, TDC_element *element)
   uint32 i= thd->thread_id % n_instances;
   TABLE *table;
 
-  tc[i].lock_and_check_contention(n_instances, i);
-  table= element->free_tables[i].list.pop_front();
-  if (table)
+  /*
+    The last released object is taken without the mutex. It stays in the
+    LRU list until it is released again or skipped by eviction.
+  */
+  if ((table= (TABLE*) my_atomic_fasptr((void**) &element->free_tables[i].mru,
+                                        0)))
+    DBUG_ASSERT(table->instance == i);
+  else
   {
-    DBUG_ASSERT(!table->in_use);
-    table->in_use= thd;
-    /* The ex-unused table must be fully functional. */
-    DBUG_ASSERT(table->db_stat && table->file);
-    /* The children must be detached from the table. */
-    DBUG_ASSERT(!table->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
-    tc[i].free_tables.remove(table);
+    tc[i].lock_and_check_contention(n_instances, i);
+    table= element->free_tables[i].list.pop_front();
+    if (table)
+      tc[i].free_tables.remove(table);
+    mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+    if (!table)
+      return 0;
   }
-  mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+  DBUG_ASSERT(!table->in_use);
+  table->in_use= thd;
+  /* The ex-unused table must be fully functional. */
+  DBUG_ASSERT(table->db_stat && table->file);
+  /* The children must be detached from the table. */
+  DBUG_ASSERT(!table->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
   return table;
 }
 
@@ -452,6 +485,14 @@ static TABLE *tc_acquire_table(THD *thd, TDC_element *element)
   unused lists. This other thread is expected to call tc_purge(),
   which is synchronized with us on TABLE_SHARE::tdc.LOCK_table_share.
 
+  @note Unlike tc_acquire_table(), this always takes LOCK_table_cache.
+  Whether the object is kept depends on records and on
+  TABLE_SHARE::tdc.flushed, and that decision has to be serialized with
+  eviction and with tc_remove_all_unused_tables(), which must not miss an
+  object published to Share_free_tables::mru after they looked at it.
+  Publishing it under the mutex also keeps TABLE::in_mru in step with the
+  LRU list. So an open/close pair takes the mutex once instead of twice.
+
   @return
     @retval true  object purged
     @retval false object released
@@ -460,10 +501,17 @@ static TABLE *tc_acquire_table(THD *thd, TDC_element *element)
 void tc_release_table(TABLE *table)
 {
   uint32 i= table->instance;
+  Share_free_tables *free_tables= &table->s->tdc->free_tables[i];
   DBUG_ASSERT(table->in_use);
   DBUG_ASSERT(table->file);
 
   mysql_mutex_lock(&tc[i].LOCK_table_cache);
+  if (table->in_mru)
+  {
+    /* Taken from Share_free_tables::mru, still in the LRU list */
+    table->in_mru= false;
+    tc[i].free_tables.remove(table);
+  }
   if (table->needs_reopen() || table->s->tdc->flushed ||
       tc[i].records > tc_size)
   {
@@ -474,8 +522,15 @@ void tc_release_table(TABLE *table)
   else
   {
     table->in_use= 0;
-    table->s->tdc->free_tables[i].list.push_front(table);
     tc[i].free_tables.push_back(table);
+    /* Only released objects are stored there, under LOCK_table_cache */
+    if (!my_atomic_loadptr((void**) &free_tables->mru))
+    {
+      table->in_mru= true;
+      my_atomic_storeptr((void**) &free_tables->mru, table);
+    }
+    else
+      free_tables->list.push_front(table);
     mysql_mutex_unlock(&tc[i].LOCK_table_cache);
   }
 }
@@ -489,7 +544,10 @@ static void tdc_assert_clean_share(TDC_element *element)
   DBUG_ASSERT(element->all_tables.is_empty());
 #ifndef DBUG_OFF
   for (ulong i= 0; i < tc_instances; i++)
+  {
     DBUG_ASSERT(element->free_tables[i].list.is_empty());
+    DBUG_ASSERT(!element->free_tables[i].mru);
+  }
 #endif
   DBUG_ASSERT(element->all_tables_refs == 0);
   DBUG_ASSERT(element->next == 0);
@@ -562,7 +620,10 @@ static void lf_alloc_constructor(uchar *arg)
   element->m_flush_tickets.empty();
   element->all_tables.empty();
   for (ulong i= 0; i < tc_instances; i++)
+  {
     element->free_tables[i].list.empty();
+    element->free_tables[i].mru= 0;
+  }
   element->all_tables_refs= 0;
   element->share= 0;
   element->ref_count= 0;
@@ -22,6 +22,11 @@ struct Share_free_tables
 {
   typedef I_P_List <TABLE, TABLE_share> List;
   List list;
+  /**
+    The last TABLE object released to this instance, if it was not taken
+    since. tc_acquire_table() takes it without LOCK_table_cache.
+  */
+  TABLE *mru;
   /** Avoid false sharing between instances */
   char pad[CPU_LEVEL1_DCACHE_LINESIZE];
 };
@@ -24,6 +24,8 @@ extern uint threadpool_stall_limit;  /* time interval in 10 ms units for stall c
 extern uint threadpool_max_threads;  /* Maximum threads in pool */
 extern uint threadpool_oversubscribe;  /* Maximum active threads in group */
 extern uint threadpool_prio_kickup_timer;  /* Time before low prio item gets prio boost */
+extern my_bool threadpool_work_stealing; /* Idle threads take work of other groups */
+extern uint threadpool_max_user_statements; /* Executing statements per user */
 #ifdef _WIN32
 extern uint threadpool_mode; /* Thread pool implementation , windows or generic */
 #define TP_MODE_WINDOWS 0
@@ -40,15 +42,57 @@ extern void tp_timeout_handler(TP_connection *c);
 /*
   Threadpool statistics
 */
+#define TP_QUEUE_WAIT_BUCKETS 6
+
 struct TP_STATISTICS
 {
   /* Current number of worker thread. */
   volatile int32 num_worker_threads;
+  /* Number of events taken from the queue of another thread group. */
+  volatile int64 steals;
+  /*
+    Number of events by the time they spent in the queue:
+    <100us, <1ms, <10ms, <100ms, <1s and longer.
+  */
+  volatile int64 queue_wait[TP_QUEUE_WAIT_BUCKETS];
 };
 
 extern TP_STATISTICS tp_stats;
 
 
+/*
+  Per-user accounting, shared by all pool connections of the same user.
+  Entries are created on the first login of a user and live until the
+  pool is shut down.
+*/
+struct TP_user
+{
+  char name[USERNAME_LENGTH + 1];
+  uint name_length;
+  /* Connections of the user, protected by LOCK_tp_users */
+  uint connections;
+  /* Statements currently executing */
+  volatile int32 running;
+  /* Connections deferred by thread_pool_max_user_statements */
+  volatile int32 waiting;
+  /* Statements executed */
+  volatile int64 statements;
+  /* Microseconds the connections of the user spent in the pool queues */
+  volatile int64 queue_time;
+  /* Number and total microseconds of deferrals */
+  volatile int64 admission_waits;
+  volatile int64 admission_time;
+  /* Deferred connections, first in first out, protected by LOCK_tp_users */
+  TP_connection *deferred;
+  TP_connection **deferred_last;
+};
+
+typedef int (*tp_user_callback)(TP_user *user, void *arg);
+extern int tp_for_each_user(tp_user_callback func, void *arg);
+extern void tp_user_wake_waiters();
+extern bool tp_user_admit(TP_connection *c);
+
+
 /* Functions to set threadpool parameters */
 extern void tp_set_min_threads(uint val);
 extern void tp_set_max_threads(uint val);
@@ -90,11 +134,26 @@ struct TP_connection
   CONNECT*    connect;
   TP_STATE    state;
   TP_PRIORITY priority;
+  TP_user*    user;
+  /* Holds a statement slot of the user, counted in TP_user::running */
+  bool        user_slot;
+  /* Returned the slot for a lock wait, takes it again in thd_wait_end() */
+  bool        user_slot_in_wait;
+  /* On the deferred list of the user, see tp_user_admit() */
+  bool        deferred;
+  TP_connection *next_deferred;
+  ulonglong   deferred_time;
   TP_connection(CONNECT *c) :
     thd(0),
     connect(c),
     state(TP_STATE_IDLE),
-    priority(TP_PRIORITY_HIGH)
+    priority(TP_PRIORITY_HIGH),
+    user(0),
+    user_slot(false),
+    user_slot_in_wait(false),
+    deferred(false),
+    next_deferred(0),
+    deferred_time(0)
   {}
 
   virtual ~TP_connection()
@@ -128,6 +187,8 @@ struct TP_pool
   virtual int set_stall_limit(uint){ return 0; }
   virtual int get_thread_count() { return tp_stats.num_worker_threads; }
   virtual int get_idle_thread_count(){ return 0; }
+  /* Queue a connection again that tp_user_admit() deferred */
+  virtual void resume(TP_connection *c) { DBUG_ASSERT(0); }
 };
 
 #ifdef _WIN32
@@ -153,4 +214,5 @@ struct TP_pool_generic :TP_pool
   virtual int set_pool_size(uint);
   virtual int set_stall_limit(uint);
   virtual int get_idle_thread_count();
+  virtual void resume(TP_connection *c);
 };
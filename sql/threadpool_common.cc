@@ -36,6 +36,8 @@ uint threadpool_max_threads;
 uint threadpool_oversubscribe;
 uint threadpool_mode;
 uint threadpool_prio_kickup_timer;
+my_bool threadpool_work_stealing;
+uint threadpool_max_user_statements;
 
 /* Stats */
 TP_STATISTICS tp_stats;
@@ -44,6 +46,12 @@ TP_STATISTICS tp_stats;
 static void  threadpool_remove_connection(THD *thd);
 static int   threadpool_process_request(THD *thd);
 static THD*  threadpool_add_connection(CONNECT *connect, void *scheduler_data);
+static void  tp_user_attach(TP_connection *c);
+static void  tp_user_detach(TP_connection *c);
+static void  tp_user_check(TP_connection *c);
+static void  tp_user_resume_killed(TP_connection *c);
+static void  tp_user_begin_statement(TP_connection *c);
+static void  tp_user_end_statement(TP_connection *c);
 
 extern "C" pthread_key(struct st_my_thread_var*, THR_KEY_mysys);
 extern bool do_command(THD*);
@@ -182,11 +190,20 @@ void tp_callback(TP_connection *c)
       goto error;
     }
     c->connect= 0;
+    tp_user_attach(c);
   }
-  else if (threadpool_process_request(thd))
+  else
   {
-    /* QUIT or an error occured. */
-    goto error;
+    int retval;
+    tp_user_begin_statement(c);
+    retval= threadpool_process_request(thd);
+    tp_user_end_statement(c);
+    if (retval)
+    {
+      /* QUIT or an error occured. */
+      goto error;
+    }
+    tp_user_check(c);
   }
 
   /* Set priority */
@@ -203,6 +220,7 @@ void tp_callback(TP_connection *c)
 
 error:
   c->thd= 0;
+  tp_user_detach(c);
   delete c;
 
   if (thd)
@@ -395,8 +413,370 @@ static bool tp_end_thread(THD *, bool)
 
 static TP_pool *pool;
 
+
+/*
+  Per-user accounting and admission control.
+
+  Every connection refers to the TP_user entry of its user. A connection
+  holds a statement slot of its user, counted in TP_user::running, while
+  it executes a request. The generic pool takes the slot when it removes
+  the connection from a workqueue. If the user already has
+  thread_pool_max_user_statements slots, the connection is not executed
+  but parked on the deferred list of the user, without the command being
+  read, and without a worker thread. It is put back into its workqueue
+  when a slot of the user is returned.
+
+  A statement returns its slot while it waits in thd_wait_begin() for a
+  row, table or metadata lock, and takes it again in thd_wait_end(), even
+  if that goes over the limit. So a statement that waits for a lock held
+  by another connection of the same user never keeps that connection
+  from running. Waits for IO keep the slot.
+
+  Connections inside a transaction, connections holding metadata locks
+  (LOCK TABLES, GET_LOCK() and the like) and killed connections are never
+  deferred, since they end transactions and release locks. This is
+  decided from the state of the connection only, the command is not
+  looked at: a KILL from a connection of the user waits for a slot like
+  any other statement.
+*/
+
+static mysql_mutex_t LOCK_tp_users;
+static HASH tp_users;
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_key key_LOCK_tp_users;
+static PSI_mutex_info tp_user_mutexes[]=
+{
+  { &key_LOCK_tp_users, "LOCK_tp_users", PSI_FLAG_GLOBAL}
+};
+#endif
+
+
+static uchar *tp_user_get_key(const uchar *entry, size_t *length,
+                              my_bool not_used __attribute__((unused)))
+{
+  TP_user *user= (TP_user *) entry;
+  *length= user->name_length;
+  return (uchar *) user->name;
+}
+
+
+static void tp_user_free(void *entry)
+{
+  my_free(entry);
+}
+
+
+static void tp_users_init()
+{
+#ifdef HAVE_PSI_INTERFACE
+  mysql_mutex_register("threadpool", tp_user_mutexes,
+                       array_elements(tp_user_mutexes));
+#endif
+  mysql_mutex_init(key_LOCK_tp_users, &LOCK_tp_users, MY_MUTEX_INIT_FAST);
+  my_hash_init(&tp_users, &my_charset_bin, 32, 0, 0, tp_user_get_key,
+               tp_user_free, 0);
+}
+
+
+static void tp_users_end()
+{
+  if (!my_hash_inited(&tp_users))
+    return;
+  my_hash_free(&tp_users);
+  mysql_mutex_destroy(&LOCK_tp_users);
+}
+
+
+static const char *tp_user_name(THD *thd, size_t *length)
+{
+  const char *name= thd->main_security_ctx.user;
+  if (!name)
+    name= "";
+  *length= strnlen(name, USERNAME_LENGTH);
+  return name;
+}
+
+
+/* Find or create the entry of the connection's user */
+
+static void tp_user_attach(TP_connection *c)
+{
+  size_t length;
+  const char *name= tp_user_name(c->thd, &length);
+  TP_user *user;
+
+  mysql_mutex_lock(&LOCK_tp_users);
+  user= (TP_user *) my_hash_search(&tp_users, (const uchar *) name, length);
+  if (!user &&
+      (user= (TP_user *) my_malloc(sizeof(TP_user), MYF(MY_WME | MY_ZEROFILL))))
+  {
+    memcpy(user->name, name, length);
+    user->name_length= (uint) length;
+    user->deferred_last= &user->deferred;
+    if (my_hash_insert(&tp_users, (uchar *) user))
+    {
+      tp_user_free(user);
+      user= NULL;
+    }
+  }
+  if (user)
+    user->connections++;
+  mysql_mutex_unlock(&LOCK_tp_users);
+  c->user= user;
+}
+
+
+static void tp_user_detach(TP_connection *c)
+{
+  if (!c->user)
+    return;
+  DBUG_ASSERT(!c->user_slot);
+  mysql_mutex_lock(&LOCK_tp_users);
+  c->user->connections--;
+  mysql_mutex_unlock(&LOCK_tp_users);
+  c->user= NULL;
+}
+
+
+/* Move the connection to another entry after COM_CHANGE_USER */
+
+static void tp_user_check(TP_connection *c)
+{
+  size_t length;
+  const char *name= tp_user_name(c->thd, &length);
+  if (c->user && (c->user->name_length != length ||
+                  memcmp(c->user->name, name, length)))
+  {
+    tp_user_detach(c);
+    tp_user_attach(c);
+  }
+}
+
+
+static bool tp_user_try_admit(TP_user *user)
+{
+  int32 running= my_atomic_load32(&user->running);
+  for (;;)
+  {
+    uint limit= threadpool_max_user_statements;
+    if (limit && running >= (int32) limit)
+      return false;
+    if (my_atomic_cas32(&user->running, &running, running + 1))
+      return true;
+  }
+}
+
+
+/*
+  Whether a connection takes a statement slot even if the user has none
+  free: a killed connection, so that it ends, and a connection that holds
+  locks, which the running statements of the user might be waiting for.
+  Only the state of the idle connection is looked at, so this is cheap
+  enough for the pool to call under its group mutex.
+*/
+
+static bool tp_user_is_exempt(THD *thd)
+{
+  return thd->killed ||
+         (thd->server_status & SERVER_STATUS_IN_TRANS) ||
+         thd->mdl_context.has_locks();
+}
+
+
+/*
+  Take a statement slot for the next request of a queued connection.
+
+  Called by the generic pool when it removes the connection from a
+  workqueue. Returns false if the user has no free slot; the connection
+  is then on the deferred list of the user and must not be executed,
+  until tp_user_release() hands it back to TP_pool::resume().
+*/
+
+bool tp_user_admit(TP_connection *c)
+{
+  THD *thd= c->thd;
+  TP_user *user= c->user;
+
+  if (!user || c->user_slot)
+    return true;
+  if (tp_user_try_admit(user))
+  {
+    c->user_slot= true;
+    return true;
+  }
+  if (tp_user_is_exempt(thd))
+  {
+    my_atomic_add32(&user->running, 1);
+    c->user_slot= true;
+    return true;
+  }
+
+  /*
+    Count the connection as waiting before trying again, so that
+    tp_user_release() either returns a slot that we see here, or finds
+    the connection deferred.
+  */
+  mysql_mutex_lock(&LOCK_tp_users);
+  my_atomic_add32(&user->waiting, 1);
+  if (!tp_user_try_admit(user))
+  {
+    if (!thd->killed)
+    {
+      c->next_deferred= NULL;
+      c->deferred_time= microsecond_interval_timer();
+      *user->deferred_last= c;
+      user->deferred_last= &c->next_deferred;
+      c->deferred= true;
+      mysql_mutex_unlock(&LOCK_tp_users);
+      return false;
+    }
+    my_atomic_add32(&user->running, 1);
+  }
+  my_atomic_add32(&user->waiting, -1);
+  mysql_mutex_unlock(&LOCK_tp_users);
+  c->user_slot= true;
+  return true;
+}
+
+
+/* Remove a connection from the deferred list, under LOCK_tp_users */
+
+static void tp_user_undefer(TP_user *user, TP_connection *c)
+{
+  TP_connection **prev;
+
+  mysql_mutex_assert_owner(&LOCK_tp_users);
+  for (prev= &user->deferred; *prev != c; prev= &(*prev)->next_deferred)
+    DBUG_ASSERT(*prev);
+  if (!(*prev= c->next_deferred))
+    user->deferred_last= prev;
+  c->deferred= false;
+  my_atomic_add32(&user->waiting, -1);
+  user->admission_waits++;
+  user->admission_time+= microsecond_interval_timer() - c->deferred_time;
+}
+
+
+/*
+  Return a statement slot, and resume the first deferred connection of
+  the user, which then takes the slot when it is dequeued again. Slots
+  taken over the limit, by exempt connections or in thd_wait_end(), do
+  not resume anybody.
+*/
+
+static void tp_user_release(TP_user *user)
+{
+  TP_connection *c= NULL;
+  int32 running= my_atomic_add32(&user->running, -1) - 1;
+  uint limit= threadpool_max_user_statements;
+
+  if (!my_atomic_load32(&user->waiting) ||
+      (limit && running >= (int32) limit))
+    return;
+
+  mysql_mutex_lock(&LOCK_tp_users);
+  if ((c= user->deferred))
+    tp_user_undefer(user, c);
+  mysql_mutex_unlock(&LOCK_tp_users);
+  if (c)
+    pool->resume(c);
+}
+
+
+/* Resume a deferred connection that was killed */
+
+static void tp_user_resume_killed(TP_connection *c)
+{
+  TP_user *user= c->user;
+  bool resume;
+
+  if (!user)
+    return;
+  mysql_mutex_lock(&LOCK_tp_users);
+  if ((resume= c->deferred))
+    tp_user_undefer(user, c);
+  mysql_mutex_unlock(&LOCK_tp_users);
+  if (resume)
+    pool->resume(c);
+}
+
+
+static void tp_user_begin_statement(TP_connection *c)
+{
+  if (!c->user)
+    return;
+  /* The Windows pool does not defer connections, just count them */
+  if (!c->user_slot)
+  {
+    my_atomic_add32(&c->user->running, 1);
+    c->user_slot= true;
+  }
+  my_atomic_add64(&c->user->statements, 1);
+}
+
+
+static void tp_user_end_statement(TP_connection *c)
+{
+  if (c->user_slot)
+  {
+    c->user_slot= false;
+    tp_user_release(c->user);
+  }
+}
+
+
+/* Let deferred connections recheck thread_pool_max_user_statements */
+
+void tp_user_wake_waiters()
+{
+  TP_connection *resumed= NULL, **last= &resumed, *c;
+
+  if (!my_hash_inited(&tp_users))
+    return;
+  mysql_mutex_lock(&LOCK_tp_users);
+  for (ulong i= 0; i < tp_users.records; i++)
+  {
+    TP_user *user= (TP_user *) my_hash_element(&tp_users, i);
+    while ((c= user->deferred))
+    {
+      tp_user_undefer(user, c);
+      *last= c;
+      last= &c->next_deferred;
+    }
+  }
+  *last= NULL;
+  mysql_mutex_unlock(&LOCK_tp_users);
+
+  while ((c= resumed))
+  {
+    resumed= c->next_deferred;
+    pool->resume(c);
+  }
+}
+
+
+/*
+  Call func for every user known to the pool, under LOCK_tp_users.
+  Stops at the first nonzero return value, and returns it.
+*/
+
+int tp_for_each_user(tp_user_callback func, void *arg)
+{
+  int res= 0;
+  if (!my_hash_inited(&tp_users))
+    return 0;
+  mysql_mutex_lock(&LOCK_tp_users);
+  for (ulong i= 0; !res && i < tp_users.records; i++)
+    res= func((TP_user *) my_hash_element(&tp_users, i), arg);
+  mysql_mutex_unlock(&LOCK_tp_users);
+  return res;
+}
+
+
 static bool tp_init()
 {
+  tp_users_init();
 
 #ifdef _WIN32
   if (threadpool_mode == TP_MODE_WINDOWS)
@@ -466,7 +846,8 @@ void tp_set_threadpool_stall_limit(uint val)
 
 void tp_timeout_handler(TP_connection *c)
 {
-  if (c->state != TP_STATE_IDLE)
+  /* A deferred connection has a command to execute, it is not idle */
+  if (c->state != TP_STATE_IDLE || c->deferred)
     return;
   THD *thd=c->thd;
   mysql_mutex_lock(&thd->LOCK_thd_kill);
@@ -477,11 +858,40 @@ void tp_timeout_handler(TP_connection *c)
 }
 
 
+/*
+  Whether a statement gives its slot back while it waits: only for lock
+  waits, as the statement it waits for may be one of the same user that
+  is not admitted yet. Statements that wait for IO keep their slot, so
+  that thread_pool_max_user_statements also limits IO bound users.
+*/
+
+static bool tp_wait_releases_slot(int type)
+{
+  switch (type) {
+  case THD_WAIT_ROW_LOCK:
+  case THD_WAIT_META_DATA_LOCK:
+  case THD_WAIT_TABLE_LOCK:
+    return true;
+  default:
+    return false;
+  }
+}
+
+
 static void tp_wait_begin(THD *thd, int type)
 {
   TP_connection *c = get_TP_connection(thd);
   if (c)
+  {
     c->wait_begin(type);
+    /* Let other statements of the user run while this one waits */
+    if (c->user_slot && tp_wait_releases_slot(type))
+    {
+      c->user_slot= false;
+      c->user_slot_in_wait= true;
+      tp_user_release(c->user);
+    }
+  }
 }
 
 
@@ -489,13 +899,22 @@ static void tp_wait_end(THD *thd)
 {
   TP_connection *c = get_TP_connection(thd);
   if (c)
+  {
+    if (c->user_slot_in_wait)
+    {
+      my_atomic_add32(&c->user->running, 1);
+      c->user_slot_in_wait= false;
+      c->user_slot= true;
+    }
     c->wait_end();
+  }
 }
 
 
 static void tp_end()
 {
   delete pool;
+  tp_users_end();
 }
 
 static void tp_post_kill_notification(THD *thd)
@@ -504,6 +923,8 @@ static void tp_post_kill_notification(THD *thd)
   if (c)
     c->priority= TP_PRIORITY_HIGH;
   post_kill_notification(thd);
+  if (c)
+    tp_user_resume_killed(c);
 }
 
 static scheduler_functions tp_scheduler_functions=
@@ -156,6 +156,8 @@ struct TP_connection_generic:public TP_connection
   TP_connection_generic **prev_in_queue;
   ulonglong abs_wait_timeout;
   ulonglong dequeue_time;
+  /* Precise time the connection was queued, for the queue wait statistics */
+  ulonglong enqueue_time;
   TP_file_handle fd;
   bool bound_to_poll_descriptor;
   int waiting;
@@ -230,6 +232,9 @@ static int  create_worker(thread_group_t *thread_group);
 static void *worker_main(void *param);
 static void check_stall(thread_group_t *thread_group);
 static void set_next_timeout_check(ulonglong abstime);
+#ifndef HAVE_IOCP
+static int  wake_thief(thread_group_t *thread_group);
+#endif
 static void print_pool_blocked_message(bool);
 
 /**
@@ -526,7 +531,71 @@ static void* native_event_get_userdata(native_event *event)
 #endif
 
 
-/* Dequeue element from a workqueue */
+/* Add the time a connection spent in the queue to the statistics */
+
+static void account_queue_wait(TP_connection_generic *c)
+{
+  ulonglong wait= microsecond_interval_timer() - c->enqueue_time;
+  ulonglong limit= 100;
+  int i;
+  for (i= 0; i < TP_QUEUE_WAIT_BUCKETS - 1 && wait >= limit; i++)
+    limit*= 10;
+  my_atomic_add64(&tp_stats.queue_wait[i], 1);
+  if (c->user)
+    my_atomic_add64(&c->user->queue_time, (int64) wait);
+}
+
+
+/*
+  How many connections at the head of a queue are considered when
+  picking the next one to execute.
+*/
+#define TP_FAIR_QUEUE_DEPTH 16
+
+/*
+  Remove the next connection to execute from a workqueue.
+
+  This is the head of the queue, unless one of the next connections
+  belongs to a user with fewer statements executing, which then goes
+  first, so that a user with many concurrent statements cannot crowd
+  out the others. The head is not passed over any more once it has
+  waited for thread_pool_prio_kickup_timer milliseconds.
+*/
+
+static TP_connection_generic *queue_pop_fair(connection_queue_t *queue)
+{
+  TP_connection_generic *c= queue->front();
+  if (!c || !c->user ||
+      pool_timer.current_microtime - c->dequeue_time >
+      1000ULL * threadpool_prio_kickup_timer)
+    return queue->pop_front();
+
+  TP_connection_generic *best= c;
+  int32 best_running= my_atomic_load32(&c->user->running);
+  I_P_List_iterator<TP_connection_generic, connection_queue_t> it(*queue);
+  it++;
+  for (int i= 1; best_running > 0 && i < TP_FAIR_QUEUE_DEPTH && (c= it++); i++)
+  {
+    if (!c->user)
+      continue;
+    int32 running= my_atomic_load32(&c->user->running);
+    if (running < best_running)
+    {
+      best= c;
+      best_running= running;
+    }
+  }
+  queue->remove(best);
+  return best;
+}
+
+
+/*
+  Dequeue element from a workqueue.
+
+  Connections whose user has no free statement slot are passed to the
+  deferred list of the user by tp_user_admit(), and are not returned.
+*/
 
 static TP_connection_generic *queue_get(thread_group_t *thread_group)
 {
@@ -535,9 +604,12 @@ static TP_connection_generic *queue_get(thread_group_t *thread_group)
   TP_connection_generic *c;
   for (int i=0; i < NQUEUES;i++)
   {
-    c= thread_group->queues[i].pop_front();
-    if (c)
-      DBUG_RETURN(c);
+    while ((c= queue_pop_fair(&thread_group->queues[i])))
+    {
+      account_queue_wait(c);
+      if (tp_user_admit(c))
+        DBUG_RETURN(c);
+    }
   }
   DBUG_RETURN(0);  
 }
@@ -564,10 +636,12 @@ static void queue_init(thread_group_t *thread_group)
 static void queue_put(thread_group_t *thread_group, native_event *ev, int cnt)
 {
   ulonglong now= pool_timer.current_microtime;
+  ulonglong enqueue_time= microsecond_interval_timer();
   for(int i=0; i < cnt; i++)
   {
     TP_connection_generic *c = (TP_connection_generic *)native_event_get_userdata(&ev[i]);
     c->dequeue_time= now;
+    c->enqueue_time= enqueue_time;
     thread_group->queues[c->priority].push_back(c);
   }
 }
@@ -749,6 +823,18 @@ void check_stall(thread_group_t *thread_group)
   if (!is_queue_empty(thread_group) && !thread_group->queue_event_count)
   {
     thread_group->stalled= true;
+#ifndef HAVE_IOCP
+    /*
+      Rather than oversubscribing the group, let an idle thread of
+      another group take the queued work.
+    */
+    if (threadpool_work_stealing && !wake_thief(thread_group))
+    {
+      thread_group->queue_event_count= 0;
+      mysql_mutex_unlock(&thread_group->mutex);
+      return;
+    }
+#endif
     wake_or_create_thread(thread_group);
   }
   
@@ -869,10 +955,12 @@ static TP_connection_generic * listener(worker_thread_t *current_thread,
     queue_put(thread_group, ev, cnt);
     if (listener_picks_event)
     {
-      /* Handle the first event. */
+      /* Handle the first event, unless all of them were deferred. */
       retval= queue_get(thread_group);
       mysql_mutex_unlock(&thread_group->mutex);
-      break;
+      if (retval)
+        break;
+      continue;
     }
 
     if(thread_group->active_thread_count==0)
@@ -900,6 +988,16 @@ static TP_connection_generic * listener(worker_thread_t *current_thread,
         }
       }
     }
+#ifndef HAVE_IOCP
+    else if (threadpool_work_stealing)
+    {
+      /*
+        The active threads of the group are busy, let an idle thread of
+        another group take the queued work.
+      */
+      wake_thief(thread_group);
+    }
+#endif
     mysql_mutex_unlock(&thread_group->mutex);
   }
 
@@ -1177,6 +1275,7 @@ static void queue_put(thread_group_t *thread_group, TP_connection_generic *conne
   DBUG_ENTER("queue_put");
 
   connection->dequeue_time= pool_timer.current_microtime;
+  connection->enqueue_time= microsecond_interval_timer();
   thread_group->queues[connection->priority].push_back(connection);
 
   if (thread_group->active_thread_count == 0)
@@ -1198,6 +1297,98 @@ static bool too_many_threads(thread_group_t *thread_group)
 }
 
 
+#ifndef HAVE_IOCP
+/**
+  Take a connection with pending event from the queue of another group.
+
+  Groups are tried in order, starting after the current one, and are
+  skipped if their mutex is busy, so that two groups never wait for
+  each other.
+
+  The connection moves to the current group, so that wait_begin() and
+  wait_end() count the thread that executes it. It is no longer
+  associated with the poll descriptor of its group, and start_io()
+  returns it there after the request, like after a change of
+  thread_pool_size.
+
+  @param thread_group - group of the current thread, locked
+
+  @return connection with pending event, or NULL
+*/
+
+static TP_connection_generic *steal_event(thread_group_t *thread_group)
+{
+  DBUG_ENTER("steal_event");
+  uint count= group_count;
+  uint self= (uint) (thread_group - all_groups);
+
+  for (uint i= 1; i <= count; i++)
+  {
+    thread_group_t *group= &all_groups[(self + i) % count];
+    if (group == thread_group || is_queue_empty(group))
+      continue;
+    if (mysql_mutex_trylock(&group->mutex))
+      continue;
+
+    TP_connection_generic *c= NULL;
+    if (!group->shutdown)
+      c= queue_get(group);
+    if (c)
+    {
+      if (c->bound_to_poll_descriptor)
+      {
+        io_poll_disassociate_fd(group->pollfd, c->fd);
+        c->bound_to_poll_descriptor= false;
+      }
+      group->connection_count--;
+    }
+    mysql_mutex_unlock(&group->mutex);
+
+    if (c)
+    {
+      c->thread_group= thread_group;
+      thread_group->connection_count++;
+      my_atomic_add64(&tp_stats.steals, 1);
+      DBUG_RETURN(c);
+    }
+  }
+  DBUG_RETURN(NULL);
+}
+
+
+/**
+  Wake an idle thread of another group, which will take the queued work
+  of the given group.
+
+  @param thread_group - group with queued work, locked
+
+  @return 0 if a thread was woken
+*/
+
+static int wake_thief(thread_group_t *thread_group)
+{
+  DBUG_ENTER("wake_thief");
+  uint count= group_count;
+  uint self= (uint) (thread_group - all_groups);
+
+  for (uint i= 1; i <= count; i++)
+  {
+    thread_group_t *group= &all_groups[(self + i) % count];
+    if (group == thread_group || group->waiting_threads.is_empty())
+      continue;
+    if (mysql_mutex_trylock(&group->mutex))
+      continue;
+    int err= (group->shutdown || too_many_threads(group)) ?
+             1 : wake_thread(group);
+    mysql_mutex_unlock(&group->mutex);
+    if (!err)
+      DBUG_RETURN(0);
+  }
+  DBUG_RETURN(1);
+}
+#endif
+
+
 /**
   Retrieve a connection with pending event.
   
@@ -1271,11 +1462,22 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
       if (cnt > 0)
       {
         queue_put(thread_group, ev, cnt);
-        connection= queue_get(thread_group);
-        break;
+        if ((connection= queue_get(thread_group)))
+          break;
+        continue;
       }
     }
 
+#ifndef HAVE_IOCP
+    /* Take work queued in another group rather than sleep. */
+    if (!oversubscribed && threadpool_work_stealing)
+    {
+      connection= steal_event(thread_group);
+      if (connection)
+        break;
+    }
+#endif
+
 
     /* And now, finally sleep */ 
     current_thread->woken = false; /* wake() sets this to true */
@@ -1392,6 +1594,20 @@ void TP_pool_generic::add(TP_connection *c)
 
 
 
+/**
+  Queue a connection again, after tp_user_admit() deferred it.
+*/
+
+void TP_pool_generic::resume(TP_connection *c)
+{
+  TP_connection_generic *connection= (TP_connection_generic *) c;
+  thread_group_t *thread_group= connection->thread_group;
+  mysql_mutex_lock(&thread_group->mutex);
+  queue_put(thread_group, connection);
+  mysql_mutex_unlock(&thread_group->mutex);
+}
+
+
 /**
   MySQL scheduler callback: wait begin
 */
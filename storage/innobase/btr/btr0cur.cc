@@ -6350,6 +6350,196 @@ btr_estimate_n_rows_in_range(
 	return(ret);
 }
 
+/** Page numbers of one level of an index tree */
+typedef std::vector<ulint, ut_allocator<ulint> >	btr_page_nos_t;
+
+/** Read the node pointers of one level of an index tree.
+@param[in]	index		index tree
+@param[in]	level		level of the pages
+@param[in]	pages		pages of the level, from left to right
+@param[in]	n_keys		number of keys wanted from the level
+@param[in,out]	heap		memory heap for the keys
+@param[out]	keys		keys of the node pointers, ascending
+@param[out]	children	child pages of the node pointers, or NULL
+@return whether the level could be read */
+static
+bool
+btr_get_split_keys_on_level(
+	dict_index_t*		index,
+	ulint			level,
+	const btr_page_nos_t&	pages,
+	ulint			n_keys,
+	mem_heap_t*		heap,
+	btr_keys_t&		keys,
+	btr_page_nos_t*		children)
+{
+	const ulint		space = dict_index_get_space(index);
+	const page_size_t	page_size(dict_table_page_size(index->table));
+	const ulint		n_fields
+		= dict_index_get_n_unique_in_tree_nonleaf(index);
+	const bool		comp = dict_table_is_comp(index->table);
+	mem_heap_t*		offsets_heap = NULL;
+	ulint			offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*			offsets = offsets_;
+	const dtuple_t*		last = NULL;
+	bool			success = true;
+	mtr_t			mtr;
+
+	rec_offs_init(offsets_);
+
+	/* Prevent changes of the tree structure while the level is read */
+	mtr.start();
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	for (ulint i = 0; i < pages.size() && success; i++) {
+		buf_block_t*	block = btr_block_get(
+			page_id_t(space, pages[i]), page_size, RW_S_LATCH,
+			index, &mtr);
+
+		if (!block) {
+			success = false;
+			break;
+		}
+
+		const page_t*	page = buf_block_get_frame(block);
+
+		if (!fil_page_index_page_check(page)
+		    || btr_page_get_index_id(page) != index->id
+		    || btr_page_get_level(page, &mtr) != level) {
+			success = false;
+			break;
+		}
+
+		/* Take about n_keys / pages.size() evenly spaced node
+		pointers of each page */
+		const ulint	n_recs = page_get_n_recs(page);
+		const ulint	step = children
+			? 1
+			: std::max<ulint>(1, n_recs * pages.size() / n_keys);
+		ulint		n = 0;
+
+		for (const rec_t* rec = page_rec_get_next_const(
+			     page_get_infimum_rec(page));
+		     !page_rec_is_supremum(rec);
+		     rec = page_rec_get_next_const(rec), n++) {
+
+			if (n % step) {
+				continue;
+			}
+
+			offsets = rec_get_offsets(rec, index, offsets, false,
+						  ULINT_UNDEFINED,
+						  &offsets_heap);
+
+			if (children) {
+				children->push_back(
+					btr_node_ptr_get_child_page_no(
+						rec, offsets));
+			}
+
+			/* The leftmost node pointer of a level is less
+			than any key, whatever is stored in it */
+			if ((rec_get_info_bits(rec, comp)
+			     & REC_INFO_MIN_REC_FLAG)
+			    || (last && cmp_dtuple_rec(last, rec, offsets)
+				>= 0)) {
+				continue;
+			}
+
+			last = dict_index_build_data_tuple(
+				rec, index, false, n_fields, heap);
+			keys.push_back(last);
+		}
+	}
+
+	mtr.commit();
+
+	if (offsets_heap) {
+		mem_heap_free(offsets_heap);
+	}
+
+	return(success);
+}
+
+/** Get keys that split an index into ranges of about the same size.
+The keys are taken from the node pointers of the highest level of the
+tree that has enough of them, without reading any leaf pages.
+With n keys, range 0 holds the records less than keys[0], range i the
+records in [keys[i - 1], keys[i]) and range n the records not less
+than keys[n - 1].
+@param[in]	index		index tree
+@param[in]	n_ranges	number of ranges wanted
+@param[in,out]	heap		memory heap for the keys
+@param[out]	keys		between 0 and n_ranges - 1 ascending keys */
+void
+btr_get_split_keys(
+	dict_index_t*	index,
+	ulint		n_ranges,
+	mem_heap_t*	heap,
+	btr_keys_t&	keys)
+{
+	btr_page_nos_t	pages;
+	btr_keys_t	level_keys;
+	mtr_t		mtr;
+	ulint		level;
+
+	keys.clear();
+
+	if (n_ranges < 2 || dict_index_is_ibuf(index)
+	    || dict_index_is_spatial(index)) {
+		return;
+	}
+
+	mtr.start();
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	if (buf_block_t* root = btr_root_block_get(index, RW_S_LATCH,
+						   &mtr)) {
+		level = btr_page_get_level(buf_block_get_frame(root), &mtr);
+		pages.push_back(dict_index_get_page(index));
+	} else {
+		level = 0;
+	}
+
+	mtr.commit();
+
+	/* Descend until a level has enough node pointers. The tree may
+	change between the levels; then the keys of the level above are
+	used. */
+	for (; level > 0; level--) {
+		btr_page_nos_t	children;
+
+		level_keys.clear();
+
+		if (!btr_get_split_keys_on_level(
+			    index, level, pages, n_ranges - 1, heap,
+			    level_keys, level > 1 ? &children : NULL)) {
+			break;
+		}
+
+		keys.swap(level_keys);
+
+		if (keys.size() >= n_ranges - 1) {
+			break;
+		}
+
+		pages.swap(children);
+	}
+
+	if (keys.size() >= n_ranges) {
+		/* Keep n_ranges - 1 evenly spaced keys */
+		const ulint	n = keys.size();
+
+		level_keys.clear();
+
+		for (ulint i = 1; i < n_ranges; i++) {
+			level_keys.push_back(keys[i * n / n_ranges]);
+		}
+
+		keys.swap(level_keys);
+	}
+}
+
 /*******************************************************************//**
 Record the number of non_null key values in a given index for
 each n-column prefix of the index where 1 <= n <= dict_index_get_n_unique(index).
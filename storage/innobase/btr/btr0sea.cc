@@ -839,6 +839,48 @@ btr_search_check_guess(
 	return(success);
 }
 
+/** Account for a hash search on an index, and stop using the hash index
+for the index for BTR_SEARCH_SUSPEND_SEARCHES searches if fewer than
+BTR_SEARCH_MIN_HIT_PERCENT of the last BTR_SEARCH_HIT_WINDOW hash searches
+succeeded. The counters are not protected by any latch.
+@param[in,out]	info	search info of the index
+@param[in]	hit	whether the hash search succeeded */
+static
+void
+btr_search_info_account(btr_search_t* info, bool hit)
+{
+	ulint	n = ++info->n_hash_window;
+
+	if (hit) {
+		info->n_hash_hits++;
+		info->n_hash_window_hits++;
+	} else {
+		info->n_hash_misses++;
+	}
+
+	if (n < BTR_SEARCH_HIT_WINDOW) {
+		return;
+	}
+
+	ulint	hits = info->n_hash_window_hits;
+
+	info->n_hash_window = 0;
+	info->n_hash_window_hits = 0;
+
+	if (hits * 100 < n * BTR_SEARCH_MIN_HIT_PERCENT) {
+		/* Let btr_cur_search_to_nth_level() skip the hash index
+		and btr_search_info_update() skip the analysis, so that
+		the search latch will not be acquired for this index.
+		The hash index entries that exist for the index stay in
+		the hash table, and are maintained and dropped like any
+		others when their records or pages change. */
+		info->n_hash_potential = 0;
+		info->last_hash_succ = FALSE;
+		info->n_hash_suspend = BTR_SEARCH_SUSPEND_SEARCHES;
+		info->n_hash_suspended++;
+	}
+}
+
 static
 void
 btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
@@ -854,6 +896,8 @@ btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
 #endif /* UNIV_SEARCH_PERF_STAT */
 
 	info->last_hash_succ = FALSE;
+
+	btr_search_info_account(info, false);
 }
 
 /** Tries to guess the right search position based on the hash search info
@@ -1055,6 +1099,8 @@ btr_search_guess_on_hash(
 #endif
 	info->last_hash_succ = TRUE;
 
+	btr_search_info_account(info, true);
+
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
 #endif
@@ -1520,6 +1566,9 @@ btr_search_build_page_hash_index(
 		ha_insert_for_fold(table, folds[i], block, recs[i]);
 	}
 
+	index->search_info->n_pages_built++;
+	index->search_info->n_rows_built += n_cached;
+
 	MONITOR_INC(MONITOR_ADAPTIVE_HASH_PAGE_ADDED);
 	MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_ROW_ADDED, n_cached);
 exit_func:
@@ -366,6 +366,85 @@ volatile bool	buf_pool_resizing;
 /** true when withdrawing buffer pool pages might cause page relocation */
 volatile bool	buf_pool_withdrawing;
 
+/** Number of slots in buf_page_hash_readers */
+static const ulint	BUF_PAGE_HASH_READER_SLOTS = 256;
+
+/** Added to every slot of buf_page_hash_readers while buf_pool_resize()
+does not allow lock-free page_hash lookups */
+static const int32	BUF_PAGE_HASH_READERS_BLOCKED = -(1 << 30);
+
+/** The longest page_hash chain that buf_page_hash_get_optimistic()
+will walk before it gives up and acquires the page_hash latch */
+static const ulint	BUF_PAGE_HASH_OPTIMISTIC_MAX_CHAIN = 16;
+
+/** A counter of threads in buf_page_hash_get_optimistic(), in a cache line
+of its own */
+struct MY_ALIGNED(CPU_LEVEL1_DCACHE_LINESIZE) buf_page_hash_reader_slot_t {
+	/** number of threads in buf_page_hash_get_optimistic()
+	that chose this slot, plus BUF_PAGE_HASH_READERS_BLOCKED while
+	the lookups are blocked */
+	int32	n;
+};
+
+/** Registration of threads that are looking up pages without holding
+the page_hash latch. buf_pool_resize() waits for these lookups to finish
+before it frees any chunks or page_hash arrays. */
+static buf_page_hash_reader_slot_t
+	buf_page_hash_readers[BUF_PAGE_HASH_READER_SLOTS];
+
+/** @return the buf_page_hash_readers slot of the current thread */
+static inline
+buf_page_hash_reader_slot_t*
+buf_page_hash_reader_slot()
+{
+	ulint	id;
+
+	if (const st_my_thread_var* var = my_thread_var) {
+		/* Consecutive numbers: up to BUF_PAGE_HASH_READER_SLOTS
+		threads that were created one after another do not share
+		a slot. */
+		id = ulint(var->id);
+	} else {
+		/* Thread identifiers tend to be aligned addresses. */
+		id = ulint(os_thread_get_curr_id());
+		id ^= (id >> 12) ^ (id >> 20);
+	}
+
+	return(&buf_page_hash_readers[id % BUF_PAGE_HASH_READER_SLOTS]);
+}
+
+/** Prevent buf_page_hash_get_optimistic() from accessing the buffer pool,
+and wait for the ongoing lookups to finish. */
+static
+void
+buf_page_hash_block_readers()
+{
+	for (ulint i = 0; i < BUF_PAGE_HASH_READER_SLOTS; i++) {
+		my_atomic_add32(&buf_page_hash_readers[i].n,
+				BUF_PAGE_HASH_READERS_BLOCKED);
+	}
+
+	for (ulint i = 0; i < BUF_PAGE_HASH_READER_SLOTS; i++) {
+		/* Any thread that entered the slot after we blocked it
+		will leave without accessing the buffer pool. */
+		while (my_atomic_load32(&buf_page_hash_readers[i].n)
+		       != BUF_PAGE_HASH_READERS_BLOCKED) {
+			os_thread_yield();
+		}
+	}
+}
+
+/** Allow buf_page_hash_get_optimistic() to access the buffer pool again. */
+static
+void
+buf_page_hash_unblock_readers()
+{
+	for (ulint i = 0; i < BUF_PAGE_HASH_READER_SLOTS; i++) {
+		my_atomic_add32(&buf_page_hash_readers[i].n,
+				-BUF_PAGE_HASH_READERS_BLOCKED);
+	}
+}
+
 /** the clock is incremented every time a pointer to a page may become obsolete;
 if the withdrwa clock has not changed, the pointer is still valid in buffer
 pool. if changed, the pointer might not be in buffer pool any more. */
@@ -1172,6 +1251,64 @@ buf_page_is_corrupted(
 	return(false);
 }
 
+/** Check which of a number of consecutive uncompressed pages carry a
+valid CRC-32C checksum, checksumming several pages at a time. Use this to
+avoid buf_page_is_corrupted() on the pages that pass; the other pages
+may still be valid and must be checked with buf_page_is_corrupted().
+Every innodb_checksum_algorithm accepts CRC-32C, but the strict ones
+other than strict_crc32 warn about it, so no page passes with those.
+@param[in]	buf	UNIV_PAGE_SIZE bytes for each page
+@param[in]	n	number of pages
+@param[out]	valid	for each page, whether buf_page_is_corrupted()
+would certainly return false */
+void
+buf_page_is_crc32_valid_multi(
+	const byte*	buf,
+	ulint		n,
+	bool*		valid)
+{
+	switch (srv_checksum_algorithm) {
+	case SRV_CHECKSUM_ALGORITHM_STRICT_INNODB:
+	case SRV_CHECKSUM_ALGORITHM_STRICT_NONE:
+		/* buf_page_is_corrupted() would warn about CRC-32C. */
+		memset(valid, 0, n * sizeof *valid);
+		return;
+	default:
+		break;
+	}
+
+	const ulint	group = 16;
+	const byte*	pages[group];
+	uint32_t	crc32[group];
+
+	for (ulint i = 0; i < n; i += group) {
+		const ulint	m = n - i < group ? n - i : group;
+
+		for (ulint j = 0; j < m; j++) {
+			pages[j] = buf + (i + j) * UNIV_PAGE_SIZE;
+		}
+
+		buf_calc_page_crc32_multi(pages, m, crc32);
+
+		for (ulint j = 0; j < m; j++) {
+			const byte*	page = pages[j];
+			ut_ad(crc32[j] == buf_calc_page_crc32(page));
+			const ulint	field1 = mach_read_from_4(
+				page + FIL_PAGE_SPACE_OR_CHKSUM);
+			const ulint	field2 = mach_read_from_4(
+				page + UNIV_PAGE_SIZE
+				- FIL_PAGE_END_LSN_OLD_CHKSUM);
+
+			/* The same checks as in buf_page_is_corrupted() */
+			valid[i + j] = field1 == crc32[j] && field2 == crc32[j]
+				&& !memcmp(page + FIL_PAGE_LSN + 4,
+					   page + UNIV_PAGE_SIZE
+					   - FIL_PAGE_END_LSN_OLD_CHKSUM + 4,
+					   4);
+		}
+	}
+}
+
 #ifndef UNIV_INNOCHECKSUM
 /** Dump a page to stderr.
 @param[in]	read_buf	database page
@@ -2774,6 +2911,8 @@ buf_pool_resize()
 	/* Indicate critical path */
 	buf_pool_resizing = true;
 
+	buf_page_hash_block_readers();
+
 	/* Acquire all buf_pool_mutex/hash_lock */
 	for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
 		buf_pool_t*	buf_pool = buf_pool_from_array(i);
@@ -2996,6 +3135,8 @@ buf_pool_resize()
 
 	UT_DELETE(chunk_map_old);
 
+	buf_page_hash_unblock_readers();
+
 	buf_pool_resizing = false;
 
 	/* Normalize other components, if the new size is too different */
@@ -4061,12 +4202,27 @@ buf_block_is_uncompressed(
 	const buf_block_t*	block)		/*!< in: pointer to block,
 						not dereferenced */
 {
-	if ((((ulint) block) % sizeof *block) != 0) {
-		/* The pointer should be aligned. */
-		return(FALSE);
+	const buf_chunk_t*		chunk	= buf_pool->chunks;
+	const buf_chunk_t* const	echunk	= chunk + ut_min(
+		buf_pool->n_chunks, buf_pool->n_chunks_new);
+
+	while (chunk < echunk) {
+		if (block >= chunk->blocks
+		    && block < chunk->blocks + chunk->size) {
+			/* The pointer should point to an element of
+			chunk->blocks. The chunk memory is not aligned
+			to sizeof *block, so the address alone does
+			not tell. */
+			return((reinterpret_cast<const byte*>(block)
+				- reinterpret_cast<const byte*>(
+					chunk->blocks))
+			       % sizeof *block == 0);
+		}
+
+		chunk++;
 	}
 
-	return(buf_pointer_is_block_field_instance(buf_pool, (void*) block));
+	return(FALSE);
 }
 
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
@@ -4132,6 +4288,161 @@ buf_wait_for_read(
 	}
 }
 
+/** Buffer-fix a block if it contains the wanted page.
+
+If the block is already buffer-fixed, the buffer-fix count is incremented
+with a compare-and-swap from a nonzero value, and the page is validated
+afterwards, without block->mutex. A block is only evicted, relocated or
+assigned another page by a thread that holds block->mutex or the
+page_hash X-latch and has seen buf_fix_count == 0, and the count cannot
+go from 0 to 1 while such a thread holds them: the other buffer-fixes
+hold block->mutex or the page_hash S-latch. So while our buffer-fix is
+counted in a count that was nonzero, the page identifier and the state
+are stable, and if they do not match, the block holds another page.
+
+A block that is not buffer-fixed is validated and buffer-fixed while
+holding block->mutex. Hot pages, such as the roots of busy indexes, are
+almost always buffer-fixed by some thread, so their lookups rarely touch
+block->mutex.
+@param[in,out]	block	control block of a buffer pool chunk
+@param[in]	page_id	page identifier
+@return whether the block was buffer-fixed */
+static
+bool
+buf_block_fix_if_page(buf_block_t* block, const page_id_t& page_id)
+{
+#ifdef UNIV_DEBUG
+	if (page_id.space() != TRX_SYS_SPACE) {
+		DEBUG_SYNC_C("buf_block_fix_if_page");
+	}
+#endif /* UNIV_DEBUG */
+
+	int32*	fix_count = reinterpret_cast<int32*>(
+		&block->page.buf_fix_count);
+	int32	count = my_atomic_load32_explicit(
+		fix_count, MY_MEMORY_ORDER_RELAXED);
+
+	while (count > 0) {
+		if (!my_atomic_cas32(fix_count, &count, count + 1)) {
+			continue;
+		}
+
+		if (buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE
+		    && page_id.equals_to(block->page.id)) {
+			ut_ad(!block->page.in_zip_hash);
+#ifdef UNIV_DEBUG
+			if (page_id.space() != TRX_SYS_SPACE) {
+				DEBUG_SYNC_C("buf_block_fix_if_page_unlatched");
+			}
+#endif /* UNIV_DEBUG */
+			return(true);
+		}
+
+		buf_block_unfix(block);
+		return(false);
+	}
+
+	buf_page_mutex_enter(block);
+
+	bool	found = buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE
+		&& page_id.equals_to(block->page.id);
+
+	if (found) {
+		ut_ad(!block->page.in_zip_hash);
+		buf_block_fix(block);
+	}
+
+	buf_page_mutex_exit(block);
+
+	return(found);
+}
+
+/** Look up and buffer-fix a block without acquiring the page_hash latch.
+
+The page_hash chain is walked without any latch, dereferencing only
+the control blocks of the buffer pool chunks. Compressed-only page
+descriptors may be freed at any time, so the lookup gives up when it meets
+one, or a watch sentinel, or a chain that is longer than expected.
+The candidate block is validated and buffer-fixed by
+buf_block_fix_if_page(), with a compare-and-swap if it is buffer-fixed
+already, or else while holding block->mutex, which buf_LRU_free_page()
+and buf_page_realloc() hold while checking buf_page_can_relocate() and
+removing the block from page_hash, and which buf_page_init() holds while
+assigning the page identifier.
+
+The chain pointers are written with plain stores by holders of the
+page_hash X-latch. Each of them is read here exactly once, with an
+acquire load, so that the walk follows a single snapshot of every link
+and the reads of the block that it points to are not hoisted above the
+load of the pointer. Nothing that is read before the buffer-fix
+is trusted: a pointer may be stale, but then it still points to a
+control block of a chunk, which the registration in
+buf_page_hash_readers keeps allocated, and the page identifier is
+compared again after the buffer-fix, which keeps the block from being
+evicted.
+
+@param[in,out]	buf_pool	buffer pool instance
+@param[in]	page_id		page identifier
+@param[in]	guess		guessed block, or NULL
+@return the buffer-fixed block
+@retval NULL if the page must be looked up with the page_hash latch */
+static
+buf_block_t*
+buf_page_hash_get_optimistic(
+	buf_pool_t*		buf_pool,
+	const page_id_t&	page_id,
+	buf_block_t*		guess)
+{
+	buf_page_hash_reader_slot_t*	slot = buf_page_hash_reader_slot();
+
+	if (my_atomic_add32(&slot->n, 1) < 0) {
+		/* buf_pool_resize() is in progress. */
+		my_atomic_add32(&slot->n, -1);
+		return(NULL);
+	}
+
+	buf_block_t*	block = NULL;
+
+	if (guess != NULL && buf_block_is_uncompressed(buf_pool, guess)
+	    && buf_block_fix_if_page(guess, page_id)) {
+		block = guess;
+	} else {
+		hash_table_t*	page_hash = buf_pool->page_hash;
+		ulint		fold = page_id.fold();
+		hash_cell_t*	cell = hash_get_nth_cell(
+			page_hash, hash_calc_hash(fold, page_hash));
+		buf_page_t*	bpage = static_cast<buf_page_t*>(
+			my_atomic_loadptr_explicit(
+				&cell->node, MY_MEMORY_ORDER_ACQUIRE));
+
+		for (ulint n = BUF_PAGE_HASH_OPTIMISTIC_MAX_CHAIN;
+		     bpage != NULL && n--;
+		     bpage = static_cast<buf_page_t*>(
+			     my_atomic_loadptr_explicit(
+				     reinterpret_cast<void**>(&bpage->hash),
+				     MY_MEMORY_ORDER_ACQUIRE))) {
+
+			buf_block_t*	candidate
+				= reinterpret_cast<buf_block_t*>(bpage);
+
+			if (!buf_block_is_uncompressed(buf_pool, candidate)) {
+				break;
+			}
+
+			if (page_id.equals_to(bpage->id)) {
+				if (buf_block_fix_if_page(candidate, page_id)) {
+					block = candidate;
+				}
+				break;
+			}
+		}
+	}
+
+	my_atomic_add32(&slot->n, -1);
+
+	return(block);
+}
+
 /** This is the general function used to get access to a database page.
 @param[in]	page_id		page id
 @param[in]	rw_latch	RW_S_LATCH, RW_X_LATCH, RW_NO_LATCH
@@ -4204,6 +4515,13 @@ buf_page_get_gen(
 	buf_pool->stat.n_page_gets++;
 	hash_lock = buf_page_hash_lock_get(buf_pool, page_id);
 loop:
+	block = buf_page_hash_get_optimistic(buf_pool, page_id, guess);
+
+	if (block != NULL) {
+		fix_block = block;
+		goto got_block;
+	}
+
 	block = guess;
 
 	rw_lock_s_lock(hash_lock);
@@ -5033,7 +5351,7 @@ buf_page_get_known_nowait(
 
 /** Given a tablespace id and page number tries to get that page. If the
 page is not in the buffer pool it is not loaded and NULL is returned.
-Suitable for using when holding the lock_sys_t::mutex.
+Suitable for using when holding lock_sys->latch.
 @param[in]	page_id	page id
 @param[in]	file	file name
 @param[in]	line	line where called
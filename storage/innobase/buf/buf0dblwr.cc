@@ -38,11 +38,49 @@ Created 2011/12/19
 /** The doublewrite buffer */
 buf_dblwr_t*	buf_dblwr = NULL;
 
+/** The doublewrite files of the buffer pool instances */
+buf_dblwr_t*	buf_dblwr_files = NULL;
+
 /** Set to TRUE when the doublewrite buffer is being created */
 ibool	buf_dblwr_being_created = FALSE;
 
+/** The newest copies of the pages in the doublewrite files,
+for crash recovery */
+static mem_heap_t*	buf_dblwr_files_recv_heap;
+
+/** Number of pages that are read from a doublewrite file at a time */
+#define BUF_DBLWR_FILES_READ_PAGES 64
+
 #define TRX_SYS_DOUBLEWRITE_BLOCKS 2
 
+/** Number of pages of a doublewrite file that are reserved for single
+page flushes */
+#define BUF_DBLWR_FILE_SINGLE_PAGE_SLOTS 16
+
+/** Get the doublewrite buffer that a page is written through.
+@param[in]	bpage	page to be written
+@return the doublewrite file of the buffer pool instance, or buf_dblwr */
+static
+buf_dblwr_t*
+buf_dblwr_get_for(const buf_page_t* bpage)
+{
+	return(buf_dblwr_files
+	       ? &buf_dblwr_files[bpage->buf_pool_index]
+	       : buf_dblwr);
+}
+
+/** Generate the path of the doublewrite file of a buffer pool instance.
+@param[out]	path	the path, FN_REFLEN bytes
+@param[in]	i	buffer pool instance number */
+static
+void
+buf_dblwr_file_path(char* path, ulint i)
+{
+	snprintf(path, FN_REFLEN, "%s%cib_doublewrite_" ULINTPF,
+		 *srv_data_home ? srv_data_home : fil_path_to_mysql_datadir,
+		 OS_PATH_SEPARATOR, i);
+}
+
 /****************************************************************//**
 Determines if a page number is located inside the doublewrite buffer.
 @return TRUE if the location is inside the two blocks of the
@@ -112,6 +150,65 @@ buf_dblwr_sync_datafiles()
 	fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
 }
 
+/** Initialize the memory structure of a doublewrite buffer.
+@param[out]	dblwr		zero-initialized doublewrite buffer
+@param[in]	buf_size	number of pages
+@param[in]	batch_size	number of pages used in batch flushing */
+static
+void
+buf_dblwr_init_low(buf_dblwr_t* dblwr, ulint buf_size, ulint batch_size)
+{
+	/* There must be atleast one buffer for single page writes
+	and one buffer for batch writes. */
+	ut_a(batch_size > 0 && batch_size < buf_size);
+
+	mutex_create(LATCH_ID_BUF_DBLWR, &dblwr->mutex);
+
+	dblwr->b_event = os_event_create("dblwr_batch_event");
+	dblwr->s_event = os_event_create("dblwr_single_event");
+	dblwr->first_free = 0;
+	dblwr->s_reserved = 0;
+	dblwr->b_reserved = 0;
+	dblwr->size = buf_size;
+	dblwr->batch_size = batch_size;
+
+	dblwr->in_use = static_cast<bool*>(
+		ut_zalloc_nokey(buf_size * sizeof(bool)));
+
+	dblwr->write_buf_unaligned = static_cast<byte*>(
+		ut_malloc_nokey((1 + buf_size) * UNIV_PAGE_SIZE));
+
+	dblwr->write_buf = static_cast<byte*>(
+		ut_align(dblwr->write_buf_unaligned,
+			 UNIV_PAGE_SIZE));
+
+	dblwr->buf_block_arr = static_cast<buf_page_t**>(
+		ut_zalloc_nokey(buf_size * sizeof(void*)));
+}
+
+/** Free the memory structure of a doublewrite buffer.
+@param[in,out]	dblwr	doublewrite buffer */
+static
+void
+buf_dblwr_free_low(buf_dblwr_t* dblwr)
+{
+	ut_ad(dblwr->s_reserved == 0);
+	ut_ad(dblwr->b_reserved == 0);
+
+	os_event_destroy(dblwr->b_event);
+	os_event_destroy(dblwr->s_event);
+	ut_free(dblwr->write_buf_unaligned);
+	dblwr->write_buf_unaligned = NULL;
+
+	ut_free(dblwr->buf_block_arr);
+	dblwr->buf_block_arr = NULL;
+
+	ut_free(dblwr->in_use);
+	dblwr->in_use = NULL;
+
+	mutex_free(&dblwr->mutex);
+}
+
 /****************************************************************//**
 Creates or initialializes the doublewrite buffer at a database start. */
 static
@@ -121,45 +218,135 @@ buf_dblwr_init(
 	byte*	doublewrite)	/*!< in: pointer to the doublewrite buf
 				header on trx sys page */
 {
-	ulint	buf_size;
-
 	buf_dblwr = static_cast<buf_dblwr_t*>(
 		ut_zalloc_nokey(sizeof(buf_dblwr_t)));
 
 	/* There are two blocks of same size in the doublewrite
 	buffer. */
-	buf_size = TRX_SYS_DOUBLEWRITE_BLOCKS * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
-
-	/* There must be atleast one buffer for single page writes
-	and one buffer for batch writes. */
-	ut_a(srv_doublewrite_batch_size > 0
-	     && srv_doublewrite_batch_size < buf_size);
-
-	mutex_create(LATCH_ID_BUF_DBLWR, &buf_dblwr->mutex);
-
-	buf_dblwr->b_event = os_event_create("dblwr_batch_event");
-	buf_dblwr->s_event = os_event_create("dblwr_single_event");
-	buf_dblwr->first_free = 0;
-	buf_dblwr->s_reserved = 0;
-	buf_dblwr->b_reserved = 0;
+	buf_dblwr_init_low(
+		buf_dblwr,
+		TRX_SYS_DOUBLEWRITE_BLOCKS * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
+		srv_doublewrite_batch_size);
 
 	buf_dblwr->block1 = mach_read_from_4(
 		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK1);
 	buf_dblwr->block2 = mach_read_from_4(
 		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK2);
+}
 
-	buf_dblwr->in_use = static_cast<bool*>(
-		ut_zalloc_nokey(buf_size * sizeof(bool)));
+/** Free the doublewrite files of the buffer pool instances. */
+static
+void
+buf_dblwr_files_free()
+{
+	if (!buf_dblwr_files) {
+		return;
+	}
 
-	buf_dblwr->write_buf_unaligned = static_cast<byte*>(
-		ut_malloc_nokey((1 + buf_size) * UNIV_PAGE_SIZE));
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_dblwr_t*	dblwr = &buf_dblwr_files[i];
 
-	buf_dblwr->write_buf = static_cast<byte*>(
-		ut_align(buf_dblwr->write_buf_unaligned,
-			 UNIV_PAGE_SIZE));
+		if (!dblwr->path) {
+			continue;
+		}
 
-	buf_dblwr->buf_block_arr = static_cast<buf_page_t**>(
-		ut_zalloc_nokey(buf_size * sizeof(void*)));
+		buf_dblwr_free_low(dblwr);
+		os_file_close(dblwr->file);
+		ut_free(dblwr->path);
+	}
+
+	ut_free(buf_dblwr_files);
+	buf_dblwr_files = NULL;
+}
+
+/** Free the pages that were read from the doublewrite files. */
+static
+void
+buf_dblwr_files_recv_free()
+{
+	if (buf_dblwr_files_recv_heap) {
+		mem_heap_free(buf_dblwr_files_recv_heap);
+		buf_dblwr_files_recv_heap = NULL;
+	}
+}
+
+/** Create or open the doublewrite files of the buffer pool instances
+when innodb_doublewrite_per_instance is set, and remove doublewrite files
+that are no longer used. This must be called after crash recovery.
+@return whether the operation succeeded */
+bool
+buf_dblwr_files_create()
+{
+	ut_ad(!srv_read_only_mode);
+
+	/* Crash recovery is over; the copies of the pages that were
+	read from the files are no longer needed. */
+	buf_dblwr_files_recv_free();
+
+	if (buf_dblwr_files) {
+		return(true);
+	}
+
+	char	path[FN_REFLEN];
+	ulint	n = 0;
+
+	if (srv_use_doublewrite_buf && srv_dblwr_per_instance) {
+		n = srv_buf_pool_instances;
+
+		buf_dblwr_files = static_cast<buf_dblwr_t*>(
+			ut_zalloc_nokey(n * sizeof *buf_dblwr_files));
+
+		for (ulint i = 0; i < n; i++) {
+			buf_dblwr_t*	dblwr = &buf_dblwr_files[i];
+			bool		success;
+
+			buf_dblwr_file_path(path, i);
+
+			dblwr->file = os_file_create(
+				innodb_data_file_key, path,
+				OS_FILE_OVERWRITE, OS_FILE_NORMAL,
+				OS_DATA_FILE, false, &success);
+
+			if (success
+			    && !os_file_set_size(
+				    path, dblwr->file,
+				    os_offset_t(srv_dblwr_file_pages)
+				    * UNIV_PAGE_SIZE)) {
+				os_file_close(dblwr->file);
+				success = false;
+			}
+
+			if (!success) {
+				ib::error() << "Cannot create the doublewrite"
+					" file " << path;
+				buf_dblwr_files_free();
+				return(false);
+			}
+
+			dblwr->path = mem_strdup(path);
+
+			buf_dblwr_init_low(
+				dblwr, srv_dblwr_file_pages,
+				srv_dblwr_file_pages
+				- BUF_DBLWR_FILE_SINGLE_PAGE_SLOTS);
+		}
+
+		ib::info() << "Using " << n << " doublewrite files of "
+			<< srv_dblwr_file_pages << " pages";
+	}
+
+	/* Remove the files of buffer pool instances that no longer
+	exist, or of all instances if the files are not used. */
+	for (bool exist = true; exist; n++) {
+		buf_dblwr_file_path(path, n);
+
+		if (!os_file_delete_if_exists(
+			    innodb_data_file_key, path, &exist)) {
+			break;
+		}
+	}
+
+	return(true);
 }
 
 /** Create the doublewrite buffer if the doublewrite buffer header
@@ -181,7 +368,7 @@ buf_dblwr_create()
 
 	if (buf_dblwr) {
 		/* Already inited */
-		return(true);
+		return(buf_dblwr_files_create());
 	}
 
 start_again:
@@ -199,7 +386,7 @@ buf_dblwr_create()
 
 		mtr.commit();
 		buf_dblwr_being_created = FALSE;
-		return(true);
+		return(buf_dblwr_files_create());
 	} else {
 		fil_space_t* space = fil_space_acquire(TRX_SYS_SPACE);
 		const bool fail = UT_LIST_GET_FIRST(space->chain)->size
@@ -342,6 +529,133 @@ buf_dblwr_create()
 	goto start_again;
 }
 
+/** Allocate page frames for the doublewrite files in crash recovery.
+@param[in]	n	number of pages
+@return	page-aligned memory for n pages */
+static
+byte*
+buf_dblwr_files_recv_alloc(ulint n)
+{
+	if (!buf_dblwr_files_recv_heap) {
+		buf_dblwr_files_recv_heap = mem_heap_create(
+			(n + 1) * UNIV_PAGE_SIZE);
+	}
+
+	return(static_cast<byte*>(
+		       ut_align(mem_heap_alloc(buf_dblwr_files_recv_heap,
+					       (n + 1) * UNIV_PAGE_SIZE),
+				UNIV_PAGE_SIZE)));
+}
+
+/** Read the pages of the doublewrite files of the buffer pool instances
+for crash recovery. The files may contain many older copies of a page;
+only the copy with the highest FIL_PAGE_LSN is kept in memory. */
+static
+void
+buf_dblwr_files_load_pages()
+{
+	recv_dblwr_t&	recv_dblwr = recv_sys->dblwr;
+	const byte*	sys_buf = buf_dblwr->write_buf;
+	const byte*	sys_end = sys_buf + buf_dblwr->size * UNIV_PAGE_SIZE;
+	byte*		read_buf = NULL;
+	byte*		frame = NULL;
+	byte*		frame_end = NULL;
+	char		path[FN_REFLEN];
+
+	ut_ad(!buf_dblwr_files_recv_heap);
+
+	/* The number of buffer pool instances may have changed since
+	the files were written. Read all the files that exist. */
+	for (ulint i = 0;; i++) {
+		bool	success;
+
+		buf_dblwr_file_path(path, i);
+
+		if (os_file_get_size(path).m_total_size == os_offset_t(~0)) {
+			break;
+		}
+
+		pfs_os_file_t	file = os_file_create_simple_no_error_handling(
+			innodb_data_file_key, path, OS_FILE_OPEN,
+			OS_FILE_READ_ONLY, true, &success);
+
+		if (!success) {
+			ib::warn() << "Cannot open the doublewrite file "
+				<< path;
+			continue;
+		}
+
+		if (!read_buf) {
+			read_buf = buf_dblwr_files_recv_alloc(
+				BUF_DBLWR_FILES_READ_PAGES);
+		}
+
+		const os_offset_t	size = ut_2pow_round(
+			os_file_get_size(file), os_offset_t(UNIV_PAGE_SIZE));
+
+		for (os_offset_t offset = 0; offset < size; ) {
+			IORequest	read_request(IORequest::READ);
+			const ulint	len = ulint(std::min(
+				size - offset,
+				os_offset_t(BUF_DBLWR_FILES_READ_PAGES
+					    * UNIV_PAGE_SIZE)));
+
+			if (os_file_read(read_request, file, read_buf,
+					 offset, len) != DB_SUCCESS) {
+				ib::warn() << "Failed to read the doublewrite"
+					" file " << path;
+				break;
+			}
+
+			offset += len;
+
+			for (const byte* page = read_buf;
+			     page < read_buf + len; page += UNIV_PAGE_SIZE) {
+				if (!memcmp(field_ref_zero,
+					    page + FIL_PAGE_LSN, 8)) {
+					/* Each valid page header must
+					contain a nonzero FIL_PAGE_LSN
+					field. */
+					continue;
+				}
+
+				byte*	copy = const_cast<byte*>(
+					recv_dblwr.find_page(
+						page_get_space_id(page),
+						page_get_page_no(page)));
+
+				if (copy != NULL
+				    && mach_read_from_8(copy + FIL_PAGE_LSN)
+				    >= mach_read_from_8(page + FIL_PAGE_LSN)) {
+					continue;
+				}
+
+				if (copy != NULL
+				    && (copy < sys_buf || copy >= sys_end)) {
+					/* Replace an older copy that was
+					read from a doublewrite file. */
+					memcpy(copy, page, UNIV_PAGE_SIZE);
+					continue;
+				}
+
+				if (frame == frame_end) {
+					frame = buf_dblwr_files_recv_alloc(
+						BUF_DBLWR_FILES_READ_PAGES);
+					frame_end = frame
+						+ BUF_DBLWR_FILES_READ_PAGES
+						* UNIV_PAGE_SIZE;
+				}
+
+				memcpy(frame, page, UNIV_PAGE_SIZE);
+				recv_dblwr.add(frame);
+				frame += UNIV_PAGE_SIZE;
+			}
+		}
+
+		os_file_close(file);
+	}
+}
+
 /**
 At database startup initializes the doublewrite buffer memory structure if
 we already have a doublewrite buffer created in the data files. If we are
@@ -519,10 +833,123 @@ buf_dblwr_init_or_load_pages(
 
 	ut_free(unaligned_read_buf);
 
+	buf_dblwr_files_load_pages();
+
 	return(DB_SUCCESS);
 }
 
-/** Process and remove the double write buffer pages for all tablespaces. */
+/** Number of data file pages that buf_dblwr_process() reads before
+checksumming them together */
+static const ulint	BUF_DBLWR_RECOVER_BATCH = 16;
+
+/** Restore a page from its doublewrite copy if the page in the data
+file is corrupted.
+@param[in,out]	page		doublewrite copy of the page
+@param[in,out]	read_buf	the page as read from the data file
+@param[in]	space		tablespace
+@param[in]	page_id		page identifier */
+static
+void
+buf_dblwr_recover_page(
+	byte*		page,
+	byte*		read_buf,
+	fil_space_t*	space,
+	const page_id_t	page_id)
+{
+	const ulint		space_id = page_id.space();
+	const ulint		page_no = page_id.page_no();
+	const page_size_t	page_size(space->flags);
+
+	const bool is_all_zero = buf_page_is_zeroes(
+		read_buf, page_size);
+
+	if (is_all_zero) {
+		/* We will check if the copy in the
+		doublewrite buffer is valid. If not, we will
+		ignore this page (there should be redo log
+		records to initialize it). */
+	} else {
+		if (fil_page_is_compressed_encrypted(read_buf) ||
+		    fil_page_is_compressed(read_buf)) {
+			/* Decompress the page before
+			validating the checksum. */
+			fil_decompress_page(
+				NULL, read_buf, srv_page_size,
+				NULL, true);
+		}
+
+		if (fil_space_verify_crypt_checksum(
+			    read_buf, page_size, space_id, page_no)
+		   || !buf_page_is_corrupted(
+			   true, read_buf, page_size, space)) {
+			/* The page is good; there is no need
+			to consult the doublewrite buffer. */
+			return;
+		}
+
+		/* We intentionally skip this message for
+		is_all_zero pages. */
+		ib::info()
+			<< "Trying to recover page " << page_id
+			<< " from the doublewrite buffer.";
+	}
+
+	/* Next, validate the doublewrite page. */
+	if (fil_page_is_compressed_encrypted(page) ||
+	    fil_page_is_compressed(page)) {
+		/* Decompress the page before
+		validating the checksum. */
+		fil_decompress_page(
+			NULL, page, srv_page_size, NULL, true);
+	}
+
+	if (!fil_space_verify_crypt_checksum(page, page_size,
+					     space_id, page_no)
+	    && buf_page_is_corrupted(true, page, page_size, space)) {
+		if (!is_all_zero) {
+			ib::warn() << "A doublewrite copy of page "
+				<< page_id << " is corrupted.";
+		}
+		/* Theoretically we could have another good
+		copy for this page in the doublewrite
+		buffer. If not, we will report a fatal error
+		for a corrupted page somewhere else if that
+		page was truly needed. */
+		return;
+	}
+
+	if (page_no == 0) {
+		/* Check the FSP_SPACE_FLAGS. */
+		ulint flags = fsp_header_get_flags(page);
+		if (!fsp_flags_is_valid(flags, space_id)
+		    && fsp_flags_convert_from_101(flags)
+		    == ULINT_UNDEFINED) {
+			ib::warn() << "Ignoring a doublewrite copy"
+				" of page " << page_id
+				<< " due to invalid flags "
+				<< ib::hex(flags);
+			return;
+		}
+		/* The flags on the page should be converted later. */
+	}
+
+	/* Write the good page from the doublewrite buffer to
+	the intended position. */
+
+	IORequest	write_request(IORequest::WRITE);
+
+	fil_io(write_request, true, page_id, page_size,
+	       0, page_size.physical(),
+			const_cast<byte*>(page), NULL);
+
+	ib::info() << "Recovered page " << page_id
+		<< " from the doublewrite buffer.";
+}
+
+/** Process and remove the double write buffer pages for all tablespaces.
+The pages in the data files are read BUF_DBLWR_RECOVER_BATCH at a time,
+and most of them, which were not torn, are validated together by
+buf_page_is_crc32_valid_multi(). */
 void
 buf_dblwr_process()
 {
@@ -530,20 +957,55 @@ buf_dblwr_process()
 	byte*		read_buf;
 	byte*		unaligned_read_buf;
 	recv_dblwr_t&	recv_dblwr	= recv_sys->dblwr;
+	byte*		pages[BUF_DBLWR_RECOVER_BATCH];
+	fil_space_t*	spaces[BUF_DBLWR_RECOVER_BATCH];
+	bool		crc32_valid[BUF_DBLWR_RECOVER_BATCH];
+	ulint		n	= 0;
 
 	if (!buf_dblwr) {
 		return;
 	}
 
 	unaligned_read_buf = static_cast<byte*>(
-		ut_malloc_nokey(2 * UNIV_PAGE_SIZE));
+		ut_malloc_nokey((BUF_DBLWR_RECOVER_BATCH + 1)
+				* UNIV_PAGE_SIZE));
 
 	read_buf = static_cast<byte*>(
 		ut_align(unaligned_read_buf, UNIV_PAGE_SIZE));
 
 	for (recv_dblwr_t::list::iterator i = recv_dblwr.pages.begin();
-	     i != recv_dblwr.pages.end();
-	     ++i, ++page_no_dblwr) {
+	     ; ++i, ++page_no_dblwr) {
+		if (i == recv_dblwr.pages.end()
+		    || n == BUF_DBLWR_RECOVER_BATCH) {
+			/* Validate and recover the pages read so far. */
+			buf_page_is_crc32_valid_multi(read_buf, n,
+						      crc32_valid);
+
+			for (ulint j = 0; j < n; j++) {
+				const page_size_t	page_size(
+					spaces[j]->flags);
+
+				if (crc32_valid[j]
+				    && !page_size.is_compressed()) {
+					/* The page is good. */
+					continue;
+				}
+
+				buf_dblwr_recover_page(
+					pages[j],
+					read_buf + j * UNIV_PAGE_SIZE,
+					spaces[j],
+					page_id_t(page_get_space_id(pages[j]),
+						  page_get_page_no(pages[j])));
+			}
+
+			n = 0;
+
+			if (i == recv_dblwr.pages.end()) {
+				break;
+			}
+		}
+
 		byte*	page		= *i;
 		ulint	space_id	= page_get_space_id(page);
 		fil_space_t*	space = fil_space_get(space_id);
@@ -559,6 +1021,12 @@ buf_dblwr_process()
 		const ulint		page_no	= page_get_page_no(page);
 		const page_id_t		page_id(space_id, page_no);
 
+		if (recv_dblwr.find_page(space_id, page_no) != page) {
+			/* The doublewrite files may contain older copies
+			of the page. Only consider the most recent one. */
+			continue;
+		}
+
 		if (page_no >= space->size) {
 
 			/* Do not report the warning if the tablespace
@@ -577,9 +1045,13 @@ buf_dblwr_process()
 		const page_size_t	page_size(space->flags);
 		ut_ad(!buf_page_is_zeroes(page, page_size));
 
+		byte*	buf = read_buf + n * UNIV_PAGE_SIZE;
+
 		/* We want to ensure that for partial reads the
-		unread portion of the page is NUL. */
-		memset(read_buf, 0x0, page_size.physical());
+		unread portion of the page is NUL. The whole slot is
+		cleared, because buf_page_is_crc32_valid_multi()
+		checksums UNIV_PAGE_SIZE bytes of it. */
+		memset(buf, 0x0, UNIV_PAGE_SIZE);
 
 		IORequest	request;
 
@@ -589,7 +1061,7 @@ buf_dblwr_process()
 		dberr_t	err = fil_io(
 			request, true,
 			page_id, page_size,
-				0, page_size.physical(), read_buf, NULL);
+				0, page_size.physical(), buf, NULL);
 
 		if (err != DB_SUCCESS) {
 			ib::warn()
@@ -598,93 +1070,13 @@ buf_dblwr_process()
 				<< "error: " << ut_strerr(err);
 		}
 
-		const bool is_all_zero = buf_page_is_zeroes(
-			read_buf, page_size);
-
-		if (is_all_zero) {
-			/* We will check if the copy in the
-			doublewrite buffer is valid. If not, we will
-			ignore this page (there should be redo log
-			records to initialize it). */
-		} else {
-			if (fil_page_is_compressed_encrypted(read_buf) ||
-			    fil_page_is_compressed(read_buf)) {
-				/* Decompress the page before
-				validating the checksum. */
-				fil_decompress_page(
-					NULL, read_buf, srv_page_size,
-					NULL, true);
-			}
-
-			if (fil_space_verify_crypt_checksum(
-				    read_buf, page_size, space_id, page_no)
-			   || !buf_page_is_corrupted(
-				   true, read_buf, page_size, space)) {
-				/* The page is good; there is no need
-				to consult the doublewrite buffer. */
-				continue;
-			}
-
-			/* We intentionally skip this message for
-			is_all_zero pages. */
-			ib::info()
-				<< "Trying to recover page " << page_id
-				<< " from the doublewrite buffer.";
-		}
-
-		/* Next, validate the doublewrite page. */
-		if (fil_page_is_compressed_encrypted(page) ||
-		    fil_page_is_compressed(page)) {
-			/* Decompress the page before
-			validating the checksum. */
-			fil_decompress_page(
-				NULL, page, srv_page_size, NULL, true);
-		}
-
-		if (!fil_space_verify_crypt_checksum(page, page_size,
-						     space_id, page_no)
-		    && buf_page_is_corrupted(true, page, page_size, space)) {
-			if (!is_all_zero) {
-				ib::warn() << "A doublewrite copy of page "
-					<< page_id << " is corrupted.";
-			}
-			/* Theoretically we could have another good
-			copy for this page in the doublewrite
-			buffer. If not, we will report a fatal error
-			for a corrupted page somewhere else if that
-			page was truly needed. */
-			continue;
-		}
-
-		if (page_no == 0) {
-			/* Check the FSP_SPACE_FLAGS. */
-			ulint flags = fsp_header_get_flags(page);
-			if (!fsp_flags_is_valid(flags, space_id)
-			    && fsp_flags_convert_from_101(flags)
-			    == ULINT_UNDEFINED) {
-				ib::warn() << "Ignoring a doublewrite copy"
-					" of page " << page_id
-					<< " due to invalid flags "
-					<< ib::hex(flags);
-				continue;
-			}
-			/* The flags on the page should be converted later. */
-		}
-
-		/* Write the good page from the doublewrite buffer to
-		the intended position. */
-
-		IORequest	write_request(IORequest::WRITE);
-
-		fil_io(write_request, true, page_id, page_size,
-		       0, page_size.physical(),
-				const_cast<byte*>(page), NULL);
-
-		ib::info() << "Recovered page " << page_id
-			<< " from the doublewrite buffer.";
+		pages[n] = page;
+		spaces[n] = space;
+		n++;
 	}
 
-	recv_dblwr.pages.clear();
+	recv_dblwr.clear();
+	buf_dblwr_files_recv_free();
 
 	fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
 	ut_free(unaligned_read_buf);
@@ -697,21 +1089,11 @@ buf_dblwr_free()
 {
 	/* Free the double write data structures. */
 	ut_a(buf_dblwr != NULL);
-	ut_ad(buf_dblwr->s_reserved == 0);
-	ut_ad(buf_dblwr->b_reserved == 0);
 
-	os_event_destroy(buf_dblwr->b_event);
-	os_event_destroy(buf_dblwr->s_event);
-	ut_free(buf_dblwr->write_buf_unaligned);
-	buf_dblwr->write_buf_unaligned = NULL;
+	buf_dblwr_files_free();
+	buf_dblwr_files_recv_free();
 
-	ut_free(buf_dblwr->buf_block_arr);
-	buf_dblwr->buf_block_arr = NULL;
-
-	ut_free(buf_dblwr->in_use);
-	buf_dblwr->in_use = NULL;
-
-	mutex_free(&buf_dblwr->mutex);
+	buf_dblwr_free_low(buf_dblwr);
 	ut_free(buf_dblwr);
 	buf_dblwr = NULL;
 }
@@ -732,42 +1114,44 @@ buf_dblwr_update(
 
 	ut_ad(!srv_read_only_mode);
 
+	buf_dblwr_t*	dblwr = buf_dblwr_get_for(bpage);
+
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
-		mutex_enter(&buf_dblwr->mutex);
+		mutex_enter(&dblwr->mutex);
 
-		ut_ad(buf_dblwr->batch_running);
-		ut_ad(buf_dblwr->b_reserved > 0);
-		ut_ad(buf_dblwr->b_reserved <= buf_dblwr->first_free);
+		ut_ad(dblwr->batch_running);
+		ut_ad(dblwr->b_reserved > 0);
+		ut_ad(dblwr->b_reserved <= dblwr->first_free);
 
-		buf_dblwr->b_reserved--;
+		dblwr->b_reserved--;
 
-		if (buf_dblwr->b_reserved == 0) {
-			mutex_exit(&buf_dblwr->mutex);
+		if (dblwr->b_reserved == 0) {
+			mutex_exit(&dblwr->mutex);
 			/* This will finish the batch. Sync data files
 			to the disk. */
 			fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-			mutex_enter(&buf_dblwr->mutex);
+			mutex_enter(&dblwr->mutex);
 
 			/* We can now reuse the doublewrite memory buffer: */
-			buf_dblwr->first_free = 0;
-			buf_dblwr->batch_running = false;
-			os_event_set(buf_dblwr->b_event);
+			dblwr->first_free = 0;
+			dblwr->batch_running = false;
+			os_event_set(dblwr->b_event);
 		}
 
-		mutex_exit(&buf_dblwr->mutex);
+		mutex_exit(&dblwr->mutex);
 		break;
 	case BUF_FLUSH_SINGLE_PAGE:
 		{
-			const ulint size = TRX_SYS_DOUBLEWRITE_BLOCKS * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
+			const ulint size = dblwr->size;
 			ulint i;
-			mutex_enter(&buf_dblwr->mutex);
-			for (i = srv_doublewrite_batch_size; i < size; ++i) {
-				if (buf_dblwr->buf_block_arr[i] == bpage) {
-					buf_dblwr->s_reserved--;
-					buf_dblwr->buf_block_arr[i] = NULL;
-					buf_dblwr->in_use[i] = false;
+			mutex_enter(&dblwr->mutex);
+			for (i = dblwr->batch_size; i < size; ++i) {
+				if (dblwr->buf_block_arr[i] == bpage) {
+					dblwr->s_reserved--;
+					dblwr->buf_block_arr[i] = NULL;
+					dblwr->in_use[i] = false;
 					break;
 				}
 			}
@@ -776,8 +1160,8 @@ buf_dblwr_update(
 			reserved block. */
 			ut_a(i < size);
 		}
-		os_event_set(buf_dblwr->s_event);
-		mutex_exit(&buf_dblwr->mutex);
+		os_event_set(dblwr->s_event);
+		mutex_exit(&dblwr->mutex);
 		break;
 	case BUF_FLUSH_N_TYPES:
 		ut_error;
@@ -899,14 +1283,17 @@ void
 buf_dblwr_write_block_to_datafile(
 /*==============================*/
 	const buf_page_t*	bpage,	/*!< in: page to write */
-	bool			sync)	/*!< in: true if sync IO
+	bool			sync,	/*!< in: true if sync IO
 					is requested */
+	bool			batch)	/*!< in: true if the caller
+					wakes the i/o handler threads
+					after posting a batch of writes */
 {
 	ut_a(buf_page_in_file(bpage));
 
 	ulint	type = IORequest::WRITE;
 
-	if (sync) {
+	if (sync || batch) {
 		type |= IORequest::DO_NOT_WAKE;
 	}
 
@@ -946,32 +1333,28 @@ Flushes possible buffered writes from the doublewrite memory buffer to disk,
 and also wakes up the aio thread if simulated aio is used. It is very
 important to call this function after a batch of writes has been posted,
 and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+of threads can occur.
+@param[in,out]	dblwr	buf_dblwr or a doublewrite file */
+static
 void
-buf_dblwr_flush_buffered_writes()
+buf_dblwr_flush_low(buf_dblwr_t* dblwr)
 {
 	byte*		write_buf;
 	ulint		first_free;
 	ulint		len;
 
-	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
-		/* Sync the writes to the disk. */
-		buf_dblwr_sync_datafiles();
-		return;
-	}
-
 	ut_ad(!srv_read_only_mode);
 
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&dblwr->mutex);
 
 	/* Write first to doublewrite buffer blocks. We use synchronous
 	aio and thus know that file write has been completed when the
 	control returns. */
 
-	if (buf_dblwr->first_free == 0) {
+	if (dblwr->first_free == 0) {
 
-		mutex_exit(&buf_dblwr->mutex);
+		mutex_exit(&dblwr->mutex);
 
 		/* Wake possible simulated aio thread as there could be
 		system temporary tablespace pages active for flushing.
@@ -982,39 +1365,39 @@ buf_dblwr_flush_buffered_writes()
 		return;
 	}
 
-	if (buf_dblwr->batch_running) {
+	if (dblwr->batch_running) {
 		/* Another thread is running the batch right now. Wait
 		for it to finish. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		int64_t	sig_count = os_event_reset(dblwr->b_event);
+		mutex_exit(&dblwr->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(dblwr->b_event, sig_count);
 		goto try_again;
 	}
 
-	ut_a(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
+	ut_a(!dblwr->batch_running);
+	ut_ad(dblwr->first_free == dblwr->b_reserved);
 
 	/* Disallow anyone else to post to doublewrite buffer or to
 	start another batch of flushing. */
-	buf_dblwr->batch_running = true;
-	first_free = buf_dblwr->first_free;
+	dblwr->batch_running = true;
+	first_free = dblwr->first_free;
 
 	/* Now safe to release the mutex. Note that though no other
 	thread is allowed to post to the doublewrite batch flushing
 	but any threads working on single page flushes are allowed
 	to proceed. */
-	mutex_exit(&buf_dblwr->mutex);
+	mutex_exit(&dblwr->mutex);
 
-	write_buf = buf_dblwr->write_buf;
+	write_buf = dblwr->write_buf;
 
 	for (ulint len2 = 0, i = 0;
-	     i < buf_dblwr->first_free;
+	     i < dblwr->first_free;
 	     len2 += UNIV_PAGE_SIZE, i++) {
 
 		const buf_block_t*	block;
 
-		block = (buf_block_t*) buf_dblwr->buf_block_arr[i];
+		block = (buf_block_t*) dblwr->buf_block_arr[i];
 
 		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
 		    || block->page.zip.data) {
@@ -1032,57 +1415,75 @@ buf_dblwr_flush_buffered_writes()
 		buf_dblwr_check_page_lsn(write_buf + len2);
 	}
 
+	if (dblwr->path) {
+		/* Write out the batch to the doublewrite file and
+		flush it to disk */
+		IORequest	write_request(IORequest::WRITE);
+
+		if (os_file_write(write_request, dblwr->path, dblwr->file,
+				  write_buf, 0,
+				  dblwr->first_free * UNIV_PAGE_SIZE)
+		    != DB_SUCCESS
+		    || !os_file_flush(dblwr->file)) {
+			ib::fatal() << "Cannot write to the doublewrite file "
+				<< dblwr->path;
+		}
+
+		goto written;
+	}
+
 	/* Write out the first block of the doublewrite buffer */
 	len = ut_min(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
-		     buf_dblwr->first_free) * UNIV_PAGE_SIZE;
+		     dblwr->first_free) * UNIV_PAGE_SIZE;
 
 	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block1), univ_page_size,
+	       page_id_t(TRX_SYS_SPACE, dblwr->block1), univ_page_size,
 	       0, len, (void*) write_buf, NULL);
 
-	if (buf_dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+	if (dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
 		/* No unwritten pages in the second block. */
 		goto flush;
 	}
 
 	/* Write out the second block of the doublewrite buffer. */
-	len = (buf_dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
+	len = (dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
 	       * UNIV_PAGE_SIZE;
 
-	write_buf = buf_dblwr->write_buf
+	write_buf = dblwr->write_buf
 		    + TRX_SYS_DOUBLEWRITE_BLOCK_SIZE * UNIV_PAGE_SIZE;
 
 	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block2), univ_page_size,
+	       page_id_t(TRX_SYS_SPACE, dblwr->block2), univ_page_size,
 	       0, len, (void*) write_buf, NULL);
 
 flush:
-	/* increment the doublewrite flushed pages counter */
-	srv_stats.dblwr_pages_written.add(buf_dblwr->first_free);
-	srv_stats.dblwr_writes.inc();
-
 	/* Now flush the doublewrite buffer data to disk */
 	fil_flush(TRX_SYS_SPACE);
 
+written:
+	/* increment the doublewrite flushed pages counter */
+	srv_stats.dblwr_pages_written.add(dblwr->first_free);
+	srv_stats.dblwr_writes.inc();
+
 	/* We know that the writes have been flushed to disk now
 	and in recovery we will find them in the doublewrite buffer
 	blocks. Next do the writes to the intended positions. */
 
-	/* Up to this point first_free and buf_dblwr->first_free are
-	same because we have set the buf_dblwr->batch_running flag
+	/* Up to this point first_free and dblwr->first_free are
+	same because we have set the dblwr->batch_running flag
 	disallowing any other thread to post any request but we
-	can't safely access buf_dblwr->first_free in the loop below.
+	can't safely access dblwr->first_free in the loop below.
 	This is so because it is possible that after we are done with
 	the last iteration and before we terminate the loop, the batch
 	gets finished in the IO helper thread and another thread posts
-	a new batch setting buf_dblwr->first_free to a higher value.
-	If this happens and we are using buf_dblwr->first_free in the
+	a new batch setting dblwr->first_free to a higher value.
+	If this happens and we are using dblwr->first_free in the
 	loop termination condition then we'll end up dispatching
 	the same block twice from two different threads. */
-	ut_ad(first_free == buf_dblwr->first_free);
+	ut_ad(first_free == dblwr->first_free);
 	for (ulint i = 0; i < first_free; i++) {
 		buf_dblwr_write_block_to_datafile(
-			buf_dblwr->buf_block_arr[i], false);
+			dblwr->buf_block_arr[i], false, true);
 	}
 
 	/* Wake possible simulated aio thread to actually post the
@@ -1092,6 +1493,49 @@ buf_dblwr_flush_buffered_writes()
 	os_aio_simulated_wake_handler_threads();
 }
 
+/********************************************************************//**
+Flushes possible buffered writes from the doublewrite memory buffer to disk,
+and also wakes up the aio thread if simulated aio is used. It is very
+important to call this function after a batch of writes has been posted,
+and also when we may have to wait for a page latch! Otherwise a deadlock
+of threads can occur. */
+void
+buf_dblwr_flush_buffered_writes()
+{
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
+		/* Sync the writes to the disk. */
+		buf_dblwr_sync_datafiles();
+		return;
+	}
+
+	if (!buf_dblwr_files) {
+		buf_dblwr_flush_low(buf_dblwr);
+		return;
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_dblwr_flush_low(&buf_dblwr_files[i]);
+	}
+}
+
+/** Flush possible buffered writes of the doublewrite buffer that the
+pages of a buffer pool instance are written through.
+@see buf_dblwr_flush_buffered_writes()
+@param[in]	buf_pool	buffer pool instance */
+void
+buf_dblwr_flush_buffered_writes(const buf_pool_t* buf_pool)
+{
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
+		/* Sync the writes to the disk. */
+		buf_dblwr_sync_datafiles();
+		return;
+	}
+
+	buf_dblwr_flush_low(buf_dblwr_files
+			    ? &buf_dblwr_files[buf_pool->instance_no]
+			    : buf_dblwr);
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -1103,12 +1547,14 @@ buf_dblwr_add_to_batch(
 {
 	ut_a(buf_page_in_file(bpage));
 
+	buf_dblwr_t*	dblwr = buf_dblwr_get_for(bpage);
+
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&dblwr->mutex);
 
-	ut_a(buf_dblwr->first_free <= srv_doublewrite_batch_size);
+	ut_a(dblwr->first_free <= dblwr->batch_size);
 
-	if (buf_dblwr->batch_running) {
+	if (dblwr->batch_running) {
 
 		/* This not nearly as bad as it looks. There is only
 		page_cleaner thread which does background flushing
@@ -1116,23 +1562,23 @@ buf_dblwr_add_to_batch(
 		point. The only exception is when a user thread is
 		forced to do a flush batch because of a sync
 		checkpoint. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		int64_t	sig_count = os_event_reset(dblwr->b_event);
+		mutex_exit(&dblwr->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(dblwr->b_event, sig_count);
 		goto try_again;
 	}
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (dblwr->first_free == dblwr->batch_size) {
+		mutex_exit(&(dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_low(dblwr);
 
 		goto try_again;
 	}
 
-	byte*	p = buf_dblwr->write_buf
-		+ univ_page_size.physical() * buf_dblwr->first_free;
+	byte*	p = dblwr->write_buf
+		+ univ_page_size.physical() * dblwr->first_free;
 
 	/* We request frame here to get correct buffer in case of
 	encryption and/or page compression */
@@ -1155,24 +1601,24 @@ buf_dblwr_add_to_batch(
 		memcpy(p, frame, bpage->size.logical());
 	}
 
-	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
+	dblwr->buf_block_arr[dblwr->first_free] = bpage;
 
-	buf_dblwr->first_free++;
-	buf_dblwr->b_reserved++;
+	dblwr->first_free++;
+	dblwr->b_reserved++;
 
-	ut_ad(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-	ut_ad(buf_dblwr->b_reserved <= srv_doublewrite_batch_size);
+	ut_ad(!dblwr->batch_running);
+	ut_ad(dblwr->first_free == dblwr->b_reserved);
+	ut_ad(dblwr->b_reserved <= dblwr->batch_size);
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (dblwr->first_free == dblwr->batch_size) {
+		mutex_exit(&(dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_low(dblwr);
 
 		return;
 	}
 
-	mutex_exit(&(buf_dblwr->mutex));
+	mutex_exit(&(dblwr->mutex));
 }
 
 /********************************************************************//**
@@ -1198,12 +1644,13 @@ buf_dblwr_write_single_page(
 	ut_a(srv_use_doublewrite_buf);
 	ut_a(buf_dblwr != NULL);
 
+	buf_dblwr_t*	dblwr = buf_dblwr_get_for(bpage);
+
 	/* total number of slots available for single page flushes
-	starts from srv_doublewrite_batch_size to the end of the
-	buffer. */
-	size = TRX_SYS_DOUBLEWRITE_BLOCKS * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
-	ut_a(size > srv_doublewrite_batch_size);
-	n_slots = size - srv_doublewrite_batch_size;
+	starts from dblwr->batch_size to the end of the buffer. */
+	size = dblwr->size;
+	ut_a(size > dblwr->batch_size);
+	n_slots = size - dblwr->batch_size;
 
 	if (buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE) {
 
@@ -1220,51 +1667,41 @@ buf_dblwr_write_single_page(
 	}
 
 retry:
-	mutex_enter(&buf_dblwr->mutex);
-	if (buf_dblwr->s_reserved == n_slots) {
+	mutex_enter(&dblwr->mutex);
+	if (dblwr->s_reserved == n_slots) {
 
 		/* All slots are reserved. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->s_event);
-		mutex_exit(&buf_dblwr->mutex);
-		os_event_wait_low(buf_dblwr->s_event, sig_count);
+		int64_t	sig_count = os_event_reset(dblwr->s_event);
+		mutex_exit(&dblwr->mutex);
+		os_event_wait_low(dblwr->s_event, sig_count);
 
 		goto retry;
 	}
 
-	for (i = srv_doublewrite_batch_size; i < size; ++i) {
+	for (i = dblwr->batch_size; i < size; ++i) {
 
-		if (!buf_dblwr->in_use[i]) {
+		if (!dblwr->in_use[i]) {
 			break;
 		}
 	}
 
 	/* We are guaranteed to find a slot. */
 	ut_a(i < size);
-	buf_dblwr->in_use[i] = true;
-	buf_dblwr->s_reserved++;
-	buf_dblwr->buf_block_arr[i] = bpage;
+	dblwr->in_use[i] = true;
+	dblwr->s_reserved++;
+	dblwr->buf_block_arr[i] = bpage;
 
 	/* increment the doublewrite flushed pages counter */
 	srv_stats.dblwr_pages_written.inc();
 	srv_stats.dblwr_writes.inc();
 
-	mutex_exit(&buf_dblwr->mutex);
-
-	/* Lets see if we are going to write in the first or second
-	block of the doublewrite buffer. */
-	if (i < TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
-		offset = buf_dblwr->block1 + i;
-	} else {
-		offset = buf_dblwr->block2 + i
-			 - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
-	}
+	mutex_exit(&dblwr->mutex);
 
 	/* We deal with compressed and uncompressed pages a little
 	differently here. In case of uncompressed pages we can
 	directly write the block to the allocated slot in the
-	doublewrite buffer in the system tablespace and then after
-	syncing the system table space we can proceed to write the page
-	in the datafile.
+	doublewrite buffer and then after syncing the doublewrite
+	buffer we can proceed to write the page in the datafile.
 	In case of compressed page we first do a memcpy of the block
 	to the in-memory buffer of doublewrite before proceeding to
 	write it. This is so because we want to pad the remaining
@@ -1275,39 +1712,54 @@ buf_dblwr_write_single_page(
 	void * frame = buf_page_get_frame(bpage);
 
 	if (bpage->size.is_compressed()) {
-		memcpy(buf_dblwr->write_buf + univ_page_size.physical() * i,
+		memcpy(dblwr->write_buf + univ_page_size.physical() * i,
 		       frame, bpage->size.physical());
 
-		memset(buf_dblwr->write_buf + univ_page_size.physical() * i
+		memset(dblwr->write_buf + univ_page_size.physical() * i
 		       + bpage->size.physical(), 0x0,
 		       univ_page_size.physical() - bpage->size.physical());
 
-		fil_io(IORequestWrite,
-		       true,
-		       page_id_t(TRX_SYS_SPACE, offset),
-		       univ_page_size,
-		       0,
-		       univ_page_size.physical(),
-		       (void *)(buf_dblwr->write_buf + univ_page_size.physical() * i),
-		       NULL);
+		frame = dblwr->write_buf + univ_page_size.physical() * i;
+	}
+
+	if (dblwr->path) {
+		/* Write the page to its slot in the doublewrite file
+		and flush it to disk */
+		IORequest	write_request(IORequest::WRITE);
+
+		if (os_file_write(write_request, dblwr->path, dblwr->file,
+				  frame, i * univ_page_size.physical(),
+				  univ_page_size.physical())
+		    != DB_SUCCESS
+		    || !os_file_flush(dblwr->file)) {
+			ib::fatal() << "Cannot write to the doublewrite file "
+				<< dblwr->path;
+		}
 	} else {
-		/* It is a regular page. Write it directly to the
-		doublewrite buffer */
+		/* Lets see if we are going to write in the first or
+		second block of the doublewrite buffer. */
+		if (i < TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+			offset = dblwr->block1 + i;
+		} else {
+			offset = dblwr->block2 + i
+				 - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
+		}
+
 		fil_io(IORequestWrite,
 		       true,
 		       page_id_t(TRX_SYS_SPACE, offset),
 		       univ_page_size,
 		       0,
 		       univ_page_size.physical(),
-		       (void*) frame,
+		       frame,
 		       NULL);
-	}
 
-	/* Now flush the doublewrite buffer data to disk */
-	fil_flush(TRX_SYS_SPACE);
+		/* Now flush the doublewrite buffer data to disk */
+		fil_flush(TRX_SYS_SPACE);
+	}
 
 	/* We know that the write has been flushed to disk now
 	and during recovery we will find it in the doublewrite buffer
 	blocks. Next do the write to the intended position. */
-	buf_dblwr_write_block_to_datafile(bpage, sync);
+	buf_dblwr_write_block_to_datafile(bpage, sync, false);
 }
@@ -71,6 +71,61 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/* Each line of the dump file is "space,page,rank", where rank is the
+position of the page in the LRU list of its buffer pool instance at the
+time of the dump, 0 being the most recently used page. A missing rank,
+as in the files written by older versions, is read as 0. */
+
+/** A page of a buffer pool dump file */
+struct buf_load_page_t {
+	/** space id and page number */
+	buf_dump_t	id;
+	/** recency rank of the page in the dump */
+	ib_uint32_t	rank;
+
+	/** Order by recency, the most recently used pages first */
+	static bool by_rank(const buf_load_page_t& a, const buf_load_page_t& b)
+	{
+		return(a.rank < b.rank || (a.rank == b.rank && a.id < b.id));
+	}
+
+	/** Order by (space, page) */
+	static bool by_id(const buf_load_page_t& a, const buf_load_page_t& b)
+	{
+		return(a.id < b.id);
+	}
+};
+
+/** The pages of a buffer pool load are read in this many groups of
+decreasing recency. The reads of a group are submitted in (space, page)
+order, so that the seeks are short; only the simulated AIO handler
+threads merge the reads of adjacent pages. */
+static const ulint	BUF_LOAD_N_GROUPS = 8;
+
+/** Number of consecutive pages that a load thread claims at a time */
+static const ulint	BUF_LOAD_SLICE = 256;
+
+/** Minimum number of pending page reads that a load keeps */
+static const ulint	BUF_LOAD_MIN_PENDING = 8;
+
+/** State of a buffer pool load that is shared by the load threads */
+struct buf_load_t {
+	/** the pages to read, in the order of reading */
+	const buf_load_page_t*	pages;
+	/** number of elements in pages[] */
+	ulint			n_pages;
+	/** number of load threads */
+	ulint			n_threads;
+	/** index of the first page of the next slice to be claimed */
+	ulint			next;
+	/** the load waits before reading a slice if more page reads than
+	this are pending; it is halved while there is foreground activity
+	and doubled, up to max_pending, while there is none */
+	ulint			cur_pending;
+	/** upper bound of cur_pending */
+	ulint			max_pending;
+};
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -360,9 +415,9 @@ buf_dump(
 		buf_pool_mutex_exit(buf_pool);
 
 		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
-			ret = fprintf(f, ULINTPF "," ULINTPF "\n",
+			ret = fprintf(f, ULINTPF "," ULINTPF "," ULINTPF "\n",
 				      BUF_DUMP_SPACE(dump[j]),
-				      BUF_DUMP_PAGE(dump[j]));
+				      BUF_DUMP_PAGE(dump[j]), j);
 			if (ret < 0) {
 				ut_free(dump);
 				fclose(f);
@@ -418,20 +473,28 @@ buf_dump(
 /*****************************************************************//**
 Artificially delay the buffer pool loading if necessary. The idea of
 this function is to prevent hogging the server with IO and slowing down
-too much normal client queries. */
+too much normal client queries. Each load thread is allowed its share of
+srv_io_capacity. The number of page reads that the load keeps pending is
+adapted to the activity of the normal client queries, so that their page
+reads do not have to queue behind those of the load. */
 UNIV_INLINE
 void
 buf_load_throttle_if_needed(
 /*========================*/
+	buf_load_t*	load,		/*!< in/out: buffer pool load */
 	ulint*	last_check_time,	/*!< in/out: milliseconds since epoch
 					of the last time we did check if
 					throttling is needed, we do the check
 					every srv_io_capacity IO ops. */
 	ulint*	last_activity_count,
-	ulint	n_io)			/*!< in: number of IO ops done since
-					buffer pool load has started */
+	ulint	n_io)			/*!< in: number of IO ops done by
+					this thread since buffer pool load
+					has started */
 {
-	if (n_io % srv_io_capacity < srv_io_capacity - 1) {
+	const ulint	io_capacity = ut_max(
+		ulint(srv_io_capacity) / load->n_threads, ulint(1));
+
+	if (n_io % io_capacity < io_capacity - 1) {
 		return;
 	}
 
@@ -441,33 +504,39 @@ buf_load_throttle_if_needed(
 		return;
 	}
 
-	/* srv_io_capacity IO operations have been performed by buffer pool
-	load since the last time we were here. */
+	/* io_capacity IO operations have been performed by this thread
+	since the last time we were here. */
 
-	/* If no other activity, then keep going without any delay. */
+	/* If no other activity, then keep going without any delay, and
+	allow more pending reads. */
 	if (srv_get_activity_count() == *last_activity_count) {
+		load->cur_pending = ut_min(load->cur_pending * 2,
+					   load->max_pending);
 		return;
 	}
 
 	/* There has been other activity, throttle. */
 
+	load->cur_pending = ut_max(load->cur_pending / 2,
+				   BUF_LOAD_MIN_PENDING);
+
 	ulint	now = ut_time_ms();
 	ulint	elapsed_time = now - *last_check_time;
 
 	/* Notice that elapsed_time is not the time for the last
-	srv_io_capacity IO operations performed by BP load. It is the
+	io_capacity IO operations performed by BP load. It is the
 	time elapsed since the last time we detected that there has been
 	other activity. This has a small and acceptable deficiency, e.g.:
 	1. BP load runs and there is no other activity.
 	2. Other activity occurs, we run N IO operations after that and
-	   enter here (where 0 <= N < srv_io_capacity).
+	   enter here (where 0 <= N < io_capacity).
 	3. last_check_time is very old and we do not sleep at this time, but
 	   only update last_check_time and last_activity_count.
-	4. We run srv_io_capacity more IO operations and call this function
+	4. We run io_capacity more IO operations and call this function
 	   again.
 	5. There has been more other activity and thus we enter here.
 	6. Now last_check_time is recent and we sleep if necessary to prevent
-	   more than srv_io_capacity IO operations per second.
+	   more than io_capacity IO operations per second.
 	The deficiency is that we could have slept at 3., but for this we
 	would have to update last_check_time before the
 	"cur_activity_count == *last_activity_count" check and calling
@@ -481,6 +550,159 @@ buf_load_throttle_if_needed(
 	*last_activity_count = srv_get_activity_count();
 }
 
+/** Wait until there are at most load->cur_pending pending page reads.
+@param[in]	load	buffer pool load */
+static
+void
+buf_load_wait_for_pending_reads(const buf_load_t* load)
+{
+	while (buf_get_n_pending_read_ios() > load->cur_pending
+	       && !SHUTTING_DOWN() && !buf_load_abort_flag) {
+		os_aio_simulated_wake_handler_threads();
+		os_thread_sleep(1000);
+	}
+}
+
+/** Read the pages of a buffer pool load. The load threads claim slices
+of load->pages[] in order, so that the most recently used pages are read
+first, and the reads of a slice are submitted in (space, page) order.
+The reads are asynchronous; a thread waits before submitting one while
+more than load->cur_pending reads are pending.
+@param[in,out]	load	buffer pool load */
+static
+void
+buf_load_pages(buf_load_t* load)
+{
+	ulint		last_check_time = 0;
+	ulint		last_activity_cnt = 0;
+	ulint		n_io = 0;
+	ulint		cur_space_id = ULINT_UNDEFINED;
+	fil_space_t*	space = NULL;
+	page_size_t	page_size(0);
+
+	while (!SHUTTING_DOWN() && !buf_load_abort_flag) {
+		const ulint	first = ulint(my_atomic_addlint(
+					      &load->next, BUF_LOAD_SLICE));
+
+		if (first >= load->n_pages) {
+			break;
+		}
+
+		const ulint	end = ut_min(first + BUF_LOAD_SLICE,
+					     load->n_pages);
+
+		if (first > 0
+		    && DBUG_EVALUATE_IF("buf_load_first_slice_only",
+					true, false)) {
+			buf_load_abort_flag = TRUE;
+			break;
+		}
+
+		for (ulint i = first; i < end; i++) {
+			const buf_dump_t	id = load->pages[i].id;
+
+			/* space_id for this iteration of the loop */
+			const ulint	this_space_id = BUF_DUMP_SPACE(id);
+
+			/* Avoid calling the expensive
+			fil_space_acquire_silent() for each page within
+			the same tablespace. */
+			if (this_space_id != cur_space_id) {
+				if (space != NULL) {
+					fil_space_release(space);
+				}
+
+				cur_space_id = this_space_id;
+				space = fil_space_acquire_silent(cur_space_id);
+
+				if (space != NULL) {
+					const page_size_t	cur_page_size(
+						space->flags);
+					page_size.copy_from(cur_page_size);
+				}
+			}
+
+			/* JAN: TODO: As we use background page read below,
+			if tablespace is encrypted we cant use it. */
+			if (space == NULL ||
+			   (space && space->crypt_data &&
+			    space->crypt_data->encryption
+			    != FIL_ENCRYPTION_OFF &&
+			    space->crypt_data->type
+			    != CRYPT_SCHEME_UNENCRYPTED)) {
+				continue;
+			}
+
+			buf_load_wait_for_pending_reads(load);
+
+			buf_read_page_background(
+				page_id_t(this_space_id, BUF_DUMP_PAGE(id)),
+				page_size, false);
+
+			if (n_io % 64 == 63) {
+				os_aio_simulated_wake_handler_threads();
+			}
+
+			buf_load_throttle_if_needed(
+				load, &last_check_time, &last_activity_cnt,
+				n_io++);
+		}
+	}
+
+	if (space != NULL) {
+		fil_space_release(space);
+	}
+
+	os_aio_simulated_wake_handler_threads();
+}
+
+/** Thread that reads pages of a buffer pool load.
+@param[in,out]	arg	buffer pool load
+@return this function does not return, it calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(buf_load_thread)(void* arg)
+{
+	my_thread_init();
+
+	buf_load_pages(static_cast<buf_load_t*>(arg));
+
+	my_thread_end();
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Read a line of a buffer pool dump file. Empty lines are skipped.
+@param[in,out]	f		dump file
+@param[out]	space_id	tablespace id
+@param[out]	page_no		page number
+@param[out]	rank		recency rank, or 0 if the line has none
+@return whether a line was read; if not, check feof(f) and ferror(f) */
+static
+bool
+buf_load_read_line(FILE* f, ulint* space_id, ulint* page_no, ulint* rank)
+{
+	char	line[80];
+
+	while (fgets(line, sizeof line, f)) {
+		*rank = 0;
+
+		switch (sscanf(line, ULINTPF "," ULINTPF "," ULINTPF,
+			       space_id, page_no, rank)) {
+		case EOF:
+			continue;
+		case 2:
+		case 3:
+			return(true);
+		default:
+			return(false);
+		}
+	}
+
+	return(false);
+}
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -495,13 +717,13 @@ buf_load()
 	char		full_filename[OS_FILE_MAX_PATH];
 	char		now[32];
 	FILE*		f;
-	buf_dump_t*	dump;
+	buf_load_page_t*dump;
 	ulint		dump_n;
 	ulint		total_buffer_pools_pages;
 	ulint		i;
 	ulint		space_id;
 	ulint		page_no;
-	int		fscanf_ret;
+	ulint		rank;
 
 	/* Ignore any leftovers from before */
 	buf_load_abort_flag = FALSE;
@@ -524,13 +746,13 @@ buf_load()
 	This file is tiny (approx 500KB per 1GB buffer pool), reading it
 	two times is fine. */
 	dump_n = 0;
-	while (fscanf(f, ULINTPF "," ULINTPF, &space_id, &page_no) == 2
+	while (buf_load_read_line(f, &space_id, &page_no, &rank)
 	       && !SHUTTING_DOWN()) {
 		dump_n++;
 	}
 
 	if (!SHUTTING_DOWN() && !feof(f)) {
-		/* fscanf() returned != 2 */
+		/* the line could not be read or parsed */
 		const char*	what;
 		if (ferror(f)) {
 			what = "reading";
@@ -554,7 +776,7 @@ buf_load()
 	}
 
 	if(dump_n != 0) {
-		dump = static_cast<buf_dump_t*>(ut_malloc_nokey(
+		dump = static_cast<buf_load_page_t*>(ut_malloc_nokey(
 				dump_n * sizeof(*dump)));
 	} else {
 		fclose(f);
@@ -577,10 +799,7 @@ buf_load()
 	rewind(f);
 
 	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-		fscanf_ret = fscanf(f, ULINTPF "," ULINTPF,
-				    &space_id, &page_no);
-
-		if (fscanf_ret != 2) {
+		if (!buf_load_read_line(f, &space_id, &page_no, &rank)) {
 			if (feof(f)) {
 				break;
 			}
@@ -609,7 +828,8 @@ buf_load()
 			return;
 		}
 
-		dump[i] = BUF_DUMP_CREATE(space_id, page_no);
+		dump[i].id = BUF_DUMP_CREATE(space_id, page_no);
+		dump[i].rank = ib_uint32_t(ut_min(rank, ulint(ULINT32_MASK)));
 	}
 
 	/* Set dump_n to the actual number of initialized elements,
@@ -629,18 +849,31 @@ buf_load()
 	}
 
 	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
+		/* Read the most recently used pages first, in groups
+		that are sorted by (space, page). */
+		const ulint	group = (dump_n + BUF_LOAD_N_GROUPS - 1)
+			/ BUF_LOAD_N_GROUPS;
+
+		std::sort(dump, dump + dump_n, buf_load_page_t::by_rank);
+
+		for (i = 0; i < dump_n; i += group) {
+			std::sort(dump + i, dump + ut_min(i + group, dump_n),
+				  buf_load_page_t::by_id);
+		}
 	}
 
-	ulint		last_check_time = 0;
-	ulint		last_activity_cnt = 0;
+	buf_load_t	load;
 
-	/* Avoid calling the expensive fil_space_acquire_silent() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	ulint		cur_space_id = BUF_DUMP_SPACE(dump[0]);
-	fil_space_t*	space = fil_space_acquire_silent(cur_space_id);
-	page_size_t	page_size(space ? space->flags : 0);
+	load.pages = dump;
+	load.n_pages = dump_n;
+	load.n_threads = ut_min(ulint(srv_n_buf_load_threads),
+				(dump_n + BUF_LOAD_SLICE - 1)
+				/ BUF_LOAD_SLICE);
+	load.next = 0;
+	load.max_pending = ut_max(srv_n_read_io_threads
+				  * OS_AIO_N_PENDING_IOS_PER_THREAD,
+				  BUF_LOAD_MIN_PENDING);
+	load.cur_pending = load.max_pending;
 
 	/* JAN: TODO: MySQL 5.7 PSI
 #ifdef HAVE_PSI_STAGE_INTERFACE
@@ -652,75 +885,40 @@ buf_load()
 	mysql_stage_set_work_completed(pfs_stage_progress, 0);
 	*/
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-
-		/* space_id for this iteration of the loop */
-		const ulint	this_space_id = BUF_DUMP_SPACE(dump[i]);
-
-		if (this_space_id != cur_space_id) {
-			if (space != NULL) {
-				fil_space_release(space);
-			}
+	os_thread_id_t*	thread_ids = static_cast<os_thread_id_t*>(
+		ut_malloc_nokey(load.n_threads * sizeof *thread_ids));
 
-			cur_space_id = this_space_id;
-			space = fil_space_acquire_silent(cur_space_id);
-
-			if (space != NULL) {
-				const page_size_t	cur_page_size(
-					space->flags);
-				page_size.copy_from(cur_page_size);
-			}
-		}
+	for (i = 1; i < load.n_threads; i++) {
+		os_thread_create(buf_load_thread, &load, &thread_ids[i]);
+	}
 
-		/* JAN: TODO: As we use background page read below,
-		if tablespace is encrypted we cant use it. */
-		if (space == NULL ||
-		   (space && space->crypt_data &&
-		    space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
-		    space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
-			continue;
-		}
+	/* This thread reads its share of the pages, too. */
+	buf_load_pages(&load);
 
-		buf_read_page_background(
-			page_id_t(this_space_id, BUF_DUMP_PAGE(dump[i])),
-			page_size, true);
+	for (i = 1; i < load.n_threads; i++) {
+		os_thread_join(thread_ids[i]);
+	}
 
-		if (i % 64 == 63) {
-			os_aio_simulated_wake_handler_threads();
-		}
+	ut_free(thread_ids);
+	ut_free(dump);
 
-		if (buf_load_abort_flag) {
-			if (space != NULL) {
-				fil_space_release(space);
-			}
-			buf_load_abort_flag = FALSE;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_INFO,
-				"Buffer pool(s) load aborted on request");
-			/* Premature end, set estimated = completed = i and
-			end the current stage event. */
-			/*
-			mysql_stage_set_work_estimated(pfs_stage_progress, i);
-			mysql_stage_set_work_completed(pfs_stage_progress,
-			i);
-			*/
+	if (buf_load_abort_flag) {
+		buf_load_abort_flag = FALSE;
+		buf_load_status(
+			STATUS_INFO,
+			"Buffer pool(s) load aborted on request");
+		/* Premature end, set estimated = completed = i and
+		end the current stage event. */
+		/*
+		mysql_stage_set_work_estimated(pfs_stage_progress, i);
+		mysql_stage_set_work_completed(pfs_stage_progress, i);
+		*/
 #ifdef HAVE_PSI_STAGE_INTERFACE
-			/* mysql_end_stage(); */
+		/* mysql_end_stage(); */
 #endif /* HAVE_PSI_STAGE_INTERFACE */
-			return;
-		}
-
-		buf_load_throttle_if_needed(
-			&last_check_time, &last_activity_cnt, i);
-	}
-
-	if (space != NULL) {
-		fil_space_release(space);
+		return;
 	}
 
-	ut_free(dump);
-
 	ut_sprintf_timestamp(now);
 
 	buf_load_status(STATUS_INFO,
@@ -84,6 +84,7 @@ static lsn_t buf_flush_sync_lsn = 0;
 
 #ifdef UNIV_PFS_THREAD
 mysql_pfs_key_t page_cleaner_thread_key;
+mysql_pfs_key_t buf_lru_manager_thread_key;
 #endif /* UNIV_PFS_THREAD */
 
 /** Event to synchronise with the flushing. */
@@ -188,6 +189,29 @@ struct page_cleaner_t {
 
 static page_cleaner_t	page_cleaner;
 
+/** LRU manager thread of a buffer pool instance (innodb_lru_manager) */
+struct buf_lru_manager_t {
+	/** event to wake up the thread */
+	os_event_t	event;
+	/** whether the event was set and the thread has not yet
+	noticed it; a hint for buf_flush_lru_manager_wake() */
+	bool		woken;
+	/** the thread */
+	os_thread_id_t	thread_id;
+};
+
+/** The LRU manager threads, one per buffer pool instance, or NULL if
+innodb_lru_manager is not set */
+static buf_lru_manager_t*	buf_lru_managers;
+/** Whether the LRU manager threads are running. When not, the page
+cleaner threads flush the LRU lists. */
+static bool			buf_lru_managers_active;
+
+/** Minimum sleep time of an LRU manager thread, in microseconds */
+static const ulint	BUF_LRU_MANAGER_MIN_SLEEP = 1000;
+/** Maximum sleep time of an LRU manager thread, in microseconds */
+static const ulint	BUF_LRU_MANAGER_MAX_SLEEP = 1000000;
+
 #ifdef UNIV_DEBUG
 my_bool innodb_page_cleaner_disabled_debug;
 #endif /* UNIV_DEBUG */
@@ -1241,7 +1265,7 @@ buf_flush_page(
 				/* avoiding deadlock possibility involves
 				doublewrite buffer, should flush it, because
 				it might hold the another block->lock. */
-				buf_dblwr_flush_buffered_writes();
+				buf_dblwr_flush_buffered_writes(buf_pool);
 			} else {
 				buf_dblwr_sync_datafiles();
 			}
@@ -1995,7 +2019,7 @@ buf_flush_end(
 	buf_pool_mutex_exit(buf_pool);
 
 	if (!srv_read_only_mode) {
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool);
 	} else {
 		os_aio_simulated_wake_handler_threads();
 	}
@@ -2862,13 +2886,19 @@ pc_flush_slot(void)
 
 		mutex_exit(&page_cleaner.mutex);
 
-		lru_tm = ut_time_ms();
+		if (buf_lru_managers_active) {
+			/* The LRU manager thread of the instance
+			keeps the free list filled. */
+			slot->n_flushed_lru = 0;
+		} else {
+			lru_tm = ut_time_ms();
 
-		/* Flush pages from end of LRU if required */
-		slot->n_flushed_lru = buf_flush_LRU_list(buf_pool);
+			/* Flush pages from end of LRU if required */
+			slot->n_flushed_lru = buf_flush_LRU_list(buf_pool);
 
-		lru_tm = ut_time_ms() - lru_tm;
-		lru_pass++;
+			lru_tm = ut_time_ms() - lru_tm;
+			lru_pass++;
+		}
 
 		if (UNIV_UNLIKELY(!page_cleaner.is_running)) {
 			slot->n_flushed_list = 0;
@@ -3099,6 +3129,186 @@ buf_flush_page_cleaner_disabled_debug_update(
 }
 #endif /* UNIV_DEBUG */
 
+/** Wake up the LRU manager thread of a buffer pool instance, if
+innodb_lru_manager is in effect.
+@param[in]	buf_pool	buffer pool instance */
+void
+buf_flush_lru_manager_wake(const buf_pool_t* buf_pool)
+{
+	if (!buf_lru_managers_active) {
+		return;
+	}
+
+	buf_lru_manager_t*	manager
+		= &buf_lru_managers[buf_pool->instance_no];
+
+	if (!manager->woken) {
+		manager->woken = true;
+		os_event_set(manager->event);
+	}
+}
+
+/** Determine how long an LRU manager thread should sleep before its
+next LRU batch. The thread runs batches back to back while the free
+list is nearly empty, and backs off while it stays full.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	n_flushed	number of pages flushed by the last batch
+@param[in]	sleep_us	the previous sleep time in microseconds
+@return the sleep time in microseconds */
+static
+ulint
+buf_lru_manager_adapt_sleep(
+	const buf_pool_t*	buf_pool,
+	ulint			n_flushed,
+	ulint			sleep_us)
+{
+	const ulint	free_len = UT_LIST_GET_LEN(buf_pool->free);
+
+	if (free_len < srv_LRU_scan_depth / 8) {
+		/* Demand is outrunning us. Unless there was nothing
+		to flush, start the next batch right away. */
+		return(n_flushed ? 0 : BUF_LRU_MANAGER_MIN_SLEEP);
+	}
+
+	if (free_len < srv_LRU_scan_depth || n_flushed) {
+		return(ut_max(sleep_us / 2, BUF_LRU_MANAGER_MIN_SLEEP));
+	}
+
+	return(ut_min(ut_max(sleep_us, BUF_LRU_MANAGER_MIN_SLEEP) * 2,
+		      BUF_LRU_MANAGER_MAX_SLEEP));
+}
+
+/** LRU manager thread of a buffer pool instance. It keeps the free
+list of the instance filled by running LRU batches ahead of the demand,
+so that user threads rarely have to flush a page in
+buf_LRU_get_free_block().
+@param[in]	arg	buffer pool instance
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(buf_lru_manager_thread)(void* arg)
+{
+	my_thread_init();
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_lru_manager_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	buf_pool_t*		buf_pool = static_cast<buf_pool_t*>(arg);
+	buf_lru_manager_t*	manager
+		= &buf_lru_managers[buf_pool->instance_no];
+	ulint			sleep_us = BUF_LRU_MANAGER_MIN_SLEEP;
+	int64_t			sig_count = os_event_reset(manager->event);
+
+	while (srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+		if (sleep_us) {
+			os_event_wait_time_low(manager->event, sleep_us,
+					       sig_count);
+		}
+
+		sig_count = os_event_reset(manager->event);
+		manager->woken = false;
+
+		if (srv_shutdown_state != SRV_SHUTDOWN_NONE) {
+			break;
+		}
+
+		ulint	n_flushed = buf_flush_LRU_list(buf_pool);
+
+		buf_flush_wait_batch_end(buf_pool, BUF_FLUSH_LRU);
+
+		MONITOR_INC(MONITOR_LRU_MANAGER_BATCHES);
+
+		if (n_flushed) {
+			MONITOR_INC_VALUE_CUMULATIVE(
+				MONITOR_LRU_BATCH_FLUSH_TOTAL_PAGE,
+				MONITOR_LRU_BATCH_FLUSH_COUNT,
+				MONITOR_LRU_BATCH_FLUSH_PAGES,
+				n_flushed);
+		}
+
+		sleep_us = buf_lru_manager_adapt_sleep(
+			buf_pool, n_flushed, sleep_us);
+	}
+
+	my_thread_end();
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start the LRU manager threads if innodb_lru_manager is set. */
+static
+void
+buf_lru_managers_start()
+{
+	ut_ad(!buf_lru_managers);
+
+	if (!srv_lru_manager) {
+		return;
+	}
+
+	buf_lru_managers = static_cast<buf_lru_manager_t*>(
+		ut_zalloc_nokey(srv_buf_pool_instances
+				* sizeof *buf_lru_managers));
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_lru_managers[i].event = os_event_create(
+			"buf_lru_manager_event");
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		os_thread_create(buf_lru_manager_thread,
+				 buf_pool_from_array(i),
+				 &buf_lru_managers[i].thread_id);
+	}
+
+	buf_lru_managers_active = true;
+}
+
+/** Stop the LRU manager threads at shutdown. The page cleaner threads
+take over the flushing of the LRU lists. The events are freed by
+buf_lru_managers_close(), because buf_flush_lru_manager_wake() may
+still be running in other threads. */
+static
+void
+buf_lru_managers_stop()
+{
+	ut_ad(srv_shutdown_state != SRV_SHUTDOWN_NONE);
+
+	if (!buf_lru_managers_active) {
+		return;
+	}
+
+	buf_lru_managers_active = false;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		os_event_set(buf_lru_managers[i].event);
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		os_thread_join(buf_lru_managers[i].thread_id);
+	}
+}
+
+/** Free the LRU managers after all page flushing has finished. */
+static
+void
+buf_lru_managers_close()
+{
+	ut_ad(!buf_lru_managers_active);
+
+	if (!buf_lru_managers) {
+		return;
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		os_event_destroy(buf_lru_managers[i].event);
+	}
+
+	ut_free(buf_lru_managers);
+	buf_lru_managers = NULL;
+}
+
 /******************************************************************//**
 page_cleaner thread tasked with flushing dirty pages from the buffer
 pools. As of now we'll have only one coordinator.
@@ -3183,6 +3393,10 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 	ulint	last_activity = srv_get_activity_count();
 	ulint	last_pages = 0;
 
+	/* Recovery is over; from now on the LRU lists may be flushed
+	by threads of their own. */
+	buf_lru_managers_start();
+
 	while (srv_shutdown_state == SRV_SHUTDOWN_NONE) {
 		ulint	curr_time = ut_time_ms();
 
@@ -3369,6 +3583,8 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 	}
 
 	ut_ad(srv_shutdown_state > 0);
+
+	buf_lru_managers_stop();
 	if (srv_fast_shutdown == 2
 	    || srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS) {
 		/* In very fast shutdown or when innodb failed to start, we
@@ -3458,6 +3674,7 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 	os_event_set(page_cleaner.is_requested);
 
 	buf_flush_page_cleaner_close();
+	buf_lru_managers_close();
 
 	buf_page_cleaner_is_active = false;
 
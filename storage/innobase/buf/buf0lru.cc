@@ -1054,6 +1054,30 @@ buf_LRU_check_size_of_non_data_objects(
 	}
 }
 
+/** Account for the time that buf_LRU_get_free_block() had to wait
+because the free list was empty.
+@param[in]	wait_start	ut_time_us() of the first free list miss */
+static
+void
+buf_LRU_get_free_wait_monitor(uintmax_t wait_start)
+{
+	const uintmax_t	us = ut_time_us(NULL) - wait_start;
+
+	MONITOR_INC_VALUE(MONITOR_LRU_GET_FREE_WAIT_TIME, us);
+
+	if (us < 100) {
+		MONITOR_INC(MONITOR_LRU_GET_FREE_WAIT_LT_100US);
+	} else if (us < 1000) {
+		MONITOR_INC(MONITOR_LRU_GET_FREE_WAIT_LT_1MS);
+	} else if (us < 10000) {
+		MONITOR_INC(MONITOR_LRU_GET_FREE_WAIT_LT_10MS);
+	} else if (us < 100000) {
+		MONITOR_INC(MONITOR_LRU_GET_FREE_WAIT_LT_100MS);
+	} else {
+		MONITOR_INC(MONITOR_LRU_GET_FREE_WAIT_GE_100MS);
+	}
+}
+
 /******************************************************************//**
 Returns a free block from the buf_pool. The block is taken off the
 free list. If free list is empty, blocks are moved from the end of the
@@ -1087,6 +1111,7 @@ buf_LRU_get_free_block(
 	bool		freed		= false;
 	ulint		n_iterations	= 0;
 	ulint		flush_failures	= 0;
+	uintmax_t	wait_start	= 0;
 
 	MONITOR_INC(MONITOR_LRU_GET_FREE_SEARCH);
 loop:
@@ -1103,6 +1128,8 @@ buf_LRU_get_free_block(
 	block = buf_LRU_get_free_only(buf_pool);
 
 	if (block != NULL) {
+		const bool	low = UT_LIST_GET_LEN(buf_pool->free)
+			< srv_LRU_scan_depth / 4;
 
 		buf_pool_mutex_exit(buf_pool);
 		ut_ad(buf_pool_from_block(block) == buf_pool);
@@ -1110,9 +1137,23 @@ buf_LRU_get_free_block(
 
 		block->skip_flush_check = false;
 		block->page.flush_observer = NULL;
+
+		if (low) {
+			/* Refill the free list before it runs dry. */
+			buf_flush_lru_manager_wake(buf_pool);
+		}
+
+		if (wait_start) {
+			buf_LRU_get_free_wait_monitor(wait_start);
+		}
+
 		return(block);
 	}
 
+	if (!wait_start) {
+		wait_start = ut_time_us(NULL);
+	}
+
 	MONITOR_INC( MONITOR_LRU_GET_FREE_LOOPS );
 	freed = false;
 	if (buf_pool->try_LRU_scan || n_iterations > 0) {
@@ -1134,6 +1175,7 @@ buf_LRU_get_free_block(
 			/* Also tell the page_cleaner thread that
 			there is work for it to do. */
 			os_event_set(buf_flush_event);
+			buf_flush_lru_manager_wake(buf_pool);
 		}
 	}
 
@@ -1173,6 +1215,7 @@ buf_LRU_get_free_block(
 
 	if (!srv_read_only_mode) {
 		os_event_set(buf_flush_event);
+		buf_flush_lru_manager_wake(buf_pool);
 	}
 
 	if (n_iterations > 1) {
@@ -121,10 +121,14 @@ where n=1..n_uniq.
 
 /* Gets the number of leaf pages to sample in persistent stats estimation */
 #define N_SAMPLE_PAGES(index)					\
-	static_cast<ib_uint64_t>(				\
-		(index)->table->stats_sample_pages != 0		\
-		? (index)->table->stats_sample_pages		\
-		: srv_stats_persistent_sample_pages)
+	std::max(						\
+		static_cast<ib_uint64_t>(			\
+			(index)->table->stats_sample_pages != 0	\
+			? (index)->table->stats_sample_pages	\
+			: srv_stats_persistent_sample_pages),	\
+		static_cast<ib_uint64_t>(			\
+			(index)->stat_n_leaf_pages		\
+			* srv_stats_persistent_sample_pct / 100))
 
 /* number of distinct records on a given level that are required to stop
 descending to lower levels and fetch N_SAMPLE_PAGES(index) records
@@ -2211,6 +2215,89 @@ dict_stats_analyze_index(
 	DBUG_VOID_RETURN;
 }
 
+/** Indexes of a table whose statistics are being calculated */
+struct dict_stats_analyze_t {
+	/** the table */
+	const dict_table_t*	table;
+	/** the indexes to analyze, the clustered index first */
+	dict_index_t**		indexes;
+	/** number of indexes */
+	ulint			n_indexes;
+	/** the next index to analyze */
+	ulint			next;
+};
+
+/** Analyze indexes until there are none left.
+@param[in,out]	analyze	the indexes */
+static
+void
+dict_stats_analyze_worker(dict_stats_analyze_t* analyze)
+{
+	for (;;) {
+		ulint	i = my_atomic_addlint(&analyze->next, 1);
+
+		if (i >= analyze->n_indexes) {
+			break;
+		}
+
+		/* The clustered index is always analyzed, because the
+		table statistics are derived from it. */
+		if (i == 0
+		    || !(analyze->table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
+			dict_stats_analyze_index(analyze->indexes[i]);
+		}
+	}
+}
+
+/** Thread that analyzes indexes for dict_stats_analyze_indexes().
+@param[in,out]	arg	the indexes
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(dict_stats_analyze_thread)(void* arg)
+{
+	my_thread_init();
+
+	dict_stats_analyze_worker(static_cast<dict_stats_analyze_t*>(arg));
+
+	my_thread_end();
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Analyze the indexes of a table with up to innodb_stats_analyze_threads
+threads, each analyzing one index at a time.
+@param[in,out]	analyze	the indexes */
+static
+void
+dict_stats_analyze_indexes(dict_stats_analyze_t* analyze)
+{
+	const ulint	n_threads = std::min(
+		analyze->n_indexes, ulint(srv_stats_analyze_threads));
+
+	if (n_threads < 2) {
+		dict_stats_analyze_worker(analyze);
+		return;
+	}
+
+	os_thread_id_t*	ids = static_cast<os_thread_id_t*>(
+		ut_malloc_nokey((n_threads - 1) * sizeof *ids));
+
+	for (ulint t = 1; t < n_threads; t++) {
+		os_thread_create(dict_stats_analyze_thread, analyze,
+				 &ids[t - 1]);
+	}
+
+	dict_stats_analyze_worker(analyze);
+
+	for (ulint t = 1; t < n_threads; t++) {
+		os_thread_join(ids[t - 1]);
+	}
+
+	ut_free(ids);
+}
+
 /*********************************************************************//**
 Calculates new estimates for table and index statistics. This function
 is relatively slow and is used to calculate persistent statistics that
@@ -2245,7 +2332,42 @@ dict_stats_update_persistent(
 
 	ut_ad(!dict_index_is_ibuf(index));
 
-	dict_stats_analyze_index(index);
+	/* Collect the indexes to analyze, the clustered index first */
+
+	dict_stats_analyze_t	analyze;
+
+	analyze.table = table;
+	analyze.indexes = static_cast<dict_index_t**>(
+		ut_malloc_nokey(UT_LIST_GET_LEN(table->indexes)
+				* sizeof *analyze.indexes));
+	analyze.n_indexes = 0;
+	analyze.next = 0;
+
+	for (; index != NULL; index = dict_table_get_next_index(index)) {
+
+		ut_ad(!dict_index_is_ibuf(index));
+
+		if (dict_index_is_clust(index)) {
+			analyze.indexes[analyze.n_indexes++] = index;
+			continue;
+		}
+
+		if (index->type & DICT_FTS || dict_index_is_spatial(index)) {
+			continue;
+		}
+
+		dict_stats_empty_index(index, false);
+
+		if (!dict_stats_should_ignore_index(index)) {
+			analyze.indexes[analyze.n_indexes++] = index;
+		}
+	}
+
+	dict_stats_analyze_indexes(&analyze);
+
+	index = analyze.indexes[0];
+
+	ut_free(analyze.indexes);
 
 	ulint	n_unique = dict_index_get_n_unique(index);
 
@@ -2253,7 +2375,7 @@ dict_stats_update_persistent(
 
 	table->stat_clustered_index_size = index->stat_index_size;
 
-	/* analyze other indexes from the table, if any */
+	/* sum up the sizes of the other indexes from the table, if any */
 
 	table->stat_sum_of_other_index_sizes = 0;
 
@@ -2261,22 +2383,11 @@ dict_stats_update_persistent(
 	     index != NULL;
 	     index = dict_table_get_next_index(index)) {
 
-		ut_ad(!dict_index_is_ibuf(index));
-
-		if (index->type & DICT_FTS || dict_index_is_spatial(index)) {
+		if (index->type & DICT_FTS || dict_index_is_spatial(index)
+		    || dict_stats_should_ignore_index(index)) {
 			continue;
 		}
 
-		dict_stats_empty_index(index, false);
-
-		if (dict_stats_should_ignore_index(index)) {
-			continue;
-		}
-
-		if (!(table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
-			dict_stats_analyze_index(index);
-		}
-
 		table->stat_sum_of_other_index_sizes
 			+= index->stat_index_size;
 	}
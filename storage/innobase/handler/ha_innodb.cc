@@ -98,6 +98,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "row0ins.h"
 #include "row0merge.h"
 #include "row0mysql.h"
+#include "row0pread.h"
 #include "row0quiesce.h"
 #include "row0sel.h"
 #include "row0trunc.h"
@@ -606,7 +607,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(trx_pool_mutex),
 	PSI_KEY(trx_pool_manager_mutex),
 	PSI_KEY(srv_sys_mutex),
-	PSI_KEY(lock_mutex),
+	PSI_KEY(lock_rec_hash_mutex),
 	PSI_KEY(lock_wait_mutex),
 	PSI_KEY(trx_mutex),
 	PSI_KEY(srv_threads_mutex),
@@ -641,6 +642,7 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	PSI_RWLOCK_KEY(fts_cache_init_rw_lock),
 	PSI_RWLOCK_KEY(trx_i_s_cache_lock),
 	PSI_RWLOCK_KEY(trx_purge_latch),
+	PSI_RWLOCK_KEY(lock_sys_latch),
 	PSI_RWLOCK_KEY(index_tree_rw_lock),
 	PSI_RWLOCK_KEY(index_online_log),
 	PSI_RWLOCK_KEY(dict_table_stats),
@@ -661,6 +663,7 @@ static PSI_thread_info	all_innodb_threads[] = {
 	PSI_KEY(io_read_thread),
 	PSI_KEY(io_write_thread),
 	PSI_KEY(page_cleaner_thread),
+	PSI_KEY(buf_lru_manager_thread),
 	PSI_KEY(recv_writer_thread),
 	PSI_KEY(srv_error_monitor_thread),
 	PSI_KEY(srv_lock_timeout_thread),
@@ -988,6 +991,8 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_dblwr_pages_written,	  SHOW_LONG},
   {"dblwr_writes",
   (char*) &export_vars.innodb_dblwr_writes,		  SHOW_LONG},
+  {"log_copy_waits",
+  (char*) &export_vars.innodb_log_copy_waits,		  SHOW_LONG},
   {"log_waits",
   (char*) &export_vars.innodb_log_waits,		  SHOW_LONG},
   {"log_write_requests",
@@ -2993,6 +2998,7 @@ ha_innobase::ha_innobase(
 			  | HA_CAN_RTREEKEYS
                           | HA_CAN_TABLES_WITHOUT_ROLLBACK
 			  | HA_CONCURRENT_OPTIMIZE
+			  | HA_CAN_PARALLEL_SCAN
 			  |  (srv_force_primary_key ? HA_REQUIRE_PRIMARY_KEY : 0)
 		  ),
 	m_start_of_scan(),
@@ -10077,6 +10083,60 @@ ha_innobase::rnd_next(
 	DBUG_RETURN(error);
 }
 
+/** Pass a row read by row_pread_scan() to the consumer.
+@param[in,out]	arg		Parallel_scan_consumer
+@param[in]	thread_no	number of the scan thread
+@param[in]	mysql_rec	row in the MySQL format */
+static
+void
+innobase_parallel_scan_row(void* arg, ulint thread_no, const byte* mysql_rec)
+{
+	static_cast<Parallel_scan_consumer*>(arg)->add_row(
+		uint(thread_no), mysql_rec);
+}
+
+/** Read all rows of the table with several threads, see
+handler::parallel_scan().
+@param[in]	n_threads	maximum number of threads
+@param[in,out]	consumer	receives the rows
+@return 0, HA_ERR_WRONG_COMMAND or error number */
+int
+ha_innobase::parallel_scan(
+	uint			n_threads,
+	Parallel_scan_consumer*	consumer)
+{
+	DBUG_ENTER("ha_innobase::parallel_scan");
+
+	TrxInInnoDB	trx_in_innodb(m_prebuilt->trx);
+
+	/* Locking reads and the columns that row_search_mvcc() has to
+	handle in a special way are left to rnd_next() */
+	if (m_prebuilt->select_lock_type != LOCK_NONE
+	    || !m_prebuilt->index_usable
+	    || !m_prebuilt->table->is_readable()
+	    || !row_pread_is_possible(m_prebuilt)) {
+		DBUG_RETURN(HA_ERR_WRONG_COMMAND);
+	}
+
+	if (TrxInInnoDB::is_aborted(m_prebuilt->trx)) {
+
+		innobase_rollback(ht, m_user_thd, false);
+
+		DBUG_RETURN(convert_error_code_to_mysql(
+			DB_FORCED_ABORT, 0, m_user_thd));
+	}
+
+	innobase_srv_conc_enter_innodb(m_prebuilt);
+
+	dberr_t	err = row_pread_scan(m_prebuilt, n_threads,
+				     innobase_parallel_scan_row, consumer);
+
+	innobase_srv_conc_exit_innodb(m_prebuilt);
+
+	DBUG_RETURN(convert_error_code_to_mysql(
+		err, m_prebuilt->table->flags, m_user_thd));
+}
+
 /**********************************************************************//**
 Fetches a row from the table based on a row reference.
 @return 0, HA_ERR_KEY_NOT_FOUND, or error code */
@@ -19796,6 +19856,18 @@ static MYSQL_SYSVAR_BOOL(doublewrite, innobase_use_doublewrite,
   " Disable with --skip-innodb-doublewrite.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(doublewrite_per_instance, srv_dblwr_per_instance,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Write pages through a doublewrite file per buffer pool instance"
+  " instead of the doublewrite buffer in the system tablespace",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_ULONG(doublewrite_file_pages, srv_dblwr_file_pages,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of pages in each doublewrite file of"
+  " innodb_doublewrite_per_instance",
+  NULL, NULL, 256, 64, 4096, 0);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, innobase_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Enable atomic writes, instead of using the doublewrite buffer, for files "
@@ -19953,6 +20025,12 @@ static MYSQL_SYSVAR_ULONG(page_cleaners, srv_n_page_cleaners,
   NULL,
   innodb_page_cleaners_threads_update, 4, 1, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(recovery_threads, srv_n_recovery_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads that read in pages and apply the redo log to them"
+  " during crash recovery",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_DOUBLE(max_dirty_pages_pct, srv_max_buf_pool_modified_pct,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of dirty pages allowed in bufferpool.",
@@ -20048,6 +20126,20 @@ static MYSQL_SYSVAR_ULONGLONG(stats_persistent_sample_pages,
   " statistics (by ANALYZE, default 20)",
   NULL, NULL, 20, 1, ~0ULL, 0);
 
+static MYSQL_SYSVAR_ULONG(stats_persistent_sample_pct,
+  srv_stats_persistent_sample_pct,
+  PLUGIN_VAR_RQCMDARG,
+  "The minimum percentage of the leaf pages of an index to sample when"
+  " calculating persistent statistics, in addition to"
+  " innodb_stats_persistent_sample_pages (default 0)",
+  NULL, NULL, 0, 0, 100, 0);
+
+static MYSQL_SYSVAR_ULONG(stats_analyze_threads, srv_stats_analyze_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that analyze the indexes of a table when calculating"
+  " persistent statistics",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(stats_modified_counter, srv_stats_modified_counter,
   PLUGIN_VAR_RQCMDARG,
   "The number of rows modified before we calculate new statistics (default 0 = current limits)",
@@ -20211,6 +20303,11 @@ static MYSQL_SYSVAR_BOOL(buffer_pool_load_at_startup, srv_buffer_pool_load_at_st
   "Load the buffer pool from a file named @@innodb_buffer_pool_filename",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_load_threads, srv_n_buf_load_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that read the pages of a buffer pool load",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_BOOL(defragment, srv_defragment,
   PLUGIN_VAR_RQCMDARG,
   "Enable/disable InnoDB defragmentation (default FALSE). When set to FALSE, all existing "
@@ -20270,6 +20367,12 @@ static MYSQL_SYSVAR_ULONG(lru_scan_depth, srv_LRU_scan_depth,
   "How deep to scan LRU to keep it clean",
   NULL, NULL, 1024, 100, ~0UL, 0);
 
+static MYSQL_SYSVAR_BOOL(lru_manager, srv_lru_manager,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Keep the free list of each buffer pool instance filled by a thread"
+  " of its own instead of the page cleaner threads",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(flush_neighbors, srv_flush_neighbors,
   PLUGIN_VAR_OPCMDARG,
   "Set to 0 (don't flush neighbors from buffer pool),"
@@ -20295,6 +20398,14 @@ static MYSQL_SYSVAR_BOOL(deadlock_detect, innobase_deadlock_detect,
   " and we rely on innodb_lock_wait_timeout in case of deadlock.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(deadlock_detect_interval,
+  innodb_deadlock_detect_interval,
+  PLUGIN_VAR_RQCMDARG,
+  "If nonzero, check the lock waits for deadlocks in a background thread"
+  " every this many milliseconds, instead of checking each lock wait"
+  " in the waiting thread when it is enqueued (default 0).",
+  NULL, NULL, 0, 0, 1000, 0);
+
 static MYSQL_SYSVAR_LONG(fill_factor, innobase_fill_factor,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of B-tree page filled during bulk insert",
@@ -20356,6 +20467,12 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(ddl_threads, srv_n_ddl_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that scan the clustered index, and that sort and"
+  " load the indexes, when ALTER TABLE creates indexes",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -20411,6 +20528,13 @@ static MYSQL_SYSVAR_ULONG(log_write_ahead_size, srv_log_write_ahead_size,
   NULL, innodb_log_write_ahead_size_update,
   8*1024L, OS_FILE_LOG_BLOCK_SIZE, UNIV_PAGE_SIZE_DEF, OS_FILE_LOG_BLOCK_SIZE);
 
+static MYSQL_SYSVAR_BOOL(log_writer_threads, srv_log_writer_threads,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Write and flush the redo log in dedicated background threads,"
+  " which committing transactions wait for, instead of in the"
+  " committing threads themselves",
+  NULL, NULL, TRUE);
+
 static MYSQL_SYSVAR_UINT(old_blocks_pct, innobase_old_blocks_pct,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of the buffer pool to reserve for 'old' blocks.",
@@ -20546,6 +20670,13 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform.",
   NULL, NULL, TRUE);
 
+#ifdef LINUX_IO_URING
+static MYSQL_SYSVAR_BOOL(use_io_uring, srv_use_io_uring,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Use io_uring instead of libaio for native AIO if supported by the kernel.",
+  NULL, NULL, FALSE);
+#endif /* LINUX_IO_URING */
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
@@ -20568,6 +20699,13 @@ static MYSQL_SYSVAR_UINT(change_buffer_max_size,
   NULL, innodb_change_buffer_max_size_update,
   CHANGE_BUFFER_DEFAULT_SIZE, 0, 50, 0);
 
+static MYSQL_SYSVAR_BOOL(change_buffer_eager_merge,
+  srv_change_buffer_eager_merge,
+  PLUGIN_VAR_OPCMDARG,
+  "Merge recently buffered changes in background batches, so that"
+  " they are usually merged before a query reads the page.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ENUM(stats_method, srv_innodb_stats_method,
    PLUGIN_VAR_RQCMDARG,
   "Specifies how InnoDB index statistics collection code should"
@@ -20934,6 +21072,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_load_now),
   MYSQL_SYSVAR(buffer_pool_load_abort),
   MYSQL_SYSVAR(buffer_pool_load_at_startup),
+  MYSQL_SYSVAR(buffer_pool_load_threads),
   MYSQL_SYSVAR(defragment),
   MYSQL_SYSVAR(defragment_n_pages),
   MYSQL_SYSVAR(defragment_stats_accuracy),
@@ -20941,6 +21080,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(defragment_fill_factor_n_recs),
   MYSQL_SYSVAR(defragment_frequency),
   MYSQL_SYSVAR(lru_scan_depth),
+  MYSQL_SYSVAR(lru_manager),
   MYSQL_SYSVAR(flush_neighbors),
   MYSQL_SYSVAR(checksum_algorithm),
   MYSQL_SYSVAR(log_checksums),
@@ -20952,6 +21092,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(temp_data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(doublewrite_per_instance),
+  MYSQL_SYSVAR(doublewrite_file_pages),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(use_atomic_writes),
   MYSQL_SYSVAR(fast_shutdown),
@@ -20976,11 +21118,13 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(locks_unsafe_for_binlog),
   MYSQL_SYSVAR(lock_wait_timeout),
   MYSQL_SYSVAR(deadlock_detect),
+  MYSQL_SYSVAR(deadlock_detect_interval),
   MYSQL_SYSVAR(page_size),
   MYSQL_SYSVAR(log_buffer_size),
   MYSQL_SYSVAR(log_file_size),
   MYSQL_SYSVAR(log_files_in_group),
   MYSQL_SYSVAR(log_write_ahead_size),
+  MYSQL_SYSVAR(log_writer_threads),
   MYSQL_SYSVAR(log_group_home_dir),
   MYSQL_SYSVAR(log_compressed_pages),
   MYSQL_SYSVAR(max_dirty_pages_pct),
@@ -21006,6 +21150,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_transient_sample_pages),
   MYSQL_SYSVAR(stats_persistent),
   MYSQL_SYSVAR(stats_persistent_sample_pages),
+  MYSQL_SYSVAR(stats_persistent_sample_pct),
+  MYSQL_SYSVAR(stats_analyze_threads),
   MYSQL_SYSVAR(stats_auto_recalc),
   MYSQL_SYSVAR(stats_modified_counter),
   MYSQL_SYSVAR(stats_traditional),
@@ -21018,6 +21164,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(ddl_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -21030,11 +21177,15 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(autoinc_lock_mode),
   MYSQL_SYSVAR(version),
   MYSQL_SYSVAR(use_native_aio),
+#ifdef LINUX_IO_URING
+  MYSQL_SYSVAR(use_io_uring),
+#endif /* LINUX_IO_URING */
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
 #endif /* HAVE_LIBNUMA */
   MYSQL_SYSVAR(change_buffering),
   MYSQL_SYSVAR(change_buffer_max_size),
+  MYSQL_SYSVAR(change_buffer_eager_merge),
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
   MYSQL_SYSVAR(change_buffering_debug),
   MYSQL_SYSVAR(disable_background_merge),
@@ -21048,6 +21199,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(io_capacity),
   MYSQL_SYSVAR(io_capacity_max),
   MYSQL_SYSVAR(page_cleaners),
+  MYSQL_SYSVAR(recovery_threads),
   MYSQL_SYSVAR(idle_flush_pct),
   MYSQL_SYSVAR(monitor_enable),
   MYSQL_SYSVAR(monitor_disable),
@@ -21171,7 +21323,9 @@ i_s_innodb_sys_virtual,
 i_s_innodb_mutexes,
 i_s_innodb_sys_semaphore_waits,
 i_s_innodb_tablespaces_encryption,
-i_s_innodb_tablespaces_scrubbing
+i_s_innodb_tablespaces_scrubbing,
+i_s_innodb_ahi_per_index,
+i_s_innodb_purge_per_table
 maria_declare_plugin_end;
 
 /** @brief Initialize the default value of innodb_commit_concurrency.
@@ -180,6 +180,8 @@ class ha_innobase: public handler
 
 	int rnd_next(uchar *buf);
 
+	int parallel_scan(uint n_threads, Parallel_scan_consumer* consumer);
+
 	int rnd_pos(uchar * buf, uchar *pos);
 
 	int ft_init();
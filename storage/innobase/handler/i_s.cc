@@ -61,6 +61,7 @@ Modified Dec 29, 2014 Jan Lindström (Added sys_semaphore_waits)
 #include "fsp0sysspace.h"
 #include "ut0new.h"
 #include "dict0crea.h"
+#include "btr0sea.h"
 
 /** structure associates a name string with a file page type and/or buffer
 page state. */
@@ -9563,3 +9564,505 @@ UNIV_INTERN struct st_maria_plugin	i_s_innodb_sys_semaphore_waits =
 	STRUCT_FLD(version_info, INNODB_VERSION_STR),
         STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
 };
+
+/**  INNODB_AHI_PER_INDEX  ***********************************************/
+/* Fields of the dynamic table INFORMATION_SCHEMA.INNODB_AHI_PER_INDEX */
+static ST_FIELD_INFO	i_s_ahi_per_index_fields_info[] =
+{
+#define AHI_IDX_DATABASE_NAME	0
+	{STRUCT_FLD(field_name,		"database_name"),
+	 STRUCT_FLD(field_length,	192),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_IDX_TABLE_NAME	1
+	{STRUCT_FLD(field_name,		"table_name"),
+	 STRUCT_FLD(field_length,	192),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_IDX_INDEX_NAME	2
+	{STRUCT_FLD(field_name,		"index_name"),
+	 STRUCT_FLD(field_length,	192),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_IDX_HASH_HITS	3
+	{STRUCT_FLD(field_name,		"hash_hits"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_IDX_HASH_MISSES	4
+	{STRUCT_FLD(field_name,		"hash_misses"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_IDX_SUSPENDED	5
+	{STRUCT_FLD(field_name,		"suspended"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_IDX_PAGES_HASHED	6
+	{STRUCT_FLD(field_name,		"pages_hashed"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_IDX_PAGES_BUILT	7
+	{STRUCT_FLD(field_name,		"pages_built"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_IDX_ROWS_BUILT	8
+	{STRUCT_FLD(field_name,		"rows_built"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_IDX_IN_USE		9
+	{STRUCT_FLD(field_name,		"in_use"),
+	 STRUCT_FLD(field_length,	1),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+	END_OF_ST_FIELD_INFO
+};
+
+#ifdef BTR_CUR_HASH_ADAPT
+/*******************************************************************//**
+Fill a row of INFORMATION_SCHEMA.INNODB_AHI_PER_INDEX.
+@param[in,out]	thd	connection
+@param[in,out]	table	I_S table
+@param[in]	index	index whose adaptive hash index counters to store
+@return 0 on success, 1 on failure */
+static
+int
+i_s_ahi_per_index_fill_index(
+	THD*			thd,
+	TABLE*			table,
+	const dict_index_t*	index)
+{
+	Field**			fields = table->field;
+	const btr_search_t*	info = index->search_info;
+	char			db_utf8[MAX_DB_UTF8_LEN];
+	char			table_utf8[MAX_TABLE_UTF8_LEN];
+
+	DBUG_ENTER("i_s_ahi_per_index_fill_index");
+
+	dict_fs2utf8(index->table_name,
+		     db_utf8, sizeof(db_utf8),
+		     table_utf8, sizeof(table_utf8));
+
+	OK(field_store_string(fields[AHI_IDX_DATABASE_NAME], db_utf8));
+	OK(field_store_string(fields[AHI_IDX_TABLE_NAME], table_utf8));
+	OK(field_store_index_name(fields[AHI_IDX_INDEX_NAME], index->name));
+	OK(fields[AHI_IDX_HASH_HITS]->store(info->n_hash_hits, true));
+	OK(fields[AHI_IDX_HASH_MISSES]->store(info->n_hash_misses, true));
+	OK(fields[AHI_IDX_SUSPENDED]->store(info->n_hash_suspended, true));
+	OK(fields[AHI_IDX_PAGES_HASHED]->store(info->ref_count, true));
+	OK(fields[AHI_IDX_PAGES_BUILT]->store(info->n_pages_built, true));
+	OK(fields[AHI_IDX_ROWS_BUILT]->store(info->n_rows_built, true));
+	OK(fields[AHI_IDX_IN_USE]->store(
+		   btr_search_enabled && !info->n_hash_suspend, true));
+
+	DBUG_RETURN(schema_table_store_record(thd, table));
+}
+#endif /* BTR_CUR_HASH_ADAPT */
+
+/*******************************************************************//**
+Fill the dynamic table INFORMATION_SCHEMA.INNODB_AHI_PER_INDEX with the
+adaptive hash index counters of the indexes in the data dictionary cache
+that have used the adaptive hash index.
+@return 0 on success, 1 on failure */
+static
+int
+i_s_ahi_per_index_fill(
+/*===================*/
+	THD*		thd,	/*!< in: thread */
+	TABLE_LIST*	tables,	/*!< in/out: tables to fill */
+	Item*		)	/*!< in: condition (ignored) */
+{
+	int	status = 0;
+
+	DBUG_ENTER("i_s_ahi_per_index_fill");
+
+	/* deny access to non-superusers */
+	if (check_global_access(thd, PROCESS_ACL)) {
+
+		DBUG_RETURN(0);
+	}
+
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+#ifdef BTR_CUR_HASH_ADAPT
+	mutex_enter(&dict_sys->mutex);
+
+	for (ulint lru = 0; lru < 2 && !status; lru++) {
+		for (const dict_table_t* table = lru
+			     ? UT_LIST_GET_FIRST(dict_sys->table_LRU)
+			     : UT_LIST_GET_FIRST(dict_sys->table_non_LRU);
+		     table != NULL && !status;
+		     table = UT_LIST_GET_NEXT(table_LRU, table)) {
+
+			for (const dict_index_t* index
+				     = dict_table_get_first_index(table);
+			     index != NULL && !status;
+			     index = dict_table_get_next_index(index)) {
+
+				const btr_search_t*	info
+					= index->search_info;
+
+				if (info->n_hash_hits || info->n_hash_misses
+				    || info->n_pages_built) {
+					status = i_s_ahi_per_index_fill_index(
+						thd, tables->table, index);
+				}
+			}
+		}
+	}
+
+	mutex_exit(&dict_sys->mutex);
+#endif /* BTR_CUR_HASH_ADAPT */
+
+	DBUG_RETURN(status);
+}
+
+/*******************************************************************//**
+Bind the dynamic table INFORMATION_SCHEMA.INNODB_AHI_PER_INDEX.
+@return 0 on success */
+static
+int
+i_s_ahi_per_index_init(
+/*===================*/
+	void*	p)	/*!< in/out: table schema object */
+{
+	ST_SCHEMA_TABLE*	schema;
+
+	DBUG_ENTER("i_s_ahi_per_index_init");
+
+	schema = (ST_SCHEMA_TABLE*) p;
+
+	schema->fields_info = i_s_ahi_per_index_fields_info;
+	schema->fill_table = i_s_ahi_per_index_fill;
+
+	DBUG_RETURN(0);
+}
+
+UNIV_INTERN struct st_maria_plugin	i_s_innodb_ahi_per_index =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	STRUCT_FLD(type, MYSQL_INFORMATION_SCHEMA_PLUGIN),
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	STRUCT_FLD(info, &i_s_info),
+
+	/* plugin name */
+	/* const char* */
+	STRUCT_FLD(name, "INNODB_AHI_PER_INDEX"),
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(author, maria_plugin_author),
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(descr, "InnoDB adaptive hash index statistics per index"),
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	STRUCT_FLD(license, PLUGIN_LICENSE_GPL),
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(init, i_s_ahi_per_index_init),
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(deinit, i_s_common_deinit),
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	STRUCT_FLD(version, INNODB_VERSION_SHORT),
+
+	/* struct st_mysql_show_var* */
+	STRUCT_FLD(status_vars, NULL),
+
+	/* struct st_mysql_sys_var** */
+	STRUCT_FLD(system_vars, NULL),
+
+	/* Maria extension */
+	STRUCT_FLD(version_info, INNODB_VERSION_STR),
+	STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
+};
+
+/**  INNODB_PURGE_PER_TABLE  *********************************************/
+/* Fields of the dynamic table INFORMATION_SCHEMA.INNODB_PURGE_PER_TABLE */
+static ST_FIELD_INFO	i_s_purge_per_table_fields_info[] =
+{
+#define PURGE_TABLE_DATABASE_NAME	0
+	{STRUCT_FLD(field_name,		"database_name"),
+	 STRUCT_FLD(field_length,	192),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define PURGE_TABLE_TABLE_NAME	1
+	{STRUCT_FLD(field_name,		"table_name"),
+	 STRUCT_FLD(field_length,	192),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define PURGE_TABLE_PURGED_RECORDS	2
+	{STRUCT_FLD(field_name,		"purged_records"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define PURGE_TABLE_PURGE_USEC	3
+	{STRUCT_FLD(field_name,		"purge_usec"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define PURGE_TABLE_PURGE_TRX_NO	4
+	{STRUCT_FLD(field_name,		"purge_trx_no"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define PURGE_TABLE_MODIFIED_TRX_NO	5
+	{STRUCT_FLD(field_name,		"modified_trx_no"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define PURGE_TABLE_PURGE_LAG	6
+	{STRUCT_FLD(field_name,		"purge_lag"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+	END_OF_ST_FIELD_INFO
+};
+
+/*******************************************************************//**
+Fill a row of INFORMATION_SCHEMA.INNODB_PURGE_PER_TABLE.
+@param[in,out]	thd	connection
+@param[in,out]	table	I_S table
+@param[in]	purge_table	table whose purge counters to store
+@return 0 on success, 1 on failure */
+static
+int
+i_s_purge_per_table_fill_table(
+	THD*			thd,
+	TABLE*			table,
+	const dict_table_t*	purge_table)
+{
+	Field**			fields = table->field;
+	char			db_utf8[MAX_DB_UTF8_LEN];
+	char			table_utf8[MAX_TABLE_UTF8_LEN];
+	const trx_id_t		purge_trx_no = purge_table->purge_trx_no;
+	const trx_id_t		mod_trx_no = purge_table->purge_mod_trx_no;
+
+	DBUG_ENTER("i_s_purge_per_table_fill_table");
+
+	if (strchr(purge_table->name.m_name, '/')) {
+		dict_fs2utf8(purge_table->name.m_name,
+			     db_utf8, sizeof(db_utf8),
+			     table_utf8, sizeof(table_utf8));
+	} else {
+		/* A table of the InnoDB data dictionary, like SYS_TABLES */
+		db_utf8[0] = '\0';
+		strncpy(table_utf8, purge_table->name.m_name,
+			sizeof(table_utf8) - 1);
+		table_utf8[sizeof(table_utf8) - 1] = '\0';
+	}
+
+	OK(field_store_string(fields[PURGE_TABLE_DATABASE_NAME], db_utf8));
+	OK(field_store_string(fields[PURGE_TABLE_TABLE_NAME], table_utf8));
+	OK(fields[PURGE_TABLE_PURGED_RECORDS]->store(
+		   purge_table->n_purged_recs, true));
+	OK(fields[PURGE_TABLE_PURGE_USEC]->store(
+		   purge_table->purge_usec, true));
+	OK(fields[PURGE_TABLE_PURGE_TRX_NO]->store(purge_trx_no, true));
+	OK(fields[PURGE_TABLE_MODIFIED_TRX_NO]->store(mod_trx_no, true));
+	/* The number of transaction serialisation numbers that the
+	purge of this table is behind its last committed modification */
+	OK(fields[PURGE_TABLE_PURGE_LAG]->store(
+		   mod_trx_no > purge_trx_no ? mod_trx_no - purge_trx_no : 0,
+		   true));
+
+	DBUG_RETURN(schema_table_store_record(thd, table));
+}
+
+/*******************************************************************//**
+Fill the dynamic table INFORMATION_SCHEMA.INNODB_PURGE_PER_TABLE with the
+purge counters of the tables in the data dictionary cache that have been
+modified or purged.
+@return 0 on success, 1 on failure */
+static
+int
+i_s_purge_per_table_fill(
+/*=====================*/
+	THD*		thd,	/*!< in: thread */
+	TABLE_LIST*	tables,	/*!< in/out: tables to fill */
+	Item*		)	/*!< in: condition (ignored) */
+{
+	int	status = 0;
+
+	DBUG_ENTER("i_s_purge_per_table_fill");
+
+	/* deny access to non-superusers */
+	if (check_global_access(thd, PROCESS_ACL)) {
+
+		DBUG_RETURN(0);
+	}
+
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+	mutex_enter(&dict_sys->mutex);
+
+	for (ulint lru = 0; lru < 2 && !status; lru++) {
+		for (const dict_table_t* table = lru
+			     ? UT_LIST_GET_FIRST(dict_sys->table_LRU)
+			     : UT_LIST_GET_FIRST(dict_sys->table_non_LRU);
+		     table != NULL && !status;
+		     table = UT_LIST_GET_NEXT(table_LRU, table)) {
+
+			if (table->n_purged_recs || table->purge_mod_trx_no) {
+				status = i_s_purge_per_table_fill_table(
+					thd, tables->table, table);
+			}
+		}
+	}
+
+	mutex_exit(&dict_sys->mutex);
+
+	DBUG_RETURN(status);
+}
+
+/*******************************************************************//**
+Bind the dynamic table INFORMATION_SCHEMA.INNODB_PURGE_PER_TABLE.
+@return 0 on success */
+static
+int
+i_s_purge_per_table_init(
+/*=====================*/
+	void*	p)	/*!< in/out: table schema object */
+{
+	ST_SCHEMA_TABLE*	schema;
+
+	DBUG_ENTER("i_s_purge_per_table_init");
+
+	schema = (ST_SCHEMA_TABLE*) p;
+
+	schema->fields_info = i_s_purge_per_table_fields_info;
+	schema->fill_table = i_s_purge_per_table_fill;
+
+	DBUG_RETURN(0);
+}
+
+UNIV_INTERN struct st_maria_plugin	i_s_innodb_purge_per_table =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	STRUCT_FLD(type, MYSQL_INFORMATION_SCHEMA_PLUGIN),
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	STRUCT_FLD(info, &i_s_info),
+
+	/* plugin name */
+	/* const char* */
+	STRUCT_FLD(name, "INNODB_PURGE_PER_TABLE"),
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(author, maria_plugin_author),
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(descr, "InnoDB purge statistics per table"),
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	STRUCT_FLD(license, PLUGIN_LICENSE_GPL),
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(init, i_s_purge_per_table_init),
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(deinit, i_s_common_deinit),
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	STRUCT_FLD(version, INNODB_VERSION_SHORT),
+
+	/* struct st_mysql_show_var* */
+	STRUCT_FLD(status_vars, NULL),
+
+	/* struct st_mysql_sys_var** */
+	STRUCT_FLD(system_vars, NULL),
+
+	/* Maria extension */
+	STRUCT_FLD(version_info, INNODB_VERSION_STR),
+	STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
+};
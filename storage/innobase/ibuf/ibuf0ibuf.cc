@@ -61,6 +61,8 @@ my_bool	srv_ibuf_disable_background_merge;
 #include "fsp0sysspace.h"
 #include "rem0cmp.h"
 
+#include <algorithm>
+
 /*	STRUCTURE OF AN INSERT BUFFER RECORD
 
 In versions < 4.1.x:
@@ -310,6 +312,18 @@ this many pages, we start to contract it synchronous contract, but do
 not insert */
 const ulint		IBUF_CONTRACT_DO_NOT_INSERT = 10;
 
+/** Maximum number of recently changed pages that are remembered for
+ibuf_merge_recent() */
+static const ulint	IBUF_RECENT_MAX = 1024;
+
+/** Recently changed pages, with the space id in the upper and the page
+number in the lower 32 bits, in the order the changes were buffered;
+protected by ibuf_mutex */
+static ib_uint64_t	ibuf_recent[IBUF_RECENT_MAX];
+
+/** Number of elements in ibuf_recent[]; protected by ibuf_mutex */
+static ulint		ibuf_n_recent;
+
 /* TODO: how to cope with drop table if there are records in the insert
 buffer for the indexes of the table? Is there actually any problem,
 because ibuf merge is done to a page when it is read in, and it is
@@ -2570,6 +2584,80 @@ ibuf_merge_pages(
 	return(sum_sizes + 1);
 }
 
+/** Position of the next ibuf_merge_sweep(), which is only invoked by
+the master thread */
+static ulint	ibuf_sweep_space;
+/** Page number of the next ibuf_merge_sweep() */
+static ulint	ibuf_sweep_page_no;
+
+/** Contract the change buffer by reading pages to the buffer pool in
+the order of the change buffer tree, continuing where the previous call
+left off. Unlike ibuf_merge_pages(), which starts at a random position,
+this reads the pages of a tablespace in ascending order and visits every
+buffered page in a bounded number of calls.
+@param[out]	n_pages		number of pages to which merged
+@return a lower limit for the combined size in bytes of entries which
+will be merged from ibuf trees to the pages read, 0 if ibuf is
+empty */
+static
+ulint
+ibuf_merge_sweep(ulint* n_pages)
+{
+	mtr_t		mtr;
+	btr_pcur_t	pcur;
+	ulint		sum_sizes	= 0;
+	ulint		pages[IBUF_MAX_N_PAGES_MERGED];
+	ulint		spaces[IBUF_MAX_N_PAGES_MERGED];
+
+	*n_pages = 0;
+
+	for (;;) {
+		mem_heap_t*	heap = mem_heap_create(512);
+		dtuple_t*	tuple = ibuf_search_tuple_build(
+			ibuf_sweep_space, ibuf_sweep_page_no, heap);
+
+		ibuf_mtr_start(&mtr);
+
+		btr_pcur_open(
+			ibuf->index, tuple, PAGE_CUR_GE, BTR_SEARCH_LEAF,
+			&pcur, &mtr);
+
+		mem_heap_free(heap);
+
+		if (const rec_t* rec = ibuf_get_user_rec(&pcur, &mtr)) {
+			sum_sizes = ibuf_get_merge_pages(
+				&pcur, ibuf_rec_get_space(&mtr, rec),
+				IBUF_MAX_N_PAGES_MERGED,
+				pages, spaces, n_pages, &mtr);
+		}
+
+		ibuf_mtr_commit(&mtr);
+		btr_pcur_close(&pcur);
+
+		if (*n_pages > 0) {
+			break;
+		}
+
+		if (!ibuf_sweep_space && !ibuf_sweep_page_no) {
+			/* The change buffer is empty. */
+			return(0);
+		}
+
+		/* We reached the end of the tree; start over. */
+		ibuf_sweep_space = 0;
+		ibuf_sweep_page_no = 0;
+	}
+
+	ibuf_sweep_space = spaces[0];
+	ibuf_sweep_page_no = pages[*n_pages - 1] + 1;
+
+	MONITOR_INC_VALUE(MONITOR_IBUF_SWEEP_PAGES, *n_pages);
+
+	buf_read_ibuf_merge_pages(false, spaces, pages, *n_pages);
+
+	return(sum_sizes + 1);
+}
+
 /*********************************************************************//**
 Contracts insert buffer trees by reading pages referring to space_id
 to the buffer pool.
@@ -2648,6 +2736,8 @@ ibuf_merge_space(
 @param[out]	n_pages		number of pages merged
 @param[in]	sync		whether the caller waits for
 the issued reads to complete
+@param[in]	sweep		whether to sweep the change buffer in
+order (ignoring sync) instead of picking a random position
 @return a lower limit for the combined size in bytes of entries which
 will be merged from ibuf trees to the pages read, 0 if ibuf is
 empty */
@@ -2655,7 +2745,8 @@ static MY_ATTRIBUTE((warn_unused_result))
 ulint
 ibuf_merge(
 	ulint*		n_pages,
-	bool		sync)
+	bool		sync,
+	bool		sweep)
 {
 	*n_pages = 0;
 
@@ -2670,6 +2761,8 @@ ibuf_merge(
 	} else if (ibuf_debug) {
 		return(0);
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
+	} else if (sweep) {
+		return(ibuf_merge_sweep(n_pages));
 	} else {
 		return(ibuf_merge_pages(n_pages, sync));
 	}
@@ -2742,7 +2835,11 @@ ibuf_merge_in_background(
 	while (sum_pages < n_pages) {
 		ulint	n_bytes;
 
-		n_bytes = ibuf_merge(&n_pag2, false);
+		/* A full contraction happens when the server is idle
+		or shutting down. Read the pages in order then, so that
+		the contraction does not keep revisiting the same part
+		of the change buffer. */
+		n_bytes = ibuf_merge(&n_pag2, false, full);
 
 		if (n_bytes == 0) {
 			return(sum_bytes);
@@ -2755,6 +2852,77 @@ ibuf_merge_in_background(
 	return(sum_bytes);
 }
 
+/** Remember a page to which a change was buffered, for
+ibuf_merge_recent(). If too many pages were changed since the previous
+ibuf_merge_recent(), the page is not remembered, and the change will be
+merged when the page is read or by the contraction of the change
+buffer.
+@param[in]	page_id	page to which a change was buffered */
+static
+void
+ibuf_note_recent(const page_id_t& page_id)
+{
+	const ib_uint64_t	id = ib_uint64_t(page_id.space()) << 32
+		| page_id.page_no();
+
+	mutex_enter(&ibuf_mutex);
+
+	if (ibuf_n_recent < IBUF_RECENT_MAX
+	    && (ibuf_n_recent == 0 || ibuf_recent[ibuf_n_recent - 1] != id)) {
+		ibuf_recent[ibuf_n_recent++] = id;
+	}
+
+	mutex_exit(&ibuf_mutex);
+}
+
+/** Merge the changes that were buffered since the previous call, by
+reading the changed pages in ascending order, in batches. The reads are
+asynchronous, so that the merge is done by the I/O threads and usually
+completes before a query reads the pages. The pages are remembered
+while innodb_change_buffer_eager_merge is set.
+@return number of pages for which a read was requested */
+ulint
+ibuf_merge_recent()
+{
+	ib_uint64_t	recent[IBUF_RECENT_MAX];
+
+#if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
+	if (srv_ibuf_disable_background_merge || ibuf_debug) {
+		return(0);
+	}
+#endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
+
+	mutex_enter(&ibuf_mutex);
+	ulint	n = ibuf_n_recent;
+	memcpy(recent, ibuf_recent, n * sizeof *recent);
+	ibuf_n_recent = 0;
+	mutex_exit(&ibuf_mutex);
+
+	std::sort(recent, recent + n);
+	n = ulint(std::unique(recent, recent + n) - recent);
+
+	/* Do not issue more reads than a full contraction would. */
+	n = ut_min(n, ulint(PCT_IO(100)));
+
+	for (ulint i = 0; i < n; ) {
+		ulint	pages[IBUF_MAX_N_PAGES_MERGED];
+		ulint	spaces[IBUF_MAX_N_PAGES_MERGED];
+		ulint	n_pages = 0;
+
+		do {
+			spaces[n_pages] = ulint(recent[i] >> 32);
+			pages[n_pages] = ulint(recent[i] & 0xFFFFFFFFU);
+			n_pages++;
+		} while (++i < n && n_pages < IBUF_MAX_N_PAGES_MERGED);
+
+		buf_read_ibuf_merge_pages(false, spaces, pages, n_pages);
+	}
+
+	MONITOR_INC_VALUE(MONITOR_IBUF_EAGER_MERGE_PAGES, n);
+
+	return(n);
+}
+
 /*********************************************************************//**
 Contract insert buffer trees after insert if they are too big. */
 UNIV_INLINE
@@ -3829,6 +3997,10 @@ ibuf_insert(
 		/* fprintf(stderr, "Ibuf insert for page no %lu of index %s\n",
 		page_no, index->name); */
 #endif
+		if (srv_change_buffer_eager_merge) {
+			ibuf_note_recent(page_id);
+		}
+
 		DBUG_RETURN(TRUE);
 
 	} else {
@@ -4426,6 +4598,26 @@ ibuf_delete_rec(
 	return(TRUE);
 }
 
+/** Account for the time that ibuf_merge_or_delete_for_page() spent
+merging buffered changes to a page that was read.
+@param[in]	us	elapsed time in microseconds */
+static
+void
+ibuf_merge_on_read_monitor(uintmax_t us)
+{
+	MONITOR_INC_VALUE(MONITOR_IBUF_MERGE_ON_READ_TIME, us);
+
+	if (us < 1000) {
+		MONITOR_INC(MONITOR_IBUF_MERGE_ON_READ_LT_1MS);
+	} else if (us < 10000) {
+		MONITOR_INC(MONITOR_IBUF_MERGE_ON_READ_LT_10MS);
+	} else if (us < 100000) {
+		MONITOR_INC(MONITOR_IBUF_MERGE_ON_READ_LT_100MS);
+	} else {
+		MONITOR_INC(MONITOR_IBUF_MERGE_ON_READ_GE_100MS);
+	}
+}
+
 /** When an index page is read from a disk to the buffer pool, this function
 applies any buffered operations to the page and deletes the entries from the
 insert buffer. If the page is not read, but created in the buffer pool, this
@@ -4539,6 +4731,8 @@ ibuf_merge_or_delete_for_page(
 	search_tuple = ibuf_search_tuple_build(
 		page_id.space(), page_id.page_no(), heap);
 
+	const uintmax_t	merge_start = block != NULL ? ut_time_us(NULL) : 0;
+
 	if (block != NULL) {
 		/* Move the ownership of the x-latch on the page to this OS
 		thread, so that we can acquire a second x-latch on it. This
@@ -4793,6 +4987,10 @@ ibuf_merge_or_delete_for_page(
 	ibuf_add_ops(ibuf->n_merged_ops, mops);
 	ibuf_add_ops(ibuf->n_discarded_ops, dops);
 
+	if (block != NULL) {
+		ibuf_merge_on_read_monitor(ut_time_us(NULL) - merge_start);
+	}
+
 #ifdef UNIV_IBUF_COUNT_DEBUG
 	ut_a(ibuf_count_get(page_id) == 0);
 #endif
@@ -608,6 +608,27 @@ btr_estimate_n_rows_in_range(
 	const dtuple_t*	tuple2,
 	page_cur_mode_t	mode2);
 
+/** Keys that split an index into ranges */
+typedef std::vector<const dtuple_t*, ut_allocator<const dtuple_t*> >
+	btr_keys_t;
+
+/** Get keys that split an index into ranges of about the same size.
+The keys are taken from the node pointers of the highest level of the
+tree that has enough of them, without reading any leaf pages.
+With n keys, range 0 holds the records less than keys[0], range i the
+records in [keys[i - 1], keys[i]) and range n the records not less
+than keys[n - 1].
+@param[in]	index		index tree
+@param[in]	n_ranges	number of ranges wanted
+@param[in,out]	heap		memory heap for the keys
+@param[out]	keys		between 0 and n_ranges - 1 ascending keys */
+void
+btr_get_split_keys(
+	dict_index_t*	index,
+	ulint		n_ranges,
+	mem_heap_t*	heap,
+	btr_keys_t&	keys);
+
 /*******************************************************************//**
 Estimates the number of different key values in a given index, for
 each n-column prefix of the index where 1 <= n <= dict_index_get_n_unique(index).
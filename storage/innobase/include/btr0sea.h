@@ -271,6 +271,20 @@ struct btr_search_t{
 				which would have succeeded, or did succeed,
 				using the hash index;
 				the range is 0 .. BTR_SEARCH_BUILD_LIMIT + 5 */
+	ulint	n_hash_suspend;	/*!< number of searches for which the hash
+				index will not be used or built for this
+				index, because too few hash searches
+				succeeded; 0 if the hash index is in use */
+	ulint	n_hash_window;	/*!< number of hash searches since the
+				fraction of successful ones was last
+				evaluated */
+	ulint	n_hash_window_hits;
+				/*!< number of successful hash searches
+				among n_hash_window */
+	ulint	n_hash_hits;	/*!< number of successful hash searches */
+	ulint	n_hash_misses;	/*!< number of failed hash searches */
+	ulint	n_hash_suspended;
+				/*!< number of times n_hash_suspend was set */
 	/* @} */
 	ulint	ref_count;	/*!< Number of blocks in this index tree
 				that have search index built
@@ -278,6 +292,12 @@ struct btr_search_t{
 				Protected by search latch except
 				when during initialization in
 				btr_search_info_create(). */
+	ulint	n_pages_built;	/*!< number of times a hash index was
+				built for a page of this index;
+				protected by search latch */
+	ulint	n_rows_built;	/*!< number of hash index entries added
+				when building the hash index for pages
+				of this index; protected by search latch */
 
 	/*---------------------- @{ */
 	ulint	n_fields;	/*!< recommended prefix length for hash search:
@@ -340,6 +360,22 @@ pattern */
 the hash index */
 #define BTR_SEARCH_ON_HASH_LIMIT	3
 
+/** Number of hash searches on an index after which the fraction of
+successful ones is evaluated */
+#define BTR_SEARCH_HIT_WINDOW		10000
+
+/** If fewer than this many percent of the hash searches on an index
+succeed, the hash index is not used for the index for a while */
+#define BTR_SEARCH_MIN_HIT_PERCENT	25
+
+/** Number of searches on an index for which the hash index is not used
+or built after too few hash searches succeeded. Suspending such an index
+only removes its own latch traffic from its partition. The contention
+of the searches on one hot index for the S-latch of its partition is not
+addressed: a latch per index would be shared by the same searches, and
+hot indexes are kept apart by innodb_adaptive_hash_index_parts. */
+#define BTR_SEARCH_SUSPEND_SEARCHES	100000
+
 /** We do this many searches before trying to keep the search latch
 over calls from MySQL. If we notice someone waiting for the latch, we
 again set this much timeout. This is to reduce contention. */
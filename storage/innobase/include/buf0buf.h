@@ -508,7 +508,7 @@ buf_page_get_known_nowait(
 
 /** Given a tablespace id and page number tries to get that page. If the
 page is not in the buffer pool it is not loaded and NULL is returned.
-Suitable for using when holding the lock_sys_t::mutex.
+Suitable for using when holding lock_sys->latch.
 @param[in]	page_id	page id
 @param[in]	file	file name
 @param[in]	line	line where called
@@ -523,7 +523,7 @@ buf_page_try_get_func(
 
 /** Tries to get a page.
 If the page is not in the buffer pool it is not loaded. Suitable for using
-when holding the lock_sys_t::mutex.
+when holding lock_sys->latch.
 @param[in]	page_id	page identifier
 @param[in]	mtr	mini-transaction
 @return the page if in buffer pool, NULL if not */
@@ -833,6 +833,21 @@ buf_page_is_corrupted(
 #endif
 	MY_ATTRIBUTE((warn_unused_result));
 
+/** Check which of a number of consecutive uncompressed pages carry a
+valid CRC-32C checksum, checksumming several pages at a time. Use this to
+avoid buf_page_is_corrupted() on the pages that pass; the other pages
+may still be valid and must be checked with buf_page_is_corrupted().
+Every innodb_checksum_algorithm accepts CRC-32C, but the strict ones
+other than strict_crc32 warn about it, so no page passes with those.
+@param[in]	buf	UNIV_PAGE_SIZE bytes for each page
+@param[in]	n	number of pages
+@param[out]	valid	for each page, whether buf_page_is_corrupted()
+would certainly return false */
+void
+buf_page_is_crc32_valid_multi(
+	const byte*	buf,
+	ulint		n,
+	bool*		valid);
 
 #ifndef UNIV_INNOCHECKSUM
 
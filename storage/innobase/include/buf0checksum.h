@@ -45,6 +45,17 @@ buf_calc_page_crc32(
 	const byte*	page,
 	bool		use_legacy_big_endian = false);
 
+/** Calculate the CRC32 checksums of several pages at once.
+@param[in]	pages		buffer pages (UNIV_PAGE_SIZE bytes each)
+@param[in]	n		number of pages
+@param[out]	checksums	the checksum of each page, as computed by
+buf_calc_page_crc32() */
+void
+buf_calc_page_crc32_multi(
+	const byte* const*	pages,
+	ulint			n,
+	uint32_t*		checksums);
+
 /** Calculate a checksum which is stored to the page when it is written
 to a file. Note that we must be careful to calculate the same value on
 32-bit and 64-bit architectures.
@@ -35,6 +35,9 @@ Created 2011/12/19 Inaam Rana
 
 /** Doublewrite system */
 extern buf_dblwr_t*	buf_dblwr;
+/** Doublewrite files, one per buffer pool instance, or NULL if
+innodb_doublewrite_per_instance is not in effect */
+extern buf_dblwr_t*	buf_dblwr_files;
 /** Set to TRUE when the doublewrite buffer is being created */
 extern ibool		buf_dblwr_being_created;
 
@@ -61,6 +64,14 @@ buf_dblwr_init_or_load_pages(
 	pfs_os_file_t	file,
 	const char*	path);
 
+/** Create or open the doublewrite files of the buffer pool instances
+when innodb_doublewrite_per_instance is set, and remove doublewrite files
+that are no longer used. This must be called after crash recovery.
+@return whether the operation succeeded */
+MY_ATTRIBUTE((warn_unused_result))
+bool
+buf_dblwr_files_create();
+
 /** Process and remove the double write buffer pages for all tablespaces. */
 void
 buf_dblwr_process();
@@ -109,6 +120,13 @@ of threads can occur. */
 void
 buf_dblwr_flush_buffered_writes();
 
+/** Flush possible buffered writes of the doublewrite buffer that the
+pages of a buffer pool instance are written through.
+@see buf_dblwr_flush_buffered_writes()
+@param[in]	buf_pool	buffer pool instance */
+void
+buf_dblwr_flush_buffered_writes(const buf_pool_t* buf_pool);
+
 /********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
 the page to the datafile and sync the datafile. This function is used
@@ -130,6 +148,17 @@ struct buf_dblwr_t{
 	ulint		block1;	/*!< the page number of the first
 				doublewrite block (64 pages) */
 	ulint		block2;	/*!< page number of the second block */
+	char*		path;	/*!< path of the doublewrite file of a
+				buffer pool instance, or NULL for the
+				doublewrite buffer in the system
+				tablespace */
+	pfs_os_file_t	file;	/*!< handle of the doublewrite file,
+				if path != NULL */
+	ulint		size;	/*!< number of pages in write_buf */
+	ulint		batch_size;/*!< number of pages at the start of
+				write_buf that are used in batch
+				flushing; the rest are used in single
+				page flushes */
 	ulint		first_free;/*!< first free position in write_buf
 				measured in units of UNIV_PAGE_SIZE */
 	ulint		b_reserved;/*!< number of slots currently reserved
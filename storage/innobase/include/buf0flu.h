@@ -125,6 +125,12 @@ buf_flush_do_batch(
 	lsn_t			lsn_limit,
 	flush_counters_t*	n);
 
+/** Wake up the LRU manager thread of a buffer pool instance, if
+innodb_lru_manager is in effect.
+@param[in]	buf_pool	buffer pool instance */
+void
+buf_flush_lru_manager_wake(const buf_pool_t* buf_pool);
+
 /** This utility flushes dirty blocks from the end of the flush list of all
 buffer pool instances.
 NOTE: The calling thread is not allowed to own any latches on pages!
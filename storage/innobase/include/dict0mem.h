@@ -1879,7 +1879,7 @@ struct dict_table_t {
 	kept in trx_t. In order to quickly determine whether a transaction has
 	locked the AUTOINC lock we keep a pointer to the transaction here in
 	the 'autoinc_trx' member. This is to avoid acquiring the
-	lock_sys_t::mutex and scanning the vector in trx_t.
+	lock_sys->latch and scanning the vector in trx_t.
 	When an AUTOINC lock has to wait, the corresponding lock instance is
 	created on the trx lock heap rather than use the pre-allocated instance
 	in autoinc_lock below. */
@@ -1902,14 +1902,14 @@ struct dict_table_t {
 
 	/** This counter is used to track the number of granted and pending
 	autoinc locks on this table. This value is set after acquiring the
-	lock_sys_t::mutex but we peek the contents to determine whether other
+	lock_sys->latch in exclusive mode but we peek the contents to determine whether other
 	transactions have acquired the AUTOINC lock or not. Of course only one
 	transaction can be granted the lock but there can be multiple
 	waiters. */
 	ulong					n_waiting_or_granted_auto_inc_locks;
 
 	/** The transaction that currently holds the the AUTOINC lock on this
-	table. Protected by lock_sys->mutex. */
+	table. Protected by the exclusive lock_sys->latch. */
 	const trx_t*				autoinc_trx;
 
 	/* @} */
@@ -1924,7 +1924,7 @@ struct dict_table_t {
 
 	/** Count of the number of record locks on this table. We use this to
 	determine whether we can evict the table from the dictionary cache.
-	It is protected by lock_sys->mutex. */
+	It is updated with atomic operations by holders of lock_sys->latch. */
 	ulint					n_rec_locks;
 
 #ifndef DBUG_ASSERT_EXISTS
@@ -1936,12 +1936,32 @@ struct dict_table_t {
 	ulint					n_ref_count;
 
 public:
-	/** List of locks on the table. Protected by lock_sys->mutex. */
+	/** List of locks on the table. Protected by the exclusive
+	lock_sys->latch. */
 	table_lock_list_t			locks;
 
 	/** Timestamp of the last modification of this table. */
 	time_t					update_time;
 
+	/** Serialisation number of the last transaction that committed
+	a modification of this table. Updated without a latch, like
+	update_time. */
+	trx_id_t				purge_mod_trx_no;
+
+	/** Purge statistics of the table since it was loaded to the
+	dictionary cache. The undo log records of a table may be purged
+	by several purge threads at a time, which update these with
+	atomic operations. */
+	/* @{ */
+	/** Serialisation number of the transaction whose undo log
+	record of this table was purged last */
+	trx_id_t				purge_trx_no;
+	/** Number of undo log records purged */
+	ulint					n_purged_recs;
+	/** Microseconds spent purging the undo log records */
+	ulint					purge_usec;
+	/* @} */
+
 #ifdef UNIV_DEBUG
 	/** Value of 'magic_n'. */
 	#define DICT_TABLE_MAGIC_N		76333786
@@ -367,6 +367,15 @@ ulint
 ibuf_merge_in_background(
 	bool	full);
 
+/** Merge the changes that were buffered since the previous call, by
+reading the changed pages in ascending order, in batches. The reads are
+asynchronous, so that the merge is done by the I/O threads and usually
+completes before a query reads the pages. The pages are remembered
+while innodb_change_buffer_eager_merge is set.
+@return number of pages for which a read was requested */
+ulint
+ibuf_merge_recent();
+
 /** Contracts insert buffer trees by reading pages referring to space_id
 to the buffer pool.
 @returns number of pages merged.*/
@@ -57,6 +57,8 @@ class ReadView;
 
 /** The value of innodb_deadlock_detect */
 extern my_bool	innobase_deadlock_detect;
+/** The value of innodb_deadlock_detect_interval */
+extern ulong	innodb_deadlock_detect_interval;
 
 /*********************************************************************//**
 Gets the size of a lock struct.
@@ -605,7 +607,7 @@ lock_print_info_all_transactions(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys->mutex. */
+The counter is updated atomically; the caller need not hold any latch. */
 ulint
 lock_number_of_rows_locked(
 /*=======================*/
@@ -614,7 +616,7 @@ lock_number_of_rows_locked(
 
 /*********************************************************************//**
 Return the number of table locks for a transaction.
-The caller must be holding lock_sys->mutex. */
+The caller must be holding lock_sys->latch in exclusive mode. */
 ulint
 lock_number_of_tables_locked(
 /*=========================*/
@@ -723,6 +725,15 @@ lock_table_has_locks(
 					held on records in this table or on the
 					table itself */
 
+/** Check the transactions that are waiting for locks for deadlocks, and
+resolve any deadlocks by cancelling the waits of victim transactions.
+This is invoked by lock_wait_timeout_thread() when
+innodb_deadlock_detect_interval is set, instead of checking each
+lock wait when it is enqueued.
+The caller must be holding lock_sys->wait_mutex. */
+void
+lock_deadlock_check_waits();
+
 /*********************************************************************//**
 A thread which wakes up threads whose lock wait may have lasted too long.
 @return a dummy parameter */
@@ -896,14 +907,38 @@ struct lock_op_t{
 
 typedef ib_mutex_t LockMutex;
 
+/** Number of mutexes on the cells of lock_sys->rec_hash */
+#define LOCK_REC_HASH_N_MUTEXES	256
+
+/** A mutex on cells of lock_sys->rec_hash, see lock_rec_page_enter() */
+struct lock_rec_hash_mutex_t {
+	LockMutex	mutex;			/*!< the mutex */
+	char		pad[CACHE_LINE_SIZE];	/*!< padding to keep the
+						mutexes on separate cache
+						lines */
+};
+
 /** The lock system struct */
 struct lock_sys_t{
 	char		pad1[CACHE_LINE_SIZE];	/*!< padding to prevent other
 						memory update hotspots from
 						residing on the same memory
 						cache line */
-	LockMutex	mutex;			/*!< Mutex protecting the
-						locks */
+	rw_lock_t	latch;			/*!< Latch protecting the
+						locks. Operations that only
+						access the record locks of one
+						page hold it in shared mode
+						together with the rec_hash
+						mutex of the page; all other
+						operations, including table
+						locks and deadlock detection,
+						hold it exclusively */
+	lock_rec_hash_mutex_t
+			rec_hash_mutexes[LOCK_REC_HASH_N_MUTEXES];
+						/*!< Mutexes protecting the
+						record locks in the cells of
+						rec_hash for the holders of
+						the shared latch */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
 	hash_table_t*	prdt_hash;		/*!< hash table of the predicate
@@ -913,7 +948,7 @@ struct lock_sys_t{
 
 	char		pad2[CACHE_LINE_SIZE];	/*!< Padding */
 	LockMutex	wait_mutex;		/*!< Mutex protecting the
-						next two fields */
+						next three fields */
 	srv_slot_t*	waiting_threads;	/*!< Array  of user threads
 						suspended while waiting for
 						locks within InnoDB, protected
@@ -927,6 +962,10 @@ struct lock_sys_t{
 						in the waiting_threads array,
 						protected by
 						lock_sys->wait_mutex */
+	ulint		n_waits;		/*!< number of slots reserved
+						in waiting_threads so far,
+						protected by
+						lock_sys->wait_mutex */
 
 	ulint		n_lock_max_wait_time;	/*!< Max wait time */
 
@@ -984,21 +1023,27 @@ lock_rec_trx_wait(
 /** The lock system */
 extern lock_sys_t*	lock_sys;
 
-/** Test if lock_sys->mutex can be acquired without waiting. */
+/** Try to acquire lock_sys->latch in exclusive mode without waiting.
+@return 0 if the latch was acquired */
 #define lock_mutex_enter_nowait() 		\
-	(lock_sys->mutex.trylock(__FILE__, __LINE__))
+	(!rw_lock_x_lock_nowait(&lock_sys->latch))
+
+/** Test if lock_sys->latch is held in exclusive mode. */
+#define lock_mutex_own() rw_lock_own(&lock_sys->latch, RW_LOCK_X)
 
-/** Test if lock_sys->mutex is owned. */
-#define lock_mutex_own() (lock_sys->mutex.is_owned())
+/** Test if lock_sys->latch is held in shared or exclusive mode. */
+#define lock_mutex_own_s_or_x()				\
+	rw_lock_own_flagged(&lock_sys->latch,		\
+			    RW_LOCK_FLAG_X | RW_LOCK_FLAG_S)
 
-/** Acquire the lock_sys->mutex. */
+/** Acquire lock_sys->latch in exclusive mode, for accessing any locks. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys->mutex);		\
+	rw_lock_x_lock(&lock_sys->latch);	\
 } while (0)
 
-/** Release the lock_sys->mutex. */
+/** Release lock_sys->latch from exclusive mode. */
 #define lock_mutex_exit() do {			\
-	lock_sys->mutex.exit();			\
+	rw_lock_x_unlock(&lock_sys->latch);	\
 } while (0)
 
 /** Test if lock_sys->wait_mutex is owned. */
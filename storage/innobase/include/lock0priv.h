@@ -111,7 +111,8 @@ operator<<(std::ostream& out, const lock_rec_t& lock)
 	return(lock.print(out));
 }
 
-/** Lock struct; protected by lock_sys->mutex */
+/** Lock struct; protected by lock_sys->latch in exclusive mode, or for
+record locks, by the shared latch and the rec_hash mutex of the page */
 struct lock_t {
 	trx_t*		trx;		/*!< transaction owning the
 					lock */
@@ -562,6 +563,31 @@ enum lock_rec_req_status {
         LOCK_REC_SUCCESS_CREATED
 };
 
+/** Acquire the latches for an operation that only accesses the record
+locks of one page: lock_sys->latch in shared mode, and the mutex of the
+lock_sys->rec_hash cell of the page.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number */
+void
+lock_rec_page_enter(ulint space, ulint page_no);
+
+/** Release the latches that lock_rec_page_enter() acquired.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number */
+void
+lock_rec_page_exit(ulint space, ulint page_no);
+
+#ifdef UNIV_DEBUG
+/** Determine whether the current thread may access the record locks
+of a page: it holds lock_sys->latch exclusively, or it has called
+lock_rec_page_enter() for the page.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number
+@return whether the record locks of the page are latched */
+bool
+lock_rec_page_own(ulint space, ulint page_no);
+#endif /* UNIV_DEBUG */
+
 /**
 Record lock ID */
 struct RecID {
@@ -861,7 +887,8 @@ class RecLock {
 	Setup the context from the requirements */
 	void init(const page_t* page)
 	{
-		ut_ad(lock_mutex_own());
+		ut_ad(lock_rec_page_own(m_rec_id.m_space_id,
+					m_rec_id.m_page_no));
 		ut_ad(!srv_read_only_mode);
 		ut_ad(dict_index_is_clust(m_index)
 		      || !dict_index_is_online_ddl(m_index));
@@ -1171,6 +1198,21 @@ lock_table_has(
 	const dict_table_t*	table,	/*!< in: table */
 	enum lock_mode		mode);	/*!< in: lock mode */
 
+#ifdef UNIV_DEBUG
+/** Determine whether the current thread may access a lock.
+@param[in]	lock	record or table lock
+@return whether the lock is latched, see lock_rec_page_own() */
+inline
+bool
+lock_own(const lock_t* lock)
+{
+	return(lock_get_type_low(lock) == LOCK_REC
+	       ? lock_rec_page_own(lock->un_member.rec_lock.space,
+				   lock->un_member.rec_lock.page_no)
+	       : lock_mutex_own());
+}
+#endif /* UNIV_DEBUG */
+
 #include "lock0priv.ic"
 
 #endif /* lock0priv_h */
@@ -53,6 +53,10 @@ step which modifies the database, is started */
 #define LOG_CHECKPOINT_FREE_PER_THREAD	(4 * UNIV_PAGE_SIZE)
 #define LOG_CHECKPOINT_EXTRA_FREE	(8 * UNIV_PAGE_SIZE)
 
+/** Number of events that threads waiting for log_writer_thread or
+log_flusher_thread are spread over, by the log block they wait for */
+#define LOG_N_WAIT_EVENTS		64
+
 typedef ulint (*log_checksum_func_t)(const byte* log_block);
 
 /** Pointer to the log checksum calculation function. Protected with
@@ -101,6 +105,31 @@ log_margin_checkpoint_age(
 lsn_t
 log_reserve_and_open(
 	ulint	len);
+/** Reserve space for log records in the log buffer that was opened with
+log_reserve_and_open(), and advance the lsn past them. The records must
+be copied to the returned position with log_buffer_write(), which does
+not require log_sys->mutex, followed by log_buffer_write_completed().
+@param[in]	len	length of the log records
+@return where to copy the log records to */
+byte*
+log_buffer_reserve(
+	ulint	len);
+
+/** Copy log records to space that was reserved by log_buffer_reserve().
+@param[in,out]	ptr	where to copy to, in the log buffer
+@param[in]	str	log records
+@param[in]	len	length of str
+@return where to copy further log records of the reservation to */
+byte*
+log_buffer_write(
+	byte*		ptr,
+	const byte*	str,
+	ulint		len);
+
+/** Note that the log records of a log_buffer_reserve() were copied. */
+void
+log_buffer_write_completed();
+
 /************************************************************//**
 Writes to the log the string given. It is assumed that the caller holds the
 log mutex. */
@@ -179,7 +208,9 @@ log_io_complete(
 /******************************************************//**
 This function is called, e.g., when a transaction wants to commit. It checks
 that the log has been written to the log file up to the last log entry written
-by the transaction. If there is a flush running, it waits and checks if the
+by the transaction. If log_writer_thread and log_flusher_thread are running,
+it wakes them up and waits until they have written (and flushed) enough.
+Otherwise, if there is a flush running, it waits and checks if the
 flush flushed enough. If not, starts a new flush. */
 void
 log_write_up_to(
@@ -599,6 +630,13 @@ struct log_t{
 	lsn_t		lsn;		/*!< log sequence number */
 	ulint		buf_free;	/*!< first free offset within the log
 					buffer in use */
+	ulint		n_pending_copies;
+					/*!< number of log_buffer_reserve()
+					whose records are still being copied
+					to the log buffer; the buffer must
+					not be written or moved before this
+					is 0. Incremented while holding
+					mutex, decremented atomically. */
 
 	char		pad2[CACHE_LINE_SIZE];/*!< Padding */
 	LogSysMutex	mutex;		/*!< mutex protecting the log */
@@ -666,6 +704,25 @@ struct log_t{
 					when a flush is running;
 					os_event_set() and os_event_reset()
 					are protected by log_sys_t::mutex */
+	os_event_t	writer_event;	/*!< set to wake up log_writer_thread
+					when the log should be written */
+	os_event_t	flusher_event;	/*!< set to wake up log_flusher_thread
+					when the log should be flushed */
+	os_event_t	write_events[LOG_N_WAIT_EVENTS];
+					/*!< events for waiting until the log
+					is written up to an lsn, see
+					log_wait_event() */
+	os_event_t	flush_events[LOG_N_WAIT_EVENTS];
+					/*!< events for waiting until the log
+					is flushed up to an lsn */
+	lsn_t		write_notified_lsn;
+					/*!< write_lsn up to which
+					write_events have been set;
+					protected by log_sys_t::mutex */
+	lsn_t		flush_notified_lsn;
+					/*!< flushed_to_disk_lsn up to which
+					flush_events have been set;
+					protected by log_sys_t::mutex */
 	ulint		n_log_ios;	/*!< number of log i/os initiated thus
 					far */
 	ulint		n_log_ios_old;	/*!< number of log i/o's at the
@@ -796,6 +853,21 @@ extern os_event_t	log_scrub_event;
 /** Whether log_scrub_thread is active */
 extern bool		log_scrub_thread_active;
 
+/** Whether log_writer_thread is active */
+extern bool		log_writer_thread_active;
+/** Whether log_flusher_thread is active */
+extern bool		log_flusher_thread_active;
+
+/** Start log_writer_thread and log_flusher_thread, which write and
+flush the log on behalf of the threads that call log_write_up_to(). */
+void
+log_writer_threads_start();
+
+/** Wake up log_writer_thread and log_flusher_thread, so that they
+notice a shutdown. */
+void
+log_writer_threads_wakeup();
+
 #include "log0log.ic"
 
 #endif
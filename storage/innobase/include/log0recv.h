@@ -36,6 +36,7 @@ Created 9/20/1997 Heikki Tuuri
 #include "ut0new.h"
 
 #include <list>
+#include <map>
 #include <vector>
 
 /** Is recv_writer_thread active? */
@@ -175,22 +176,44 @@ struct recv_addr_t{
 };
 
 struct recv_dblwr_t {
-	/** Add a page frame to the doublewrite recovery buffer. */
-	void add(byte* page) {
-		pages.push_back(page);
-	}
+	/** Add a page frame to the doublewrite recovery buffer.
+	@param[in]	page	page frame */
+	void add(byte* page);
 
 	/** Find a doublewrite copy of a page.
 	@param[in]	space_id	tablespace identifier
 	@param[in]	page_no		page number
-	@return	page frame
+	@return	the copy with the highest FIL_PAGE_LSN
 	@retval NULL if no page was found */
-	const byte* find_page(ulint space_id, ulint page_no);
+	const byte* find_page(ulint space_id, ulint page_no) const;
+
+	/** Remove all page frames. */
+	void clear()
+	{
+		pages.clear();
+		newest.clear();
+	}
 
 	typedef std::list<byte*, ut_allocator<byte*> >	list;
 
 	/** Recovered doublewrite buffer page frames */
 	list	pages;
+
+private:
+	/** @return the key of a page in newest */
+	static ib_uint64_t key(ulint space_id, ulint page_no)
+	{
+		return(ib_uint64_t(space_id) << 32 | page_no);
+	}
+
+	typedef std::map<
+		ib_uint64_t, const byte*, std::less<ib_uint64_t>,
+		ut_allocator<std::pair<const ib_uint64_t, const byte*> > >
+		newest_map;
+
+	/** The frame in pages with the highest FIL_PAGE_LSN of each page,
+	so that find_page() does not have to scan pages */
+	newest_map	newest;
 };
 
 /** Recovery system data structure */
@@ -253,6 +276,10 @@ struct recv_sys_t{
 	hash_table_t*	addr_hash;/*!< hash table of file addresses of pages */
 	ulint		n_addrs;/*!< number of not processed hashed file
 				addresses in the hash table */
+	/** n_addrs at the start of recv_apply_hashed_log_recs() */
+	ulint		n_addrs_batch;
+	/** the time when recv_apply_hashed_log_recs() started */
+	ib_time_t	apply_start_time;
 
 	recv_dblwr_t	dblwr;
 
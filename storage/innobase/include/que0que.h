@@ -104,8 +104,8 @@ que_graph_free(
 			afterwards! */
 /**********************************************************************//**
 Stops a query thread if graph or trx is in a state requiring it. The
-conditions are tested in the order (1) graph, (2) trx. The lock_sys_t::mutex
-has to be reserved.
+conditions are tested in the order (1) graph, (2) trx. lock_sys->latch
+has to be reserved in exclusive mode.
 @return TRUE if stopped */
 ibool
 que_thr_stop(
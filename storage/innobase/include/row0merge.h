@@ -137,6 +137,10 @@ struct row_merge_dup_t {
 					(index->table), or NULL if not
 					rebuilding table */
 	ulint			n_dup;	/*!< number of duplicates */
+	ulint*			n_dup_all;
+					/*!< number of duplicates found by
+					all threads that build indexes in
+					parallel, or NULL */
 };
 
 /*************************************************************//**
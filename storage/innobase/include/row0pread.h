@@ -0,0 +1,71 @@
+/*****************************************************************************
+
+Copyright (c) 2018, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/row0pread.h
+Consistent read of a whole table with several threads
+*******************************************************/
+
+#ifndef row0pread_h
+#define row0pread_h
+
+#include "univ.i"
+#include "db0err.h"
+
+struct row_prebuilt_t;
+
+/** Number of ranges the clustered index is split into per scan thread,
+so that threads which get smaller ranges can pick up more of them */
+#define ROW_PREAD_RANGES_PER_THREAD	8
+
+/** Receives the rows of row_pread_scan().
+@param[in,out]	arg		argument passed to row_pread_scan()
+@param[in]	thread_no	number of the scan thread, less than n_threads
+@param[in]	mysql_rec	row in the MySQL format */
+typedef void (*row_pread_callback_t)(void* arg, ulint thread_no,
+				     const byte* mysql_rec);
+
+/** Check if the rows can be read with row_pread_scan(): this is
+not the case if the template contains columns that have to be copied
+to prebuilt->blob_heap or virtual columns, or if the table has a
+fulltext index (prebuilt->fts_doc_id would have to be updated).
+@param[in]	prebuilt	prebuilt struct, with the template built
+				for the clustered index
+@return whether the table can be scanned in parallel */
+bool
+row_pread_is_possible(const row_prebuilt_t* prebuilt);
+
+/** Read all rows of the table in the consistent read view of the
+transaction, with up to n_threads threads. The clustered index is split
+into ranges by the keys of its node pointers, see btr_get_split_keys(),
+and each thread reads ranges until none is left. The calling thread
+is scan thread 0.
+@param[in,out]	prebuilt	prebuilt struct, see row_pread_is_possible()
+@param[in]	n_threads	maximum number of scan threads
+@param[in]	callback	called for every row by the thread that read it
+@param[in,out]	arg		argument of callback
+@return DB_SUCCESS, DB_INTERRUPTED if the query was killed,
+or error code */
+dberr_t
+row_pread_scan(
+	row_prebuilt_t*		prebuilt,
+	ulint			n_threads,
+	row_pread_callback_t	callback,
+	void*			arg);
+
+#endif /* row0pread_h */
@@ -141,6 +141,9 @@ enum monitor_id_t {
 	MONITOR_MODULE_LOCK,
 	MONITOR_DEADLOCK,
 	MONITOR_TIMEOUT,
+	MONITOR_DEADLOCK_DETECT_ROUNDS,
+	MONITOR_DEADLOCK_DETECT_TIME,
+	MONITOR_DEADLOCK_DETECT_LATENCY,
 	MONITOR_LOCKREC_WAIT,
 	MONITOR_TABLELOCK_WAIT,
 	MONITOR_NUM_RECLOCK_REQ,
@@ -238,6 +241,13 @@ enum monitor_id_t {
 	MONITOR_LRU_SINGLE_FLUSH_SCANNED_PER_CALL,
 	MONITOR_LRU_SINGLE_FLUSH_FAILURE_COUNT,
 	MONITOR_LRU_GET_FREE_SEARCH,
+	MONITOR_LRU_GET_FREE_WAIT_TIME,
+	MONITOR_LRU_GET_FREE_WAIT_LT_100US,
+	MONITOR_LRU_GET_FREE_WAIT_LT_1MS,
+	MONITOR_LRU_GET_FREE_WAIT_LT_10MS,
+	MONITOR_LRU_GET_FREE_WAIT_LT_100MS,
+	MONITOR_LRU_GET_FREE_WAIT_GE_100MS,
+	MONITOR_LRU_MANAGER_BATCHES,
 	MONITOR_LRU_SEARCH_SCANNED,
 	MONITOR_LRU_SEARCH_SCANNED_NUM_CALL,
 	MONITOR_LRU_SEARCH_SCANNED_PER_CALL,
@@ -291,6 +301,16 @@ enum monitor_id_t {
 	MONITOR_OVLD_OS_LOG_FSYNC,
 	MONITOR_OVLD_OS_LOG_PENDING_FSYNC,
 	MONITOR_OVLD_OS_LOG_PENDING_WRITES,
+	MONITOR_OS_AIO_READ_TIME,
+	MONITOR_OS_AIO_READ_LT_1MS,
+	MONITOR_OS_AIO_READ_LT_10MS,
+	MONITOR_OS_AIO_READ_LT_100MS,
+	MONITOR_OS_AIO_READ_GE_100MS,
+	MONITOR_OS_AIO_WRITE_TIME,
+	MONITOR_OS_AIO_WRITE_LT_1MS,
+	MONITOR_OS_AIO_WRITE_LT_10MS,
+	MONITOR_OS_AIO_WRITE_LT_100MS,
+	MONITOR_OS_AIO_WRITE_GE_100MS,
 
 	/* Transaction related counters */
 	MONITOR_MODULE_TRX,
@@ -316,6 +336,12 @@ enum monitor_id_t {
 	MONITOR_DML_PURGE_DELAY,
 	MONITOR_PURGE_STOP_COUNT,
 	MONITOR_PURGE_RESUME_COUNT,
+	MONITOR_PURGE_N_REC_HANDLED,
+	MONITOR_PURGE_N_TABLES,
+	MONITOR_PURGE_N_THREADS_USED,
+	MONITOR_PURGE_TRUNCATE_HISTORY_COUNT,
+	MONITOR_PURGE_TRUNCATE_HISTORY_MICROSECOND,
+	MONITOR_PURGE_N_LOG_TRUNCATED,
 
 	/* Recovery related counters */
 	MONITOR_MODULE_RECOVERY,
@@ -390,6 +416,13 @@ enum monitor_id_t {
 	MONITOR_OVLD_IBUF_MERGE_DISCARD_PURGE,
 	MONITOR_OVLD_IBUF_MERGES,
 	MONITOR_OVLD_IBUF_SIZE,
+	MONITOR_IBUF_MERGE_ON_READ_TIME,
+	MONITOR_IBUF_MERGE_ON_READ_LT_1MS,
+	MONITOR_IBUF_MERGE_ON_READ_LT_10MS,
+	MONITOR_IBUF_MERGE_ON_READ_LT_100MS,
+	MONITOR_IBUF_MERGE_ON_READ_GE_100MS,
+	MONITOR_IBUF_SWEEP_PAGES,
+	MONITOR_IBUF_EAGER_MERGE_PAGES,
 
 	/* Counters for server operations */
 	MONITOR_MODULE_SERVER,
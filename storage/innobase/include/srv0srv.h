@@ -88,6 +88,10 @@ struct srv_stats_t
 	space in the log buffer and have to flush it */
 	ulint_ctr_1_t		log_waits;
 
+	/** Number of times a log write waited for mini-transactions
+	to finish copying their records to the log buffer */
+	ulint_ctr_1_t		log_copy_waits;
+
 	/** Count the number of times the doublewrite buffer was flushed */
 	ulint_ctr_1_t		dblwr_writes;
 
@@ -221,6 +225,9 @@ extern char*		srv_buf_dump_filename;
 and/or load it during startup. */
 extern char		srv_buffer_pool_dump_at_shutdown;
 extern char		srv_buffer_pool_load_at_startup;
+/** innodb_buffer_pool_load_threads; the number of threads that read the
+pages of a buffer pool load */
+extern ulong		srv_n_buf_load_threads;
 
 /* Whether to disable file system cache if it is defined */
 extern char		srv_disable_sort_file_cache;
@@ -267,6 +274,9 @@ extern ibool	srv_locks_unsafe_for_binlog;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** innodb_ddl_threads; the number of threads that scan the clustered index
+and sort and load the indexes in ALTER TABLE */
+extern ulong	srv_n_ddl_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -275,6 +285,9 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
+/** innodb_use_io_uring; whether native aio is done with io_uring
+instead of libaio. Reset at startup if io_uring is not available. */
+extern my_bool	srv_use_io_uring;
 extern my_bool	srv_numa_interleave;
 
 /* Use atomic writes i.e disable doublewrite buffer */
@@ -380,6 +393,8 @@ extern const ulong	srv_buf_pool_instances_default;
 extern ulong	srv_n_page_hash_locks;
 /** Scan depth for LRU flush batch i.e.: number of blocks scanned*/
 extern ulong	srv_LRU_scan_depth;
+/** Whether each buffer pool instance has an LRU manager thread */
+extern my_bool	srv_lru_manager;
 /** Whether or not to flush neighbors of a block */
 extern ulong	srv_buf_pool_dump_pct;	/*!< dump that may % of each buffer
 					pool during BP dump */
@@ -415,6 +430,9 @@ extern ulong	srv_idle_flush_pct;
 
 extern uint	srv_change_buffer_max_size;
 
+/** innodb_change_buffer_eager_merge */
+extern my_bool	srv_change_buffer_eager_merge;
+
 /* Number of IO operations per second the server can do */
 extern ulong    srv_io_capacity;
 
@@ -439,6 +457,10 @@ extern ulint	srv_max_n_open_files;
 
 extern ulong	srv_n_page_cleaners;
 
+/** innodb_recovery_threads; the number of threads that apply the redo log
+during crash recovery */
+extern ulong	srv_n_recovery_threads;
+
 extern double	srv_max_dirty_pages_pct;
 extern double	srv_max_dirty_pages_pct_lwm;
 
@@ -464,6 +486,10 @@ extern ibool	srv_innodb_status;
 extern unsigned long long	srv_stats_transient_sample_pages;
 extern my_bool			srv_stats_persistent;
 extern unsigned long long	srv_stats_persistent_sample_pages;
+/** Minimum percentage of the leaf pages that persistent statistics sample */
+extern ulong			srv_stats_persistent_sample_pct;
+/** Number of threads that analyze the indexes of a table */
+extern ulong			srv_stats_analyze_threads;
 extern my_bool			srv_stats_auto_recalc;
 extern my_bool			srv_stats_include_delete_marked;
 extern unsigned long long	srv_stats_modified_counter;
@@ -471,6 +497,11 @@ extern my_bool			srv_stats_sample_traditional;
 
 extern ibool	srv_use_doublewrite_buf;
 extern ulong	srv_doublewrite_batch_size;
+/** innodb_doublewrite_per_instance; whether pages are written through
+a doublewrite file per buffer pool instance */
+extern my_bool	srv_dblwr_per_instance;
+/** innodb_doublewrite_file_pages; size of a doublewrite file in pages */
+extern ulong	srv_dblwr_file_pages;
 extern ulong	srv_checksum_algorithm;
 
 extern double	srv_max_buf_pool_modified_pct;
@@ -519,6 +550,10 @@ extern bool	srv_dict_stats_thread_active;
 /* TRUE if enable log scrubbing */
 extern my_bool	srv_scrub_log;
 
+/** whether the redo log is written and flushed by log_writer_thread
+and log_flusher_thread */
+extern my_bool	srv_log_writer_threads;
+
 extern ulong	srv_n_spin_wait_rounds;
 extern ulong	srv_n_free_tickets_to_enter;
 extern ulong	srv_thread_sleep_delay;
@@ -598,6 +633,7 @@ extern mysql_pfs_key_t	io_log_thread_key;
 extern mysql_pfs_key_t	io_read_thread_key;
 extern mysql_pfs_key_t	io_write_thread_key;
 extern mysql_pfs_key_t	page_cleaner_thread_key;
+extern mysql_pfs_key_t	buf_lru_manager_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
 extern mysql_pfs_key_t	srv_error_monitor_thread_key;
 extern mysql_pfs_key_t	srv_lock_timeout_thread_key;
@@ -785,8 +821,8 @@ ibool
 srv_printf_innodb_monitor(
 /*======================*/
 	FILE*	file,		/*!< in: output stream */
-	ibool	nowait,		/*!< in: whether to wait for the
-				lock_sys_t::mutex */
+	ibool	nowait,		/*!< in: whether to wait for
+				lock_sys->latch */
 	ulint*	trx_start,	/*!< out: file position of the start of
 				the list of active transactions */
 	ulint*	trx_end);	/*!< out: file position of the end of
@@ -968,6 +1004,7 @@ struct export_var_t{
 	ulint innodb_dblwr_writes;		/*!< srv_dblwr_writes */
 	ibool innodb_have_atomic_builtins;	/*!< HAVE_ATOMIC_BUILTINS */
 	ulint innodb_log_waits;			/*!< srv_log_waits */
+	ulint innodb_log_copy_waits;		/*!< srv_log_copy_waits */
 	ulint innodb_log_write_requests;	/*!< srv_log_write_requests */
 	ulint innodb_log_writes;		/*!< srv_log_writes */
 	lsn_t innodb_os_log_written;		/*!< srv_os_log_written */
@@ -571,6 +571,8 @@ extern purge_sys_t*	purge_sys;
 struct trx_purge_rec_t {
 	trx_undo_rec_t*	undo_rec;	/*!< Record to purge */
 	roll_ptr_t	roll_ptr;	/*!< File pointr to UNDO record */
+	trx_id_t	trx_no;		/*!< Serialisation number of the
+					transaction that wrote the record */
 };
 
 #include "trx0purge.ic"
@@ -63,6 +63,14 @@ undo_no_t
 trx_undo_rec_get_undo_no(
 /*=====================*/
 	const trx_undo_rec_t*	undo_rec);	/*!< in: undo log record */
+/**********************************************************************//**
+Reads the table id from an undo log record.
+@return table id */
+UNIV_INLINE
+table_id_t
+trx_undo_rec_get_table_id(
+/*======================*/
+	const trx_undo_rec_t*	undo_rec);	/*!< in: undo log record */
 
 /**********************************************************************//**
 Returns the start of the undo record data area. */
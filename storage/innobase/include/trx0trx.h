@@ -270,7 +270,7 @@ This function is used to find one X/Open XA distributed transaction
 which is in the prepared state
 @return trx or NULL; on match, the trx->xid will be invalidated;
 note that the trx may have been committed, unless the caller is
-holding lock_sys->mutex */
+holding lock_sys->latch in exclusive mode */
 trx_t *
 trx_get_trx_by_xid(
 /*===============*/
@@ -331,7 +331,7 @@ trx_print_low(
 
 /**********************************************************************//**
 Prints info about a transaction.
-The caller must hold lock_sys->mutex and trx_sys.mutex.
+The caller must hold lock_sys->latch in exclusive mode and trx_sys.mutex.
 When possible, use trx_print() instead. */
 void
 trx_print_latched(
@@ -343,7 +343,7 @@ trx_print_latched(
 
 /**********************************************************************//**
 Prints info about a transaction.
-Acquires and releases lock_sys->mutex. */
+Acquires and releases lock_sys->latch in exclusive mode. */
 void
 trx_print(
 /*======*/
@@ -616,7 +616,7 @@ To query the state either of the mutexes is sufficient within the locking
 code and no mutex is required when the query thread is no longer waiting. */
 
 /** The locks and state of an active transaction. Protected by
-lock_sys->mutex, trx->mutex or both. */
+lock_sys->latch, trx->mutex or both. */
 struct trx_lock_t {
 	ulint		n_active_thrs;	/*!< number of active query threads */
 
@@ -628,10 +628,11 @@ struct trx_lock_t {
 					TRX_QUE_LOCK_WAIT, this points to
 					the lock request, otherwise this is
 					NULL; set to non-NULL when holding
-					both trx->mutex and lock_sys->mutex;
-					set to NULL when holding
-					lock_sys->mutex; readers should
-					hold lock_sys->mutex, except when
+					both trx->mutex and the exclusive
+					lock_sys->latch; set to NULL when
+					holding lock_sys->latch exclusively;
+					readers should hold lock_sys->latch
+					exclusively, except when
 					they are holding trx->mutex and
 					wait_lock==NULL */
 	ib_uint64_t	deadlock_mark;	/*!< A mark field that is initialized
@@ -645,13 +646,20 @@ struct trx_lock_t {
 					resolution, it sets this to true.
 					Protected by trx->mutex. */
 	time_t		wait_started;	/*!< lock wait started at this time,
-					protected only by lock_sys->mutex */
+					protected only by the exclusive
+					lock_sys->latch */
+	uintmax_t	wait_started_us;/*!< lock wait started at this time
+					in microseconds, for measuring the
+					deadlock detection latency;
+					protected only by the exclusive
+					lock_sys->latch */
 
 	que_thr_t*	wait_thr;	/*!< query thread belonging to this
 					trx that is in QUE_THR_LOCK_WAIT
 					state. For threads suspended in a
-					lock wait, this is protected by
-					lock_sys->mutex. Otherwise, this may
+					lock wait, this is protected by the
+					exclusive lock_sys->latch. Otherwise,
+					this may
 					only be modified by the thread that is
 					serving the running transaction. */
 
@@ -664,12 +672,16 @@ struct trx_lock_t {
 	ulint		table_cached;	/*!< Next free table lock in pool */
 
 	mem_heap_t*	lock_heap;	/*!< memory heap for trx_locks;
-					protected by lock_sys->mutex */
+					protected by the exclusive
+					lock_sys->latch, or by the shared
+					latch and trx->mutex */
 
 	trx_lock_list_t trx_locks;	/*!< locks requested by the transaction;
 					insertions are protected by trx->mutex
-					and lock_sys->mutex; removals are
-					protected by lock_sys->mutex */
+					and lock_sys->latch in any mode;
+					removals are protected by the
+					exclusive lock_sys->latch, or by the
+					shared latch and trx->mutex */
 
 	lock_pool_t	table_locks;	/*!< All table locks requested by this
 					transaction, including AUTOINC locks */
@@ -683,9 +695,10 @@ struct trx_lock_t {
 					check for this cancel of a transaction's
 					locks and avoid reacquiring the trx
 					mutex to prevent recursive deadlocks.
-					Protected by both the lock sys mutex
+					Protected by both lock_sys->latch
 					and the trx_t::mutex. */
-	ulint		n_rec_locks;	/*!< number of rec locks in this trx */
+	ulint		n_rec_locks;	/*!< number of rec locks in this trx;
+					updated with atomic operations */
 
 	/** The transaction called ha_innobase::start_stmt() to
 	lock a table. Most likely a temporary table. */
@@ -792,7 +805,7 @@ transactions. The trx_sys.mutex prevents a race condition between it
 and lock_trx_release_locks() [invoked by trx_commit()].
 
 * trx_print_low() may access transactions not associated with the current
-thread. The caller must be holding lock_sys->mutex.
+thread. The caller must be holding lock_sys->latch in exclusive mode.
 
 * When a transaction handle is in the trx_sys.mysql_trx_list or
 trx_sys.trx_list, some of its fields must not be modified without
@@ -801,7 +814,7 @@ holding trx_sys.mutex exclusively.
 * The locking code (in particular, lock_deadlock_recursive() and
 lock_rec_convert_impl_to_expl()) will access transactions associated
 to other connections. The locks of transactions are protected by
-lock_sys->mutex and sometimes by trx->mutex. */
+lock_sys->latch and sometimes by trx->mutex. */
 
 typedef enum {
 	TRX_SERVER_ABORT = 0,
@@ -874,7 +887,7 @@ struct trx_t {
 	TrxMutex	mutex;		/*!< Mutex protecting the fields
 					state and lock (except some fields
 					of lock, which are protected by
-					lock_sys->mutex) */
+					lock_sys->latch) */
 
 	/* Note: in_depth was split from in_innodb for fixing a RO
 	performance issue. Acquiring the trx_t::mutex for each row
@@ -965,8 +978,9 @@ struct trx_t {
 	ACTIVE->COMMITTED is possible when the transaction is in
 	rw_trx_hash.
 
-	Transitions to COMMITTED are protected by both lock_sys->mutex
-	and trx->mutex.
+	Transitions to COMMITTED are protected by both lock_sys->latch
+	(in shared mode at least) and trx->mutex, so that holders of the
+	exclusive latch see a stable state.
 
 	NOTE: Some of these state change constraints are an overkill,
 	currently only required for a consistent view for printing stats.
@@ -978,7 +992,7 @@ struct trx_t {
 					transaction, or NULL if not yet set */
 	trx_lock_t	lock;		/*!< Information about the transaction
 					locks and state. Protected by
-					trx->mutex or lock_sys->mutex
+					trx->mutex or lock_sys->latch
 					or both */
 	bool		is_recovered;	/*!< 0=normal transaction,
 					1=recovered, must be rolled back,
@@ -1161,7 +1175,7 @@ struct trx_t {
 					also in the lock list trx_locks. This
 					vector needs to be freed explicitly
 					when the trx instance is destroyed.
-					Protected by lock_sys->mutex. */
+					Protected by lock_sys->latch. */
 	/*------------------------------*/
 	bool		read_only;	/*!< true if transaction is flagged
 					as a READ-ONLY transaction.
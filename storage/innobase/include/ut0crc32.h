@@ -47,6 +47,19 @@ typedef uint32_t	(*ut_crc32_func_t)(const byte* ptr, ulint len);
 /** Pointer to CRC32 calculation function. */
 extern ut_crc32_func_t	ut_crc32;
 
+/** Calculates CRC32 of several buffers of the same length. This is
+faster than calling ut_crc32() for each buffer, because the calculations
+are interleaved.
+@param bufs - buffers over which to calculate CRC32.
+@param len - length of each buffer in bytes.
+@param crcs - CRC32 of each buffer (output).
+@param n - number of buffers. */
+typedef void	(*ut_crc32_multi_func_t)(const byte* const* bufs, ulint len,
+					 uint32_t* crcs, ulint n);
+
+/** Pointer to the CRC32 calculation function for several buffers. */
+extern ut_crc32_multi_func_t	ut_crc32_multi;
+
 /** CRC32 calculation function, which uses big-endian byte order
 when converting byte strings to integers internally. */
 extern uint32_t ut_crc32_legacy_big_endian(const byte* buf, ulint len);
@@ -66,6 +66,20 @@ IF(UNIX)
       ADD_DEFINITIONS(-DLINUX_NATIVE_AIO=1)
       LINK_LIBRARIES(aio)
     ENDIF()
+
+    # io_uring is used through the system calls, without liburing
+    CHECK_C_SOURCE_COMPILES("
+    #include <linux/io_uring.h>
+    #include <sys/syscall.h>
+    int main()
+    {
+      return __NR_io_uring_setup + __NR_io_uring_enter + IORING_OP_WRITEV;
+    }"
+    HAVE_LINUX_IO_URING)
+
+    IF(HAVE_LINUX_IO_URING)
+      ADD_DEFINITIONS(-DLINUX_IO_URING=1)
+    ENDIF()
     IF(HAVE_LIBNUMA)
       LINK_LIBRARIES(numa)
     ENDIF()
@@ -39,6 +39,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "trx0purge.h"
 #include "trx0sys.h"
 #include "srv0mon.h"
+#include "sync0sync.h"
 #include "ut0vec.h"
 #include "btr0btr.h"
 #include "dict0boot.h"
@@ -59,6 +60,9 @@ ulong innodb_lock_schedule_algorithm = INNODB_LOCK_SCHEDULE_ALGORITHM_FCFS;
 /** The value of innodb_deadlock_detect */
 my_bool	innobase_deadlock_detect;
 
+/** The value of innodb_deadlock_detect_interval */
+ulong	innodb_deadlock_detect_interval;
+
 /** Total number of cached record locks */
 static const ulint	REC_LOCK_CACHE = 8;
 
@@ -82,7 +86,7 @@ lock_rec_has_to_wait_in_queue(
 
 /*************************************************************//**
 Grants a lock to a waiting lock request and releases the waiting transaction.
-The caller must hold lock_sys->mutex. */
+The caller must hold lock_sys->latch in exclusive mode. */
 static
 void
 lock_grant(
@@ -129,6 +133,11 @@ class DeadlockChecker {
 		const lock_t*	lock,
 		trx_t*		trx);
 
+	/** Check all lock waits for deadlocks, and resolve the deadlocks
+	by choosing victim transactions and cancelling their waits.
+	See innodb_deadlock_detect_interval. */
+	static void check_waits();
+
 private:
 	/** Do a shallow copy. Default destructor OK.
 	@param trx the start transaction (start node)
@@ -243,6 +252,11 @@ class DeadlockChecker {
 	/** Rollback transaction selected as the victim. */
 	void trx_rollback();
 
+	/** Determine when the deadlock found by search() was formed.
+	@return the start time of the latest lock wait in the cycle,
+	in microseconds */
+	uintmax_t cycle_formed() const;
+
 	/** Looks iteratively for a deadlock. Note: the joining transaction
 	may have been granted its lock by the deadlock checks.
 
@@ -280,9 +294,14 @@ class DeadlockChecker {
 		ulint		m_heap_no;	/*!< heap number if rec lock */
 	};
 
-	/** Used in deadlock tracking. Protected by lock_sys->mutex. */
+	/** Used in deadlock tracking. Protected by the exclusive
+	lock_sys->latch. */
 	static ib_uint64_t	s_lock_mark_counter;
 
+	/** Value of lock_sys->n_waits at the last check_waits() round.
+	Protected by lock_sys->wait_mutex. */
+	static ulint		s_n_waits_checked;
+
 	/** Calculation steps thus far. It is the count of the nodes visited. */
 	ulint			m_cost;
 
@@ -315,6 +334,9 @@ ib_uint64_t	DeadlockChecker::s_lock_mark_counter = 0;
 /** The stack used for deadlock searches. */
 DeadlockChecker::state_t	DeadlockChecker::s_states[MAX_STACK_SIZE];
 
+/** Value of lock_sys->n_waits at the last check_waits() round. */
+ulint	DeadlockChecker::s_n_waits_checked = 0;
+
 #ifdef UNIV_DEBUG
 /*********************************************************************//**
 Validates the lock system.
@@ -491,7 +513,12 @@ lock_sys_create(
 
 	lock_sys->last_slot = lock_sys->waiting_threads;
 
-	mutex_create(LATCH_ID_LOCK_SYS, &lock_sys->mutex);
+	rw_lock_create(lock_sys_latch_key, &lock_sys->latch, SYNC_LOCK_SYS);
+
+	for (ulint i = 0; i < LOCK_REC_HASH_N_MUTEXES; i++) {
+		mutex_create(LATCH_ID_LOCK_REC_HASH,
+			     &lock_sys->rec_hash_mutexes[i].mutex);
+	}
 
 	mutex_create(LATCH_ID_LOCK_SYS_WAIT, &lock_sys->wait_mutex);
 
@@ -507,6 +534,59 @@ lock_sys_create(
 	}
 }
 
+/** Get the mutex that protects the lock_sys->rec_hash cell of a page
+for the holders of the shared lock_sys->latch.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number
+@return the mutex */
+static inline
+LockMutex*
+lock_rec_hash_mutex_get(ulint space, ulint page_no)
+{
+	/* The cell index, and thus the choice of the mutex, can only
+	change in lock_sys_resize(), which holds the exclusive latch. */
+	return(&lock_sys->rec_hash_mutexes[lock_rec_hash(space, page_no)
+					   % LOCK_REC_HASH_N_MUTEXES].mutex);
+}
+
+/** Acquire the latches for an operation that only accesses the record
+locks of one page: lock_sys->latch in shared mode, and the mutex of the
+lock_sys->rec_hash cell of the page.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number */
+void
+lock_rec_page_enter(ulint space, ulint page_no)
+{
+	rw_lock_s_lock(&lock_sys->latch);
+	mutex_enter(lock_rec_hash_mutex_get(space, page_no));
+}
+
+/** Release the latches that lock_rec_page_enter() acquired.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number */
+void
+lock_rec_page_exit(ulint space, ulint page_no)
+{
+	mutex_exit(lock_rec_hash_mutex_get(space, page_no));
+	rw_lock_s_unlock(&lock_sys->latch);
+}
+
+#ifdef UNIV_DEBUG
+/** Determine whether the current thread may access the record locks
+of a page: it holds lock_sys->latch exclusively, or it has called
+lock_rec_page_enter() for the page.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number
+@return whether the record locks of the page are latched */
+bool
+lock_rec_page_own(ulint space, ulint page_no)
+{
+	return(lock_mutex_own()
+	       || (rw_lock_own(&lock_sys->latch, RW_LOCK_S)
+		   && mutex_own(lock_rec_hash_mutex_get(space, page_no))));
+}
+#endif /* UNIV_DEBUG */
+
 /** Calculates the fold value of a lock: used in migrating the hash table.
 @param[in]	lock	record lock object
 @return	folded value */
@@ -592,7 +672,12 @@ lock_sys_close(void)
 
 	os_event_destroy(lock_sys->timeout_event);
 
-	mutex_destroy(&lock_sys->mutex);
+	rw_lock_free(&lock_sys->latch);
+
+	for (ulint i = 0; i < LOCK_REC_HASH_N_MUTEXES; i++) {
+		mutex_destroy(&lock_sys->rec_hash_mutexes[i].mutex);
+	}
+
 	mutex_destroy(&lock_sys->wait_mutex);
 
 	srv_slot_t*	slot = lock_sys->waiting_threads;
@@ -647,7 +732,7 @@ lock_reset_lock_and_trx_wait(
 	lock_t*	lock)	/*!< in/out: record lock */
 {
 	ut_ad(lock_get_wait(lock));
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_own(lock));
 
 	if (lock->trx->lock.wait_lock &&
 	    lock->trx->lock.wait_lock != lock) {
@@ -997,7 +1082,7 @@ lock_rec_reset_nth_bit(
 
 	if (bit != 0) {
 		ut_ad(lock->trx->lock.n_rec_locks > 0);
-		--lock->trx->lock.n_rec_locks;
+		my_atomic_addlint(&lock->trx->lock.n_rec_locks, ulint(-1));
 	}
 
 	return(bit);
@@ -1146,7 +1231,8 @@ lock_rec_has_expl(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(block->page.id.space(),
+			       block->page.id.page_no()));
 	ut_ad((precise_mode & LOCK_MODE_MASK) == LOCK_S
 	      || (precise_mode & LOCK_MODE_MASK) == LOCK_X);
 	ut_ad(!(precise_mode & LOCK_INSERT_INTENTION));
@@ -1195,7 +1281,8 @@ lock_rec_other_has_expl_req(
 					are taken into account */
 {
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(block->page.id.space(),
+			       block->page.id.page_no()));
 	ut_ad(mode == LOCK_X || mode == LOCK_S);
 
 	/* Only GAP lock can be on SUPREMUM, and we are not looking for
@@ -1310,7 +1397,8 @@ lock_rec_other_has_conflicting(
 {
 	lock_t*		lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(block->page.id.space(),
+			       block->page.id.page_no()));
 
 	bool	is_supremum = (heap_no == PAGE_HEAP_NO_SUPREMUM);
 
@@ -1394,7 +1482,7 @@ lock_sec_rec_some_has_impl(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys->mutex. */
+The counter is updated atomically; the caller need not hold any latch. */
 ulint
 lock_number_of_rows_locked(
 /*=======================*/
@@ -1407,7 +1495,7 @@ lock_number_of_rows_locked(
 
 /*********************************************************************//**
 Return the number of table locks for a transaction.
-The caller must be holding lock_sys->mutex. */
+The caller must be holding lock_sys->latch in exclusive mode. */
 ulint
 lock_number_of_tables_locked(
 /*=========================*/
@@ -1526,7 +1614,8 @@ RecLock::lock_alloc(
 	const RecID&	rec_id,
 	ulint		size)
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(rec_id.m_space_id, rec_id.m_page_no));
+	ut_ad(trx_mutex_own(trx));
 
 	lock_t*	lock;
 
@@ -1576,9 +1665,9 @@ RecLock::lock_alloc(
 
 	lock_rec_set_nth_bit(lock, rec_id.m_heap_no);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
 
 	return(lock);
 }
@@ -1741,7 +1830,7 @@ Add the lock to the record lock hash and the transaction's lock list
 void
 RecLock::lock_add(lock_t* lock, bool add_to_hash) const
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_own(lock));
 	ut_ad(trx_mutex_own(lock->trx));
 
 	bool wait_lock = m_mode & LOCK_WAIT;
@@ -1750,7 +1839,7 @@ RecLock::lock_add(lock_t* lock, bool add_to_hash) const
 		ulint	key = m_rec_id.fold();
 		hash_table_t *lock_hash = lock_hash_get(m_mode);
 
-		++lock->index->table->n_rec_locks;
+		my_atomic_addlint(&lock->index->table->n_rec_locks, 1);
 
 		if (innodb_lock_schedule_algorithm == INNODB_LOCK_SCHEDULE_ALGORITHM_VATS
 			&& !thd_is_replication_slave_thread(lock->trx->mysql_thd)) {
@@ -1793,13 +1882,23 @@ RecLock::create(
 #endif /* WITH_WSREP */
 ) const
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(m_rec_id.m_space_id, m_rec_id.m_page_no));
 	ut_ad(owns_trx_mutex == trx_mutex_own(trx));
 
-	/* Create the explicit lock instance and initialise it. */
+	/* Create the explicit lock instance and initialise it. The lock
+	memory of trx may concurrently be used by another thread that is
+	converting an implicit lock of trx under a different page shard. */
+
+	if (!owns_trx_mutex) {
+		trx_mutex_enter(trx);
+	}
 
 	lock_t*	lock = lock_alloc(trx, m_index, m_mode, m_rec_id, m_size);
 
+	if (!owns_trx_mutex) {
+		trx_mutex_exit(trx);
+	}
+
 	if (prdt != NULL && (m_mode & LOCK_PREDICATE)) {
 
 		lock_prdt_set_prdt(lock, prdt);
@@ -1884,13 +1983,13 @@ RecLock::create(
 					   << wsrep_thd_query(trx->mysql_thd);
 			}
 
-                        ++lock->index->table->n_rec_locks;
+                        my_atomic_addlint(&lock->index->table->n_rec_locks, 1);
 			/* have to bail out here to avoid lock_set_lock... */
 			return(lock);
 		}
 		trx_mutex_exit(c_lock->trx);
 		/* we don't want to add to hash anymore, but need other updates from lock_add */
-		++lock->index->table->n_rec_locks;
+		my_atomic_addlint(&lock->index->table->n_rec_locks, 1);
 		lock_add(lock, false);
 	} else {
 #endif /* WITH_WSREP */
@@ -2034,6 +2133,7 @@ RecLock::set_wait_state(lock_t* lock)
 	ut_ad(lock_get_wait(lock));
 
 	m_trx->lock.wait_started = ut_time();
+	m_trx->lock.wait_started_us = ut_time_us(NULL);
 
 	m_trx->lock.que_state = TRX_QUE_LOCK_WAIT;
 
@@ -2149,7 +2249,8 @@ lock_rec_add_to_queue(
 					transaction mutex */
 {
 #ifdef UNIV_DEBUG
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(block->page.id.space(),
+			       block->page.id.page_no()));
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index)
 	      || dict_index_get_online_status(index) != ONLINE_INDEX_CREATION);
@@ -2288,7 +2389,25 @@ lock_rec_lock(
   ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
   DBUG_EXECUTE_IF("innodb_report_deadlock", return DB_DEADLOCK;);
 
-  lock_mutex_enter();
+  const ulint space= block->page.id.space();
+  const ulint page_no= block->page.id.page_no();
+  /*
+    Requests that can be granted without waiting only touch the lock queue
+    of this page, and they are served under the shard latch of the page.
+    A request that may have to wait enqueues itself and runs the deadlock
+    detector, which requires the exclusive lock_sys->latch.
+  */
+  bool sharded= true;
+#ifdef WITH_WSREP
+  if (wsrep_on_trx(trx))
+    sharded= false;
+#endif /* WITH_WSREP */
+
+retry:
+  if (sharded)
+    lock_rec_page_enter(space, page_no);
+  else
+    lock_mutex_enter();
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_S ||
         lock_table_has(trx, index->table, LOCK_IS));
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_X ||
@@ -2308,6 +2427,13 @@ lock_rec_lock(
         if (lock_t *wait_for= lock_rec_other_has_conflicting(mode, block,
                                                              heap_no, trx))
         {
+          if (sharded)
+          {
+            trx_mutex_exit(trx);
+            lock_rec_page_exit(space, page_no);
+            sharded= false;
+            goto retry;
+          }
           /*
             If another transaction has a non-gap conflicting
             request in the queue, as this transaction does not
@@ -2350,7 +2476,10 @@ lock_rec_lock(
       RecLock(index, block, heap_no, mode).create(trx, false, true);
     err= DB_SUCCESS_LOCKED_REC;
   }
-  lock_mutex_exit();
+  if (sharded)
+    lock_rec_page_exit(space, page_no);
+  else
+    lock_mutex_exit();
   MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
   return err;
 }
@@ -2372,7 +2501,7 @@ lock_rec_has_to_wait_in_queue(
 	ulint		bit_offset;
 	hash_table_t*	hash;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_own(wait_lock));
 	ut_ad(lock_get_wait(wait_lock));
 	ut_ad(lock_get_type_low(wait_lock) == LOCK_REC);
 
@@ -2419,7 +2548,8 @@ lock_rec_has_to_wait_in_queue(
 
 /*************************************************************//**
 Grants a lock to a waiting lock request and releases the waiting transaction.
-The caller must hold lock_sys->mutex but not lock->trx->mutex. */
+The caller must hold lock_sys->latch in exclusive mode, but not
+lock->trx->mutex. */
 static
 void
 lock_grant(
@@ -2427,7 +2557,7 @@ lock_grant(
 	lock_t*	lock,	/*!< in/out: waiting lock request */
 	bool	owns_trx_mutex)    /*!< in: whether lock->trx->mutex is owned */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_own(lock));
 	ut_ad(trx_mutex_own(lock->trx) == owns_trx_mutex);
 
 	lock_reset_lock_and_trx_wait(lock);
@@ -2614,7 +2744,7 @@ RecLock::lock_add_priority(
 	/* Add the lock to lock hash table. */
 	lock->hash = add_position->hash;
 	add_position->hash = lock;
-	++lock->index->table->n_rec_locks;
+	my_atomic_addlint(&lock->index->table->n_rec_locks, 1);
 
 	return(grant_lock);
 }
@@ -2709,7 +2839,7 @@ lock_rec_cancel(
 {
 	que_thr_t*	thr;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_own(lock));
 	ut_ad(lock_get_type_low(lock) == LOCK_REC);
 
 	/* Reset the bit (there can be only one set bit) in the lock bitmap */
@@ -2824,7 +2954,7 @@ lock_rec_dequeue_from_page(
 	trx_lock_t*	trx_lock;
 	hash_table_t*	lock_hash;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_own(in_lock));
 	ut_ad(lock_get_type_low(in_lock) == LOCK_REC);
 	/* We may or may not be holding in_lock->trx->mutex here. */
 
@@ -2834,7 +2964,7 @@ lock_rec_dequeue_from_page(
 	page_no = in_lock->un_member.rec_lock.page_no;
 
 	ut_ad(in_lock->index->table->n_rec_locks > 0);
-	in_lock->index->table->n_rec_locks--;
+	my_atomic_addlint(&in_lock->index->table->n_rec_locks, ulint(-1));
 
 	lock_hash = lock_hash_get(in_lock->type_mode);
 
@@ -2843,8 +2973,8 @@ lock_rec_dequeue_from_page(
 
 	UT_LIST_REMOVE(trx_lock->trx_locks, in_lock);
 
-	MONITOR_INC(MONITOR_RECLOCK_REMOVED);
-	MONITOR_DEC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_REMOVED);
+	MONITOR_ATOMIC_DEC(MONITOR_NUM_RECLOCK);
 
 	if (innodb_lock_schedule_algorithm
 		== INNODB_LOCK_SCHEDULE_ALGORITHM_FCFS ||
@@ -2908,7 +3038,7 @@ lock_rec_discard(
 	page_no = in_lock->un_member.rec_lock.page_no;
 
 	ut_ad(in_lock->index->table->n_rec_locks > 0);
-	in_lock->index->table->n_rec_locks--;
+	my_atomic_addlint(&in_lock->index->table->n_rec_locks, ulint(-1));
 
 	HASH_DELETE(lock_t, hash, lock_hash_get(in_lock->type_mode),
 			    lock_rec_fold(space, page_no), in_lock);
@@ -3089,7 +3219,7 @@ lock_rec_inherit_to_gap_if_gap_lock(
 {
 	lock_t*	lock;
 
-	lock_mutex_enter();
+	lock_rec_page_enter(block->page.id.space(), block->page.id.page_no());
 
 	for (lock = lock_rec_get_first(lock_sys->rec_hash, block, heap_no);
 	     lock != NULL;
@@ -3106,7 +3236,7 @@ lock_rec_inherit_to_gap_if_gap_lock(
 		}
 	}
 
-	lock_mutex_exit();
+	lock_rec_page_exit(block->page.id.space(), block->page.id.page_no());
 }
 
 /*************************************************************//**
@@ -4420,6 +4550,7 @@ lock_table_enqueue_waiting(
 	trx->lock.que_state = TRX_QUE_LOCK_WAIT;
 
 	trx->lock.wait_started = ut_time();
+	trx->lock.wait_started_us = ut_time_us(NULL);
 	trx->lock.was_chosen_as_deadlock_victim = false;
 
 	ut_a(que_thr_stop(thr));
@@ -4984,6 +5115,66 @@ lock_release(
 	}
 }
 
+/** Release the record locks of a transaction that has been committed
+in memory, holding lock_sys->latch in shared mode, so that transactions
+that access the locks of other pages are not blocked. Predicate locks and
+table locks are left for lock_release().
+@param[in,out]	trx	transaction in TRX_STATE_COMMITTED_IN_MEMORY */
+static
+void
+lock_release_rec_locks(
+	trx_t*	trx)
+{
+	ulint	count = 0;
+
+	ut_ad(rw_lock_own(&lock_sys->latch, RW_LOCK_S));
+	ut_ad(!trx_mutex_own(trx));
+	ut_ad(trx_state_eq(trx, TRX_STATE_COMMITTED_IN_MEMORY));
+
+	for (;;) {
+		/* Other threads may append locks to trx->lock.trx_locks
+		under trx->mutex while we are not holding the exclusive
+		latch, when inheriting gap locks to other records. */
+		trx_mutex_enter(trx);
+
+		lock_t*	lock = UT_LIST_GET_LAST(trx->lock.trx_locks);
+
+		while (lock != NULL
+		       && (lock_get_type_low(lock) != LOCK_REC
+			   || (lock->type_mode
+			       & (LOCK_PREDICATE | LOCK_PRDT_PAGE)))) {
+			lock = UT_LIST_GET_PREV(trx_locks, lock);
+		}
+
+		trx_mutex_exit(trx);
+
+		if (lock == NULL) {
+			break;
+		}
+
+		ut_d(lock_check_dict_lock(lock));
+
+		/* Only this thread can remove the locks of trx, so
+		the lock remains valid after releasing trx->mutex. */
+		LockMutex*	mutex = lock_rec_hash_mutex_get(
+			lock->un_member.rec_lock.space,
+			lock->un_member.rec_lock.page_no);
+
+		mutex_enter(mutex);
+		trx_mutex_enter(trx);
+		lock_rec_dequeue_from_page(lock);
+		trx_mutex_exit(trx);
+		mutex_exit(mutex);
+
+		if (++count == LOCK_RELEASE_INTERVAL) {
+			/* Let any waiting exclusive latch requests in */
+			rw_lock_s_unlock(&lock_sys->latch);
+			rw_lock_s_lock(&lock_sys->latch);
+			count = 0;
+		}
+	}
+}
+
 /* True if a lock mode is S or X */
 #define IS_LOCK_S_OR_X(lock) \
 	(lock_get_mode(lock) == LOCK_S \
@@ -5521,7 +5712,8 @@ lock_table_queue_validate(
 		/* lock->trx->state cannot change from or to NOT_STARTED
 		while we are holding the trx_sys.mutex. It may change
 		from ACTIVE to PREPARED, but it may not change to
-		COMMITTED, because we are holding the lock_sys->mutex. */
+		COMMITTED, because we are holding lock_sys->latch in
+		exclusive mode. */
 		ut_ad(trx_assert_started(lock->trx));
 
 		if (!lock_get_wait(lock)) {
@@ -5609,7 +5801,7 @@ lock_rec_queue_validate(
 
 		ut_ad(lock_mutex_own());
 		/* impl_trx cannot be committed until lock_mutex_exit()
-		because lock_trx_release_locks() acquires lock_sys->mutex */
+		because lock_trx_release_locks() acquires lock_sys->latch */
 
 		if (impl_trx != NULL) {
 			const lock_t*	other_lock
@@ -5935,8 +6127,8 @@ lock_validate()
 				    (lock_validate_table_locks), 0);
 
 	/* Iterate over all the record locks and validate the locks. We
-	don't want to hog the lock_sys_t::mutex and the trx_sys_t::mutex.
-	Release both mutexes during the validation check. */
+	don't want to hog lock_sys->latch and the trx_sys_t::mutex.
+	Release both latches during the validation check. */
 
 	for (ulint i = 0; i < hash_get_n_cells(lock_sys->rec_hash); i++) {
 		ib_uint64_t	limit = 0;
@@ -6009,7 +6201,21 @@ lock_rec_insert_check_and_lock(
 	ulint		heap_no = page_rec_get_heap_no(next_rec);
 	ut_ad(!rec_is_default_row(next_rec, index));
 
-	lock_mutex_enter();
+	const ulint	space = block->page.id.space();
+	const ulint	page_no = block->page.id.page_no();
+	/* Unless the insert has to wait, only the lock queue of the
+	page is accessed, under the shard latch of the page. */
+	bool		sharded = true;
+#ifdef WITH_WSREP
+	sharded = !wsrep_on_trx(trx);
+#endif /* WITH_WSREP */
+
+retry:
+	if (sharded) {
+		lock_rec_page_enter(space, page_no);
+	} else {
+		lock_mutex_enter();
+	}
 	/* Because this code is invoked for a running transaction by
 	the thread that is serving the transaction, it is not necessary
 	to hold trx->mutex here. */
@@ -6024,7 +6230,11 @@ lock_rec_insert_check_and_lock(
 	if (lock == NULL) {
 		/* We optimize CPU time usage in the simplest case */
 
-		lock_mutex_exit();
+		if (sharded) {
+			lock_rec_page_exit(space, page_no);
+		} else {
+			lock_mutex_exit();
+		}
 
 		if (inherit_in && !dict_index_is_clust(index)) {
 			/* Update the page max trx id field */
@@ -6041,6 +6251,11 @@ lock_rec_insert_check_and_lock(
 	/* Spatial index does not use GAP lock protection. It uses
 	"predicate lock" to protect the "range" */
 	if (dict_index_is_spatial(index)) {
+		if (sharded) {
+			lock_rec_page_exit(space, page_no);
+		} else {
+			lock_mutex_exit();
+		}
 		return(DB_SUCCESS);
 	}
 
@@ -6063,6 +6278,14 @@ lock_rec_insert_check_and_lock(
 
 	if (wait_for != NULL) {
 
+		if (sharded) {
+			/* Enqueueing a waiting request and checking for
+			deadlocks requires the exclusive latch. */
+			lock_rec_page_exit(space, page_no);
+			sharded = false;
+			goto retry;
+		}
+
 		RecLock	rec_lock(thr, index, block, heap_no, type_mode);
 
 		trx_mutex_enter(trx);
@@ -6075,7 +6298,11 @@ lock_rec_insert_check_and_lock(
 		err = DB_SUCCESS;
 	}
 
-	lock_mutex_exit();
+	if (sharded) {
+		lock_rec_page_exit(space, page_no);
+	} else {
+		lock_mutex_exit();
+	}
 
 	switch (err) {
 	case DB_SUCCESS_LOCKED_REC:
@@ -6138,7 +6365,14 @@ lock_rec_convert_impl_to_expl_for_trx(
 
 	DEBUG_SYNC_C("before_lock_rec_convert_impl_to_expl_for_trx");
 
-	lock_mutex_enter();
+	const ulint	space = block->page.id.space();
+	const ulint	page_no = block->page.id.page_no();
+
+	lock_rec_page_enter(space, page_no);
+
+	/* lock_trx_release_locks() changes the state under trx->mutex
+	before it releases the record locks of trx. */
+	trx_mutex_enter(trx);
 
 	ut_ad(!trx_state_eq(trx, TRX_STATE_NOT_STARTED));
 
@@ -6151,10 +6385,12 @@ lock_rec_convert_impl_to_expl_for_trx(
 		type_mode = (LOCK_REC | LOCK_X | LOCK_REC_NOT_GAP);
 
 		lock_rec_add_to_queue(
-			type_mode, block, heap_no, index, trx, FALSE);
+			type_mode, block, heap_no, index, trx, true);
 	}
 
-	lock_mutex_exit();
+	trx_mutex_exit(trx);
+
+	lock_rec_page_exit(space, page_no);
 
 	trx->release_reference();
 
@@ -6954,11 +7190,20 @@ lock_trx_release_locks(
 
 	bool release_lock = UT_LIST_GET_LEN(trx->lock.trx_locks) > 0;
 
-	/* Don't take lock_sys mutex if trx didn't acquire any lock. */
-	if (release_lock) {
+	/* With the FCFS lock scheduling, releasing a record lock only
+	accesses the lock queue of its page, and the record locks can be
+	released under the shared lock_sys->latch. */
+	const bool shared = release_lock
+		&& (innodb_lock_schedule_algorithm
+		    == INNODB_LOCK_SCHEDULE_ALGORITHM_FCFS
+		    || thd_is_replication_slave_thread(trx->mysql_thd));
 
+	/* Don't take lock_sys->latch if trx didn't acquire any lock. */
+	if (shared) {
 		/* The transition of trx->state to TRX_STATE_COMMITTED_IN_MEMORY
-		is protected by both the lock_sys->mutex and the trx->mutex. */
+		is protected by both the lock_sys->latch and the trx->mutex. */
+		rw_lock_s_lock(&lock_sys->latch);
+	} else if (release_lock) {
 		lock_mutex_enter();
 	}
 
@@ -6986,7 +7231,11 @@ lock_trx_release_locks(
 
 		ut_a(release_lock);
 
-		lock_mutex_exit();
+		if (shared) {
+			rw_lock_s_unlock(&lock_sys->latch);
+		} else {
+			lock_mutex_exit();
+		}
 
 		while (trx->is_referenced()) {
 
@@ -6997,12 +7246,26 @@ lock_trx_release_locks(
 			ut_delay(srv_spin_wait_delay);
 		}
 
-		lock_mutex_enter();
+		if (shared) {
+			rw_lock_s_lock(&lock_sys->latch);
+		} else {
+			lock_mutex_enter();
+		}
 	}
 
 	ut_ad(!trx->is_referenced());
 
-	if (release_lock) {
+	if (shared) {
+		lock_release_rec_locks(trx);
+
+		rw_lock_s_unlock(&lock_sys->latch);
+
+		if (UT_LIST_GET_LEN(trx->lock.trx_locks) > 0) {
+			lock_mutex_enter();
+			lock_release(trx);
+			lock_mutex_exit();
+		}
+	} else if (release_lock) {
 
 		lock_release(trx);
 
@@ -7746,7 +8009,10 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 	We return current transaction as deadlock victim here. */
 	if (trx->in_innodb & TRX_FORCE_ROLLBACK_ASYNC) {
 		return(trx);
-	} else if (!innobase_deadlock_detect) {
+	} else if (!innobase_deadlock_detect
+		   || innodb_deadlock_detect_interval) {
+		/* If innodb_deadlock_detect_interval is set, the wait
+		will be checked by lock_deadlock_check_waits(). */
 		return(NULL);
 	}
 
@@ -7816,6 +8082,138 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 	return(victim_trx);
 }
 
+/** Determine when the deadlock found by search() was formed.
+@return the start time of the latest lock wait in the cycle,
+in microseconds */
+uintmax_t
+DeadlockChecker::cycle_formed() const
+{
+	ut_ad(lock_mutex_own());
+
+	/* The waiting transactions in the cycle are m_start and the
+	owners of the locks on the search stack. */
+	uintmax_t	formed = m_start->lock.wait_started_us;
+
+	for (size_t i = 0; i < m_n_elems; i++) {
+		formed = std::max(
+			formed, s_states[i].m_lock->trx->lock.wait_started_us);
+	}
+
+	return(formed);
+}
+
+/** Check all lock waits for deadlocks, and resolve the deadlocks by
+choosing victim transactions and cancelling their waits.
+See innodb_deadlock_detect_interval. */
+void
+DeadlockChecker::check_waits()
+{
+	ut_ad(lock_wait_mutex_own());
+	ut_ad(!srv_read_only_mode);
+
+	/* A deadlock is formed by a new lock wait, so there is nothing
+	to check unless a wait was suspended since the last round. As with
+	the checks when a wait is enqueued, cycles that are formed in any
+	other way are left to innodb_lock_wait_timeout. This avoids
+	taking the exclusive lock_sys->latch when there is nothing new. */
+	if (lock_sys->n_waits == s_n_waits_checked) {
+		return;
+	}
+
+	s_n_waits_checked = lock_sys->n_waits;
+
+	const srv_slot_t*	slot = lock_sys->waiting_threads;
+
+	while (slot < lock_sys->last_slot && !slot->in_use) {
+		++slot;
+	}
+
+	if (slot >= lock_sys->last_slot) {
+		/* The new waits already ended. */
+		return;
+	}
+
+	uintmax_t	start_time = ut_time_us(NULL);
+
+	lock_mutex_enter();
+
+	/* The slots cannot be freed or reserved while we are holding
+	lock_sys->wait_mutex. */
+	for (; slot < lock_sys->last_slot; ++slot) {
+
+		if (!slot->in_use) {
+			continue;
+		}
+
+		trx_t*		trx = thr_get_trx(slot->thr);
+		const lock_t*	wait_lock = trx->lock.wait_lock;
+
+		/* The lock may have been granted, or the wait may have
+		been cancelled as part of a deadlock resolved earlier in
+		this round. */
+		if (wait_lock == NULL
+		    || trx->lock.que_state != TRX_QUE_LOCK_WAIT) {
+			continue;
+		}
+
+		DeadlockChecker	checker(
+			trx, wait_lock, s_lock_mark_counter,
+			trx->mysql_thd
+			&& thd_need_wait_reports(trx->mysql_thd));
+
+		const trx_t*	victim_trx = checker.search();
+
+		if (victim_trx == NULL) {
+			continue;
+		}
+
+		if (checker.is_too_deep()) {
+			ut_ad(victim_trx == trx);
+
+			rollback_print(trx, wait_lock);
+		} else {
+			MONITOR_SET(MONITOR_DEADLOCK_DETECT_LATENCY,
+				    ut_time_us(NULL) - checker.cycle_formed());
+
+			print(victim_trx == trx
+			      ? "*** WE ROLL BACK TRANSACTION (2)\n"
+			      : "*** WE ROLL BACK TRANSACTION (1)\n");
+		}
+
+		trx_t*	victim = const_cast<trx_t*>(victim_trx);
+
+		trx_mutex_enter(victim);
+
+		victim->lock.was_chosen_as_deadlock_victim = true;
+
+		lock_cancel_waiting_and_release(victim->lock.wait_lock);
+
+		trx_mutex_exit(victim);
+
+		lock_deadlock_found = true;
+
+		MONITOR_INC(MONITOR_DEADLOCK);
+	}
+
+	lock_mutex_exit();
+
+	MONITOR_INC(MONITOR_DEADLOCK_DETECT_ROUNDS);
+	MONITOR_INC_TIME_IN_MICRO_SECS(MONITOR_DEADLOCK_DETECT_TIME,
+				       start_time);
+}
+
+/** Check the transactions that are waiting for locks for deadlocks, and
+resolve any deadlocks by cancelling the waits of victim transactions.
+This is invoked by lock_wait_timeout_thread() when
+innodb_deadlock_detect_interval is set, instead of checking each
+lock wait when it is enqueued.
+The caller must be holding lock_sys->wait_mutex. */
+void
+lock_deadlock_check_waits()
+{
+	DeadlockChecker::check_waits();
+}
+
 /**
 Allocate cached locks for the transaction.
 @param trx		allocate cached record locks for this transaction */
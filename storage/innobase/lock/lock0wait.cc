@@ -162,6 +162,8 @@ lock_wait_table_reserve_slot(
 				++lock_sys->last_slot;
 			}
 
+			++lock_sys->n_waits;
+
 			ut_ad(lock_sys->last_slot
 			      <= lock_sys->waiting_threads + OS_THREAD_MAX_N);
 
@@ -441,13 +443,14 @@ lock_wait_release_thread_if_suspended(
 	que_thr_t*	thr)	/*!< in: query thread associated with the
 				user OS thread	 */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_mutex_own_s_or_x());
 	ut_ad(trx_mutex_own(thr_get_trx(thr)));
 
-	/* We own both the lock mutex and the trx_t::mutex but not the
-	lock wait mutex. This is OK because other threads will see the state
-	of this slot as being in use and no other thread can change the state
-	of the slot to free unless that thread also owns the lock mutex. */
+	/* We own both the lock_sys->latch (possibly in shared mode) and
+	the trx_t::mutex but not the lock wait mutex. This is OK because
+	other threads will see the state of this slot as being in use and
+	no other thread can change the state of the slot to free unless
+	that thread owns the lock_sys->latch exclusively. */
 
 	if (thr->slot != NULL && thr->slot->in_use && thr->slot->thr == thr) {
 		trx_t*	trx = thr_get_trx(thr);
@@ -542,9 +545,16 @@ DECLARE_THREAD(lock_wait_timeout_thread)(void*)
 		srv_slot_t*	slot;
 
 		/* When someone is waiting for a lock, we wake up every second
-		and check if a timeout has passed for a lock wait */
+		and check if a timeout has passed for a lock wait. If the
+		waits are checked for deadlocks in the background, we wake up
+		every innodb_deadlock_detect_interval milliseconds. */
+
+		const ulint	interval = innobase_deadlock_detect
+			? innodb_deadlock_detect_interval : 0;
 
-		os_event_wait_time_low(event, 1000000, sig_count);
+		os_event_wait_time_low(event,
+				       interval ? interval * 1000 : 1000000,
+				       sig_count);
 		sig_count = os_event_reset(event);
 
 		if (srv_shutdown_state >= SRV_SHUTDOWN_CLEANUP) {
@@ -570,6 +580,10 @@ DECLARE_THREAD(lock_wait_timeout_thread)(void*)
 			}
 		}
 
+		if (interval) {
+			lock_deadlock_check_waits();
+		}
+
 		sig_count = os_event_reset(event);
 
 		lock_wait_mutex_exit();
@@ -162,6 +162,31 @@ log_buf_pool_get_oldest_modification(void)
 	return(lsn);
 }
 
+/** Wait until the records of all log_buffer_reserve() have been copied
+to the log buffer, so that it can be written or moved. No reservations
+can be made meanwhile, because the caller holds log_sys->mutex. */
+static
+void
+log_buffer_wait_for_copies()
+{
+	ut_ad(log_mutex_own());
+
+	if (!my_atomic_loadlint(&log_sys->n_pending_copies)) {
+		return;
+	}
+
+	srv_stats.log_copy_waits.inc();
+
+	for (ulint i = 0; my_atomic_loadlint(&log_sys->n_pending_copies);
+	     i++) {
+		if (i < srv_n_spin_wait_rounds) {
+			ut_delay(srv_spin_wait_delay);
+		} else {
+			os_thread_yield();
+		}
+	}
+}
+
 /** Extends the log buffer.
 @param[in]	len	requested minimum size in bytes */
 void
@@ -214,6 +239,8 @@ log_buffer_extend(
 		log_mutex_enter_all();
 	}
 
+	log_buffer_wait_for_copies();
+
 	move_start = ut_calc_align_down(
 		log_sys->buf_free,
 		OS_FILE_LOG_BLOCK_SIZE);
@@ -399,74 +426,128 @@ log_reserve_and_open(
 	return(log_sys->lsn);
 }
 
-/************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
-void
-log_write_low(
-/*==========*/
-	const byte*	str,		/*!< in: string */
-	ulint		str_len)	/*!< in: string length */
+/** Reserve space for log records in the log buffer that was opened with
+log_reserve_and_open(), and advance the lsn past them. The records must
+be copied to the returned position with log_buffer_write(), which does
+not require log_sys->mutex, followed by log_buffer_write_completed().
+
+The space is reserved by formatting the headers of the log blocks that
+the records will fill, so that the threads that copy records to
+different parts of the buffer never write to the same bytes.
+@param[in]	len	length of the log records
+@return where to copy the log records to */
+byte*
+log_buffer_reserve(
+	ulint	len)
 {
 	log_t*	log	= log_sys;
-	ulint	len;
-	ulint	data_len;
-	byte*	log_block;
+	byte*	ptr	= log->buf + log->buf_free;
 
 	ut_ad(log_mutex_own());
-part_loop:
-	/* Calculate a part length */
+	ut_ad(len > 0);
+
+	for (;;) {
+		byte*	log_block = static_cast<byte*>(
+			ut_align_down(log->buf + log->buf_free,
+				      OS_FILE_LOG_BLOCK_SIZE));
+		ulint	data_len = log->buf_free % OS_FILE_LOG_BLOCK_SIZE
+			+ len;
+
+		if (data_len < OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE) {
+			/* The rest fits within the current log block */
+			log_block_set_data_len(log_block, data_len);
+			log->buf_free += len;
+			log->lsn += len;
+			break;
+		}
 
-	data_len = (log->buf_free % OS_FILE_LOG_BLOCK_SIZE) + str_len;
+		/* This block becomes full */
+		ulint	part_len = OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE
+			- log->buf_free % OS_FILE_LOG_BLOCK_SIZE;
 
-	if (data_len <= OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE) {
+		len -= part_len;
+		part_len += LOG_BLOCK_HDR_SIZE + LOG_BLOCK_TRL_SIZE;
 
-		/* The string fits within the current log block */
+		log_block_set_data_len(log_block, OS_FILE_LOG_BLOCK_SIZE);
+		log_block_set_checkpoint_no(log_block,
+					    log->next_checkpoint_no);
+		log->buf_free += part_len;
+		log->lsn += part_len;
 
-		len = str_len;
-	} else {
-		data_len = OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE;
+		/* Initialize the next block header */
+		log_block_init(log_block + OS_FILE_LOG_BLOCK_SIZE, log->lsn);
 
-		len = OS_FILE_LOG_BLOCK_SIZE
-			- (log->buf_free % OS_FILE_LOG_BLOCK_SIZE)
-			- LOG_BLOCK_TRL_SIZE;
+		if (!len) {
+			break;
+		}
 	}
 
-	ut_memcpy(log->buf + log->buf_free, str, len);
+	ut_ad(log->buf_free <= log->buf_size);
 
-	str_len -= len;
-	str = str + len;
+	my_atomic_addlint(&log->n_pending_copies, 1);
+	srv_stats.log_write_requests.inc();
 
-	log_block = static_cast<byte*>(
-		ut_align_down(
-			log->buf + log->buf_free, OS_FILE_LOG_BLOCK_SIZE));
+	return(ptr);
+}
 
-	log_block_set_data_len(log_block, data_len);
+/** Copy log records to space that was reserved by log_buffer_reserve().
+@param[in,out]	ptr	where to copy to, in the log buffer
+@param[in]	str	log records
+@param[in]	len	length of str
+@return where to copy further log records of the reservation to */
+byte*
+log_buffer_write(
+	byte*		ptr,
+	const byte*	str,
+	ulint		len)
+{
+	while (len > 0) {
+		ulint	offset = ut_align_offset(ptr, OS_FILE_LOG_BLOCK_SIZE);
+
+		if (offset == OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE) {
+			/* Skip the trailer of the full block and the
+			header of the next one */
+			ptr += LOG_BLOCK_TRL_SIZE + LOG_BLOCK_HDR_SIZE;
+			offset = LOG_BLOCK_HDR_SIZE;
+		}
 
-	if (data_len == OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE) {
-		/* This block became full */
-		log_block_set_data_len(log_block, OS_FILE_LOG_BLOCK_SIZE);
-		log_block_set_checkpoint_no(log_block,
-					    log_sys->next_checkpoint_no);
-		len += LOG_BLOCK_HDR_SIZE + LOG_BLOCK_TRL_SIZE;
+		ut_ad(offset >= LOG_BLOCK_HDR_SIZE);
 
-		log->lsn += len;
+		ulint	part_len = std::min(
+			len, OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE
+			- offset);
 
-		/* Initialize the next block header */
-		log_block_init(log_block + OS_FILE_LOG_BLOCK_SIZE, log->lsn);
-	} else {
-		log->lsn += len;
+		memcpy(ptr, str, part_len);
+		ptr += part_len;
+		str += part_len;
+		len -= part_len;
 	}
 
-	log->buf_free += len;
+	return(ptr);
+}
 
-	ut_ad(log->buf_free <= log->buf_size);
+/** Note that the log records of a log_buffer_reserve() were copied. */
+void
+log_buffer_write_completed()
+{
+	ut_ad(my_atomic_loadlint(&log_sys->n_pending_copies) > 0);
 
-	if (str_len > 0) {
-		goto part_loop;
-	}
+	/* This is a full memory barrier: the copied records are
+	visible to log_buffer_wait_for_copies() */
+	my_atomic_addlint(&log_sys->n_pending_copies, -1);
+}
 
-	srv_stats.log_write_requests.inc();
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+void
+log_write_low(
+/*==========*/
+	const byte*	str,		/*!< in: string */
+	ulint		str_len)	/*!< in: string length */
+{
+	log_buffer_write(log_buffer_reserve(str_len), str, str_len);
+	log_buffer_write_completed();
 }
 
 /************************************************************//**
@@ -744,6 +825,14 @@ log_sys_init()
 
 	os_event_set(log_sys->flush_event);
 
+	log_sys->writer_event = os_event_create(0);
+	log_sys->flusher_event = os_event_create(0);
+
+	for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+		log_sys->write_events[i] = os_event_create(0);
+		log_sys->flush_events[i] = os_event_create(0);
+	}
+
 	/*----------------------------*/
 
 	log_sys->last_checkpoint_lsn = log_sys->lsn;
@@ -1112,8 +1201,9 @@ wait and check if an already running write is covering the request.
 included in the redo log file write
 @param[in]	flush_to_disk	whether the written log should also
 be flushed to the file system */
+static
 void
-log_write_up_to(
+log_write_up_to_low(
 	lsn_t	lsn,
 	bool	flush_to_disk)
 {
@@ -1214,6 +1304,8 @@ log_write_up_to(
 		}
 	}
 
+	log_buffer_wait_for_copies();
+
 	start_offset = log_sys->buf_next_to_write;
 	end_offset = log_sys->buf_free;
 
@@ -1298,6 +1390,232 @@ log_write_up_to(
 	}
 }
 
+/** Get the event to wait on until the log is written or flushed up to
+an lsn. The waiters are spread over the events by the log block that
+they wait for, so that a write wakes up only the threads that it
+satisfies, and those that happen to share their events.
+@param[in]	events	log_sys->write_events or log_sys->flush_events
+@param[in]	lsn	log sequence number
+@return event */
+static inline
+os_event_t
+log_wait_event(os_event_t* events, lsn_t lsn)
+{
+	return(events[((lsn - 1) / OS_FILE_LOG_BLOCK_SIZE)
+		      % LOG_N_WAIT_EVENTS]);
+}
+
+/** Wake up the threads that wait for the log to be written or flushed
+up to an lsn that has been reached, see log_write_up_to().
+@param[in,out]	events		log_sys->write_events or
+				log_sys->flush_events
+@param[in]	notified_lsn	the lsn up to which events were set before
+@param[in]	lsn		the lsn that was reached */
+static
+void
+log_wait_events_set(os_event_t* events, lsn_t notified_lsn, lsn_t lsn)
+{
+	ut_ad(notified_lsn < lsn);
+
+	/* Set the events of the log blocks from the one that contains
+	notified_lsn to the one that contains lsn - 1 */
+	ulint	n = ulint((lsn - 1) / OS_FILE_LOG_BLOCK_SIZE
+			  - notified_lsn / OS_FILE_LOG_BLOCK_SIZE) + 1;
+
+	for (ulint i = 0; i < std::min<ulint>(n, LOG_N_WAIT_EVENTS); i++) {
+		os_event_set(log_wait_event(
+				     events, notified_lsn + 1
+				     + i * OS_FILE_LOG_BLOCK_SIZE));
+	}
+}
+
+/** Wake up the threads that wait for the log to be written or flushed
+up to what log_writer_thread or log_flusher_thread has reached. */
+static
+void
+log_notify_waiters()
+{
+	log_mutex_enter();
+
+	const lsn_t	write_notified_lsn = log_sys->write_notified_lsn;
+	const lsn_t	write_lsn = log_sys->write_lsn;
+	const lsn_t	flush_notified_lsn = log_sys->flush_notified_lsn;
+	const lsn_t	flush_lsn = log_sys->flushed_to_disk_lsn;
+
+	log_sys->write_notified_lsn = std::max(write_notified_lsn, write_lsn);
+	log_sys->flush_notified_lsn = std::max(flush_notified_lsn, flush_lsn);
+
+	log_mutex_exit();
+
+	if (write_lsn > write_notified_lsn) {
+		log_wait_events_set(log_sys->write_events,
+				    write_notified_lsn, write_lsn);
+	}
+
+	if (flush_lsn > flush_notified_lsn) {
+		log_wait_events_set(log_sys->flush_events,
+				    flush_notified_lsn, flush_lsn);
+	}
+}
+
+/** Ensure that the log has been written to the log file up to a given
+log entry (such as that of a transaction commit). If log_writer_thread
+and log_flusher_thread are running, wake them up and wait until they
+have written (and flushed) enough, otherwise do the write.
+@param[in]	lsn		log sequence number that should be
+included in the redo log file write
+@param[in]	flush_to_disk	whether the written log should also
+be flushed to the file system */
+void
+log_write_up_to(
+	lsn_t	lsn,
+	bool	flush_to_disk)
+{
+	ut_ad(!srv_read_only_mode);
+
+	if (recv_no_ibuf_operations) {
+		/* Recovery is running and no operations on the log files are
+		allowed yet (the variable name .._no_ibuf_.. is misleading) */
+
+		return;
+	}
+
+	lsn_t*		reached_lsn = flush_to_disk
+		? &log_sys->flushed_to_disk_lsn : &log_sys->write_lsn;
+	const bool*	thread_active = flush_to_disk
+		? &log_flusher_thread_active : &log_writer_thread_active;
+	os_event_t	thread_event = flush_to_disk
+		? log_sys->flusher_event : log_sys->writer_event;
+	os_event_t	event = log_wait_event(
+		flush_to_disk ? log_sys->flush_events : log_sys->write_events,
+		lsn);
+
+	for (;;) {
+		const int64_t	sig_count = os_event_reset(event);
+
+		if (lsn_t(my_atomic_load64(reinterpret_cast<int64*>(
+					     reached_lsn))) >= lsn) {
+			return;
+		}
+
+		if (!*thread_active) {
+			/* The thread has exited, or was never started */
+			log_write_up_to_low(lsn, flush_to_disk);
+			return;
+		}
+
+		os_event_set(thread_event);
+		os_event_wait_low(event, sig_count);
+	}
+}
+
+/** Body of log_writer_thread and log_flusher_thread.
+@param[in]	flush_to_disk	whether the log is also flushed
+@param[in,out]	event		event that wakes up the thread
+@param[in,out]	active		log_writer_thread_active or
+				log_flusher_thread_active */
+static
+void
+log_writer_loop(bool flush_to_disk, os_event_t event, bool* active)
+{
+	ut_ad(!srv_read_only_mode);
+
+	while (srv_shutdown_state < SRV_SHUTDOWN_FLUSH_PHASE) {
+		os_event_wait(event);
+		os_event_reset(event);
+
+		/* Write everything that is in the log buffer, including
+		the log of threads that did not wait for us yet: one write
+		serves the whole group of threads that are committing */
+		log_write_up_to_low(log_get_lsn(), flush_to_disk);
+		log_notify_waiters();
+	}
+
+	*active = false;
+
+	/* Let the waiters notice that they have to write themselves */
+	for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+		os_event_set(flush_to_disk
+			     ? log_sys->flush_events[i]
+			     : log_sys->write_events[i]);
+	}
+}
+
+/** Whether log_writer_thread is active */
+bool	log_writer_thread_active;
+/** Whether log_flusher_thread is active */
+bool	log_flusher_thread_active;
+
+/** The thread that writes the redo log to the log files when
+log_write_up_to() is called without flushing.
+@return a dummy value */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(void*)
+{
+	my_thread_init();
+
+	log_writer_loop(false, log_sys->writer_event,
+			&log_writer_thread_active);
+
+	my_thread_end();
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** The thread that writes the redo log to the log files and flushes
+them when log_write_up_to() is called with flushing.
+@return a dummy value */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(void*)
+{
+	my_thread_init();
+
+	log_writer_loop(true, log_sys->flusher_event,
+			&log_flusher_thread_active);
+
+	my_thread_end();
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start log_writer_thread and log_flusher_thread, which write and
+flush the log on behalf of the threads that call log_write_up_to(). */
+void
+log_writer_threads_start()
+{
+	ut_ad(!srv_read_only_mode);
+	ut_ad(!log_writer_thread_active);
+	ut_ad(!log_flusher_thread_active);
+
+	log_mutex_enter();
+	log_sys->write_notified_lsn = log_sys->write_lsn;
+	log_sys->flush_notified_lsn = log_sys->flushed_to_disk_lsn;
+	log_mutex_exit();
+
+	log_writer_thread_active = true;
+	log_flusher_thread_active = true;
+	os_thread_create(log_writer_thread, NULL, NULL);
+	os_thread_create(log_flusher_thread, NULL, NULL);
+}
+
+/** Wake up log_writer_thread and log_flusher_thread, so that they
+notice a shutdown. */
+void
+log_writer_threads_wakeup()
+{
+	if (log_writer_thread_active) {
+		os_event_set(log_sys->writer_event);
+	}
+
+	if (log_flusher_thread_active) {
+		os_event_set(log_sys->flusher_event);
+	}
+}
+
 /** write to the log file up to the last log entry.
 @param[in]	sync	whether we want the written log
 also to be flushed to disk. */
@@ -2008,13 +2326,16 @@ logs_empty_and_mark_files_at_shutdown(void)
 		os_event_set(log_scrub_event);
 	}
 
+	log_writer_threads_wakeup();
+
 	if (log_sys) {
 		log_mutex_enter();
 		const ulint	n_write	= log_sys->n_pending_checkpoint_writes;
 		const ulint	n_flush	= log_sys->n_pending_flushes;
 		log_mutex_exit();
 
-		if (log_scrub_thread_active || n_write || n_flush) {
+		if (log_scrub_thread_active || log_writer_thread_active
+		    || log_flusher_thread_active || n_write || n_flush) {
 			if (srv_print_verbose_log && count > 600) {
 				ib::info() << "Pending checkpoint_writes: "
 					<< n_write
@@ -2264,6 +2585,13 @@ log_shutdown()
 	log_sys->checkpoint_buf = NULL;
 
 	os_event_destroy(log_sys->flush_event);
+	os_event_destroy(log_sys->writer_event);
+	os_event_destroy(log_sys->flusher_event);
+
+	for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+		os_event_destroy(log_sys->write_events[i]);
+		os_event_destroy(log_sys->flush_events[i]);
+	}
 
 	rw_lock_free(&log_sys->checkpoint_lock);
 
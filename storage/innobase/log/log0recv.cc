@@ -420,7 +420,7 @@ void
 recv_sys_close()
 {
 	if (recv_sys != NULL) {
-		recv_sys->dblwr.pages.clear();
+		recv_sys->dblwr.clear();
 
 		if (recv_sys->addr_hash != NULL) {
 			hash_table_free(recv_sys->addr_hash);
@@ -1845,9 +1845,27 @@ recv_recover_page(bool just_read_in, buf_block_t* block)
 	ut_a(recv_sys->n_addrs > 0);
 	if (ulint n = --recv_sys->n_addrs) {
 		if (recv_sys->report(time)) {
-			ib::info() << "To recover: " << n << " pages from log";
-			sd_notifyf(0, "STATUS=To recover: " ULINTPF
-				   " pages from log", n);
+			/* Estimate the remaining time from the rate at
+			which the pages of this batch were recovered */
+			const ulint	done = recv_sys->n_addrs_batch - n;
+			const ulint	elapsed = ulint(
+				time - recv_sys->apply_start_time);
+
+			if (done && elapsed) {
+				const ulint	eta = ulint(
+					double(elapsed) * n / done);
+				ib::info() << "To recover: " << n
+					<< " pages from log; estimated time"
+					" remaining: " << eta << " seconds";
+				sd_notifyf(0, "STATUS=To recover: " ULINTPF
+					   " pages from log, ETA " ULINTPF
+					   " seconds", n, eta);
+			} else {
+				ib::info() << "To recover: " << n
+					<< " pages from log";
+				sd_notifyf(0, "STATUS=To recover: " ULINTPF
+					   " pages from log", n);
+			}
 		}
 	}
 
@@ -1901,50 +1919,32 @@ recv_read_in_area(
 	return(n);
 }
 
-/** Apply the hash table of stored log records to persistent data pages.
-@param[in]	last_batch	whether the change buffer merge will be
-				performed as part of the operation */
+/** A thread of recv_apply_hashed_log_recs() */
+struct recv_apply_thread_t {
+	/** the first cell of recv_sys->addr_hash that the thread handles */
+	ulint		first;
+	/** the number of threads; each handles every n_threads'th cell */
+	ulint		n_threads;
+	/** the thread identifier */
+	os_thread_id_t	id;
+};
+
+/** Apply the log records of the pages in a part of recv_sys->addr_hash.
+The pages that are in the buffer pool are recovered by this thread, and
+the others are read in, to be recovered by the i/o handler threads.
+Pages are independent of each other, so the threads that apply a batch
+only need to coordinate on the state of each recv_addr_t.
+@param[in]	first		the first hash cell to process
+@param[in]	n_threads	the number of threads that apply the batch */
+static
 void
-recv_apply_hashed_log_recs(bool last_batch)
+recv_apply_hash_cells(ulint first, ulint n_threads)
 {
-	ut_ad(srv_operation == SRV_OPERATION_NORMAL
-	      || srv_operation == SRV_OPERATION_RESTORE
-	      || srv_operation == SRV_OPERATION_RESTORE_EXPORT);
+	const ulint	n_cells = hash_get_n_cells(recv_sys->addr_hash);
 
 	mutex_enter(&recv_sys->mutex);
 
-	while (recv_sys->apply_batch_on) {
-		bool abort = recv_sys->found_corrupt_log;
-		mutex_exit(&recv_sys->mutex);
-
-		if (abort) {
-			return;
-		}
-
-		os_thread_sleep(500000);
-		mutex_enter(&recv_sys->mutex);
-	}
-
-	ut_ad(!last_batch == log_mutex_own());
-
-	recv_no_ibuf_operations = !last_batch
-		|| srv_operation == SRV_OPERATION_RESTORE
-		|| srv_operation == SRV_OPERATION_RESTORE_EXPORT;
-
-	ut_d(recv_no_log_write = recv_no_ibuf_operations);
-
-	if (ulint n = recv_sys->n_addrs) {
-		const char* msg = last_batch
-			? "Starting final batch to recover "
-			: "Starting a batch to recover ";
-		ib::info() << msg << n << " pages from redo log.";
-		sd_notifyf(0, "STATUS=%s" ULINTPF " pages from redo log",
-			   msg, n);
-	}
-	recv_sys->apply_log_recs = TRUE;
-	recv_sys->apply_batch_on = TRUE;
-
-	for (ulint i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
+	for (ulint i = first; i < n_cells; i += n_threads) {
 		for (recv_addr_t* recv_addr = static_cast<recv_addr_t*>(
 			     HASH_GET_FIRST(recv_sys->addr_hash, i));
 		     recv_addr;
@@ -2000,6 +2000,105 @@ recv_apply_hashed_log_recs(bool last_batch)
 		}
 	}
 
+	mutex_exit(&recv_sys->mutex);
+}
+
+/** A thread other than the one that called recv_apply_hashed_log_recs()
+that applies log records
+@param[in]	arg	recv_apply_thread_t
+@return a dummy value */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(void* arg)
+{
+	my_thread_init();
+
+	const recv_apply_thread_t*	thr
+		= static_cast<recv_apply_thread_t*>(arg);
+
+	recv_apply_hash_cells(thr->first, thr->n_threads);
+
+	my_thread_end();
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Apply the hash table of stored log records to persistent data pages.
+@param[in]	last_batch	whether the change buffer merge will be
+				performed as part of the operation */
+void
+recv_apply_hashed_log_recs(bool last_batch)
+{
+	ut_ad(srv_operation == SRV_OPERATION_NORMAL
+	      || srv_operation == SRV_OPERATION_RESTORE
+	      || srv_operation == SRV_OPERATION_RESTORE_EXPORT);
+
+	mutex_enter(&recv_sys->mutex);
+
+	while (recv_sys->apply_batch_on) {
+		bool abort = recv_sys->found_corrupt_log;
+		mutex_exit(&recv_sys->mutex);
+
+		if (abort) {
+			return;
+		}
+
+		os_thread_sleep(500000);
+		mutex_enter(&recv_sys->mutex);
+	}
+
+	ut_ad(!last_batch == log_mutex_own());
+
+	recv_no_ibuf_operations = !last_batch
+		|| srv_operation == SRV_OPERATION_RESTORE
+		|| srv_operation == SRV_OPERATION_RESTORE_EXPORT;
+
+	ut_d(recv_no_log_write = recv_no_ibuf_operations);
+
+	if (ulint n = recv_sys->n_addrs) {
+		const char* msg = last_batch
+			? "Starting final batch to recover "
+			: "Starting a batch to recover ";
+		ib::info() << msg << n << " pages from redo log.";
+		sd_notifyf(0, "STATUS=%s" ULINTPF " pages from redo log",
+			   msg, n);
+	}
+	recv_sys->apply_log_recs = TRUE;
+	recv_sys->apply_batch_on = TRUE;
+
+	recv_sys->n_addrs_batch = recv_sys->n_addrs;
+	recv_sys->apply_start_time = ut_time();
+
+	/* Partition the hash table between srv_n_recovery_threads threads,
+	which read in the pages and apply the log records in parallel. */
+	const ulint	n_threads = std::max<ulint>(
+		1, std::min<ulint>(srv_n_recovery_threads,
+				   recv_sys->n_addrs));
+	recv_apply_thread_t*	thr = n_threads > 1
+		? static_cast<recv_apply_thread_t*>(
+			ut_malloc_nokey((n_threads - 1) * sizeof *thr))
+		: NULL;
+
+	mutex_exit(&recv_sys->mutex);
+
+	for (ulint i = 1; i < n_threads; i++) {
+		thr[i - 1].first = i;
+		thr[i - 1].n_threads = n_threads;
+		os_thread_create(recv_apply_thread, &thr[i - 1],
+				 &thr[i - 1].id);
+	}
+
+	recv_apply_hash_cells(0, n_threads);
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_join(thr[i - 1].id);
+	}
+
+	ut_free(thr);
+
+	mutex_enter(&recv_sys->mutex);
+
 	/* Wait until all the pages have been processed */
 
 	while (recv_sys->n_addrs != 0) {
@@ -3474,49 +3573,34 @@ recv_reset_logs(
 	log_mutex_enter();
 }
 
+/** Add a page frame to the doublewrite recovery buffer.
+@param[in]	page	page frame */
+void
+recv_dblwr_t::add(byte* page)
+{
+	pages.push_back(page);
+
+	const byte*&	copy = newest[key(page_get_space_id(page),
+					  page_get_page_no(page))];
+
+	if (copy == NULL
+	    || mach_read_from_8(page + FIL_PAGE_LSN)
+	    > mach_read_from_8(copy + FIL_PAGE_LSN)) {
+		copy = page;
+	}
+}
+
 /** Find a doublewrite copy of a page.
 @param[in]	space_id	tablespace identifier
 @param[in]	page_no		page number
-@return	page frame
+@return	the copy with the highest FIL_PAGE_LSN
 @retval NULL if no page was found */
-
 const byte*
-recv_dblwr_t::find_page(ulint space_id, ulint page_no)
+recv_dblwr_t::find_page(ulint space_id, ulint page_no) const
 {
-	typedef std::vector<const byte*, ut_allocator<const byte*> >
-		matches_t;
-
-	matches_t	matches;
-	const byte*	result = 0;
-
-	for (list::iterator i = pages.begin(); i != pages.end(); ++i) {
-		if (page_get_space_id(*i) == space_id
-		    && page_get_page_no(*i) == page_no) {
-			matches.push_back(*i);
-		}
-	}
-
-	if (matches.size() == 1) {
-		result = matches[0];
-	} else if (matches.size() > 1) {
-
-		lsn_t max_lsn	= 0;
-		lsn_t page_lsn	= 0;
-
-		for (matches_t::iterator i = matches.begin();
-		     i != matches.end();
-		     ++i) {
-
-			page_lsn = mach_read_from_8(*i + FIL_PAGE_LSN);
-
-			if (page_lsn > max_lsn) {
-				max_lsn = page_lsn;
-				result = *i;
-			}
-		}
-	}
+	newest_map::const_iterator	i = newest.find(key(space_id, page_no));
 
-	return(result);
+	return(i == newest.end() ? NULL : i->second);
 }
 
 #ifndef DBUG_OFF
@@ -420,9 +420,25 @@ class mtr_t::Command {
 
 	/** Append the redo log records to the redo log buffer.
 	@param[in]	len	number of bytes to write */
-	void finish_write(ulint len);
+	void finish_write(ulint len)
+	{
+		if (byte* ptr = reserve_write(len)) {
+			write(ptr);
+		}
+	}
 
 private:
+	/** Reserve space for the redo log records in the redo log buffer.
+	@param[in]	len	number of bytes to write
+	@return where write() has to copy the records to, or NULL if they
+	were already appended */
+	byte* reserve_write(ulint len);
+
+	/** Copy the redo log records to the space reserved for them.
+	This does not require log_sys->mutex.
+	@param[in]	ptr	return value of reserve_write() */
+	void write(byte* ptr);
+
 	/** Prepare to write the mini-transaction log to the redo log buffer.
 	@return number of bytes to write in finish_write() */
 	ulint prepare_write();
@@ -460,13 +476,20 @@ mtr_t::is_block_dirtied(const buf_block_t* block)
 
 /** Write the block contents to the REDO log */
 struct mtr_write_log_t {
+	/** Constructor
+	@param[in]	ptr	space reserved by log_buffer_reserve() */
+	explicit mtr_write_log_t(byte* ptr) : m_ptr(ptr) {}
+
 	/** Append a block to the redo log buffer.
 	@return whether the appending should continue */
-	bool operator()(const mtr_buf_t::block_t* block) const
+	bool operator()(const mtr_buf_t::block_t* block)
 	{
-		log_write_low(block->begin(), block->used());
+		m_ptr = log_buffer_write(m_ptr, block->begin(), block->used());
 		return(true);
 	}
+
+	/** Where to copy the next block to */
+	byte*	m_ptr;
 };
 
 /** Append records to the system-wide redo log buffer.
@@ -476,7 +499,6 @@ mtr_write_log(
 	const mtr_buf_t*	log)
 {
 	const ulint	len = log->size();
-	mtr_write_log_t	write_log;
 
 	ut_ad(!recv_no_log_write);
 	DBUG_PRINT("ib_log",
@@ -484,7 +506,9 @@ mtr_write_log(
 		    len, log_sys->lsn));
 
 	log_reserve_and_open(len);
+	mtr_write_log_t	write_log(log_buffer_reserve(len));
 	log->for_each_block(write_log);
+	log_buffer_write_completed();
 	log_close();
 }
 
@@ -874,10 +898,12 @@ mtr_t::Command::prepare_write()
 	return(len);
 }
 
-/** Append the redo log records to the redo log buffer
-@param[in] len	number of bytes to write */
-void
-mtr_t::Command::finish_write(
+/** Reserve space for the redo log records in the redo log buffer.
+@param[in]	len	number of bytes to write
+@return where write() has to copy the records to, or NULL if they
+were already appended */
+byte*
+mtr_t::Command::reserve_write(
 	ulint	len)
 {
 	ut_ad(m_impl->m_log_mode == MTR_LOG_ALL);
@@ -885,6 +911,8 @@ mtr_t::Command::finish_write(
 	ut_ad(m_impl->m_log.size() == len);
 	ut_ad(len > 0);
 
+#ifdef UNIV_LOG_LSN_DEBUG
+	/* Only log_reserve_and_write_fast() writes MLOG_LSN records */
 	if (m_impl->m_log.is_small()) {
 		const mtr_buf_t::block_t*	front = m_impl->m_log.front();
 		ut_ad(len <= front->used());
@@ -893,17 +921,30 @@ mtr_t::Command::finish_write(
 			front->begin(), len, &m_start_lsn);
 
 		if (m_end_lsn > 0) {
-			return;
+			return(NULL);
 		}
 	}
+#endif /* UNIV_LOG_LSN_DEBUG */
 
-	/* Open the database log for log_write_low */
 	m_start_lsn = log_reserve_and_open(len);
 
-	mtr_write_log_t	write_log;
-	m_impl->m_log.for_each_block(write_log);
+	byte*	ptr = log_buffer_reserve(len);
 
 	m_end_lsn = log_close();
+
+	return(ptr);
+}
+
+/** Copy the redo log records to the space reserved for them.
+This does not require log_sys->mutex.
+@param[in]	ptr	return value of reserve_write() */
+void
+mtr_t::Command::write(
+	byte*	ptr)
+{
+	mtr_write_log_t	write_log(ptr);
+	m_impl->m_log.for_each_block(write_log);
+	log_buffer_write_completed();
 }
 
 /** Release the latches and blocks acquired by this mini-transaction */
@@ -949,8 +990,10 @@ mtr_t::Command::execute()
 {
 	ut_ad(m_impl->m_log_mode != MTR_LOG_NONE);
 
+	byte*	ptr = NULL;
+
 	if (const ulint len = prepare_write()) {
-		finish_write(len);
+		ptr = reserve_write(len);
 	}
 
 	if (m_impl->m_made_dirty) {
@@ -962,6 +1005,13 @@ mtr_t::Command::execute()
 	to insert into the flush list. */
 	log_mutex_exit();
 
+	/* Other mini-transactions may copy their records to the log
+	buffer concurrently. The log buffer will not be written before
+	this is done. */
+	if (ptr) {
+		write(ptr);
+	}
+
 	m_impl->m_mtr->m_commit_lsn = m_end_lsn;
 
 	release_blocks();
@@ -64,6 +64,14 @@ Created 10/21/1995 Heikki Tuuri
 #include <libaio.h>
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif /* LINUX_IO_URING */
+
 #ifdef HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE
 # include <fcntl.h>
 # include <linux/falloc.h>
@@ -189,6 +197,49 @@ mysql_pfs_key_t  innodb_temp_file_key;
 
 class AIO;
 
+#ifdef LINUX_IO_URING
+/** An io_uring submission and completion queue, one per AIO segment.
+The submission queue is protected by the AIO array mutex; the completion
+queue is only accessed by the i/o handler thread of the segment. */
+struct os_uring_t {
+	/** file descriptor of the ring, or -1 */
+	int			fd;
+
+	/** mapping of the submission queue ring */
+	void*			sq_ring;
+	/** size of sq_ring */
+	size_t			sq_ring_size;
+	/** mapping of the completion queue ring; may be sq_ring */
+	void*			cq_ring;
+	/** size of cq_ring */
+	size_t			cq_ring_size;
+	/** submission queue entries */
+	struct io_uring_sqe*	sqes;
+	/** size of sqes */
+	size_t			sqes_size;
+
+	/** submission queue head, advanced by the kernel */
+	unsigned*		sq_head;
+	/** submission queue tail */
+	unsigned*		sq_tail;
+	/** mask for indexing the submission queue */
+	unsigned		sq_mask;
+	/** number of submission queue entries */
+	unsigned		sq_entries;
+	/** submission queue indexes to sqes */
+	unsigned*		sq_array;
+
+	/** completion queue head */
+	unsigned*		cq_head;
+	/** completion queue tail, advanced by the kernel */
+	unsigned*		cq_tail;
+	/** mask for indexing the completion queue */
+	unsigned		cq_mask;
+	/** completion queue entries */
+	struct io_uring_cqe*	cqes;
+};
+#endif /* LINUX_IO_URING */
+
 /** The asynchronous I/O context */
 struct Slot {
 
@@ -246,6 +297,9 @@ struct Slot {
 	/** AIO completion status */
 	dberr_t			err;
 
+	/** time when the request was reserved, in microseconds */
+	uintmax_t		start_us;
+
 #ifdef WIN_ASYNC_IO
 
 	/** bytes written/read */
@@ -256,9 +310,16 @@ struct Slot {
 
 	/** aio array containing this slot */
 	AIO				*array;
-#elif defined(LINUX_NATIVE_AIO)
+#elif defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
+# ifdef LINUX_NATIVE_AIO
 	/** Linux control block for aio */
 	struct iocb		control;
+# endif /* LINUX_NATIVE_AIO */
+
+# ifdef LINUX_IO_URING
+	/** the buffer of an io_uring request */
+	struct iovec		iov;
+# endif /* LINUX_IO_URING */
 
 	/** AIO return code */
 	int			ret;
@@ -397,13 +458,48 @@ class AIO {
 	@param[in, out]	file	File to write to */
 	void to_file(FILE* file) const;
 
-#ifdef LINUX_NATIVE_AIO
+#if defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
 	/** Dispatch an AIO request to the kernel.
 	@param[in,out]	slot	an already reserved slot
+	@param[in]	submit	false to leave an io_uring request queued
+				until os_aio_simulated_wake_handler_threads()
 	@return true on success. */
-	bool linux_dispatch(Slot* slot)
+	bool linux_dispatch(Slot* slot, bool submit)
+		MY_ATTRIBUTE((warn_unused_result));
+#endif /* LINUX_NATIVE_AIO || LINUX_IO_URING */
+
+#ifdef LINUX_IO_URING
+	/** Accessor for the io_uring of a segment
+	@param[in]	segment	Segment for which to get the ring
+	@return the io_uring of the segment */
+	os_uring_t* uring(ulint segment)
+		MY_ATTRIBUTE((warn_unused_result))
+	{
+		ut_ad(segment < get_n_segments());
+
+		return(&m_uring[segment]);
+	}
+
+	/** Queue an AIO request to the io_uring of its segment.
+	The caller must own the mutex.
+	@param[in,out]	slot	an already reserved slot
+	@param[in]	submit	whether to submit the queued requests of
+				the segment to the kernel now */
+	void uring_dispatch(Slot* slot, bool submit);
+
+	/** Submit the queued requests of all segments to the kernel */
+	void uring_submit();
+
+	/** Submit the queued requests of all the AIO arrays to the kernel */
+	static void uring_submit_all();
+
+	/** Checks if io_uring can be used on this system.
+	@return true if supported, false otherwise. */
+	static bool is_uring_supported()
 		MY_ATTRIBUTE((warn_unused_result));
+#endif /* LINUX_IO_URING */
 
+#ifdef LINUX_NATIVE_AIO
 	/** Accessor for an AIO event
 	@param[in]	index	Index into the array
 	@return the event at the index */
@@ -587,6 +683,13 @@ class AIO {
 		MY_ATTRIBUTE((warn_unused_result));
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+	/** Initialise an io_uring for each segment
+	@return DB_SUCCESS or error code */
+	dberr_t init_uring()
+		MY_ATTRIBUTE((warn_unused_result));
+#endif /* LINUX_IO_URING */
+
 private:
 	typedef std::vector<Slot> Slots;
 
@@ -629,6 +732,11 @@ class AIO {
 	IOEvents		m_events;
 #endif /* LINUX_NATIV_AIO */
 
+#ifdef LINUX_IO_URING
+	/** io_uring for each segment; NULL if io_uring is not used */
+	os_uring_t*		m_uring;
+#endif /* LINUX_IO_URING */
+
 	/** The aio arrays for non-ibuf i/o and ibuf i/o, as well as
 	sync AIO. These are NULL when the module has not yet been
 	initialized. */
@@ -656,9 +764,12 @@ AIO*	AIO::s_ibuf;
 AIO*	AIO::s_log;
 AIO*	AIO::s_sync;
 
-#if defined(LINUX_NATIVE_AIO)
-/** timeout for each io_getevents() call = 500ms. */
+#if defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
+/** timeout for each io_getevents() or io_uring poll() call = 500ms. */
 static const ulint	OS_AIO_REAP_TIMEOUT = 500000000UL;
+#endif /* LINUX_NATIVE_AIO || LINUX_IO_URING */
+
+#if defined(LINUX_NATIVE_AIO)
 
 /** time to sleep, in microseconds if io_setup() returns EAGAIN. */
 static const ulint	OS_AIO_IO_SETUP_RETRY_SLEEP = 500000UL;
@@ -1001,6 +1112,31 @@ class SyncFileIO {
 	os_offset_t		m_offset;
 };
 
+/** Account the latency of a completed asynchronous I/O request in the
+os_aio_read_* or os_aio_write_* monitor counters.
+@param[in]	slot	the completed request */
+static
+void
+os_aio_monitor_latency(const Slot* slot)
+{
+	const monitor_id_t	first = slot->type.is_read()
+		? MONITOR_OS_AIO_READ_TIME : MONITOR_OS_AIO_WRITE_TIME;
+
+	if (!MONITOR_IS_ON(first)) {
+		return;
+	}
+
+	const uintmax_t	now = ut_time_us(NULL);
+	const uintmax_t	us = now > slot->start_us ? now - slot->start_us : 0;
+	const monitor_id_t	bucket = monitor_id_t(
+		first + (us < 1000 ? 1
+			 : us < 10000 ? 2
+			 : us < 100000 ? 3 : 4));
+
+	MONITOR_INC_VALUE(first, us);
+	MONITOR_INC(bucket);
+}
+
 /** Do any post processing after a read/write
 @return DB_SUCCESS or error code. */
 dberr_t
@@ -1187,10 +1323,12 @@ AIO::release(Slot* slot)
 		os_event_set(m_is_empty);
 	}
 
-#if defined(LINUX_NATIVE_AIO)
+#if defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
 
 	if (srv_use_native_aio) {
+# ifdef LINUX_NATIVE_AIO
 		memset(&slot->control, 0x0, sizeof(slot->control));
+# endif /* LINUX_NATIVE_AIO */
 		slot->ret = 0;
 		slot->n_bytes = 0;
 	} else {
@@ -1622,7 +1760,168 @@ os_file_punch_hole_posix(
 	return(DB_IO_NO_PUNCH_HOLE);
 }
 
-#if defined(LINUX_NATIVE_AIO)
+#if defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
+
+#ifdef LINUX_IO_URING
+/** Close an io_uring.
+@param[in,out]	ring	io_uring */
+static
+void
+os_uring_close(os_uring_t* ring)
+{
+	if (ring->sqes != NULL) {
+		munmap(ring->sqes, ring->sqes_size);
+	}
+
+	if (ring->cq_ring != NULL && ring->cq_ring != ring->sq_ring) {
+		munmap(ring->cq_ring, ring->cq_ring_size);
+	}
+
+	if (ring->sq_ring != NULL) {
+		munmap(ring->sq_ring, ring->sq_ring_size);
+	}
+
+	if (ring->fd >= 0) {
+		close(ring->fd);
+	}
+
+	memset(ring, 0x0, sizeof *ring);
+	ring->fd = -1;
+}
+
+/** Map a part of an io_uring to memory.
+@param[in]	fd	io_uring file descriptor
+@param[in]	size	size of the mapping
+@param[in]	offset	IORING_OFF_SQ_RING, IORING_OFF_CQ_RING or
+			IORING_OFF_SQES
+@return the mapping, or NULL on failure */
+static
+void*
+os_uring_mmap(int fd, size_t size, off_t offset)
+{
+	void*	ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			   MAP_SHARED | MAP_POPULATE, fd, offset);
+
+	return(ptr == MAP_FAILED ? NULL : ptr);
+}
+
+/** Create an io_uring.
+@param[out]	ring	io_uring to initialize
+@param[in]	entries	minimum number of submission queue entries
+@return true on success */
+static
+bool
+os_uring_create(os_uring_t* ring, unsigned entries)
+{
+	struct io_uring_params	params;
+
+	memset(ring, 0x0, sizeof *ring);
+	memset(&params, 0x0, sizeof params);
+
+	ring->fd = int(syscall(__NR_io_uring_setup, entries, &params));
+
+	if (ring->fd < 0) {
+		ib::error()
+			<< "io_uring_setup() returned following error["
+			<< errno << "]";
+		ring->fd = -1;
+		return(false);
+	}
+
+	ring->sq_ring_size = params.sq_off.array
+		+ params.sq_entries * sizeof(unsigned);
+	ring->cq_ring_size = params.cq_off.cqes
+		+ params.cq_entries * sizeof(struct io_uring_cqe);
+	ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+	if (params.features & IORING_FEAT_SINGLE_MMAP) {
+		ring->sq_ring_size = ring->cq_ring_size = std::max(
+			ring->sq_ring_size, ring->cq_ring_size);
+	}
+
+	ring->sq_ring = os_uring_mmap(
+		ring->fd, ring->sq_ring_size, IORING_OFF_SQ_RING);
+
+	ring->cq_ring = (params.features & IORING_FEAT_SINGLE_MMAP)
+		? ring->sq_ring
+		: os_uring_mmap(
+			ring->fd, ring->cq_ring_size, IORING_OFF_CQ_RING);
+
+	ring->sqes = static_cast<struct io_uring_sqe*>(
+		os_uring_mmap(ring->fd, ring->sqes_size, IORING_OFF_SQES));
+
+	if (ring->sq_ring == NULL
+	    || ring->cq_ring == NULL
+	    || ring->sqes == NULL) {
+
+		ib::error()
+			<< "mmap() of io_uring returned following error["
+			<< errno << "]";
+		os_uring_close(ring);
+		return(false);
+	}
+
+	byte*	sq = static_cast<byte*>(ring->sq_ring);
+	byte*	cq = static_cast<byte*>(ring->cq_ring);
+
+	ring->sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+	ring->sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+	ring->sq_mask = *reinterpret_cast<unsigned*>(
+		sq + params.sq_off.ring_mask);
+	ring->sq_entries = *reinterpret_cast<unsigned*>(
+		sq + params.sq_off.ring_entries);
+	ring->sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+	ring->cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+	ring->cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+	ring->cq_mask = *reinterpret_cast<unsigned*>(
+		cq + params.cq_off.ring_mask);
+	ring->cqes = reinterpret_cast<struct io_uring_cqe*>(
+		cq + params.cq_off.cqes);
+
+	return(true);
+}
+
+/** Submit the queued requests of an io_uring to the kernel.
+The caller must own the mutex of the AIO array.
+@param[in,out]	ring	io_uring */
+static
+void
+os_uring_submit(os_uring_t* ring)
+{
+	for (;;) {
+		const unsigned	n = *ring->sq_tail - __atomic_load_n(
+			ring->sq_head, __ATOMIC_ACQUIRE);
+
+		if (n == 0) {
+			return;
+		}
+
+		long	ret = syscall(
+			__NR_io_uring_enter, ring->fd, n, 0, 0, NULL, 0);
+
+		if (ret > 0) {
+			continue;
+		} else if (ret == 0) {
+			return;
+		}
+
+		switch (errno) {
+		case EINTR:
+			continue;
+		case EAGAIN:
+		case EBUSY:
+			/* Not enough resources. The requests stay
+			queued and the i/o handler thread will retry. */
+			return;
+		}
+
+		ib::fatal()
+			<< "io_uring_enter() returned following error["
+			<< errno << "]";
+	}
+}
+#endif /* LINUX_IO_URING */
 
 /** Linux native AIO handler */
 class LinuxAIOHandler {
@@ -1685,6 +1984,20 @@ class LinuxAIOHandler {
 	@return NULL or a slot that has completed IO */
 	Slot* find_completed_slot(ulint* n_pending);
 
+	/** Mark a request completed. The error handling will be done
+	by check_state().
+	@param[in,out]	slot		the request
+	@param[in]	ret		0 or the negated error number
+	@param[in]	n_bytes		number of bytes read or written */
+	void mark_completed(Slot* slot, int ret, ssize_t n_bytes);
+
+#ifdef LINUX_IO_URING
+	/** Collect completed requests from the io_uring of the segment,
+	like collect(). The requests that were queued without submitting
+	them are submitted first. */
+	void collect_uring();
+#endif /* LINUX_IO_URING */
+
 	/** This is called from within the IO-thread. If there are no completed
 	IO requests in the slot array, the thread calls this function to
 	collect more requests from the Linux kernel.
@@ -1736,6 +2049,17 @@ LinuxAIOHandler::resubmit(Slot* slot)
 	slot->n_bytes = 0;
 	slot->io_already_done = false;
 
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring) {
+		m_array->uring_dispatch(slot, true);
+		return(DB_SUCCESS);
+	}
+#endif /* LINUX_IO_URING */
+
+#ifndef LINUX_NATIVE_AIO
+	ut_error;
+	return(DB_IO_PARTIAL_FAILED);
+#else
 	struct iocb*	iocb = &slot->control;
 
 	if (slot->type.is_read()) {
@@ -1768,6 +2092,7 @@ LinuxAIOHandler::resubmit(Slot* slot)
 	}
 
 	return(ret < 0 ? DB_IO_PARTIAL_FAILED : DB_SUCCESS);
+#endif /* !LINUX_NATIVE_AIO */
 }
 
 /** Check if the AIO succeeded
@@ -1847,6 +2172,49 @@ LinuxAIOHandler::find_completed_slot(ulint* n_pending)
 	return(NULL);
 }
 
+/** Mark a request completed. The error handling will be done
+by check_state().
+@param[in,out]	slot		the request
+@param[in]	ret		0 or the negated error number
+@param[in]	n_bytes		number of bytes read or written */
+void
+LinuxAIOHandler::mark_completed(Slot* slot, int ret, ssize_t n_bytes)
+{
+	/* Some sanity checks. */
+	ut_a(slot != NULL);
+	ut_a(slot->is_reserved);
+
+	/* We are not scribbling previous segment. */
+	ut_a(slot->pos >= m_segment * m_n_slots);
+
+	/* We have not overstepped to next segment. */
+	ut_a(slot->pos < (m_segment + 1) * m_n_slots);
+
+	/* Deallocate unused blocks from file system.
+	This is newer done to page 0 or to log files.*/
+	if (slot->offset > 0
+	    && !slot->type.is_log()
+	    && slot->type.is_write()
+	    && slot->type.punch_hole()) {
+
+		slot->err = slot->type.punch_hole(
+			slot->file,
+			slot->offset, slot->len);
+	} else {
+		slot->err = DB_SUCCESS;
+	}
+
+	/* Mark this request as completed. The error handling
+	will be done in the calling function. */
+	m_array->acquire();
+
+	slot->ret = ret;
+	slot->io_already_done = true;
+	slot->n_bytes = n_bytes;
+
+	m_array->release();
+}
+
 /** This function is only used in Linux native asynchronous i/o. This is
 called from within the io-thread. If there are no completed IO requests
 in the slot array, the thread calls this function to collect more
@@ -1864,15 +2232,19 @@ LinuxAIOHandler::collect()
 	ut_ad(m_array != NULL);
 	ut_ad(m_segment < m_array->get_n_segments());
 
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring) {
+		collect_uring();
+		return;
+	}
+#endif /* LINUX_IO_URING */
+
+#ifndef LINUX_NATIVE_AIO
+	ut_error;
+#else
 	/* Which io_context we are going to use. */
 	io_context*	io_ctx = m_array->io_ctx(m_segment);
 
-	/* Starting point of the m_segment we will be working on. */
-	ulint	start_pos = m_segment * m_n_slots;
-
-	/* End point. */
-	ulint	end_pos = start_pos + m_n_slots;
-
 	for (;;) {
 		struct io_event*	events;
 
@@ -1900,41 +2272,9 @@ LinuxAIOHandler::collect()
 			iocb = reinterpret_cast<struct iocb*>(events[i].obj);
 			ut_a(iocb != NULL);
 
-			Slot*	slot = reinterpret_cast<Slot*>(iocb->data);
-
-			/* Some sanity checks. */
-			ut_a(slot != NULL);
-			ut_a(slot->is_reserved);
-
-			/* We are not scribbling previous segment. */
-			ut_a(slot->pos >= start_pos);
-
-			/* We have not overstepped to next segment. */
-			ut_a(slot->pos < end_pos);
-
-			/* Deallocate unused blocks from file system.
-			This is newer done to page 0 or to log files.*/
-			if (slot->offset > 0
-			    && !slot->type.is_log()
-			    && slot->type.is_write()
-			    && slot->type.punch_hole()) {
-
-				slot->err = slot->type.punch_hole(
-					slot->file,
-					slot->offset, slot->len);
-			} else {
-				slot->err = DB_SUCCESS;
-			}
-
-			/* Mark this request as completed. The error handling
-			will be done in the calling function. */
-			m_array->acquire();
-
-			slot->ret = events[i].res2;
-			slot->io_already_done = true;
-			slot->n_bytes = events[i].res;
-
-			m_array->release();
+			mark_completed(
+				reinterpret_cast<Slot*>(iocb->data),
+				int(events[i].res2), ssize_t(events[i].res));
 		}
 
 		if (srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS
@@ -1972,7 +2312,69 @@ LinuxAIOHandler::collect()
 
 		break;
 	}
+#endif /* !LINUX_NATIVE_AIO */
+}
+
+#ifdef LINUX_IO_URING
+/** Collect completed requests from the io_uring of the segment, like
+collect(). The requests that were queued without submitting them are
+submitted first. */
+void
+LinuxAIOHandler::collect_uring()
+{
+	os_uring_t*	ring = m_array->uring(m_segment);
+
+	for (;;) {
+		m_array->acquire();
+		os_uring_submit(ring);
+		m_array->release();
+
+		unsigned	head = *ring->cq_head;
+
+		if (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+			/* Wait for completions. The timeout lets us
+			check the server state, like io_getevents(). */
+			struct pollfd	pfd;
+
+			pfd.fd = ring->fd;
+			pfd.events = POLLIN;
+			pfd.revents = 0;
+
+			if (::poll(&pfd, 1, int(OS_AIO_REAP_TIMEOUT / 1000000))
+			    < 0 && errno != EINTR) {
+				ib::fatal()
+					<< "poll() on io_uring failed with"
+					" errno " << errno;
+			}
+		}
+
+		/* Reap the completion queue directly from the
+		shared memory, without a system call. */
+		const unsigned	tail = __atomic_load_n(
+			ring->cq_tail, __ATOMIC_ACQUIRE);
+		const bool	reaped = head != tail;
+
+		for (; head != tail; head++) {
+			const struct io_uring_cqe*	cqe
+				= &ring->cqes[head & ring->cq_mask];
+			const int	res = cqe->res;
+
+			mark_completed(
+				reinterpret_cast<Slot*>(cqe->user_data),
+				res < 0 ? res : 0, res < 0 ? 0 : res);
+		}
+
+		__atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+
+		if (srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS
+		    || !buf_page_cleaner_is_active
+		    || reaped) {
+
+			break;
+		}
+	}
 }
+#endif /* LINUX_IO_URING */
 
 /** Process a Linux AIO request
 @param[out]	m1		the messages passed with the
@@ -2055,6 +2457,8 @@ LinuxAIOHandler::poll(fil_node_t** m1, void** m2, IORequest* request)
 
 	*request = slot->type;
 
+	os_aio_monitor_latency(slot);
+
 	m_array->release(slot);
 
 	m_array->release();
@@ -2095,13 +2499,28 @@ os_aio_linux_handler(
 
 /** Dispatch an AIO request to the kernel.
 @param[in,out]	slot		an already reserved slot
+@param[in]	submit		false to leave an io_uring request queued
+				until os_aio_simulated_wake_handler_threads()
 @return true on success. */
 bool
-AIO::linux_dispatch(Slot* slot)
+AIO::linux_dispatch(Slot* slot, bool submit)
 {
 	ut_a(slot->is_reserved);
 	ut_ad(slot->type.validate());
 
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring) {
+		acquire();
+		uring_dispatch(slot, submit);
+		release();
+		return(true);
+	}
+#endif /* LINUX_IO_URING */
+
+#ifndef LINUX_NATIVE_AIO
+	ut_error;
+	return(false);
+#else
 	/* Find out what we are going to work with.
 	The iocb struct is directly in the slot.
 	The io_context is one per segment. */
@@ -2121,8 +2540,107 @@ AIO::linux_dispatch(Slot* slot)
 	}
 
 	return(ret == 1);
+#endif /* !LINUX_NATIVE_AIO */
+}
+
+#ifdef LINUX_IO_URING
+/** Queue an AIO request to the io_uring of its segment.
+The caller must own the mutex.
+@param[in,out]	slot	an already reserved slot
+@param[in]	submit	whether to submit the queued requests of
+			the segment to the kernel now */
+void
+AIO::uring_dispatch(Slot* slot, bool submit)
+{
+	ut_ad(is_mutex_owned());
+	ut_a(slot->is_reserved);
+
+	os_uring_t*	ring = uring((slot->pos * m_n_segments) / m_slots.size());
+	const unsigned	tail = *ring->sq_tail;
+
+	/* Each slot of the segment has at most one queued request,
+	and the ring has at least as many entries as the segment has
+	slots. */
+	ut_a(tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE)
+	     < ring->sq_entries);
+
+	struct io_uring_sqe*	sqe = &ring->sqes[tail & ring->sq_mask];
+
+	memset(sqe, 0x0, sizeof *sqe);
+
+	slot->iov.iov_base = slot->ptr;
+	slot->iov.iov_len = slot->len;
+
+	sqe->opcode = slot->type.is_read()
+		? IORING_OP_READV : IORING_OP_WRITEV;
+	sqe->fd = slot->file;
+	sqe->off = slot->offset;
+	sqe->addr = reinterpret_cast<uintptr_t>(&slot->iov);
+	sqe->len = 1;
+	sqe->user_data = reinterpret_cast<uintptr_t>(slot);
+
+	ring->sq_array[tail & ring->sq_mask] = tail & ring->sq_mask;
+
+	__atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	if (submit) {
+		os_uring_submit(ring);
+	}
+}
+
+/** Submit the queued requests of all segments to the kernel */
+void
+AIO::uring_submit()
+{
+	acquire();
+
+	for (ulint i = 0; i < m_n_segments; ++i) {
+		os_uring_submit(uring(i));
+	}
+
+	release();
+}
+
+/** Submit the queued requests of all the AIO arrays to the kernel */
+void
+AIO::uring_submit_all()
+{
+	s_reads->uring_submit();
+
+	if (s_writes != NULL) {
+		s_writes->uring_submit();
+	}
+
+	if (s_ibuf != NULL) {
+		s_ibuf->uring_submit();
+	}
+
+	if (s_log != NULL) {
+		s_log->uring_submit();
+	}
+}
+
+/** Checks if io_uring can be used on this system.
+@return true if supported, false otherwise. */
+bool
+AIO::is_uring_supported()
+{
+	os_uring_t	ring;
+
+	if (!os_uring_create(&ring, 1)) {
+		ib::info()
+			<< "You can disable io_uring by setting"
+			" innodb_use_io_uring = 0 in my.cnf";
+		return(false);
+	}
+
+	os_uring_close(&ring);
+
+	return(true);
 }
+#endif /* LINUX_IO_URING */
 
+#ifdef LINUX_NATIVE_AIO
 /** Creates an io_context for native linux AIO.
 @param[in]	max_events	number of events
 @param[out]	io_ctx		io_ctx to initialize.
@@ -2327,9 +2845,10 @@ AIO::is_linux_native_aio_supported()
 
 	return(false);
 }
-
 #endif /* LINUX_NATIVE_AIO */
 
+#endif /* LINUX_NATIVE_AIO || LINUX_IO_URING */
+
 /** Retrieves the last error number if an error occurs in a file io function.
 The number should be retrieved before any other OS calls (because they may
 overwrite the error number). If the number is not known to this program,
@@ -5716,7 +6235,7 @@ os_aio_handler(
 
 		err = os_aio_windows_handler(segment, 0, m1, m2, request);
 
-#elif defined(LINUX_NATIVE_AIO)
+#elif defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
 
 		err = os_aio_linux_handler(segment, m1, m2, request);
 
@@ -5752,6 +6271,9 @@ AIO::AIO(
 	,m_aio_ctx(),
 	m_events(m_slots.size())
 # endif /* LINUX_NATIVE_AIO */
+# ifdef LINUX_IO_URING
+	,m_uring()
+# endif /* LINUX_IO_URING */
 {
 	ut_a(n > 0);
 	ut_a(m_n_segments > 0);
@@ -5784,13 +6306,15 @@ AIO::init_slots()
 
 		slot.array = this;
 
-#elif defined(LINUX_NATIVE_AIO)
+#elif defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
 
 		slot.ret = 0;
 
 		slot.n_bytes = 0;
 
+# ifdef LINUX_NATIVE_AIO
 		memset(&slot.control, 0x0, sizeof(slot.control));
+# endif /* LINUX_NATIVE_AIO */
 
 #endif /* WIN_ASYNC_IO */
 	}
@@ -5848,6 +6372,52 @@ AIO::init_linux_native_aio()
 }
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+/** Initialise an io_uring for each segment */
+dberr_t
+AIO::init_uring()
+{
+	ut_a(m_uring == NULL);
+
+	m_uring = static_cast<os_uring_t*>(
+		ut_zalloc_nokey(m_n_segments * sizeof(*m_uring)));
+
+	if (m_uring == NULL) {
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	for (ulint i = 0; i < m_n_segments; ++i) {
+
+		if (!os_uring_create(
+			    &m_uring[i], unsigned(slots_per_segment()))) {
+
+			/* The rings of the other AIO arrays may have
+			been created already, so we cannot switch to
+			libaio here. Fall back to simulated AIO. */
+
+			ib::warn()
+				<< "io_uring disabled because"
+				" io_uring_setup() failed. To get rid of"
+				" this warning you can try increasing"
+				" the locked memory limit (ulimit -l) or"
+				" setting innodb_use_io_uring = 0 in my.cnf";
+
+			while (i--) {
+				os_uring_close(&m_uring[i]);
+			}
+
+			ut_free(m_uring);
+			m_uring = NULL;
+			srv_use_io_uring = FALSE;
+			srv_use_native_aio = FALSE;
+			return(DB_SUCCESS);
+		}
+	}
+
+	return(DB_SUCCESS);
+}
+#endif /* LINUX_IO_URING */
+
 /** Initialise the array */
 dberr_t
 AIO::init()
@@ -5855,7 +6425,17 @@ AIO::init()
 	ut_a(!m_slots.empty());
 
 
-	if (srv_use_native_aio) {
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring) {
+		dberr_t	err = init_uring();
+
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
+	}
+#endif /* LINUX_IO_URING */
+
+	if (srv_use_native_aio && !srv_use_io_uring) {
 #ifdef LINUX_NATIVE_AIO
 		dberr_t	err = init_linux_native_aio();
 
@@ -5919,6 +6499,16 @@ AIO::~AIO()
 	}
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+	if (m_uring != NULL) {
+		for (ulint i = 0; i < m_n_segments; ++i) {
+			os_uring_close(&m_uring[i]);
+		}
+
+		ut_free(m_uring);
+	}
+#endif /* LINUX_IO_URING */
+
 	m_slots.clear();
 }
 
@@ -5941,9 +6531,22 @@ AIO::start(
 	ulint		n_writers,
 	ulint		n_slots_sync)
 {
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring && !is_uring_supported()) {
+
+		ib::warn() << "io_uring disabled.";
+
+		srv_use_io_uring = FALSE;
+# ifndef LINUX_NATIVE_AIO
+		srv_use_native_aio = FALSE;
+# endif /* !LINUX_NATIVE_AIO */
+	}
+#endif /* LINUX_IO_URING */
+
 #if defined(LINUX_NATIVE_AIO)
 	/* Check if native aio is supported on this system and tmpfs */
-	if (srv_use_native_aio && !is_linux_native_aio_supported()) {
+	if (srv_use_native_aio && !srv_use_io_uring
+	    && !is_linux_native_aio_supported()) {
 
 		ib::warn() << "Linux Native AIO disabled.";
 
@@ -6115,9 +6718,9 @@ os_aio_wake_all_threads_at_shutdown()
 {
 #ifdef WIN_ASYNC_IO
 	AIO::wake_at_shutdown();
-#elif defined(LINUX_NATIVE_AIO)
+#elif defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
 	/* When using native AIO interface the io helper threads
-	wait on io_getevents with a timeout value of 500ms. At
+	wait on io_getevents or poll with a timeout value of 500ms. At
 	each wake up these threads check the server status.
 	No need to do anything to wake them up. */
 #endif /* !WIN_ASYNC_AIO */
@@ -6298,6 +6901,7 @@ AIO::reserve_slot(
 	slot->original_len = static_cast<uint32>(len);
 	slot->io_already_done = false;
 	slot->buf      = static_cast<byte*>(buf);
+	slot->start_us = ut_time_us(NULL);
 
 #ifdef WIN_ASYNC_IO
 	{
@@ -6309,8 +6913,9 @@ AIO::reserve_slot(
 	}
 #elif defined(LINUX_NATIVE_AIO)
 
-	/* If we are not using native AIO skip this part. */
-	if (srv_use_native_aio) {
+	/* If we are not using native AIO skip this part. io_uring
+	requests are prepared in AIO::uring_dispatch(). */
+	if (srv_use_native_aio && !srv_use_io_uring) {
 
 		off_t		aio_offset;
 
@@ -6403,6 +7008,14 @@ void
 os_aio_simulated_wake_handler_threads()
 {
 	if (srv_use_native_aio) {
+#ifdef LINUX_IO_URING
+		if (srv_use_io_uring) {
+			/* Submit the batch of requests that were
+			posted with IORequest::DO_NOT_WAKE. */
+			AIO::uring_submit_all();
+		}
+#endif /* LINUX_IO_URING */
+
 		/* We do not use simulated aio: do nothing */
 
 		return;
@@ -6452,10 +7065,10 @@ AIO::select_slot_array(IORequest& type, bool read_only, ulint mode)
 	case OS_AIO_SYNC:
 
 		array = AIO::s_sync;
-#if defined(LINUX_NATIVE_AIO)
+#if defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
 		/* In Linux native AIO we don't use sync IO array. */
 		ut_a(!srv_use_native_aio);
-#endif /* LINUX_NATIVE_AIO */
+#endif /* LINUX_NATIVE_AIO || LINUX_IO_URING */
 		break;
 
 	default:
@@ -6617,6 +7230,8 @@ os_aio_windows_handler(
 		err = AIOHandler::post_io_processing(slot);
 	}
 
+	os_aio_monitor_latency(slot);
+
 	ut_a(slot->array);
 	slot->array->release_with_mutex(slot);
 
@@ -6711,8 +7326,8 @@ os_aio_func(
 			ret = ReadFile(
 				file, slot->ptr, slot->len,
 				NULL, &slot->control);
-#elif defined(LINUX_NATIVE_AIO)
-			if (!array->linux_dispatch(slot)) {
+#elif defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
+			if (!array->linux_dispatch(slot, type.is_wake())) {
 				goto err_exit;
 			}
 #endif /* WIN_ASYNC_IO */
@@ -6729,8 +7344,8 @@ os_aio_func(
 			ret = WriteFile(
 				file, slot->ptr, slot->len,
 				NULL, &slot->control);
-#elif defined(LINUX_NATIVE_AIO)
-			if (!array->linux_dispatch(slot)) {
+#elif defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
+			if (!array->linux_dispatch(slot, type.is_wake())) {
 				goto err_exit;
 			}
 #endif /* WIN_ASYNC_IO */
@@ -6756,9 +7371,10 @@ os_aio_func(
 	/* AIO request was queued successfully! */
 	return(DB_SUCCESS);
 
-#if defined LINUX_NATIVE_AIO || defined WIN_ASYNC_IO
+#if defined LINUX_NATIVE_AIO || defined LINUX_IO_URING \
+	|| defined WIN_ASYNC_IO
 err_exit:
-#endif /* LINUX_NATIVE_AIO || WIN_ASYNC_IO */
+#endif /* LINUX_NATIVE_AIO || LINUX_IO_URING || WIN_ASYNC_IO */
 
 	array->release_with_mutex(slot);
 
@@ -7321,6 +7937,8 @@ os_aio_simulated_handler(
 
 	*type = slot->type;
 
+	os_aio_monitor_latency(slot);
+
 	array->release(slot);
 
 	array->release();
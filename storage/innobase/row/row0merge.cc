@@ -860,7 +860,8 @@ row_merge_dup_report(
 	row_merge_dup_t*	dup,	/*!< in/out: for reporting duplicates */
 	const dfield_t*		entry)	/*!< in: duplicate index entry */
 {
-	if (!dup->n_dup++) {
+	if (!dup->n_dup++
+	    && (!dup->n_dup_all || !my_atomic_addlint(dup->n_dup_all, 1))) {
 		/* Only report the first duplicate record,
 		but count all duplicate records. */
 		innobase_fields_to_mysql(dup->table, dup->index, entry);
@@ -1765,7 +1766,7 @@ row_merge_read_clustered_index(
 	merge_buf = static_cast<row_merge_buf_t**>(
 		ut_malloc_nokey(n_index * sizeof *merge_buf));
 
-	row_merge_dup_t	clust_dup = {index[0], table, col_map, 0};
+	row_merge_dup_t	clust_dup = {index[0], table, col_map, 0, NULL};
 	dfield_t*	prev_fields;
 	const ulint	n_uniq = dict_index_get_n_unique(index[0]);
 
@@ -2570,7 +2571,8 @@ row_merge_read_clustered_index(
 					}
 				} else if (dict_index_is_unique(buf->index)) {
 					row_merge_dup_t	dup = {
-						buf->index, table, col_map, 0};
+						buf->index, table, col_map, 0,
+						NULL};
 
 					row_merge_buf_sort(buf, &dup);
 
@@ -2883,6 +2885,565 @@ row_merge_read_clustered_index(
 	DBUG_RETURN(err);
 }
 
+/** State of a scan of the clustered index by several threads,
+see row_merge_read_clustered_index_parallel() */
+struct row_merge_scan_t {
+	/** transaction that is creating the indexes */
+	trx_t*			trx;
+	/** MySQL table object, for reporting duplicate keys */
+	struct TABLE*		table;
+	/** the table; not being rebuilt */
+	const dict_table_t*	old_table;
+	/** whether the indexes are being created online */
+	bool			online;
+	/** indexes to be created */
+	dict_index_t**		index;
+	/** temporary files, one for each index */
+	merge_file_t*		files;
+	/** number of indexes to be created */
+	ulint			n_index;
+	/** number of duplicates found by all threads */
+	ulint			n_dup;
+	/** set when one of the threads fails, to make the others stop */
+	volatile bool		failed;
+};
+
+/** A key range of the clustered index that is scanned by one thread */
+struct row_merge_scan_range_t {
+	/** the scan */
+	row_merge_scan_t*	scan;
+	/** the smallest key in the range, or NULL for the start of
+	the index */
+	const dtuple_t*		start;
+	/** the smallest key after the range, or NULL for the end of
+	the index */
+	const dtuple_t*		end;
+	/** sort buffers, one for each index */
+	row_merge_buf_t**	merge_buf;
+	/** number of index entries added to each buffer */
+	ulint*			n_rec;
+	/** file buffer */
+	row_merge_block_t*	block;
+	/** encryption buffer, or NULL */
+	row_merge_block_t*	crypt_block;
+	/** outcome of the scan */
+	dberr_t			err;
+	/** index that an error was reported for */
+	ulint			err_index;
+	/** the thread, if not the one that started the scan */
+	os_thread_id_t		id;
+};
+
+/** Sort a buffer of index entries and write it to the end of the file
+of the index.
+@param[in,out]	range	key range being scanned
+@param[in]	i	index number
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_scan_write(row_merge_scan_range_t* range, ulint i)
+{
+	row_merge_scan_t*	scan	= range->scan;
+	row_merge_buf_t*	buf	= range->merge_buf[i];
+	merge_file_t*		file	= &scan->files[i];
+
+	if (dict_index_is_unique(buf->index)) {
+		row_merge_dup_t	dup = {
+			buf->index, scan->table, NULL, 0, &scan->n_dup};
+
+		row_merge_buf_sort(buf, &dup);
+
+		if (dup.n_dup) {
+			return(DB_DUPLICATE_KEY);
+		}
+	} else {
+		row_merge_buf_sort(buf, NULL);
+	}
+
+	row_merge_buf_write(buf, file, range->block);
+
+	/* The blocks of all threads are appended to the same file.
+	Each block is a run of its own for row_merge_sort(). */
+	if (!row_merge_write(file->fd, my_atomic_addlint(&file->offset, 1),
+			     range->block, range->crypt_block,
+			     scan->old_table->space)) {
+		return(DB_TEMP_FILE_WRITE_FAIL);
+	}
+
+	UNIV_MEM_INVALID(&range->block[0], srv_sort_buf_size);
+
+	range->merge_buf[i] = row_merge_buf_empty(buf);
+
+	return(DB_SUCCESS);
+}
+
+/** Scan a key range of the clustered index and write the entries of
+the indexes to be created to their files.
+@param[in,out]	range	key range
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_scan_range(row_merge_scan_range_t* range)
+{
+	row_merge_scan_t*	scan		= range->scan;
+	trx_t*			trx		= scan->trx;
+	const dict_table_t*	old_table	= scan->old_table;
+	dict_index_t*		clust_index
+		= dict_table_get_first_index(old_table);
+	const ulint		comp
+		= dict_table_is_comp(old_table);
+	mem_heap_t*		row_heap
+		= mem_heap_create(sizeof(mrec_buf_t));
+	mem_heap_t*		v_heap		= NULL;
+	doc_id_t		doc_id		= 0;
+	dberr_t			err		= DB_SUCCESS;
+	btr_pcur_t		pcur;
+	mtr_t			mtr;
+
+	mtr_start(&mtr);
+
+	if (range->start == NULL) {
+		btr_pcur_open_at_index_side(
+			true, clust_index, BTR_SEARCH_LEAF, &pcur, true, 0,
+			&mtr);
+	} else {
+		btr_pcur_open(clust_index, range->start, PAGE_CUR_L,
+			      BTR_SEARCH_LEAF, &pcur, &mtr);
+	}
+
+	for (;;) {
+		const rec_t*	rec = btr_pcur_get_rec(&pcur);
+
+		mem_heap_empty(row_heap);
+
+		if (page_rec_is_supremum(page_rec_get_next_const(rec))) {
+			/* We are at the end of a page. */
+			if (scan->failed) {
+				break;
+			}
+
+			if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
+				err = DB_INTERRUPTED;
+				break;
+			}
+
+			if (my_atomic_load32_explicit(
+				    &clust_index->lock.waiters,
+				    MY_MEMORY_ORDER_RELAXED)) {
+				/* Let the waiters on the clustered index
+				tree lock proceed, as
+				row_merge_read_clustered_index() does. */
+				btr_pcur_store_position(&pcur, &mtr);
+				mtr_commit(&mtr);
+				os_thread_yield();
+				mtr_start(&mtr);
+				btr_pcur_restore_position(
+					BTR_SEARCH_LEAF, &pcur, &mtr);
+			}
+		}
+
+		if (!btr_pcur_move_to_next_user_rec(&pcur, &mtr)) {
+			break;
+		}
+
+		rec = btr_pcur_get_rec(&pcur);
+
+		if (rec_is_default_row(rec, clust_index)) {
+			continue;
+		}
+
+		ulint*	offsets = rec_get_offsets(
+			rec, clust_index, NULL, true, ULINT_UNDEFINED,
+			&row_heap);
+
+		if (range->end != NULL
+		    && cmp_dtuple_rec(range->end, rec, offsets) <= 0) {
+			break;
+		}
+
+		if (scan->online) {
+			/* Perform a REPEATABLE READ, like
+			row_merge_read_clustered_index() does. */
+			trx_id_t rec_trx_id = row_get_rec_trx_id(
+				rec, clust_index, offsets);
+
+			if (!trx->read_view.changes_visible(
+				    rec_trx_id, old_table->name)) {
+				rec_t*	old_vers;
+
+				row_vers_build_for_consistent_read(
+					rec, &mtr, clust_index, &offsets,
+					&trx->read_view, &row_heap,
+					row_heap, &old_vers, NULL);
+
+				if (!old_vers) {
+					continue;
+				}
+
+				rec = old_vers;
+			}
+		}
+
+		if (rec_get_deleted_flag(rec, comp)) {
+			continue;
+		}
+
+		row_ext_t*	ext;
+		const dtuple_t*	row = row_build_w_add_vcol(
+			ROW_COPY_POINTERS, clust_index, rec, offsets,
+			old_table, NULL, NULL, NULL, &ext, row_heap);
+
+		for (ulint i = 0; i < scan->n_index; i++) {
+			ulint	rows_added = row_merge_buf_add(
+				range->merge_buf[i], NULL, old_table,
+				old_table, NULL, row, ext, &doc_id, NULL,
+				&err, &v_heap, NULL, trx);
+
+			if (!rows_added && err == DB_SUCCESS) {
+				/* The buffer is full. */
+				err = row_merge_scan_write(range, i);
+
+				if (err != DB_SUCCESS) {
+					range->err_index = i;
+					break;
+				}
+
+				rows_added = row_merge_buf_add(
+					range->merge_buf[i], NULL, old_table,
+					old_table, NULL, row, ext, &doc_id,
+					NULL, &err, &v_heap, NULL, trx);
+				/* An empty buffer should have enough
+				room for at least one record. */
+				ut_a(rows_added || err != DB_SUCCESS);
+			}
+
+			range->n_rec[i] += rows_added;
+
+			if (err != DB_SUCCESS) {
+				range->err_index = i;
+				break;
+			}
+		}
+
+		if (err != DB_SUCCESS) {
+			break;
+		}
+
+		if (v_heap) {
+			mem_heap_empty(v_heap);
+		}
+	}
+
+	mtr_commit(&mtr);
+	btr_pcur_close(&pcur);
+
+	for (ulint i = 0; err == DB_SUCCESS && i < scan->n_index; i++) {
+		if (range->merge_buf[i]->n_tuples) {
+			err = row_merge_scan_write(range, i);
+			range->err_index = i;
+		}
+	}
+
+	if (err != DB_SUCCESS) {
+		scan->failed = true;
+	}
+
+	if (v_heap) {
+		mem_heap_free(v_heap);
+	}
+
+	mem_heap_free(row_heap);
+
+	return(err);
+}
+
+/** A thread other than the one that called
+row_merge_read_clustered_index_parallel() that scans a key range
+@param[in,out]	arg	row_merge_scan_range_t
+@return a dummy value */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_scan_thread)(void* arg)
+{
+	my_thread_init();
+
+	row_merge_scan_range_t*	range
+		= static_cast<row_merge_scan_range_t*>(arg);
+
+	range->err = row_merge_scan_range(range);
+
+	my_thread_end();
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Split the clustered index into key ranges of roughly equal size,
+at node pointers of the root page.
+@param[in]	index	clustered index
+@param[in]	n	maximum number of ranges
+@param[in,out]	heap	memory heap for the keys
+@param[out]	bounds	the smallest keys of all but the first range
+@return the number of ranges */
+static
+ulint
+row_merge_split_clust_index(
+	dict_index_t*		index,
+	ulint			n,
+	mem_heap_t*		heap,
+	const dtuple_t**	bounds)
+{
+	mtr_t	mtr;
+
+	mtr_start(&mtr);
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	const page_t*	page = buf_block_get_frame(
+		btr_root_block_get(index, RW_S_LATCH, &mtr));
+
+	if (page_is_leaf(page)) {
+		n = 1;
+	} else {
+		const ulint	n_recs = page_get_n_recs(page);
+		const ulint	n_fields
+			= dict_index_get_n_unique_in_tree_nonleaf(index);
+		const rec_t*	rec = page_get_infimum_rec(page);
+		ulint		rec_no = 0;
+
+		n = std::min(n, n_recs);
+
+		/* The first node pointer carries no key; the ranges
+		start at records 0, n_recs / n, 2 * n_recs / n, ... */
+		for (ulint k = 1; k < n; k++) {
+			const ulint	target = k * n_recs / n;
+
+			do {
+				rec = page_rec_get_next_const(rec);
+			} while (rec_no++ < target);
+
+			bounds[k - 1] = dict_index_build_data_tuple(
+				rec, index, false, n_fields, heap);
+		}
+	}
+
+	mtr_commit(&mtr);
+
+	return(n);
+}
+
+/** Determine if row_merge_read_clustered_index_parallel() can be used.
+@param[in]	old_table	table where rows are read from
+@param[in]	new_table	table where indexes are created
+@param[in]	index		indexes to be created
+@param[in]	n_index		number of indexes to create
+@param[in]	add_v		new virtual columns, or NULL
+@param[in]	drop_historical	whether to drop historical system rows
+@param[in]	n_threads	innodb_ddl_threads at the start of the
+				operation
+@return whether the clustered index can be scanned by several threads */
+static
+bool
+row_merge_scan_can_be_parallel(
+	const dict_table_t*	old_table,
+	const dict_table_t*	new_table,
+	dict_index_t**		index,
+	ulint			n_index,
+	const dict_add_v_col_t*	add_v,
+	bool			drop_historical,
+	ulint			n_threads)
+{
+	if (n_threads < 2 || old_table != new_table || add_v
+	    || drop_historical) {
+		return(false);
+	}
+
+	for (ulint i = 0; i < n_index; i++) {
+		if ((index[i]->type & DICT_FTS)
+		    || dict_index_is_spatial(index[i])
+		    || dict_index_has_virtual(index[i])) {
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/** Read the clustered index of the table with several threads, each
+scanning a key range, and create temporary files containing the index
+entries for the secondary indexes to be built. This is only done when
+creating secondary indexes on non-virtual columns without rebuilding the
+table; see row_merge_scan_can_be_parallel(). Each thread sorts its own
+buffers, and all the blocks are appended to a common file for each index.
+@param[in]	trx		transaction
+@param[in,out]	table		MySQL table object, for reporting
+				duplicate keys
+@param[in]	old_table	table where rows are read from
+@param[in]	online		true if creating indexes online
+@param[in]	index		indexes to be created
+@param[in]	files		temporary files
+@param[in]	key_numbers	MySQL key numbers to create
+@param[in]	n_index		number of indexes to create
+@param[in,out]	block		file buffer
+@param[in,out]	tmpfd		temporary file handle
+@param[in,out]	crypt_block	crypted file buffer
+@param[in]	n_threads	maximum number of threads to use
+@return DB_SUCCESS or error code
+@retval DB_UNSUPPORTED if the table is too small to be split */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_read_clustered_index_parallel(
+	trx_t*			trx,
+	struct TABLE*		table,
+	const dict_table_t*	old_table,
+	bool			online,
+	dict_index_t**		index,
+	merge_file_t*		files,
+	const ulint*		key_numbers,
+	ulint			n_index,
+	row_merge_block_t*	block,
+	int*			tmpfd,
+	row_merge_block_t*	crypt_block,
+	ulint			n_threads)
+{
+	DBUG_ENTER("row_merge_read_clustered_index_parallel");
+
+	ut_ad(n_threads > 1);
+
+	mem_heap_t*	heap = mem_heap_create(1024);
+	const dtuple_t** bounds = static_cast<const dtuple_t**>(
+		mem_heap_alloc(heap, (n_threads - 1) * sizeof *bounds));
+	const ulint	n = row_merge_split_clust_index(
+		dict_table_get_first_index(old_table), n_threads,
+		heap, bounds);
+
+	if (n < 2) {
+		mem_heap_free(heap);
+		DBUG_RETURN(DB_UNSUPPORTED);
+	}
+
+	const char*	path = thd_innodb_tmpdir(trx->mysql_thd);
+	dberr_t		err = DB_SUCCESS;
+
+	trx->op_info = "reading clustered index";
+
+	for (ulint i = 0; i < n_index; i++) {
+		if (row_merge_file_create_if_needed(
+			    &files[i], tmpfd, 0, path) < 0) {
+			trx->error_key_num = i;
+			mem_heap_free(heap);
+			trx->op_info = "";
+			DBUG_RETURN(DB_OUT_OF_MEMORY);
+		}
+	}
+
+	row_merge_scan_t	scan = {
+		trx, table, old_table, online, index, files, n_index, 0,
+		false};
+
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	ut_new_pfx_t*	pfx = static_cast<ut_new_pfx_t*>(
+		mem_heap_zalloc(heap, 2 * n * sizeof *pfx));
+	row_merge_scan_range_t*	ranges
+		= static_cast<row_merge_scan_range_t*>(
+			mem_heap_zalloc(heap, n * sizeof *ranges));
+
+	for (ulint k = 0; k < n; k++) {
+		row_merge_scan_range_t*	range = &ranges[k];
+
+		range->scan = &scan;
+		range->start = k ? bounds[k - 1] : NULL;
+		range->end = k + 1 < n ? bounds[k] : NULL;
+		range->merge_buf = static_cast<row_merge_buf_t**>(
+			mem_heap_alloc(heap,
+				       n_index * sizeof *range->merge_buf));
+		range->n_rec = static_cast<ulint*>(
+			mem_heap_zalloc(heap, n_index * sizeof *range->n_rec));
+
+		for (ulint i = 0; i < n_index; i++) {
+			range->merge_buf[i] = row_merge_buf_create(index[i]);
+		}
+
+		if (k == 0) {
+			range->block = block;
+			range->crypt_block = crypt_block;
+			continue;
+		}
+
+		range->block = alloc.allocate_large(
+			srv_sort_buf_size, &pfx[2 * k]);
+
+		if (crypt_block) {
+			range->crypt_block = alloc.allocate_large(
+				srv_sort_buf_size, &pfx[2 * k + 1]);
+		}
+
+		os_thread_create(row_merge_scan_thread, range, &range->id);
+	}
+
+	ranges[0].err = row_merge_scan_range(&ranges[0]);
+
+	for (ulint k = 1; k < n; k++) {
+		os_thread_join(ranges[k].id);
+	}
+
+	for (ulint k = 0; k < n; k++) {
+		row_merge_scan_range_t*	range = &ranges[k];
+
+		if (err == DB_SUCCESS && range->err != DB_SUCCESS) {
+			err = range->err;
+			trx->error_key_num = err == DB_DUPLICATE_KEY
+				? key_numbers[range->err_index]
+				: range->err_index;
+		}
+
+		for (ulint i = 0; i < n_index; i++) {
+			files[i].n_rec += range->n_rec[i];
+			row_merge_buf_free(range->merge_buf[i]);
+		}
+
+		if (k) {
+			alloc.deallocate_large(range->block, &pfx[2 * k]);
+
+			if (range->crypt_block) {
+				alloc.deallocate_large(range->crypt_block,
+						       &pfx[2 * k + 1]);
+			}
+		}
+	}
+
+	for (ulint i = 0; i < n_index; i++) {
+		if (files[i].offset == 0) {
+			/* The table is empty. */
+			row_merge_file_destroy(&files[i]);
+		}
+
+		if (err != DB_SUCCESS || !online) {
+			continue;
+		}
+
+		/* Note the newest transaction that modified this index
+		when the scan was completed. We prevent older readers
+		from accessing this index, to ensure read consistency. */
+		rw_lock_x_lock(dict_index_get_lock(index[i]));
+		ut_a(dict_index_get_online_status(index[i])
+		     == ONLINE_INDEX_CREATION);
+
+		trx_id_t	max_trx_id = row_log_get_max_trx(index[i]);
+
+		if (max_trx_id > index[i]->trx_id) {
+			index[i]->trx_id = max_trx_id;
+		}
+
+		rw_lock_x_unlock(dict_index_get_lock(index[i]));
+	}
+
+	mem_heap_free(heap);
+
+	trx->op_info = "";
+
+	DBUG_RETURN(err);
+}
+
 /** Write a record via buffer 2 and read the next record to buffer N.
 @param N number of the buffer (0 or 1)
 @param INDEX record descriptor
@@ -3360,7 +3921,7 @@ row_merge_sort(
 	*/
 #ifndef UNIV_SOLARIS
 	/* Progress report only for "normal" indexes. */
-	if (!(dup->index->type & DICT_FTS)) {
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_init(trx->mysql_thd, 1);
 	}
 #endif /* UNIV_SOLARIS */
@@ -3377,7 +3938,7 @@ row_merge_sort(
 		show processlist progress field */
 		/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-		if (!(dup->index->type & DICT_FTS)) {
+		if (update_progress && !(dup->index->type & DICT_FTS)) {
 			thd_progress_report(trx->mysql_thd, file->offset - num_runs, file->offset);
 		}
 #endif /* UNIV_SOLARIS */
@@ -3406,7 +3967,7 @@ row_merge_sort(
 
 	/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-	if (!(dup->index->type & DICT_FTS)) {
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_end(trx->mysql_thd);
 	}
 #endif /* UNIV_SOLARIS */
@@ -4570,6 +5131,224 @@ row_merge_write_redo(
 	mtr.commit();
 }
 
+/** State of sorting and loading several indexes in parallel,
+see row_merge_build_indexes_parallel() */
+struct row_merge_build_t {
+	/** transaction that is creating the indexes */
+	trx_t*			trx;
+	/** MySQL table object, for reporting duplicate keys */
+	struct TABLE*		table;
+	/** table where rows are read from */
+	const dict_table_t*	old_table;
+	/** table where indexes are created */
+	const dict_table_t*	new_table;
+	/** mapping of old column numbers to new ones, or NULL */
+	const ulint*		col_map;
+	/** indexes to be created */
+	dict_index_t**		indexes;
+	/** temporary files, one for each index */
+	merge_file_t*		files;
+	/** number of indexes */
+	ulint			n_indexes;
+	/** flush observer for BtrBulk, or NULL */
+	FlushObserver*		flush_observer;
+	/** directory for the temporary files */
+	const char*		path;
+	/** outcome of building each index */
+	dberr_t*		errors;
+	/** whether each index was sorted and loaded */
+	bool*			built;
+	/** progress percentage after the scan */
+	double			pct_progress;
+	/** the total cost of the sort and load, see
+	row_merge_build_indexes() */
+	double			total_cost;
+	/** the dynamic part of total_cost */
+	double			total_dynamic_cost;
+	/** number of blocks in all the files */
+	ulint			total_index_blocks;
+	/** innodb_ddl_threads at the start of the operation */
+	ulint			max_threads;
+	/** the index to be picked next */
+	ulint			next;
+	/** number of duplicates found in all indexes */
+	ulint			n_dup;
+	/** set when one of the threads fails, to make the others stop */
+	volatile bool		failed;
+};
+
+/** Determine if an index can be sorted and loaded by
+row_merge_build_indexes_parallel().
+@param[in]	index	index to be created
+@param[in]	file	temporary file of the index
+@return	whether the index can be built by any thread */
+static
+bool
+row_merge_build_is_parallel(
+	const dict_index_t*	index,
+	const merge_file_t*	file)
+{
+	return(!(index->type & DICT_FTS) && !dict_index_is_spatial(index)
+	       && file->fd >= 0);
+}
+
+/** Sort and load indexes until there are none left.
+@param[in,out]	build	the indexes to be built */
+static
+void
+row_merge_build_indexes_worker(row_merge_build_t* build)
+{
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	ut_new_pfx_t		block_pfx;
+	ut_new_pfx_t		crypt_pfx;
+	row_merge_block_t*	crypt_block = NULL;
+	int			tmpfd = -1;
+	const ulint		space = build->new_table->space;
+	row_merge_block_t*	block = alloc.allocate_large(
+		3 * srv_sort_buf_size, &block_pfx);
+
+	if (log_tmp_is_encrypted()) {
+		crypt_block = alloc.allocate_large(
+			3 * srv_sort_buf_size, &crypt_pfx);
+	}
+
+	for (;;) {
+		ulint	i = my_atomic_addlint(&build->next, 1);
+
+		if (i >= build->n_indexes || build->failed) {
+			break;
+		}
+
+		merge_file_t*	file = &build->files[i];
+		dict_index_t*	index = build->indexes[i];
+
+		if (!row_merge_build_is_parallel(index, file)) {
+			continue;
+		}
+
+		dberr_t		error;
+		const double	cost = COST_BUILD_INDEX_STATIC
+			+ build->total_dynamic_cost * file->offset
+			/ build->total_index_blocks;
+
+		if (tmpfd < 0) {
+			tmpfd = row_merge_file_create_low(build->path);
+		}
+
+		if (block == NULL || (log_tmp_is_encrypted() && !crypt_block)
+		    || tmpfd < 0) {
+			error = DB_OUT_OF_MEMORY;
+			goto done;
+		}
+
+		{
+			row_merge_dup_t	dup = {
+				index, build->table, build->col_map, 0,
+				&build->n_dup};
+
+			error = row_merge_sort(
+				build->trx, &dup, file, block, &tmpfd, false,
+				build->pct_progress, cost / build->total_cost
+				* PCT_COST_MERGESORT_INDEX * 100,
+				crypt_block, space, NULL);
+		}
+
+		DBUG_EXECUTE_IF(
+			"ib_merge_wait_after_sort",
+			os_thread_sleep(20000000););  /* 20 sec */
+
+		if (error == DB_SUCCESS) {
+			BtrBulk	btr_bulk(index, build->trx->id,
+					 build->flush_observer);
+			btr_bulk.init();
+
+			error = row_merge_insert_index_tuples(
+				index, build->old_table, file->fd, block,
+				NULL, &btr_bulk, file->n_rec,
+				build->pct_progress, cost / build->total_cost
+				* PCT_COST_INSERT_INDEX * 100,
+				crypt_block, space, NULL);
+
+			error = btr_bulk.finish(error);
+		}
+done:
+		build->errors[i] = error;
+		build->built[i] = true;
+
+		if (error != DB_SUCCESS) {
+			build->failed = true;
+		}
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	if (block) {
+		alloc.deallocate_large(block, &block_pfx);
+	}
+
+	if (crypt_block) {
+		alloc.deallocate_large(crypt_block, &crypt_pfx);
+	}
+}
+
+/** A thread other than the one that called
+row_merge_build_indexes_parallel() that sorts and loads indexes
+@param[in,out]	arg	row_merge_build_t
+@return a dummy value */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_build_indexes_thread)(void* arg)
+{
+	my_thread_init();
+
+	row_merge_build_indexes_worker(static_cast<row_merge_build_t*>(arg));
+
+	my_thread_end();
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Sort the temporary files of the indexes and load the indexes with
+up to innodb_ddl_threads threads, each building one index at a time.
+FULLTEXT and SPATIAL indexes are left to row_merge_build_indexes().
+@param[in,out]	build	the indexes to be built */
+static
+void
+row_merge_build_indexes_parallel(row_merge_build_t* build)
+{
+	ulint	n_threads = 0;
+
+	for (ulint i = 0; i < build->n_indexes; i++) {
+		build->built[i] = false;
+		build->errors[i] = DB_SUCCESS;
+		n_threads += row_merge_build_is_parallel(
+			build->indexes[i], &build->files[i]);
+	}
+
+	n_threads = std::min(n_threads, build->max_threads);
+
+	if (n_threads < 2) {
+		return;
+	}
+
+	os_thread_id_t*	ids = static_cast<os_thread_id_t*>(
+		ut_malloc_nokey((n_threads - 1) * sizeof *ids));
+
+	for (ulint t = 1; t < n_threads; t++) {
+		os_thread_create(row_merge_build_indexes_thread, build,
+				 &ids[t - 1]);
+	}
+
+	row_merge_build_indexes_worker(build);
+
+	for (ulint t = 1; t < n_threads; t++) {
+		os_thread_join(ids[t - 1]);
+	}
+
+	ut_free(ids);
+}
+
 /** Build indexes on a table by reading a clustered index, creating a temporary
 file containing index entries, merge sorting these index entries and inserting
 sorted index entries to indexes.
@@ -4633,6 +5412,9 @@ row_merge_build_indexes(
 	fts_psort_t*		merge_info = NULL;
 	int64_t			sig_count = 0;
 	bool			fts_psort_initiated = false;
+	row_merge_build_t*	build = NULL;
+	/* innodb_ddl_threads may be changed while we are running */
+	const ulint		n_ddl_threads = srv_n_ddl_threads;
 
 	double total_static_cost = 0;
 	double total_dynamic_cost = 0;
@@ -4733,6 +5515,7 @@ row_merge_build_indexes(
 			dup->table = table;
 			dup->col_map = col_map;
 			dup->n_dup = 0;
+			dup->n_dup_all = NULL;
 
 			/* This can fail e.g. if temporal files can't be
 			created */
@@ -4772,12 +5555,25 @@ row_merge_build_indexes(
 
 	/* Read clustered index of the table and create files for
 	secondary index entries for merge sort */
-	error = row_merge_read_clustered_index(
-		trx, table, old_table, new_table, online, indexes,
-		fts_sort_idx, psort_info, merge_files, key_numbers,
-		n_indexes, add_cols, add_v, col_map, add_autoinc,
-		sequence, block, skip_pk_sort, &tmpfd, stage,
-		pct_cost, crypt_block, eval_table, drop_historical);
+	error = DB_UNSUPPORTED;
+
+	if (row_merge_scan_can_be_parallel(old_table, new_table, indexes,
+					   n_indexes, add_v,
+					   drop_historical, n_ddl_threads)) {
+		error = row_merge_read_clustered_index_parallel(
+			trx, table, old_table, online, indexes, merge_files,
+			key_numbers, n_indexes, block, &tmpfd, crypt_block,
+			n_ddl_threads);
+	}
+
+	if (error == DB_UNSUPPORTED) {
+		error = row_merge_read_clustered_index(
+			trx, table, old_table, new_table, online, indexes,
+			fts_sort_idx, psort_info, merge_files, key_numbers,
+			n_indexes, add_cols, add_v, col_map, add_autoinc,
+			sequence, block, skip_pk_sort, &tmpfd, stage,
+			pct_cost, crypt_block, eval_table, drop_historical);
+	}
 
 	stage->end_phase_read_pk();
 
@@ -4802,6 +5598,32 @@ row_merge_build_indexes(
 	/* Now we have files containing index entries ready for
 	sorting and inserting. */
 
+	if (n_ddl_threads > 1) {
+		build = static_cast<row_merge_build_t*>(
+			ut_zalloc_nokey(sizeof *build));
+		build->trx = trx;
+		build->table = table;
+		build->old_table = old_table;
+		build->new_table = new_table;
+		build->col_map = col_map;
+		build->indexes = indexes;
+		build->files = merge_files;
+		build->n_indexes = n_indexes;
+		build->flush_observer = flush_observer;
+		build->path = thd_innodb_tmpdir(trx->mysql_thd);
+		build->errors = static_cast<dberr_t*>(
+			ut_malloc_nokey(n_indexes * sizeof *build->errors));
+		build->built = static_cast<bool*>(
+			ut_malloc_nokey(n_indexes * sizeof *build->built));
+		build->pct_progress = pct_progress;
+		build->total_cost = total_static_cost + total_dynamic_cost;
+		build->total_dynamic_cost = total_dynamic_cost;
+		build->total_index_blocks = total_index_blocks;
+		build->max_threads = n_ddl_threads;
+
+		row_merge_build_indexes_parallel(build);
+	}
+
 	for (i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
 
@@ -4881,10 +5703,14 @@ row_merge_build_indexes(
 #ifdef FTS_INTERNAL_DIAG_PRINT
 			DEBUG_FTS_SORT_PRINT("FTS_SORT: Complete Insert\n");
 #endif
+		} else if (build && build->built[i]) {
+			/* The index was sorted and loaded by
+			row_merge_build_indexes_parallel(). */
+			error = build->errors[i];
 		} else if (merge_files[i].fd >= 0) {
 			char	buf[NAME_LEN + 1];
 			row_merge_dup_t	dup = {
-				sort_idx, table, col_map, 0};
+				sort_idx, table, col_map, 0, NULL};
 
 			pct_cost = (COST_BUILD_INDEX_STATIC +
 				(total_dynamic_cost * merge_files[i].offset /
@@ -5036,6 +5862,12 @@ row_merge_build_indexes(
 
 	ut_free(merge_files);
 
+	if (build) {
+		ut_free(build->errors);
+		ut_free(build->built);
+		ut_free(build);
+	}
+
 	alloc.deallocate_large(block, &block_pfx);
 
 	if (crypt_block) {
@@ -0,0 +1,354 @@
+/*****************************************************************************
+
+Copyright (c) 2018, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file row/row0pread.cc
+Consistent read of a whole table with several threads
+*******************************************************/
+
+#include "row0pread.h"
+#include "btr0cur.h"
+#include "btr0pcur.h"
+#include "lock0lock.h"
+#include "row0mysql.h"
+#include "row0sel.h"
+#include "row0vers.h"
+#include "srv0srv.h"
+#include "trx0trx.h"
+
+/** Number of records after which a scan thread commits its
+mini-transaction, so that it does not keep a page latched for long */
+#define ROW_PREAD_RECS_PER_MTR	1000
+
+/** State of a parallel scan, shared by its threads */
+struct row_pread_t {
+	/** prebuilt struct of the handler */
+	row_prebuilt_t*		prebuilt;
+	/** the clustered index */
+	dict_index_t*		index;
+	/** the consistent read view, or NULL to read the latest
+	version of the records */
+	ReadView*		view;
+	/** keys that split the index into ranges */
+	btr_keys_t		keys;
+	/** number of the next range to read, keys.size() + 1 ranges */
+	ulint			next_range;
+	/** nonzero if a thread failed and the others should stop */
+	int32			aborted;
+	/** called for each row */
+	row_pread_callback_t	callback;
+	/** argument of callback */
+	void*			arg;
+};
+
+/** A thread of a parallel scan */
+struct row_pread_thread_t {
+	/** the scan */
+	row_pread_t*		pread;
+	/** number of the thread, passed to pread->callback */
+	ulint			thread_no;
+	/** buffer for the rows in MySQL format */
+	byte*			mysql_rec;
+	/** outcome of the ranges read by this thread */
+	dberr_t			err;
+	/** thread identifier */
+	os_thread_id_t		id;
+};
+
+/** Check if the rows can be read with row_pread_scan().
+@param[in]	prebuilt	prebuilt struct, with the template built
+				for the clustered index
+@return whether the table can be scanned in parallel */
+bool
+row_pread_is_possible(const row_prebuilt_t* prebuilt)
+{
+	if (!dict_index_is_clust(prebuilt->index)
+	    || dict_table_has_fts_index(prebuilt->table)) {
+		return(false);
+	}
+
+	for (ulint i = 0; i < prebuilt->n_template; i++) {
+		const mysql_row_templ_t*templ = &prebuilt->mysql_template[i];
+
+		if (templ->is_virtual
+		    || DATA_LARGE_MTYPE(templ->type)
+		    || DATA_GEOMETRY_MTYPE(templ->type)) {
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/** Read the records of one range of the clustered index.
+@param[in,out]	thr	scan thread
+@param[in]	range	number of the range
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_pread_range(row_pread_thread_t* thr, ulint range)
+{
+	row_pread_t*	pread = thr->pread;
+	row_prebuilt_t*	prebuilt = pread->prebuilt;
+	dict_index_t*	index = pread->index;
+	const dtuple_t*	low = range ? pread->keys[range - 1] : NULL;
+	const dtuple_t*	high = range < pread->keys.size()
+		? pread->keys[range] : NULL;
+	const bool	comp = dict_table_is_comp(index->table);
+	mem_heap_t*	heap = NULL;
+	mem_heap_t*	vers_heap = NULL;
+	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*		offsets = offsets_;
+	ulint		n_recs = 0;
+	bool		move;
+	btr_pcur_t	pcur;
+	mtr_t		mtr;
+	dberr_t		err;
+
+	rec_offs_init(offsets_);
+	mtr.start();
+
+	if (low) {
+		/* The cursor is positioned on the first record that is
+		not less than low, or on the supremum before it */
+		err = btr_pcur_open(index, low, PAGE_CUR_GE,
+				    BTR_SEARCH_LEAF, &pcur, &mtr);
+		move = false;
+	} else {
+		err = btr_pcur_open_at_index_side(
+			true, index, BTR_SEARCH_LEAF, &pcur, true, 0, &mtr);
+		move = true;
+	}
+
+	while (err == DB_SUCCESS) {
+		if (move && !btr_pcur_move_to_next(&pcur, &mtr)) {
+			break;
+		}
+
+		move = true;
+
+		const rec_t*	rec = btr_pcur_get_rec(&pcur);
+
+		if (!page_rec_is_user_rec(rec)
+		    || rec_is_default_row(rec, index)) {
+			continue;
+		}
+
+		offsets = rec_get_offsets(rec, index, offsets, true,
+					  ULINT_UNDEFINED, &heap);
+
+		if (high && cmp_dtuple_rec(high, rec, offsets) <= 0) {
+			break;
+		}
+
+		if (pread->view
+		    && srv_force_recovery < 5
+		    && !lock_clust_rec_cons_read_sees(rec, index, offsets,
+						      pread->view)) {
+			rec_t*	old_vers;
+
+			if (vers_heap) {
+				mem_heap_empty(vers_heap);
+			} else {
+				vers_heap = mem_heap_create(200);
+			}
+
+			err = row_vers_build_for_consistent_read(
+				rec, &mtr, index, &offsets, pread->view,
+				&heap, vers_heap, &old_vers, NULL);
+
+			if (err != DB_SUCCESS) {
+				break;
+			}
+
+			rec = old_vers;
+		}
+
+		if (rec
+		    && !rec_get_deleted_flag(rec, comp)
+		    && row_sel_store_mysql_rec(thr->mysql_rec, prebuilt, rec,
+					       NULL, true, index, offsets)) {
+			pread->callback(pread->arg, thr->thread_no,
+					thr->mysql_rec);
+		}
+
+		if (++n_recs % ROW_PREAD_RECS_PER_MTR == 0) {
+			if (trx_is_interrupted(prebuilt->trx)
+			    || my_atomic_load32(&pread->aborted)) {
+				err = DB_INTERRUPTED;
+				break;
+			}
+
+			/* The offsets may have been allocated from heap
+			for an old version of a record */
+			if (heap) {
+				mem_heap_free(heap);
+				heap = NULL;
+				offsets = offsets_;
+			}
+
+			btr_pcur_store_position(&pcur, &mtr);
+			mtr.commit();
+			mtr.start();
+			btr_pcur_restore_position(BTR_SEARCH_LEAF, &pcur, &mtr);
+		}
+	}
+
+	btr_pcur_close(&pcur);
+	mtr.commit();
+
+	if (heap) {
+		mem_heap_free(heap);
+	}
+
+	if (vers_heap) {
+		mem_heap_free(vers_heap);
+	}
+
+	return(err);
+}
+
+/** Read ranges until none is left or the scan is aborted.
+@param[in,out]	thr	scan thread */
+static
+void
+row_pread_ranges(row_pread_thread_t* thr)
+{
+	row_pread_t*	pread = thr->pread;
+	const ulint	n_ranges = pread->keys.size() + 1;
+
+	thr->err = DB_SUCCESS;
+
+	for (;;) {
+		ulint	range = my_atomic_addlint(&pread->next_range, 1);
+
+		if (range >= n_ranges || my_atomic_load32(&pread->aborted)) {
+			break;
+		}
+
+		thr->err = row_pread_range(thr, range);
+
+		if (thr->err != DB_SUCCESS) {
+			my_atomic_store32(&pread->aborted, 1);
+			break;
+		}
+	}
+}
+
+/** Scan thread other than the one that called row_pread_scan()
+@param[in,out]	arg	row_pread_thread_t
+@return a dummy value */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_pread_thread)(void* arg)
+{
+	my_thread_init();
+
+	row_pread_ranges(static_cast<row_pread_thread_t*>(arg));
+
+	my_thread_end();
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Read all rows of the table in the consistent read view of the
+transaction, with up to n_threads threads.
+@param[in,out]	prebuilt	prebuilt struct, see row_pread_is_possible()
+@param[in]	n_threads	maximum number of scan threads
+@param[in]	callback	called for every row by the thread that read it
+@param[in,out]	arg		argument of callback
+@return DB_SUCCESS, DB_INTERRUPTED if the query was killed,
+or error code */
+dberr_t
+row_pread_scan(
+	row_prebuilt_t*		prebuilt,
+	ulint			n_threads,
+	row_pread_callback_t	callback,
+	void*			arg)
+{
+	trx_t*		trx = prebuilt->trx;
+	row_pread_t	pread;
+	dberr_t		err = DB_SUCCESS;
+
+	ut_ad(prebuilt->select_lock_type == LOCK_NONE);
+	ut_ad(row_pread_is_possible(prebuilt));
+	ut_ad(n_threads > 0);
+
+	/* Assign a read view for the statement, as row_search_mvcc()
+	would do */
+	trx_start_if_not_started(trx, false);
+	trx->read_view.open(trx);
+	prebuilt->sql_stat_start = FALSE;
+
+	/* The scan threads can not share the BLOB heap */
+	if (prebuilt->blob_heap) {
+		row_mysql_prebuilt_free_blob_heap(prebuilt);
+	}
+
+	pread.prebuilt = prebuilt;
+	pread.index = dict_table_get_first_index(prebuilt->table);
+	pread.view = trx->isolation_level == TRX_ISO_READ_UNCOMMITTED
+		|| prebuilt->table->no_rollback()
+		? NULL : &trx->read_view;
+	pread.next_range = 0;
+	pread.aborted = 0;
+	pread.callback = callback;
+	pread.arg = arg;
+
+	mem_heap_t*	heap = mem_heap_create(1024);
+
+	btr_get_split_keys(pread.index,
+			   n_threads * ROW_PREAD_RANGES_PER_THREAD,
+			   heap, pread.keys);
+
+	n_threads = std::min(n_threads, ulint(pread.keys.size() + 1));
+
+	row_pread_thread_t*	thr = static_cast<row_pread_thread_t*>(
+		mem_heap_alloc(heap, n_threads * sizeof *thr));
+
+	for (ulint i = 0; i < n_threads; i++) {
+		thr[i].pread = &pread;
+		thr[i].thread_no = i;
+		thr[i].mysql_rec = static_cast<byte*>(
+			mem_heap_dup(heap, prebuilt->default_rec,
+				     prebuilt->mysql_row_len));
+		thr[i].err = DB_SUCCESS;
+
+		if (i) {
+			os_thread_create(row_pread_thread, &thr[i],
+					 &thr[i].id);
+		}
+	}
+
+	row_pread_ranges(&thr[0]);
+
+	for (ulint i = 0; i < n_threads; i++) {
+		if (i) {
+			os_thread_join(thr[i].id);
+		}
+
+		if (err == DB_SUCCESS) {
+			err = thr[i].err;
+		}
+	}
+
+	mem_heap_free(heap);
+
+	return(err);
+}
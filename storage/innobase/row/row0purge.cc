@@ -1097,6 +1097,8 @@ row_purge(
 /*======*/
 	purge_node_t*	node,		/*!< in: row purge node */
 	trx_undo_rec_t*	undo_rec,	/*!< in: record to purge */
+	trx_id_t	trx_no,		/*!< in: serialisation number of
+					the transaction of undo_rec */
 	que_thr_t*	thr)		/*!< in: query thread */
 {
 	if (undo_rec != &trx_purge_dummy_rec) {
@@ -1105,9 +1107,30 @@ row_purge(
 		while (row_purge_parse_undo_rec(
 			       node, undo_rec, &updated_extern, thr)) {
 
+			/* The table cannot be evicted from the cache
+			while we hold dict_operation_lock. */
+			dict_table_t*	table = node->table;
+			uintmax_t	start = ut_time_us(NULL);
+
 			bool purged = row_purge_record(
 				node, undo_rec, thr, updated_extern);
 
+			my_atomic_addlint(&table->purge_usec,
+					  ulint(ut_time_us(NULL) - start));
+
+			if (purged) {
+				my_atomic_addlint(&table->n_purged_recs, 1);
+
+				int64	old = int64(table->purge_trx_no);
+
+				while (trx_no > trx_id_t(old)
+				       && !my_atomic_cas64(
+					       reinterpret_cast<int64*>(
+						       &table->purge_trx_no),
+					       &old, int64(trx_no))) {
+				}
+			}
+
 			rw_lock_s_unlock(dict_operation_lock);
 
 			if (purged
@@ -1184,7 +1207,7 @@ row_purge_step(
 
 		node->roll_ptr = purge_rec->roll_ptr;
 
-		row_purge(node, purge_rec->undo_rec, thr);
+		row_purge(node, purge_rec->undo_rec, purge_rec->trx_no, thr);
 
 		if (ib_vector_is_empty(node->undo_recs)) {
 			row_purge_end(thr);
@@ -3077,7 +3077,6 @@ be needed in the query.
 @param[in]	index			index of rec
 @param[in]	offsets			array returned by rec_get_offsets(rec)
 @return TRUE on success, FALSE if not all columns could be retrieved */
-static MY_ATTRIBUTE((warn_unused_result))
 ibool
 row_sel_store_mysql_rec(
 	byte*		mysql_rec,
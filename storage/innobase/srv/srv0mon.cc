@@ -98,6 +98,24 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_DEFAULT_ON,
 	 MONITOR_DEFAULT_START, MONITOR_TIMEOUT},
 
+	{"lock_deadlock_detect_rounds", "lock",
+	 "Number of times the waits were checked for deadlocks in the"
+	 " background (innodb_deadlock_detect_interval)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_DEADLOCK_DETECT_ROUNDS},
+
+	{"lock_deadlock_detect_time", "lock",
+	 "Time spent checking the waits for deadlocks in the background"
+	 " (in microseconds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_DEADLOCK_DETECT_TIME},
+
+	{"lock_deadlock_detect_latency", "lock",
+	 "Time from the forming of the last deadlock until it was"
+	 " detected in the background (in microseconds)",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_DEADLOCK_DETECT_LATENCY},
+
 	{"lock_rec_lock_waits", "lock",
 	 "Number of times enqueued into record lock wait queue",
 	 MONITOR_NONE,
@@ -595,6 +613,44 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_SEARCH},
 
+	/* Histogram of the time to get a block when the free list
+	was empty */
+	{"buffer_LRU_get_free_wait_usec", "Buffer",
+	 "Total time waited for a free block when the free list was empty"
+	 " (in microseconds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_WAIT_TIME},
+
+	{"buffer_LRU_get_free_wait_lt_100us", "Buffer",
+	 "Number of free block waits shorter than 100 microseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_WAIT_LT_100US},
+
+	{"buffer_LRU_get_free_wait_lt_1ms", "Buffer",
+	 "Number of free block waits of 100 microseconds to 1 millisecond",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_WAIT_LT_1MS},
+
+	{"buffer_LRU_get_free_wait_lt_10ms", "Buffer",
+	 "Number of free block waits of 1 to 10 milliseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_WAIT_LT_10MS},
+
+	{"buffer_LRU_get_free_wait_lt_100ms", "Buffer",
+	 "Number of free block waits of 10 to 100 milliseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_WAIT_LT_100MS},
+
+	{"buffer_LRU_get_free_wait_ge_100ms", "Buffer",
+	 "Number of free block waits of 100 milliseconds or longer",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_WAIT_GE_100MS},
+
+	{"buffer_LRU_manager_batches", "Buffer",
+	 "Number of LRU batches run by the LRU manager threads",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_MANAGER_BATCHES},
+
 	/* Cumulative counter for LRU search scans */
 	{"buffer_LRU_search_scanned", "buffer",
 	 "Total pages scanned as part of LRU search",
@@ -770,6 +826,56 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_OS_LOG_PENDING_WRITES},
 
+	{"os_aio_read_usec", "os",
+	 "Total time of asynchronous reads (in microseconds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_READ_TIME},
+
+	{"os_aio_read_lt_1ms", "os",
+	 "Number of asynchronous reads shorter than 1 millisecond",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_READ_LT_1MS},
+
+	{"os_aio_read_lt_10ms", "os",
+	 "Number of asynchronous reads of 1 to 10 milliseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_READ_LT_10MS},
+
+	{"os_aio_read_lt_100ms", "os",
+	 "Number of asynchronous reads of 10 to 100 milliseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_READ_LT_100MS},
+
+	{"os_aio_read_ge_100ms", "os",
+	 "Number of asynchronous reads of 100 milliseconds or longer",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_READ_GE_100MS},
+
+	{"os_aio_write_usec", "os",
+	 "Total time of asynchronous writes (in microseconds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_WRITE_TIME},
+
+	{"os_aio_write_lt_1ms", "os",
+	 "Number of asynchronous writes shorter than 1 millisecond",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_WRITE_LT_1MS},
+
+	{"os_aio_write_lt_10ms", "os",
+	 "Number of asynchronous writes of 1 to 10 milliseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_WRITE_LT_10MS},
+
+	{"os_aio_write_lt_100ms", "os",
+	 "Number of asynchronous writes of 10 to 100 milliseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_WRITE_LT_100MS},
+
+	{"os_aio_write_ge_100ms", "os",
+	 "Number of asynchronous writes of 100 milliseconds or longer",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_WRITE_GE_100MS},
+
 	/* ========== Counters for Transaction Module ========== */
 	{"module_trx", "transaction", "Transaction Manager",
 	 MONITOR_MODULE,
@@ -874,6 +980,37 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_DISPLAY_CURRENT,
 	 MONITOR_DEFAULT_START, MONITOR_PURGE_RESUME_COUNT},
 
+	{"purge_undo_log_records", "purge",
+	 "Number of undo log records handled by the purge",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_N_REC_HANDLED},
+
+	{"purge_batch_tables", "purge",
+	 "Number of tables whose undo log records were in the last"
+	 " purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_N_TABLES},
+
+	{"purge_batch_threads", "purge",
+	 "Number of purge threads that ran the last purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_N_THREADS_USED},
+
+	{"purge_truncate_history_count", "purge",
+	 "Number of times the purged history was truncated",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_TRUNCATE_HISTORY_COUNT},
+
+	{"purge_truncate_history_usec", "purge",
+	 "Time (in microseconds) spent truncating the purged history",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_TRUNCATE_HISTORY_MICROSECOND},
+
+	{"purge_undo_logs_truncated", "purge",
+	 "Number of undo logs removed from the history list",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_N_LOG_TRUNCATED},
+
 	/* ========== Counters for Recovery Module ========== */
 	{"module_log", "recovery", "Recovery Module",
 	 MONITOR_MODULE,
@@ -1164,6 +1301,45 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_IBUF_SIZE},
 
+	/* Histogram of the time to merge buffered changes to a page
+	that was read into the buffer pool */
+	{"ibuf_merge_on_read_usec", "change_buffer",
+	 "Total time spent merging buffered changes to pages read"
+	 " into the buffer pool (in microseconds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_ON_READ_TIME},
+
+	{"ibuf_merge_on_read_lt_1ms", "change_buffer",
+	 "Number of page merges shorter than 1 millisecond",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_ON_READ_LT_1MS},
+
+	{"ibuf_merge_on_read_lt_10ms", "change_buffer",
+	 "Number of page merges of 1 to 10 milliseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_ON_READ_LT_10MS},
+
+	{"ibuf_merge_on_read_lt_100ms", "change_buffer",
+	 "Number of page merges of 10 to 100 milliseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_ON_READ_LT_100MS},
+
+	{"ibuf_merge_on_read_ge_100ms", "change_buffer",
+	 "Number of page merges of 100 milliseconds or longer",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_ON_READ_GE_100MS},
+
+	{"ibuf_sweep_pages", "change_buffer",
+	 "Number of pages read for merging by the change buffer sweep",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_SWEEP_PAGES},
+
+	{"ibuf_eager_merge_pages", "change_buffer",
+	 "Number of recently changed pages read for merging in the"
+	 " background (innodb_change_buffer_eager_merge)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_EAGER_MERGE_PAGES},
+
 	/* ========== Counters for server operations ========== */
 	{"module_innodb", "innodb",
 	 "Counter for general InnoDB server wide operations and properties",
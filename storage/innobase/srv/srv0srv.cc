@@ -97,6 +97,10 @@ bool	srv_buf_resize_thread_active;
 
 my_bool	srv_scrub_log;
 
+/** whether the redo log is written and flushed by log_writer_thread
+and log_flusher_thread */
+my_bool	srv_log_writer_threads;
+
 const char*	srv_main_thread_op_info = "";
 
 /** Prefix used by MySQL to indicate pre-5.1 table name encoding */
@@ -159,6 +163,9 @@ on duplicate key checking and foreign key checking */
 ibool	srv_locks_unsafe_for_binlog;
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size;
+/** innodb_ddl_threads; the number of threads that scan the clustered index
+and sort and load the indexes in ALTER TABLE */
+ulong	srv_n_ddl_threads;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -167,6 +174,9 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
+/** innodb_use_io_uring; whether native aio is done with io_uring
+instead of libaio. Reset at startup if io_uring is not available. */
+my_bool	srv_use_io_uring;
 my_bool	srv_numa_interleave;
 /** copy of innodb_use_atomic_writes; @see innobase_init() */
 my_bool	srv_use_atomic_writes;
@@ -240,6 +250,9 @@ number of locks to protect buf_pool->page_hash */
 ulong	srv_n_page_hash_locks = 16;
 /** innodb_lru_scan_depth; number of blocks scanned in LRU flush batch */
 ulong	srv_LRU_scan_depth;
+/** innodb_lru_manager; whether each buffer pool instance has a thread
+that keeps its free list filled */
+my_bool	srv_lru_manager;
 /** innodb_flush_neighbors; whether or not to flush neighbors of a block */
 ulong	srv_flush_neighbors;
 /** Previously requested size */
@@ -272,6 +285,10 @@ ulong	srv_read_ahead_threshold;
 buffer in terms of percentage of the buffer pool. */
 uint	srv_change_buffer_max_size;
 
+/** innodb_change_buffer_eager_merge; whether the master thread merges
+recently buffered changes in the background */
+my_bool	srv_change_buffer_eager_merge;
+
 char*	srv_file_flush_method_str;
 
 
@@ -289,6 +306,10 @@ ulong	srv_max_io_capacity;
 /** innodb_page_cleaners; the number of page cleaner threads */
 ulong	srv_n_page_cleaners;
 
+/** innodb_recovery_threads; the number of threads that apply the redo log
+during crash recovery */
+ulong	srv_n_recovery_threads = 4;
+
 /* The InnoDB main thread tries to keep the ratio of modified pages
 in the buffer pool to all database pages in the buffer pool smaller than
 the following number. But it is not guaranteed that the value stays below
@@ -364,6 +385,12 @@ my_bool		srv_stats_persistent;
 my_bool		srv_stats_include_delete_marked;
 /** innodb_stats_persistent_sample_pages */
 unsigned long long	srv_stats_persistent_sample_pages;
+/** innodb_stats_persistent_sample_pct; minimum percentage of the leaf
+pages of an index that persistent statistics sample */
+ulong	srv_stats_persistent_sample_pct;
+/** innodb_stats_analyze_threads; the number of threads that analyze the
+indexes of a table when persistent statistics are calculated */
+ulong	srv_stats_analyze_threads;
 /** innodb_stats_auto_recalc */
 my_bool		srv_stats_auto_recalc;
 
@@ -383,6 +410,16 @@ number of pages to use in LRU and flush_list batch flushing.
 The rest of the doublewrite buffer is used for single-page flushing. */
 ulong	srv_doublewrite_batch_size = 120;
 
+/** innodb_doublewrite_per_instance; whether pages are written through
+a doublewrite file per buffer pool instance instead of the doublewrite
+buffer in the system tablespace */
+my_bool	srv_dblwr_per_instance;
+
+/** innodb_doublewrite_file_pages; size of a doublewrite file in pages.
+Most of the pages are used in batch flushing, the rest in single-page
+flushing. */
+ulong	srv_dblwr_file_pages;
+
 /** innodb_replication_delay */
 ulong	srv_replication_delay;
 
@@ -643,6 +680,9 @@ char*	srv_buf_dump_filename;
 and/or load it during startup. */
 char	srv_buffer_pool_dump_at_shutdown = TRUE;
 char	srv_buffer_pool_load_at_startup = TRUE;
+/** innodb_buffer_pool_load_threads; the number of threads that read the
+pages of a buffer pool load */
+ulong	srv_n_buf_load_threads;
 
 /** Slot index in the srv_sys.sys_threads array for the purge thread. */
 static const ulint	SRV_PURGE_SLOT	= 1;
@@ -1538,6 +1578,8 @@ srv_export_innodb_status(void)
 
 	export_vars.innodb_log_waits = srv_stats.log_waits;
 
+	export_vars.innodb_log_copy_waits = srv_stats.log_copy_waits;
+
 	export_vars.innodb_os_log_written = srv_stats.os_log_written;
 
 	export_vars.innodb_os_log_fsyncs = fil_n_log_flushes;
@@ -1717,7 +1759,7 @@ DECLARE_THREAD(srv_monitor_thread)(void*)
 		if (srv_print_innodb_monitor) {
 			/* Reset mutex_skipped counter everytime
 			srv_print_innodb_monitor changes. This is to
-			ensure we will not be blocked by lock_sys->mutex
+			ensure we will not be blocked by lock_sys->latch
 			for short duration information printing,
 			such as requested by sync_array_print_long_waits() */
 			if (!last_srv_print_monitor) {
@@ -2197,6 +2239,7 @@ srv_master_do_active_tasks(void)
 	/* Do an ibuf merge */
 	srv_main_thread_op_info = "doing insert buffer merge";
 	counter_time = ut_time_us(NULL);
+	ibuf_merge_recent();
 	ibuf_merge_in_background(false);
 	MONITOR_INC_TIME_IN_MICRO_SECS(
 		MONITOR_SRV_IBUF_MERGE_MICROSECOND, counter_time);
@@ -2282,6 +2325,7 @@ srv_master_do_idle_tasks(void)
 	/* Do an ibuf merge */
 	counter_time = ut_time_us(NULL);
 	srv_main_thread_op_info = "doing insert buffer merge";
+	ibuf_merge_recent();
 	ibuf_merge_in_background(true);
 	MONITOR_INC_TIME_IN_MICRO_SECS(
 		MONITOR_SRV_IBUF_MERGE_MICROSECOND, counter_time);
@@ -1288,6 +1288,8 @@ srv_shutdown_all_bg_threads()
 			if (log_scrub_thread_active) {
 				os_event_set(log_scrub_event);
 			}
+
+			log_writer_threads_wakeup();
 		}
 
 		if (srv_start_state_is_set(SRV_START_STATE_IO)) {
@@ -1581,9 +1583,22 @@ innobase_start_or_create_for_mysql()
 #ifdef _WIN32
 	srv_use_native_aio = TRUE;
 
-#elif defined(LINUX_NATIVE_AIO)
+#elif defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
+
+	if (!srv_use_native_aio) {
+		srv_use_io_uring = FALSE;
+	}
+# ifndef LINUX_NATIVE_AIO
+	else if (!srv_use_io_uring) {
+		/* Without libaio, io_uring is the only native AIO
+		interface. */
+		srv_use_native_aio = FALSE;
+	}
+# endif /* !LINUX_NATIVE_AIO */
 
-	if (srv_use_native_aio) {
+	if (srv_use_io_uring) {
+		ib::info() << "Using Linux native AIO with io_uring";
+	} else if (srv_use_native_aio) {
 		ib::info() << "Using Linux native AIO";
 	}
 #else
@@ -1658,6 +1673,7 @@ innobase_start_or_create_for_mysql()
 			    + srv_n_write_io_threads
 			    + srv_n_purge_threads
 			    + srv_n_page_cleaners
+			    + srv_n_recovery_threads
 			    /* FTS Parallel Sort */
 			    + fts_sort_pll_degree * FTS_NUM_AUX_INDEX
 			      * max_connections;
@@ -2217,7 +2233,7 @@ innobase_start_or_create_for_mysql()
 
 		err = recv_recovery_from_checkpoint_start(flushed_lsn);
 
-		recv_sys->dblwr.pages.clear();
+		recv_sys->dblwr.clear();
 
 		if (err != DB_SUCCESS) {
 			return(srv_init_abort(err));
@@ -2640,6 +2656,10 @@ innobase_start_or_create_for_mysql()
 			NULL, thread_ids + (1 + SRV_MAX_N_IO_THREADS));
 		thread_started[1 + SRV_MAX_N_IO_THREADS] = true;
 		srv_start_state_set(SRV_START_STATE_MASTER);
+
+		if (srv_log_writer_threads) {
+			log_writer_threads_start();
+		}
 	}
 
 	if (!srv_read_only_mode && srv_operation == SRV_OPERATION_NORMAL
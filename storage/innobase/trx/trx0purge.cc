@@ -539,6 +539,8 @@ trx_purge_truncate_rseg_history(trx_rseg_t* rseg, const purge_iter_t* limit)
 		mtr_commit(&mtr);
 	}
 
+	MONITOR_INC(MONITOR_PURGE_N_LOG_TRUNCATED);
+
 	mtr_start(&mtr);
 	mutex_enter(&(rseg->mutex));
 
@@ -1379,6 +1381,8 @@ trx_undo_rec_t*
 trx_purge_fetch_next_rec(
 /*=====================*/
 	roll_ptr_t*	roll_ptr,	/*!< out: roll pointer to undo record */
+	trx_id_t*	trx_no,		/*!< out: serialisation number of
+					the transaction of the undo log */
 	ulint*		n_pages_handled,/*!< in/out: number of UNDO log pages
 					handled */
 	mem_heap_t*	heap)		/*!< in: memory heap where copied */
@@ -1408,27 +1412,62 @@ trx_purge_fetch_next_rec(
 		purge_sys->rseg->id,
 		purge_sys->page_no, purge_sys->offset);
 
+	*trx_no = purge_sys->iter.trx_no;
+
 	/* The following call will advance the stored values of the
 	purge iterator. */
 
 	return(trx_purge_get_next_rec(n_pages_handled, heap));
 }
 
-/*******************************************************************//**
-This function runs a purge batch.
+/** Number of undo log records of a table that are handed to one purge
+thread before the table is assigned to a thread again */
+static const ulint	TRX_PURGE_TABLE_SLICE = 128;
+
+/** The purge thread that gets the records of a table in a batch */
+struct purge_table_slice_t {
+	/** purge node of the thread */
+	purge_node_t*	node;
+	/** number of records left before the table is assigned again */
+	ulint		n_left;
+};
+
+/** Map of table_id to the purge thread that gets its records in a batch */
+typedef std::map<
+	table_id_t,
+	purge_table_slice_t,
+	std::less<table_id_t>,
+	ut_allocator<std::pair<const table_id_t, purge_table_slice_t> > >
+	purge_table_node_map;
+
+/** Distribute the undo log records of a purge batch to the purge threads.
+The records of a table are handed to the same thread in slices of
+TRX_PURGE_TABLE_SLICE, so that the threads seldom wait for each other on
+the pages and index latches of one table, while a table that dominates
+the batch is still purged by all the threads. At the start of each slice
+the table is assigned to the thread that has got the fewest records so
+far; the threads that got records thus always are the first ones of
+purge_sys->query->thrs.
+@param[in]	n_purge_threads	number of purge threads
+@param[in,out]	purge_sys	purge instance
+@param[in]	batch_size	maximum number of undo log pages to purge
+@param[out]	n_tasks		number of purge threads that got records
 @return number of undo log pages handled in the batch */
 static
 ulint
 trx_purge_attach_undo_recs(
-/*=======================*/
-	ulint		n_purge_threads,/*!< in: number of purge threads */
-	purge_sys_t*	purge_sys,	/*!< in/out: purge instance */
-	ulint		batch_size)	/*!< in: no. of pages to purge */
+	ulint		n_purge_threads,
+	purge_sys_t*	purge_sys,
+	ulint		batch_size,
+	ulint*		n_tasks)
 {
-	que_thr_t*	thr;
-	ulint		i = 0;
-	ulint		n_pages_handled = 0;
-	ulint		n_thrs = UT_LIST_GET_LEN(purge_sys->query->thrs);
+	que_thr_t*		thr;
+	ulint			i = 0;
+	ulint			n_pages_handled = 0;
+	ulint			n_recs = 0;
+	ulint			n_thrs = UT_LIST_GET_LEN(purge_sys->query->thrs);
+	mem_heap_t*		heap;
+	purge_table_node_map	table_node;
 
 	ut_a(n_purge_threads > 0);
 
@@ -1454,28 +1493,22 @@ trx_purge_attach_undo_recs(
 	/* There should never be fewer nodes than threads, the inverse
 	however is allowed because we only use purge threads as needed. */
 	ut_a(i == n_purge_threads);
-
-	/* Fetch and parse the UNDO records. The UNDO records are added
-	to a per purge node vector. */
-	thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
-	ut_a(n_thrs > 0 && thr != NULL);
+	ut_a(n_thrs > 0);
 
 	ut_ad(trx_purge_check_limit());
 
-	i = 0;
+	/* The records are fetched to this heap before we know the
+	purge node whose heap they must be copied to. */
+	heap = mem_heap_create(1024);
 
-	for (;;) {
-		purge_node_t*		node;
-		trx_purge_rec_t*	purge_rec;
+	*n_tasks = 0;
 
-		ut_a(!thr->is_active);
-
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
-		purge_rec = static_cast<trx_purge_rec_t*>(
-			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
+	/* Fetch and parse the UNDO records. The UNDO records are added
+	to a per purge node vector. */
+	for (;;) {
+		trx_purge_rec_t	purge_rec;
+		trx_undo_rec_t*	undo_rec;
+		table_id_t	table_id;
 
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
@@ -1485,39 +1518,104 @@ trx_purge_attach_undo_recs(
 		}
 
 		/* Fetch the next record, and advance the purge_sys->iter. */
-		purge_rec->undo_rec = trx_purge_fetch_next_rec(
-			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
+		undo_rec = trx_purge_fetch_next_rec(
+			&purge_rec.roll_ptr, &purge_rec.trx_no,
+			&n_pages_handled, heap);
+
+		if (undo_rec == NULL) {
+			break;
+		}
 
-		if (purge_rec->undo_rec != NULL) {
+		table_id = undo_rec == &trx_purge_dummy_rec
+			? 0 : trx_undo_rec_get_table_id(undo_rec);
 
-			if (node->undo_recs == NULL) {
-				node->undo_recs = ib_vector_create(
-					ib_heap_allocator_create(node->heap),
-					sizeof(trx_purge_rec_t),
-					batch_size);
-			} else {
-				ut_a(!ib_vector_is_empty(node->undo_recs));
-			}
+		purge_table_slice_t&	slice = table_node[table_id];
 
-			ib_vector_push(node->undo_recs, purge_rec);
+		if (slice.n_left == 0) {
+			ulint	min_recs = ULINT_UNDEFINED;
 
-			if (n_pages_handled >= batch_size) {
+			for (thr = UT_LIST_GET_FIRST(purge_sys->query->thrs),
+			     i = 0;
+			     i < n_purge_threads;
+			     thr = UT_LIST_GET_NEXT(thrs, thr), ++i) {
 
-				break;
+				purge_node_t*	n = static_cast<purge_node_t*>(
+					thr->child);
+				ulint		n_recs = n->undo_recs == NULL
+					? 0 : ib_vector_size(n->undo_recs);
+
+				ut_a(!thr->is_active);
+
+				if (n_recs < min_recs) {
+					min_recs = n_recs;
+					slice.node = n;
+				}
 			}
+
+			if (min_recs == 0) {
+				++*n_tasks;
+			}
+
+			slice.n_left = TRX_PURGE_TABLE_SLICE;
+		}
+
+		slice.n_left--;
+		purge_node_t*	node = slice.node;
+
+		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
+
+		if (undo_rec == &trx_purge_dummy_rec) {
+			purge_rec.undo_rec = undo_rec;
 		} else {
-			break;
+			/* trx_purge_get_next_rec() stored the length
+			of the copy in its first two bytes. */
+			purge_rec.undo_rec = static_cast<trx_undo_rec_t*>(
+				mem_heap_dup(node->heap, undo_rec,
+					     mach_read_from_2(undo_rec)));
 		}
 
-		thr = UT_LIST_GET_NEXT(thrs, thr);
+		mem_heap_empty(heap);
 
-		if (!(++i % n_purge_threads)) {
-			thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
+		if (node->undo_recs == NULL) {
+			node->undo_recs = ib_vector_create(
+				ib_heap_allocator_create(node->heap),
+				sizeof(trx_purge_rec_t),
+				batch_size);
+		} else {
+			ut_a(!ib_vector_is_empty(node->undo_recs));
 		}
 
-		ut_a(thr != NULL);
+		ib_vector_push(node->undo_recs, &purge_rec);
+		n_recs++;
+
+		if (n_pages_handled >= batch_size) {
+
+			break;
+		}
 	}
 
+	mem_heap_free(heap);
+
+	MONITOR_INC_VALUE(MONITOR_PURGE_N_REC_HANDLED, n_recs);
+
+	/* The purge threads that did not get any records will not be
+	run in this batch. */
+	for (thr = UT_LIST_GET_FIRST(purge_sys->query->thrs), i = 0;
+	     i < n_purge_threads;
+	     thr = UT_LIST_GET_NEXT(thrs, thr), ++i) {
+
+		purge_node_t*	node = static_cast<purge_node_t*>(thr->child);
+
+		ut_ad((node->undo_recs != NULL) == (i < *n_tasks));
+
+		if (i >= *n_tasks) {
+			node->done = TRUE;
+		}
+	}
+
+	MONITOR_SET(MONITOR_PURGE_N_TABLES,
+		    table_node.size() - table_node.count(0));
+
 	ut_ad(trx_purge_check_limit());
 
 	return(n_pages_handled);
@@ -1605,6 +1703,7 @@ trx_purge(
 {
 	que_thr_t*	thr = NULL;
 	ulint		n_pages_handled;
+	ulint		n_tasks;
 
 	ut_a(n_purge_threads > 0);
 
@@ -1625,14 +1724,16 @@ trx_purge(
 
 	/* Fetch the UNDO recs that need to be purged. */
 	n_pages_handled = trx_purge_attach_undo_recs(
-		n_purge_threads, purge_sys, batch_size);
+		n_purge_threads, purge_sys, batch_size, &n_tasks);
+
+	MONITOR_SET(MONITOR_PURGE_N_THREADS_USED, n_tasks);
 
 	/* Do we do an asynchronous purge or not ? */
-	if (n_purge_threads > 1) {
+	if (n_tasks > 1) {
 		ulint	i = 0;
 
 		/* Submit the tasks to the work queue. */
-		for (i = 0; i < n_purge_threads - 1; ++i) {
+		for (i = 0; i < n_tasks - 1; ++i) {
 			thr = que_fork_scheduler_round_robin(
 				purge_sys->query, thr);
 
@@ -1644,12 +1745,12 @@ trx_purge(
 		thr = que_fork_scheduler_round_robin(purge_sys->query, thr);
 		ut_a(thr != NULL);
 
-		purge_sys->n_submitted += n_purge_threads - 1;
+		purge_sys->n_submitted += n_tasks - 1;
 
 		goto run_synchronously;
 
 	/* Do it synchronously. */
-	} else {
+	} else if (n_tasks) {
 		thr = que_fork_scheduler_round_robin(purge_sys->query, NULL);
 		ut_ad(thr);
 
@@ -1661,7 +1762,7 @@ trx_purge(
 		my_atomic_addlint(
 			&purge_sys->n_completed, 1);
 
-		if (n_purge_threads > 1) {
+		if (n_tasks > 1) {
 			trx_purge_wait_for_workers_to_complete(purge_sys);
 		}
 	}
@@ -1679,10 +1780,16 @@ trx_purge(
 #endif /* UNIV_DEBUG */
 
 	if (truncate) {
+		uintmax_t	start = ut_time_us(NULL);
+
 		trx_purge_truncate_history(
 			purge_sys->limit.trx_no
 			? &purge_sys->limit
 			: &purge_sys->iter);
+
+		MONITOR_INC_VALUE(MONITOR_PURGE_TRUNCATE_HISTORY_COUNT, 1);
+		MONITOR_INC_TIME_IN_MICRO_SECS(
+			MONITOR_PURGE_TRUNCATE_HISTORY_MICROSECOND, start);
 	}
 
 	MONITOR_INC_VALUE(MONITOR_PURGE_INVOKED, 1);
@@ -1494,6 +1494,10 @@ trx_update_mod_tables_timestamp(
 		protecting it with a latch here would be too performance
 		intrusive. */
 		it->first->update_time = now;
+
+		if (trx->no != TRX_ID_MAX && !it->first->is_temporary()) {
+			it->first->purge_mod_trx_no = trx->no;
+		}
 	}
 
 	trx->mod_tables.clear();
@@ -2130,7 +2134,7 @@ trx_print_low(
 
 /**********************************************************************//**
 Prints info about a transaction.
-The caller must hold lock_sys->mutex.
+The caller must hold lock_sys->latch in exclusive mode.
 When possible, use trx_print() instead. */
 void
 trx_print_latched(
@@ -2150,7 +2154,7 @@ trx_print_latched(
 
 /**********************************************************************//**
 Prints info about a transaction.
-Acquires and releases lock_sys->mutex. */
+Acquires and releases lock_sys->latch in exclusive mode. */
 void
 trx_print(
 /*======*/
@@ -2192,7 +2196,8 @@ trx_assert_started(
 	/* trx->state can change from or to NOT_STARTED while we are holding
 	trx_sys.mutex for non-locking autocommit selects but not for other
 	types of transactions. It may change from ACTIVE to PREPARED. Unless
-	we are holding lock_sys->mutex, it may also change to COMMITTED. */
+	we are holding lock_sys->latch in exclusive mode, it may also change
+	to COMMITTED. */
 
 	switch (trx->state) {
 	case TRX_STATE_PREPARED:
@@ -2468,7 +2473,8 @@ static my_bool trx_get_trx_by_xid_callback(rw_trx_hash_element_t *element,
 /**
   Finds PREPARED XA transaction by xid.
 
-  trx may have been committed, unless the caller is holding lock_sys->mutex.
+  trx may have been committed, unless the caller is holding lock_sys->latch
+  in exclusive mode.
 
   @param[in]  xid  X/Open XA transaction identifier
 
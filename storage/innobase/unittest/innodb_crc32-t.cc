@@ -0,0 +1,87 @@
+/* Copyright (c) 2018, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA */
+
+/**
+  @file
+
+  Compare ut_crc32_multi() with ut_crc32() of each buffer, for every
+  number of buffers up to two full groups of the interleaved loop and
+  for lengths that do and do not end at an 8-byte boundary.
+*/
+
+#include "univ.i"
+#include "ut0crc32.h"
+#include <tap.h>
+
+static const ulint	max_bufs = 7;
+static const ulint	lengths[] = {
+	0, 1, 7, 8, 9, 15, 63, 100, 1021, 4096, 16383, 16384
+};
+static const ulint	n_lengths = sizeof lengths / sizeof *lengths;
+
+int main(int, char**)
+{
+	MY_INIT("innodb_crc32-t");
+
+	plan(1 + 2 * max_bufs * n_lengths);
+
+	ut_crc32_init();
+	diag("%s", ut_crc32_implementation);
+
+	ok(ut_crc32(reinterpret_cast<const byte*>("123456789"), 9)
+	   == 0xE3069283, "CRC-32C check value");
+
+	/* One byte more than the longest buffer, to checksum buffers
+	that are not 8-byte aligned too. */
+	const ulint	size = lengths[n_lengths - 1] + 1;
+	byte*		mem = static_cast<byte*>(malloc(max_bufs * size));
+	uint32_t	state = 1;
+
+	for (ulint i = 0; i < max_bufs * size; i++) {
+		state = state * 1103515245 + 12345;
+		mem[i] = byte(state >> 16);
+	}
+
+	for (ulint n = 1; n <= max_bufs; n++) {
+		for (ulint l = 0; l < n_lengths; l++) {
+			const ulint	len = lengths[l];
+
+			for (ulint misalign = 0; misalign < 2; misalign++) {
+				const byte*	bufs[max_bufs];
+				uint32_t	crcs[max_bufs];
+				bool		same = true;
+
+				for (ulint i = 0; i < n; i++) {
+					bufs[i] = mem + i * size + misalign;
+				}
+
+				ut_crc32_multi(bufs, len, crcs, n);
+
+				for (ulint i = 0; i < n; i++) {
+					same &= crcs[i]
+						== ut_crc32(bufs[i], len);
+				}
+
+				ok(same, ULINTPF " buffers of " ULINTPF
+				   " bytes%s", n, len,
+				   misalign ? ", misaligned" : "");
+			}
+		}
+	}
+
+	free(mem);
+	my_end(0);
+	return exit_status();
+}
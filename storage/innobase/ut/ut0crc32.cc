@@ -132,6 +132,26 @@ ut_crc32_func_t	ut_crc32 = ut_crc32_sw;
 const char*	ut_crc32_implementation = "Using generic crc32 instructions";
 #endif
 
+/** Calculates CRC32 of several buffers, one buffer at a time.
+@param[in]	bufs	buffers
+@param[in]	len	length of each buffer in bytes
+@param[out]	crcs	CRC-32C of each buffer
+@param[in]	n	number of buffers */
+static
+void
+ut_crc32_multi_generic(
+	const byte* const*	bufs,
+	ulint			len,
+	uint32_t*		crcs,
+	ulint			n)
+{
+	for (ulint i = 0; i < n; i++) {
+		crcs[i] = ut_crc32(bufs[i], len);
+	}
+}
+
+ut_crc32_multi_func_t	ut_crc32_multi = ut_crc32_multi_generic;
+
 #if (defined(__GNUC__) && defined(__x86_64__)) || defined(_MSC_VER)
 /********************************************************************//**
 Fetches CPU info */
@@ -358,6 +378,70 @@ ut_crc32_hw(
 
 	return(~crc);
 }
+
+/** Read a possibly unaligned 64-bit integer.
+@param[in]	data	data to read
+@return the integer in native byte order */
+inline
+uint64_t
+ut_crc32_read_64(const byte* data)
+{
+	uint64_t	data_int;
+	memcpy(&data_int, data, sizeof data_int);
+	return(data_int);
+}
+
+/** Calculates CRC32 of several buffers using hardware/CPU instructions.
+The crc32 instruction has a latency of 3 cycles but a throughput of one
+per cycle, so a single buffer leaves most of its capacity unused. Three
+buffers are processed at a time, each in a dependency chain of its own.
+@param[in]	bufs	buffers
+@param[in]	len	length of each buffer in bytes
+@param[out]	crcs	CRC-32C of each buffer
+@param[in]	n	number of buffers */
+static
+void
+ut_crc32_multi_hw(
+	const byte* const*	bufs,
+	ulint			len,
+	uint32_t*		crcs,
+	ulint			n)
+{
+	ulint	i = 0;
+
+	for (; i + 3 <= n; i += 3) {
+		const byte*	b0 = bufs[i];
+		const byte*	b1 = bufs[i + 1];
+		const byte*	b2 = bufs[i + 2];
+		uint32_t	c0 = 0xFFFFFFFFU;
+		uint32_t	c1 = 0xFFFFFFFFU;
+		uint32_t	c2 = 0xFFFFFFFFU;
+		ulint		l0 = len;
+
+		for (; l0 >= 8; l0 -= 8, b0 += 8, b1 += 8, b2 += 8) {
+			c0 = ut_crc32_64_low_hw(c0, ut_crc32_read_64(b0));
+			c1 = ut_crc32_64_low_hw(c1, ut_crc32_read_64(b1));
+			c2 = ut_crc32_64_low_hw(c2, ut_crc32_read_64(b2));
+		}
+
+		ulint	l1 = l0;
+		ulint	l2 = l0;
+
+		while (l0 > 0) {
+			ut_crc32_8_hw(&c0, &b0, &l0);
+			ut_crc32_8_hw(&c1, &b1, &l1);
+			ut_crc32_8_hw(&c2, &b2, &l2);
+		}
+
+		crcs[i] = ~c0;
+		crcs[i + 1] = ~c1;
+		crcs[i + 2] = ~c2;
+	}
+
+	for (; i < n; i++) {
+		crcs[i] = ut_crc32_hw(bufs[i], len);
+	}
+}
 #endif /* defined(__GNUC__) && defined(__x86_64__) || (_WIN64) */
 
 /* CRC32 software implementation. */
@@ -637,6 +721,7 @@ ut_crc32_init()
 
 	if (features_ecx & 1 << 20) {
 		ut_crc32 = ut_crc32_hw;
+		ut_crc32_multi = ut_crc32_multi_hw;
 		ut_crc32_implementation = "Using SSE2 crc32 instructions";
 	}
 #endif
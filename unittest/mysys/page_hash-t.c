@@ -0,0 +1,206 @@
+/* Copyright (c) 2018, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file
+
+  Microbenchmark of the page lookup protocols of the InnoDB buffer pool.
+
+  A chained hash table of "blocks" is partitioned by rw-locks like
+  buf_pool_t::page_hash. The latched lookup takes the partition rw-lock
+  in shared mode. The other two walk the chain without it, registered in
+  a per-thread counter slot like buf_page_hash_get_optimistic(), and
+  buffer-fix the block found either under the block mutex, or, like
+  buf_block_fix_if_page(), with a compare-and-swap when the block is
+  already buffer-fixed. Every thread looks up pages of a small, fully
+  cached working set, or only one hot page, like the root of an index,
+  and the lookups per second of a thread are reported.
+
+  The correctness of the protocol is tested on the real buffer pool by
+  mysql-test innodb.page_hash_unlatched.
+*/
+
+#include "thr_template.c"
+
+#define N_BLOCKS 4096
+#define N_CELLS 8192
+#define N_PARTITIONS 16
+#define N_SLOTS 256
+#define WORKING_SET 512
+#define LOOKUPS 1000000
+
+typedef struct st_block
+{
+  pthread_mutex_t mutex;
+  struct st_block *hash;
+  uint32 page_no;
+  int32 fix_count;
+  char pad[CPU_LEVEL1_DCACHE_LINESIZE];
+} BLOCK;
+
+typedef struct st_slot
+{
+  int32 n;
+  char pad[CPU_LEVEL1_DCACHE_LINESIZE - sizeof(int32)];
+} SLOT;
+
+enum lookup_protocol { LATCHED, BLOCK_MUTEX, OPTIMISTIC };
+
+static BLOCK blocks[N_BLOCKS];
+static BLOCK *cells[N_CELLS];
+static rw_lock_t partitions[N_PARTITIONS];
+static SLOT slots[N_SLOTS];
+static int32 next_slot;
+static enum lookup_protocol protocol;
+static uint32 working_set;
+
+static uint cell_of(uint32 page_no)
+{
+  return (page_no * 2654435761U) % N_CELLS;
+}
+
+static BLOCK *walk(uint32 page_no)
+{
+  BLOCK *block;
+  for (block= cells[cell_of(page_no)]; block; block= block->hash)
+    if (block->page_no == page_no)
+      return block;
+  return NULL;
+}
+
+static BLOCK *get_latched(uint32 page_no)
+{
+  rw_lock_t *latch= &partitions[cell_of(page_no) % N_PARTITIONS];
+  BLOCK *block;
+  rw_rdlock(latch);
+  if ((block= walk(page_no)))
+    my_atomic_add32(&block->fix_count, 1);
+  rw_unlock(latch);
+  return block;
+}
+
+/* buf_block_fix_if_page() */
+static int fix_if_page(BLOCK *block, uint32 page_no)
+{
+  int found;
+
+  if (protocol == OPTIMISTIC)
+  {
+    int32 count= my_atomic_load32_explicit(&block->fix_count,
+                                           MY_MEMORY_ORDER_RELAXED);
+    while (count > 0)
+    {
+      if (!my_atomic_cas32(&block->fix_count, &count, count + 1))
+        continue;
+      if (block->page_no == page_no)
+        return 1;
+      my_atomic_add32(&block->fix_count, -1);
+      return 0;
+    }
+  }
+
+  pthread_mutex_lock(&block->mutex);
+  if ((found= block->page_no == page_no))
+    my_atomic_add32(&block->fix_count, 1);
+  pthread_mutex_unlock(&block->mutex);
+  return found;
+}
+
+/* buf_page_hash_get_optimistic() */
+static BLOCK *get_optimistic(uint32 page_no, SLOT *slot)
+{
+  BLOCK *block, *found= NULL;
+  my_atomic_add32(&slot->n, 1);
+  if ((block= walk(page_no)) && fix_if_page(block, page_no))
+    found= block;
+  my_atomic_add32(&slot->n, -1);
+  return found;
+}
+
+pthread_handler_t test_lookup(void *arg)
+{
+  int m= *(int *)arg;
+  uint32 x= (uint32) (intptr) &m;
+  SLOT *slot= &slots[my_atomic_add32(&next_slot, 1) % N_SLOTS];
+
+  for (; m ; m--)
+  {
+    uint32 page_no;
+    BLOCK *block;
+    x= x * 1103515245 + 12345;
+    page_no= (x >> 8) % working_set;
+    block= protocol == LATCHED
+      ? get_latched(page_no) : get_optimistic(page_no, slot);
+    if (!block || block->page_no != page_no)
+      bad= 1;
+    else
+      my_atomic_add32(&block->fix_count, -1);
+  }
+  pthread_mutex_lock(&mutex);
+  if (!--running_threads) pthread_cond_signal(&cond);
+  pthread_mutex_unlock(&mutex);
+  return 0;
+}
+
+static void benchmark(const char *name, enum lookup_protocol p,
+                      uint32 pages, int threads)
+{
+  ulonglong start, ns;
+  protocol= p;
+  working_set= pages;
+  start= my_interval_timer();
+  test_concurrently(name, test_lookup, threads, LOOKUPS);
+  ns= my_interval_timer() - start;
+  diag("%s of %u pages: %d threads, %.0f lookups/s per thread",
+       name, pages, threads, LOOKUPS * 1e9 / (double) ns);
+}
+
+void do_tests()
+{
+  int i, threads, pages;
+  int max_threads= MY_MIN(my_getncpus(), 16);
+
+  for (i= 0; i < N_BLOCKS; i++)
+  {
+    uint c;
+    pthread_mutex_init(&blocks[i].mutex, NULL);
+    blocks[i].page_no= i;
+    c= cell_of(i);
+    blocks[i].hash= cells[c];
+    cells[c]= &blocks[i];
+  }
+  for (i= 0; i < N_PARTITIONS; i++)
+    my_rwlock_init(&partitions[i], NULL);
+
+  for (threads= 1, i= 0; threads <= max_threads; threads*= 2)
+    i++;
+  plan(2 * 3 * i);
+
+  for (pages= WORKING_SET; pages; pages= pages == 1 ? 0 : 1)
+  {
+    for (threads= 1; threads <= max_threads; threads*= 2)
+    {
+      benchmark("latched lookup", LATCHED, pages, threads);
+      benchmark("lookup fixing under the block mutex", BLOCK_MUTEX, pages,
+                threads);
+      benchmark("optimistic lookup", OPTIMISTIC, pages, threads);
+    }
+  }
+
+  for (i= 0; i < N_PARTITIONS; i++)
+    rwlock_destroy(&partitions[i]);
+  for (i= 0; i < N_BLOCKS; i++)
+    pthread_mutex_destroy(&blocks[i].mutex);
+}
@@ -0,0 +1,114 @@
+/* Copyright (c) 2018, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <tap.h>
+#include <string.h>
+
+#define MSD_ROWS 300000
+#define LSD_ROWS 5000
+
+enum key_pattern { RANDOM, FEW_VALUES, COMMON_PREFIX, DEEP_SPLITS };
+
+static void fill_keys(uchar *data, uint rows, size_t size,
+                      enum key_pattern pattern)
+{
+  uint i;
+  size_t j;
+  for (i= 0; i < rows; i++)
+  {
+    uchar *key= data + i * size;
+    for (j= 0; j < size; j++)
+    {
+      switch (pattern) {
+      case RANDOM:        key[j]= (uchar) rand(); break;
+      case FEW_VALUES:    key[j]= (uchar) (rand() % 3); break;
+      case COMMON_PREFIX: key[j]= j < size / 2 ? 'x' : (uchar) rand(); break;
+      case DEEP_SPLITS:
+        /* Every level splits off one key only, to reach the depth limit */
+        key[j]= j < 20 ? (uchar) (i == j) : (uchar) rand();
+        break;
+      }
+    }
+  }
+}
+
+
+static int cmp_keys(void *size, const void *a, const void *b)
+{
+  return memcmp(*(uchar**) a, *(uchar**) b, *(size_t*) size);
+}
+
+
+static void test_sort(uint rows, size_t size, enum key_pattern pattern,
+                      my_bool msd)
+{
+  uchar *data= (uchar*) malloc(rows * size);
+  uchar **keys= (uchar**) malloc(rows * sizeof(uchar*));
+  uchar **expected= (uchar**) malloc(rows * sizeof(uchar*));
+  uchar **buffer= (uchar**) malloc(rows * sizeof(uchar*));
+  uchar *digits= (uchar*) malloc(rows);
+  uint i, sorted= 1;
+
+  fill_keys(data, rows, size, pattern);
+  for (i= 0; i < rows; i++)
+    keys[i]= expected[i]= data + i * size;
+
+  my_qsort2(expected, rows, sizeof(uchar*), (qsort2_cmp) cmp_keys, &size);
+  if (msd)
+    radixsort_msd_for_str_ptr(keys, rows, size, buffer, digits);
+  else
+    radixsort_for_str_ptr(keys, rows, size, buffer);
+
+  for (i= 0; i < rows && sorted; i++)
+    sorted= !memcmp(keys[i], expected[i], size);
+  ok(sorted, "%s radixsort of %u keys of size %u, pattern %d",
+     msd ? "MSD" : "LSD", rows, (uint) size, (int) pattern);
+
+  free(digits);
+  free(buffer);
+  free(expected);
+  free(keys);
+  free(data);
+}
+
+
+int main(int argc __attribute__((unused)), char **argv)
+{
+  static const size_t sizes[]= { 1, 4, 8, 20, 33 };
+  uint i;
+  int pattern;
+  MY_INIT(argv[0]);
+
+  plan(4 + 2 * array_elements(sizes) * 4);
+
+  ok(!radixsort_msd_is_applicable(LSD_ROWS, 8), "MSD not used for few keys");
+  ok(radixsort_msd_is_applicable(MSD_ROWS, 8), "MSD used for many keys");
+  ok(radixsort_msd_is_applicable(MSD_ROWS, 1024), "MSD used for long keys");
+  ok(radixsort_is_appliccable(LSD_ROWS, 8), "LSD used for short keys");
+
+  for (i= 0; i < array_elements(sizes); i++)
+  {
+    for (pattern= RANDOM; pattern <= DEEP_SPLITS; pattern++)
+    {
+      test_sort(MSD_ROWS, sizes[i], (enum key_pattern) pattern, TRUE);
+      test_sort(LSD_ROWS, sizes[i], (enum key_pattern) pattern, FALSE);
+    }
+  }
+
+  my_end(0);
+  return exit_status();
+}